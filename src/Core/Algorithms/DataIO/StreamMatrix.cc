@@ -0,0 +1,673 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+using namespace SCIRun::Core::Datatypes;
+
+ALGORITHM_PARAMETER_DEF(DataIO, StreamSliceIsColumn);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamWindowStart);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamWindowSize);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamWindowIncrement);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamMaxIndex);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamPrefetch);
+ALGORITHM_PARAMETER_DEF(DataIO, StreamStorageOrder);
+ALGORITHM_PARAMETER_DEF(DataIO, RawMatrixRows);
+ALGORITHM_PARAMETER_DEF(DataIO, RawMatrixColumns);
+ALGORITHM_PARAMETER_DEF(DataIO, RawMatrixDataType);
+
+size_t MatrixFileLayout::valueSize() const
+{
+  switch (type)
+  {
+    case ValueType::Int8: case ValueType::UInt8: return 1;
+    case ValueType::Int16: case ValueType::UInt16: return 2;
+    case ValueType::Int32: case ValueType::UInt32: case ValueType::Float: return 4;
+    default: return 8;
+  }
+}
+
+MatrixFileLayout::ValueType MatrixFileLayout::parseValueType(const std::string& name)
+{
+  // The type names used by NRRD, including its aliases.
+  const auto type = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(name));
+  if (type == "signed char" || type == "int8" || type == "int8_t" || type == "char") return ValueType::Int8;
+  if (type == "uchar" || type == "unsigned char" || type == "uint8" || type == "uint8_t") return ValueType::UInt8;
+  if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int" || type == "int16" || type == "int16_t") return ValueType::Int16;
+  if (type == "ushort" || type == "unsigned short" || type == "unsigned short int" || type == "uint16" || type == "uint16_t") return ValueType::UInt16;
+  if (type == "int" || type == "signed int" || type == "int32" || type == "int32_t") return ValueType::Int32;
+  if (type == "uint" || type == "unsigned int" || type == "uint32" || type == "uint32_t") return ValueType::UInt32;
+  if (type == "longlong" || type == "long long" || type == "long long int" || type == "signed long long" || type == "signed long long int" || type == "int64" || type == "int64_t") return ValueType::Int64;
+  if (type == "ulonglong" || type == "unsigned long long" || type == "unsigned long long int" || type == "uint64" || type == "uint64_t") return ValueType::UInt64;
+  if (type == "float") return ValueType::Float;
+  if (type == "double") return ValueType::Double;
+  THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Unsupported matrix value type: " + name);
+}
+
+namespace
+{
+  bool hostIsBigEndian()
+  {
+    const uint16_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 0;
+  }
+}
+
+MatrixFileLayout MatrixFileLayout::fromNrrdHeader(const std::string& filename, bool rowMajor)
+{
+  std::ifstream header(filename.c_str(), std::ios::binary);
+  if (!header)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Could not open header file: " + filename);
+
+  std::string line;
+  if (!std::getline(header, line) || line.compare(0, 4, "NRRD") != 0)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Not a NRRD header: " + filename);
+
+  MatrixFileLayout layout;
+  layout.rowMajor = rowMajor;
+  std::vector<size_type> sizes;
+  std::vector<double> spacings;
+  bool bigEndian = false;
+  bool endianGiven = false;
+  std::string encoding = "raw";
+
+  while (std::getline(header, line))
+  {
+    boost::algorithm::trim_right_if(line, boost::algorithm::is_any_of("\r"));
+    // A blank line ends the header; attached data follows it.
+    if (line.empty())
+      break;
+    if (line[0] == '#')
+      continue;
+
+    auto colon = line.find(':');
+    if (colon == std::string::npos)
+      continue;
+    const auto key = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(line.substr(0, colon)));
+    auto value = line.substr(colon + 1);
+    if (!value.empty() && value[0] == '=')
+      value = value.substr(1);
+    boost::algorithm::trim(value);
+
+    std::istringstream values(value);
+    if (key == "type")
+      layout.type = parseValueType(value);
+    else if (key == "sizes")
+    {
+      size_type s;
+      while (values >> s) sizes.push_back(s);
+    }
+    else if (key == "spacings")
+    {
+      std::string s;
+      while (values >> s)
+      {
+        try { spacings.push_back(boost::lexical_cast<double>(s)); }
+        catch (boost::bad_lexical_cast&) { spacings.push_back(1.0); }
+      }
+    }
+    else if (key == "endian")
+    {
+      bigEndian = (value == "big");
+      endianGiven = true;
+    }
+    else if (key == "encoding")
+      encoding = value;
+    else if (key == "byte skip" || key == "byteskip")
+      layout.byteSkip = boost::lexical_cast<size_t>(value);
+    else if (key == "data file" || key == "datafile")
+      layout.dataFile = value;
+  }
+
+  if (encoding != "raw")
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Only raw NRRD encoding can be streamed from disk, found: " + encoding);
+  if (sizes.empty() || sizes.size() > 2)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("A streamed matrix needs a one or two dimensional NRRD: " + filename);
+
+  if (layout.dataFile.empty())
+  {
+    layout.dataFile = filename;
+    layout.byteSkip += static_cast<size_t>(header.tellg());
+  }
+  else if (boost::filesystem::path(layout.dataFile).is_relative())
+  {
+    layout.dataFile = (boost::filesystem::path(filename).parent_path() / layout.dataFile).string();
+  }
+
+  const size_type fast = sizes[0];
+  const size_type slow = sizes.size() > 1 ? sizes[1] : 1;
+  const double fastSpacing = spacings.size() > 0 ? spacings[0] : 1.0;
+  const double slowSpacing = spacings.size() > 1 ? spacings[1] : 1.0;
+  layout.columns = rowMajor ? fast : slow;
+  layout.rows = rowMajor ? slow : fast;
+  layout.columnSpacing = rowMajor ? fastSpacing : slowSpacing;
+  layout.rowSpacing = rowMajor ? slowSpacing : fastSpacing;
+  layout.swapBytes = endianGiven && layout.valueSize() > 1 && bigEndian != hostIsBigEndian();
+  return layout;
+}
+
+namespace
+{
+  /// Read-only mapping of a whole file.
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string& filename)
+    {
+#ifdef _WIN32
+      file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+      if (file_ == INVALID_HANDLE_VALUE)
+        THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Could not open data file: " + filename);
+      LARGE_INTEGER size;
+      GetFileSizeEx(file_, &size);
+      size_ = static_cast<size_t>(size.QuadPart);
+      if (size_ > 0)
+      {
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_)
+          data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+      }
+#else
+      fd_ = ::open(filename.c_str(), O_RDONLY);
+      if (fd_ < 0)
+        THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Could not open data file: " + filename);
+      struct stat info;
+      if (fstat(fd_, &info) == 0)
+        size_ = static_cast<size_t>(info.st_size);
+      if (size_ > 0)
+      {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (data != MAP_FAILED)
+          data_ = static_cast<const char*>(data);
+      }
+#endif
+      if (!data_ && size_ > 0)
+      {
+        close();
+        THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Could not memory-map data file: " + filename);
+      }
+    }
+
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    /// Hints the kernel that a byte range will be read soon.
+    void willNeed(size_t offset, size_t length) const
+    {
+#ifndef _WIN32
+      if (!data_ || offset >= size_) return;
+      const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+      const size_t start = offset - offset % page;
+      madvise(const_cast<char*>(data_ + start), std::min(size_ - start, length + offset - start), MADV_WILLNEED);
+#endif
+    }
+
+  private:
+    void close()
+    {
+#ifdef _WIN32
+      if (data_) UnmapViewOfFile(data_);
+      if (mapping_) CloseHandle(mapping_);
+      if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+      mapping_ = nullptr;
+      file_ = INVALID_HANDLE_VALUE;
+#else
+      if (data_) munmap(const_cast<char*>(data_), size_);
+      if (fd_ >= 0) ::close(fd_);
+      fd_ = -1;
+#endif
+      data_ = nullptr;
+    }
+
+#ifdef _WIN32
+    HANDLE file_ {INVALID_HANDLE_VALUE};
+    HANDLE mapping_ {nullptr};
+#else
+    int fd_ {-1};
+#endif
+    const char* data_ {nullptr};
+    size_t size_ {0};
+  };
+
+  template <typename T>
+  double readValue(const char* ptr, bool swap)
+  {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, ptr, sizeof(T));
+    if (swap)
+      std::reverse(bytes, bytes + sizeof(T));
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return static_cast<double>(value);
+  }
+
+  struct WindowKey
+  {
+    bool byColumn;
+    index_type first;
+    size_type count;
+    bool operator==(const WindowKey& other) const
+    {
+      return byColumn == other.byColumn && first == other.first && count == other.count;
+    }
+  };
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+  class StreamMatrixPrivate
+  {
+  public:
+    StreamMatrixPrivate(const MatrixFileLayout& layout, bool prefetch) : layout_(layout), file_(layout.dataFile)
+    {
+      const auto needed = layout_.byteSkip + static_cast<size_t>(layout_.rows) * static_cast<size_t>(layout_.columns) * layout_.valueSize();
+      if (layout_.rows < 0 || layout_.columns < 0 || needed > file_.size())
+        THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Data file " + layout_.dataFile + " is smaller than the matrix it should hold.");
+      if (prefetch)
+        worker_ = std::thread([this]() { prefetchLoop(); });
+    }
+
+    ~StreamMatrixPrivate()
+    {
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        quit_ = true;
+      }
+      wakeup_.notify_all();
+      if (worker_.joinable())
+        worker_.join();
+    }
+
+    double value(size_type row, size_type column) const
+    {
+      const size_t offset = layout_.rowMajor ?
+        static_cast<size_t>(row) * layout_.columns + column :
+        static_cast<size_t>(column) * layout_.rows + row;
+      const char* ptr = file_.data() + layout_.byteSkip + offset * layout_.valueSize();
+      const bool swap = layout_.swapBytes;
+      switch (layout_.type)
+      {
+        case MatrixFileLayout::ValueType::Int8: return readValue<int8_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::UInt8: return readValue<uint8_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::Int16: return readValue<int16_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::UInt16: return readValue<uint16_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::Int32: return readValue<int32_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::UInt32: return readValue<uint32_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::Int64: return readValue<int64_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::UInt64: return readValue<uint64_t>(ptr, swap);
+        case MatrixFileLayout::ValueType::Float: return readValue<float>(ptr, swap);
+        default: return readValue<double>(ptr, swap);
+      }
+    }
+
+    DenseMatrixHandle extract(const std::vector<index_type>& indices, bool byColumn) const
+    {
+      // Walk the file in storage order so every page is touched once.
+      DenseMatrixHandle out;
+      const auto count = static_cast<size_type>(indices.size());
+      if (byColumn)
+      {
+        out = boost::make_shared<DenseMatrix>(layout_.rows, count);
+        if (layout_.rowMajor)
+        {
+          for (size_type r = 0; r < layout_.rows; ++r)
+            for (size_type j = 0; j < count; ++j)
+              (*out)(r, j) = value(r, indices[j]);
+        }
+        else
+        {
+          for (size_type j = 0; j < count; ++j)
+            for (size_type r = 0; r < layout_.rows; ++r)
+              (*out)(r, j) = value(r, indices[j]);
+        }
+      }
+      else
+      {
+        out = boost::make_shared<DenseMatrix>(count, layout_.columns);
+        if (layout_.rowMajor)
+        {
+          for (size_type i = 0; i < count; ++i)
+            for (size_type c = 0; c < layout_.columns; ++c)
+              (*out)(i, c) = value(indices[i], c);
+        }
+        else
+        {
+          for (size_type c = 0; c < layout_.columns; ++c)
+            for (size_type i = 0; i < count; ++i)
+              (*out)(i, c) = value(indices[i], c);
+        }
+      }
+      return out;
+    }
+
+    DenseMatrixHandle extract(const WindowKey& key) const
+    {
+      std::vector<index_type> indices(key.count);
+      for (size_type k = 0; k < key.count; ++k)
+        indices[k] = key.first + k;
+      return extract(indices, key.byColumn);
+    }
+
+    /// Asks the background thread to extract a window ahead of time.
+    void requestPrefetch(const WindowKey& key)
+    {
+      if (!worker_.joinable())
+        return;
+      {
+        std::lock_guard<std::mutex> lock(lock_);
+        if ((ready_ && readyKey_ == key) || (busy_ && workingKey_ == key))
+          return;
+        pending_ = key;
+      }
+      wakeup_.notify_all();
+    }
+
+    /// Returns a prefetched window, waiting for it if it is queued or being extracted.
+    DenseMatrixHandle takePrefetched(const WindowKey& key)
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      done_.wait(lock, [&]() { return !(busy_ && workingKey_ == key) && !(pending_ && *pending_ == key); });
+      if (ready_ && readyKey_ == key)
+      {
+        auto window = ready_;
+        ready_.reset();
+        return window;
+      }
+      return nullptr;
+    }
+
+    const MatrixFileLayout layout_;
+    MappedFile file_;
+    size_type prefetchHits_ {0};
+
+  private:
+    void prefetchLoop()
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      while (true)
+      {
+        wakeup_.wait(lock, [this]() { return quit_ || pending_; });
+        if (quit_)
+          return;
+
+        workingKey_ = *pending_;
+        pending_.reset();
+        busy_ = true;
+        lock.unlock();
+
+        auto window = extract(workingKey_);
+
+        lock.lock();
+        ready_ = window;
+        readyKey_ = workingKey_;
+        busy_ = false;
+        done_.notify_all();
+      }
+    }
+
+    std::thread worker_;
+    std::mutex lock_;
+    std::condition_variable wakeup_, done_;
+    boost::optional<WindowKey> pending_;
+    WindowKey workingKey_ {true, 0, 0};
+    WindowKey readyKey_ {true, 0, 0};
+    DenseMatrixHandle ready_;
+    bool busy_ {false};
+    bool quit_ {false};
+  };
+
+}}}}
+
+StreamMatrix::StreamMatrix(const MatrixFileLayout& layout, bool prefetch) :
+  impl_(boost::make_shared<StreamMatrixPrivate>(layout, prefetch))
+{
+}
+
+StreamMatrix::~StreamMatrix()
+{
+}
+
+const MatrixFileLayout& StreamMatrix::layout() const
+{
+  return impl_->layout_;
+}
+
+DenseMatrixHandle StreamMatrix::columns(index_type first, size_type count, index_type nextFirst, size_type nextCount)
+{
+  return window(true, first, count, nextFirst, nextCount);
+}
+
+DenseMatrixHandle StreamMatrix::rows(index_type first, size_type count, index_type nextFirst, size_type nextCount)
+{
+  return window(false, first, count, nextFirst, nextCount);
+}
+
+size_type StreamMatrix::prefetchHits() const
+{
+  return impl_->prefetchHits_;
+}
+
+DenseMatrixHandle StreamMatrix::window(bool byColumn, index_type first, size_type count,
+  index_type nextFirst, size_type nextCount)
+{
+  const auto size = byColumn ? ncols() : nrows();
+  if (first < 0 || count < 1 || first + count > size)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Requested window [" + std::to_string(first) + ", " + std::to_string(first + count) +
+      ") lies outside the " + std::to_string(size) + (byColumn ? " columns" : " rows") + " of the streamed matrix.");
+
+  const WindowKey key {byColumn, first, count};
+  auto out = impl_->takePrefetched(key);
+  if (out)
+    impl_->prefetchHits_++;
+  else
+    out = impl_->extract(key);
+
+  // Without a hint, assume the caller steps forward by whole windows.
+  if (nextFirst < 0)
+  {
+    nextFirst = first + count;
+    nextCount = count;
+  }
+  if (nextCount < 1)
+    nextCount = count;
+  if (nextFirst + nextCount <= size)
+    impl_->requestPrefetch({byColumn, nextFirst, nextCount});
+  return out;
+}
+
+DenseMatrixHandle StreamMatrix::select(const std::vector<index_type>& indices, bool byColumn) const
+{
+  const auto size = byColumn ? ncols() : nrows();
+  for (auto i : indices)
+  {
+    if (i < 0 || i >= size)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("Index " + std::to_string(i) + " lies outside the streamed matrix.");
+  }
+  return impl_->extract(indices, byColumn);
+}
+
+const AlgorithmInputName StreamMatrixAlgo::Indices("Indices");
+const AlgorithmOutputName StreamMatrixAlgo::DataVector("DataVector");
+const AlgorithmOutputName StreamMatrixAlgo::Index("Index");
+const AlgorithmOutputName StreamMatrixAlgo::ScaledIndex("ScaledIndex");
+
+StreamMatrixAlgo::StreamMatrixAlgo()
+{
+  addParameter(Variables::Filename, std::string(""));
+  addParameter(Parameters::StreamSliceIsColumn, true);
+  addParameter(Parameters::StreamWindowStart, 0);
+  addParameter(Parameters::StreamWindowSize, 1);
+  addParameter(Parameters::StreamWindowIncrement, 1);
+  addParameter(Parameters::StreamMaxIndex, 0);
+  addParameter(Parameters::StreamPrefetch, true);
+  addOption(Parameters::StreamStorageOrder, "row-major", "row-major|column-major");
+  addParameter(Parameters::RawMatrixRows, 0);
+  addParameter(Parameters::RawMatrixColumns, 0);
+  addOption(Parameters::RawMatrixDataType, "double", "double|float|int8|uint8|int16|uint16|int32|uint32|int64|uint64");
+}
+
+StreamMatrixHandle StreamMatrixAlgo::open() const
+{
+  const auto filename = get(Variables::Filename).toFilename().string();
+  if (filename.empty())
+    THROW_ALGORITHM_INPUT_ERROR("No file name was given.");
+
+  const bool rowMajor = checkOption(Parameters::StreamStorageOrder, "row-major");
+  const auto extension = boost::filesystem::extension(filename);
+  const bool nrrd = extension == ".nhdr" || extension == ".nrrd";
+
+  std::ostringstream key;
+  key << filename << '|' << rowMajor << '|' << get(Parameters::StreamPrefetch).toBool();
+  if (!nrrd)
+  {
+    key << '|' << get(Parameters::RawMatrixRows).toInt() << '|' << get(Parameters::RawMatrixColumns).toInt()
+      << '|' << getOption(Parameters::RawMatrixDataType);
+  }
+  if (stream_ && streamKey_ == key.str())
+    return stream_;
+
+  stream_.reset();
+  MatrixFileLayout layout;
+  if (nrrd)
+  {
+    layout = MatrixFileLayout::fromNrrdHeader(filename, rowMajor);
+  }
+  else
+  {
+    // Headerless files hold the values only; the shape comes from the parameters.
+    layout.dataFile = filename;
+    layout.rows = get(Parameters::RawMatrixRows).toInt();
+    layout.columns = get(Parameters::RawMatrixColumns).toInt();
+    layout.type = MatrixFileLayout::parseValueType(getOption(Parameters::RawMatrixDataType));
+    layout.rowMajor = rowMajor;
+    if (layout.rows <= 0 || layout.columns <= 0)
+      THROW_ALGORITHM_INPUT_ERROR("Raw matrix files need the number of rows and columns; use a .nhdr header to describe the file instead.");
+  }
+
+  stream_ = boost::make_shared<StreamMatrix>(layout, get(Parameters::StreamPrefetch).toBool());
+  streamKey_ = key.str();
+  return stream_;
+}
+
+index_type StreamMatrixAlgo::nextWindowStart(index_type start, index_type increment, index_type maxIndex)
+{
+  auto next = start + increment;
+  if (next > maxIndex || next < 0)
+    next = increment > 0 ? 0 : maxIndex;
+  return next;
+}
+
+AlgorithmOutput StreamMatrixAlgo::run(const AlgorithmInput& input) const
+{
+  auto stream = open();
+  const bool byColumn = get(Parameters::StreamSliceIsColumn).toBool();
+  const auto size = byColumn ? stream->ncols() : stream->nrows();
+  const double spacing = byColumn ? stream->layout().columnSpacing : stream->layout().rowSpacing;
+
+  std::vector<index_type> indices;
+  DenseMatrixHandle data;
+  auto indexInput = input.get<Matrix>(Indices);
+  if (indexInput)
+  {
+    auto dense = castMatrix::toDense(indexInput);
+    if (!dense)
+      THROW_ALGORITHM_INPUT_ERROR("Indices need to be a dense matrix.");
+    for (size_type k = 0; k < dense->size(); ++k)
+      indices.push_back(static_cast<index_type>((*dense)(k)));
+    data = stream->select(indices, byColumn);
+  }
+  else
+  {
+    const auto start = static_cast<index_type>(get(Parameters::StreamWindowStart).toInt());
+    if (start < 0 || start >= size)
+      THROW_ALGORITHM_INPUT_ERROR("Window start " + std::to_string(start) + " is out of range [0, " + std::to_string(size - 1) + "].");
+    const auto windowSize = get(Parameters::StreamWindowSize).toInt();
+    auto clampedCount = [&](index_type first) { return std::max<size_type>(1, std::min<size_type>(windowSize, size - first)); };
+    const auto count = clampedCount(start);
+    for (size_type k = 0; k < count; ++k)
+      indices.push_back(start + k);
+
+    // Read ahead the window StreamMatrixFromDisk will ask for on its next execution.
+    const auto next = nextWindowStart(start, get(Parameters::StreamWindowIncrement).toInt(), size - 1);
+    data = byColumn ? stream->columns(start, count, next, clampedCount(next)) : stream->rows(start, count, next, clampedCount(next));
+  }
+
+  auto index = boost::make_shared<DenseMatrix>(1, static_cast<size_type>(indices.size()));
+  auto scaled = boost::make_shared<DenseMatrix>(1, static_cast<size_type>(indices.size()));
+  for (size_t k = 0; k < indices.size(); ++k)
+  {
+    (*index)(0, k) = static_cast<double>(indices[k]);
+    (*scaled)(0, k) = spacing * indices[k];
+  }
+
+  AlgorithmOutput output;
+  output[DataVector] = data;
+  output[Index] = index;
+  output[ScaledIndex] = scaled;
+  output.setAdditionalAlgoOutput(boost::make_shared<Variable>(Name("maxIndex"), static_cast<int>(size - 1)));
+  return output;
+}
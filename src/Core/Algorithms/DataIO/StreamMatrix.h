@@ -0,0 +1,149 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef ALGORITHMS_DATAIO_STREAMMATRIX_H
+#define ALGORITHMS_DATAIO_STREAMMATRIX_H
+
+#include <string>
+#include <vector>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Algorithms/DataIO/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+      ALGORITHM_PARAMETER_DECL(StreamSliceIsColumn);
+      ALGORITHM_PARAMETER_DECL(StreamWindowStart);
+      ALGORITHM_PARAMETER_DECL(StreamWindowSize);
+      ALGORITHM_PARAMETER_DECL(StreamWindowIncrement);
+      ALGORITHM_PARAMETER_DECL(StreamMaxIndex);
+      ALGORITHM_PARAMETER_DECL(StreamPrefetch);
+      ALGORITHM_PARAMETER_DECL(StreamStorageOrder);
+      ALGORITHM_PARAMETER_DECL(RawMatrixRows);
+      ALGORITHM_PARAMETER_DECL(RawMatrixColumns);
+      ALGORITHM_PARAMETER_DECL(RawMatrixDataType);
+
+      /// Where and how a dense matrix is stored in a binary file.
+      struct SCISHARE MatrixFileLayout
+      {
+        enum class ValueType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float, Double };
+
+        std::string dataFile;
+        size_type rows {0};
+        size_type columns {0};
+        ValueType type {ValueType::Double};
+        bool rowMajor {true};
+        bool swapBytes {false};
+        size_t byteSkip {0};
+        double rowSpacing {1.0};
+        double columnSpacing {1.0};
+
+        size_t valueSize() const;
+        static ValueType parseValueType(const std::string& name);
+
+        /// Reads a NRRD header (.nhdr with a detached raw data file, or .nrrd with
+        /// raw data attached). The fastest axis holds the columns of a row-major
+        /// matrix, or the rows of a column-major one.
+        static MatrixFileLayout fromNrrdHeader(const std::string& filename, bool rowMajor = true);
+      };
+
+      class StreamMatrixPrivate;
+
+      /// Out-of-core access to a dense matrix stored in a binary file. The file is
+      /// memory-mapped, so only the pages of the windows that are requested are read.
+      /// After a window is handed out, the next window is extracted on a background
+      /// thread, so stepping through the file overlaps disk reads with the work done
+      /// downstream. At most two windows are held in memory.
+      class SCISHARE StreamMatrix
+      {
+      public:
+        explicit StreamMatrix(const MatrixFileLayout& layout, bool prefetch = true);
+        ~StreamMatrix();
+        StreamMatrix(const StreamMatrix&) = delete;
+        StreamMatrix& operator=(const StreamMatrix&) = delete;
+
+        const MatrixFileLayout& layout() const;
+        size_type nrows() const { return layout().rows; }
+        size_type ncols() const { return layout().columns; }
+
+        /// Columns [first, first + count) as a nrows() x count matrix. The window of
+        /// nextCount columns at nextFirst is read ahead; by default that is the
+        /// window of the same size directly after this one.
+        Datatypes::DenseMatrixHandle columns(index_type first, size_type count,
+          index_type nextFirst = -1, size_type nextCount = 0);
+        /// Rows [first, first + count) as a count x ncols() matrix, reading ahead
+        /// like columns().
+        Datatypes::DenseMatrixHandle rows(index_type first, size_type count,
+          index_type nextFirst = -1, size_type nextCount = 0);
+        /// An arbitrary selection of columns or rows, read without prefetching.
+        Datatypes::DenseMatrixHandle select(const std::vector<index_type>& indices, bool byColumn) const;
+
+        /// Number of windows handed out that had already been read ahead.
+        size_type prefetchHits() const;
+
+      private:
+        Datatypes::DenseMatrixHandle window(bool byColumn, index_type first, size_type count,
+          index_type nextFirst, size_type nextCount);
+        boost::shared_ptr<StreamMatrixPrivate> impl_;
+      };
+
+      typedef boost::shared_ptr<StreamMatrix> StreamMatrixHandle;
+
+      class SCISHARE StreamMatrixAlgo : public AlgorithmBase
+      {
+      public:
+        StreamMatrixAlgo();
+
+        /// Opens the file named by Variables::Filename, reusing the open stream
+        /// when neither the file nor its layout parameters changed.
+        StreamMatrixHandle open() const;
+
+        /// Start of the window after the one at start when stepping by increment. A step
+        /// past maxIndex restarts at 0; a step below 0 restarts at maxIndex.
+        static index_type nextWindowStart(index_type start, index_type increment, index_type maxIndex);
+
+        AlgorithmOutput run(const AlgorithmInput& input) const override;
+
+        static const AlgorithmInputName Indices;
+        static const AlgorithmOutputName DataVector;
+        static const AlgorithmOutputName Index;
+        static const AlgorithmOutputName ScaledIndex;
+
+      private:
+        mutable StreamMatrixHandle stream_;
+        mutable std::string streamKey_;
+      };
+
+}}}}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace SCIRun;
+using namespace SCIRun::Core;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+namespace
+{
+  const size_type rows = 7;
+  const size_type cols = 11;
+
+  double entry(size_type r, size_type c) { return 100.0 * r + c; }
+
+  boost::filesystem::path writeTestMatrix(const std::string& name, bool rowMajor)
+  {
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    std::ofstream raw((dir / (name + ".raw")).string().c_str(), std::ios::binary);
+    for (size_type i = 0; i < (rowMajor ? rows : cols); ++i)
+      for (size_type j = 0; j < (rowMajor ? cols : rows); ++j)
+      {
+        float value = static_cast<float>(rowMajor ? entry(i, j) : entry(j, i));
+        raw.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      }
+    raw.close();
+
+    std::ofstream header((dir / (name + ".nhdr")).string().c_str());
+    header << "NRRD0004\n# test matrix\ntype: float\ndimension: 2\n"
+      << "sizes: " << (rowMajor ? cols : rows) << " " << (rowMajor ? rows : cols) << "\n"
+      << "spacings: " << (rowMajor ? "0.5 2" : "2 0.5") << "\n"
+      << "encoding: raw\ndata file: " << name << ".raw\n";
+    return dir / (name + ".nhdr");
+  }
+}
+
+TEST(StreamMatrixTests, ReadsColumnWindowsWhileSteppingForward)
+{
+  auto header = writeTestMatrix("cols", true);
+  StreamMatrix stream(MatrixFileLayout::fromNrrdHeader(header.string()));
+  ASSERT_EQ(rows, stream.nrows());
+  ASSERT_EQ(cols, stream.ncols());
+  EXPECT_EQ(0.5, stream.layout().columnSpacing);
+
+  for (index_type first = 0; first + 3 <= cols; first += 3)
+  {
+    auto window = stream.columns(first, 3);
+    ASSERT_EQ(rows, window->nrows());
+    ASSERT_EQ(3, window->ncols());
+    for (size_type r = 0; r < rows; ++r)
+      for (size_type c = 0; c < 3; ++c)
+        EXPECT_EQ(entry(r, first + c), (*window)(r, c));
+  }
+  EXPECT_THROW(stream.columns(cols - 1, 2), AlgorithmInputException);
+  boost::filesystem::remove_all(header.parent_path());
+}
+
+TEST(StreamMatrixTests, ReadsRowsAndSelectionsFromColumnMajorFiles)
+{
+  auto header = writeTestMatrix("rows", false);
+  StreamMatrix stream(MatrixFileLayout::fromNrrdHeader(header.string(), false));
+  ASSERT_EQ(rows, stream.nrows());
+  ASSERT_EQ(cols, stream.ncols());
+
+  auto window = stream.rows(2, 4);
+  for (size_type r = 0; r < 4; ++r)
+    for (size_type c = 0; c < cols; ++c)
+      EXPECT_EQ(entry(2 + r, c), (*window)(r, c));
+
+  auto selection = stream.select({ 10, 0, 4 }, true);
+  for (size_type r = 0; r < rows; ++r)
+  {
+    EXPECT_EQ(entry(r, 10), (*selection)(r, 0));
+    EXPECT_EQ(entry(r, 0), (*selection)(r, 1));
+    EXPECT_EQ(entry(r, 4), (*selection)(r, 2));
+  }
+  boost::filesystem::remove_all(header.parent_path());
+}
+
+TEST(StreamMatrixTests, AlgorithmOutputsWindowAndIndices)
+{
+  auto header = writeTestMatrix("algo", true);
+  StreamMatrixAlgo algo;
+  algo.set(Variables::Filename, header.string());
+  algo.set(Parameters::StreamWindowStart, 9);
+  algo.set(Parameters::StreamWindowSize, 4);
+
+  auto output = algo.run(AlgorithmInput());
+  auto data = output.get<DenseMatrix>(StreamMatrixAlgo::DataVector);
+  auto scaled = output.get<DenseMatrix>(StreamMatrixAlgo::ScaledIndex);
+  ASSERT_TRUE(data != nullptr);
+  ASSERT_EQ(2, data->ncols());
+  EXPECT_EQ(entry(3, 10), (*data)(3, 1));
+  EXPECT_EQ(4.5, (*scaled)(0, 0));
+  EXPECT_EQ(cols - 1, output.additionalAlgoOutput()->toInt());
+  boost::filesystem::remove_all(header.parent_path());
+}
+
+TEST(StreamMatrixTests, ReadsAheadWithIncrementOtherThanWindowSize)
+{
+  auto header = writeTestMatrix("stride", true);
+  StreamMatrixAlgo algo;
+  algo.set(Variables::Filename, header.string());
+  algo.set(Parameters::StreamWindowSize, 4);
+  algo.set(Parameters::StreamWindowIncrement, 3);
+
+  // Step the way StreamMatrixFromDisk does: 0, 3, 6, 9 (clamped to two columns), then wrap to 0.
+  index_type start = 0;
+  for (int step = 0; step < 6; ++step)
+  {
+    algo.set(Parameters::StreamWindowStart, static_cast<int>(start));
+    auto output = algo.run(AlgorithmInput());
+    auto data = output.get<DenseMatrix>(StreamMatrixAlgo::DataVector);
+    ASSERT_TRUE(data != nullptr);
+    EXPECT_EQ(start == 9 ? 2 : 4, data->ncols());
+    EXPECT_EQ(entry(0, start), (*data)(0, 0));
+    start = StreamMatrixAlgo::nextWindowStart(start, 3, output.additionalAlgoOutput()->toInt());
+  }
+
+  // Every window after the first was read ahead.
+  EXPECT_EQ(5, algo.open()->prefetchHits());
+  boost::filesystem::remove_all(header.parent_path());
+}
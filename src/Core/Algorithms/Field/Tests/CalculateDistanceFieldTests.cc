@@ -0,0 +1,202 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Logging/LoggerInterface.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+#include <boost/assign.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::TestUtils;
+using namespace boost::assign;
+
+namespace
+{
+  std::vector<double> distanceValues(const std::string& method, bool truncate)
+  {
+    auto latvol = CreateEmptyLatVol(24, 20, 16, data_info_type::DOUBLE_E, Point(-1, -1, -2), Point(2, 2, 1));
+    auto cube = CubeTriSurfLinearBasis(data_info_type::DOUBLE_E);
+
+    CalculateDistanceFieldAlgo algo;
+    algo.setOption(Parameters::DistanceMethod, method);
+    algo.set(Parameters::Truncate, truncate);
+    algo.set(Parameters::TruncateDistance, 0.5);
+
+    FieldHandle output;
+    EXPECT_TRUE(algo.runImpl(latvol, cube, output));
+
+    std::vector<double> values;
+    output->vfield()->get_values(values);
+    return values;
+  }
+
+  // Unit cube around the origin with all face normals pointing outwards, so the signed
+  // distance is negative inside. The faces are axis aligned, which keeps the narrow band thin.
+  FieldHandle orientedCubeTriSurf()
+  {
+    FieldInformation fi(mesh_info_type::TRISURFMESH_E, databasis_info_type::NODATA_E, data_info_type::DOUBLE_E);
+    auto field = CreateField(fi);
+    auto vmesh = field->vmesh();
+    for (int k = 0; k < 2; ++k)
+      for (int j = 0; j < 2; ++j)
+        for (int i = 0; i < 2; ++i)
+          vmesh->add_point(Point(i - 0.5, j - 0.5, k - 0.5));
+
+    // corners of each face, counterclockwise seen from outside
+    const int faces[6][4] = { {0,4,6,2}, {1,3,7,5}, {0,1,5,4}, {2,6,7,3}, {0,2,3,1}, {4,5,7,6} };
+    for (const auto& f : faces)
+    {
+      VMesh::Node::array_type tri1, tri2;
+      tri1 += f[0], f[1], f[2];
+      tri2 += f[0], f[2], f[3];
+      vmesh->add_elem(tri1);
+      vmesh->add_elem(tri2);
+    }
+    return field;
+  }
+
+  FieldHandle regularGrid(databasis_info_type basis)
+  {
+    FieldInformation lfi(mesh_info_type::LATVOLMESH_E, basis, data_info_type::DOUBLE_E);
+    auto mesh = CreateMesh(lfi, 21, 21, 21, Point(-1, -1, -1), Point(1, 1, 1));
+    return CreateField(lfi, mesh);
+  }
+
+  std::vector<double> signedDistanceValues(FieldHandle input, const std::string& method,
+    Core::Logging::LoggerHandle logger = Core::Logging::LoggerHandle())
+  {
+    CalculateSignedDistanceFieldAlgo algo;
+    if (logger)
+      algo.setLogger(logger);
+    algo.setOption(Parameters::DistanceMethod, method);
+
+    FieldHandle output;
+    EXPECT_TRUE(algo.run(input, orientedCubeTriSurf(), output));
+
+    std::vector<double> values;
+    output->vfield()->get_values(values);
+    return values;
+  }
+
+  class RemarkLogger : public Core::Logging::LegacyLoggerInterface
+  {
+  public:
+    void error(const std::string&) const override {}
+    bool errorReported() const override { return false; }
+    void setErrorFlag(bool) override {}
+    void warning(const std::string&) const override {}
+    void remark(const std::string& msg) const override { remarks_.push_back(msg); }
+    void status(const std::string&) const override {}
+
+    mutable std::vector<std::string> remarks_;
+  };
+}
+
+TEST(CalculateDistanceFieldTests, FastSweepingMatchesExactDistance)
+{
+  auto exact = distanceValues("exact", false);
+  auto sweep = distanceValues("fast sweeping", false);
+
+  ASSERT_EQ(exact.size(), sweep.size());
+  for (size_t i = 0; i < exact.size(); ++i)
+  {
+    // first order scheme, the error grows with the distance from the band
+    EXPECT_NEAR(exact[i], sweep[i], 0.1 + 0.05*exact[i]);
+  }
+}
+
+TEST(CalculateDistanceFieldTests, FastSweepingHonorsTruncation)
+{
+  auto exact = distanceValues("exact", true);
+  auto sweep = distanceValues("fast sweeping", true);
+
+  ASSERT_EQ(exact.size(), sweep.size());
+  for (size_t i = 0; i < exact.size(); ++i)
+  {
+    EXPECT_LE(sweep[i], 0.5);
+    if (exact[i] < 0.3)
+      EXPECT_NEAR(exact[i], sweep[i], 0.05);
+  }
+}
+
+class CalculateSignedDistanceFieldTests : public ::testing::TestWithParam<databasis_info_type>
+{
+};
+
+TEST_P(CalculateSignedDistanceFieldTests, FastSweepingMatchesExactSignedDistance)
+{
+  auto exact = signedDistanceValues(regularGrid(GetParam()), "exact");
+  auto sweep = signedDistanceValues(regularGrid(GetParam()), "fast sweeping");
+
+  // samples this close to the surface are in the band of the default width of two spacings
+  const double band = 0.2;
+  ASSERT_EQ(exact.size(), sweep.size());
+  for (size_t i = 0; i < exact.size(); ++i)
+  {
+    if (std::fabs(exact[i]) < band)
+      EXPECT_NEAR(exact[i], sweep[i], 1e-10);
+    else
+    {
+      EXPECT_EQ(exact[i] < 0.0, sweep[i] < 0.0);
+      EXPECT_NEAR(std::fabs(exact[i]), std::fabs(sweep[i]), 0.1 + 0.05*std::fabs(exact[i]));
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  NodeAndCellData,
+  CalculateSignedDistanceFieldTests,
+  ::testing::Values(databasis_info_type::LINEARDATA_E, databasis_info_type::CONSTANTDATA_E)
+  );
+
+TEST(CalculateSignedDistanceFieldFallbackTests, FastSweepingFallsBackToExactOnIrregularMesh)
+{
+  auto tets = CubeTetVolLinearBasis(data_info_type::DOUBLE_E);
+  auto logger = boost::make_shared<RemarkLogger>();
+
+  auto exact = signedDistanceValues(tets, "exact");
+  auto sweep = signedDistanceValues(tets, "fast sweeping", logger);
+
+  ASSERT_EQ(1u, logger->remarks_.size());
+  EXPECT_NE(std::string::npos, logger->remarks_[0].find("computing exact distances"));
+  EXPECT_EQ(exact, sweep);
+}
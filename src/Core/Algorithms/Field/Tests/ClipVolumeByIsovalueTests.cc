@@ -39,6 +39,7 @@
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Core/Datatypes/DenseMatrix.h>
 
 using namespace SCIRun;
@@ -118,3 +119,41 @@ TEST(ClipVolumeByIsovalueAlgoTest, DISABLED_ClipVolumeByIsovalue_LatVol_DataOnNo
   EXPECT_EQ(output->vmesh()->num_elems(),1);
   EXPECT_EQ(output->vfield()->num_values(),8);
 }
+
+namespace
+{
+  // Unit cube split into six tetrahedra around the 0-7 diagonal, so every
+  // element contains node 0 and the clip edges are shared between elements.
+  FieldHandle CubeOfTets(double cornerValue)
+  {
+    FieldInformation fi("TetVolMesh", 1, "double");
+    FieldHandle field = CubeGrid(1, fi);
+
+    VField* values = field->vfield();
+    for (VMesh::index_type idx = 0; idx < 8; ++idx)
+      values->set_value(idx == 0 ? cornerValue : -cornerValue, idx);
+    return field;
+  }
+}
+
+TEST(ClipVolumeByIsovalueAlgoTest, ClippedCornerSharesEdgeNodesBetweenElements)
+{
+  ClipMeshByIsovalueAlgo algo;
+  FieldHandle output;
+  algo.set(Parameters::ScalarIsoValue, 0.0);
+  algo.set(Parameters::LessThanIsoValue, true);
+  algo.run(CubeOfTets(1.0), output);
+
+  // The corner node plus one node on each of its seven edges.
+  ASSERT_EQ(8, output->vmesh()->num_nodes());
+  EXPECT_EQ(6, output->vmesh()->num_elems());
+
+  double value;
+  output->vfield()->get_value(value, 0);
+  EXPECT_EQ(1.0, value);
+  for (VMesh::index_type idx = 1; idx < 8; ++idx)
+  {
+    output->vfield()->get_value(value, idx);
+    EXPECT_EQ(0.0, value);
+  }
+}
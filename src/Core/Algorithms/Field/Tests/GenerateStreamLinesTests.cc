@@ -32,10 +32,14 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Algorithms/Legacy/Fields/StreamLines/GenerateStreamLines.h>
+#include <Core/Algorithms/Legacy/Fields/StreamLines/StreamLineIntegrators.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/GeometryPrimitives/BBox.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Core/Datatypes/DenseMatrix.h>
 
 using namespace SCIRun;
@@ -290,3 +294,74 @@ TEST(GenerateStreamLinesTests, ManySeedsMultithreadedStreamlineLength)
     EXPECT_NEAR(max, meshOutputByMethodTotalLength[method].second, 1e-1);
   }
 }
+
+namespace
+{
+  /// (n-1)^3 unit cubes split into six tets each, holding a vector field that
+  /// swirls around the x axis while drifting out through the x = n - 1 side.
+  FieldHandle swirlingTetVol(int n)
+  {
+    FieldInformation fi("TetVolMesh", 1, "Vector");
+    auto field = CubeGrid(n - 1, fi);
+    auto mesh = field->vmesh();
+
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_point(p, idx);
+      const int i = static_cast<int>(p.x()), k = static_cast<int>(p.z());
+      mesh->set_point(Point(p.x(), p.y() + 0.1 * ((i + 2 * k) % 3), p.z()), idx);
+    }
+    mesh->synchronize(Mesh::EPSILON_E | Mesh::ELEM_LOCATE_E | Mesh::FACES_E | Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
+
+    auto vfield = field->vfield();
+    const double c = (n - 1) / 2.0;
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_center(p, idx);
+      vfield->set_value(Vector(0.3 + 0.05 * p.z(), c - p.z(), p.y() - c), idx);
+    }
+    return field;
+  }
+
+  std::vector<Point> traceStreamline(VField* field, const Point& seed, IntegrationMethod method, bool walk)
+  {
+    StreamLineIntegrators integrator;
+    integrator.vfield_ = field;
+    integrator.seed_ = seed;
+    integrator.tolerance2_ = 1e-8;
+    integrator.step_size_ = 0.05;
+    integrator.max_steps_ = 5000;
+    integrator.walk_ = walk;
+    integrator.nodes_.push_back(seed);
+    integrator.integrate(method);
+    return integrator.nodes_;
+  }
+}
+
+TEST(GenerateStreamLinesTests, TetVolWalkMatchesFullLocateUntilLeavingMesh)
+{
+  const int n = 6;
+  auto field = swirlingTetVol(n);
+  BBox box = field->vmesh()->get_bounding_box();
+
+  for (auto method : { IntegrationMethod::AdamsBashforth, IntegrationMethod::Heun,
+    IntegrationMethod::RungeKutta, IntegrationMethod::RungeKuttaFehlberg })
+  {
+    for (const auto& seed : { Point(0.2, 2.5, 1.0), Point(1.3, 1.1, 3.7), Point(0.5, 3.9, 2.2) })
+    {
+      auto walked = traceStreamline(field->vfield(), seed, method, true);
+      auto located = traceStreamline(field->vfield(), seed, method, false);
+
+      ASSERT_EQ(located.size(), walked.size()) << static_cast<int>(method);
+      for (size_t i = 0; i < located.size(); ++i)
+        ASSERT_NEAR(0.0, (located[i] - walked[i]).length(), 1e-9) << static_cast<int>(method) << " node " << i;
+
+      // Every streamline drifts out of the mesh well before max_steps_.
+      ASSERT_GT(walked.size(), 10u);
+      EXPECT_LT(walked.size(), 5000u);
+      EXPECT_GT(walked.back().x(), box.get_max().x() - 0.5);
+    }
+  }
+}
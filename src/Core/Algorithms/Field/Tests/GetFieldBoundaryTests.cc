@@ -145,6 +145,66 @@ TEST(GetFieldBoundaryTest, LatVolBoundary)
   EXPECT_EQ("None (nodata basis)", info.dataLocation);*/
 }
 
+TEST(GetFieldBoundaryTest, LargeLatVolBoundaryIsComplete)
+{
+  FieldInformation lfi("LatVolMesh", 1, "double");
+  MeshHandle mesh = CreateMesh(lfi, 20, 15, 10, Point(0, 0, 0), Point(1, 1, 1));
+  FieldHandle ofh = CreateField(lfi, mesh);
+  ofh->vfield()->clear_all_values();
+
+  GetFieldBoundaryAlgo algo;
+  FieldHandle boundary;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.run(ofh, boundary, mapping));
+
+  EXPECT_EQ(2*(19*14 + 19*9 + 14*9), boundary->vmesh()->num_elems());
+  EXPECT_EQ(20*15*10 - 18*13*8, boundary->vmesh()->num_nodes());
+  ASSERT_TRUE(mapping != nullptr);
+  EXPECT_EQ(boundary->vmesh()->num_nodes(), mapping->nrows());
+  EXPECT_EQ(20*15*10, mapping->ncols());
+
+  FieldHandle boundaryOnly;
+  ASSERT_TRUE(algo.run(ofh, boundaryOnly));
+  EXPECT_EQ(boundary->vmesh()->num_elems(), boundaryOnly->vmesh()->num_elems());
+  EXPECT_EQ(boundary->vmesh()->num_nodes(), boundaryOnly->vmesh()->num_nodes());
+}
+
+TEST(GetFieldBoundaryTest, TetsSharingAFace)
+{
+  FieldInformation fi("TetVolMesh", 0, "double");
+  FieldHandle field = CreateField(fi);
+  auto vmesh = field->vmesh();
+  vmesh->add_point(Point(0, 0, 0));
+  vmesh->add_point(Point(1, 0, 0));
+  vmesh->add_point(Point(0, 1, 0));
+  vmesh->add_point(Point(0, 0, 1));
+  vmesh->add_point(Point(0, 0, -1));
+  const VMesh::Node::index_type tets[2][4] = { { 0, 1, 2, 3 }, { 0, 2, 1, 4 } };
+  VMesh::Node::array_type nodes;
+  for (const auto& tet : tets)
+  {
+    nodes.assign(tet, tet + 4);
+    vmesh->add_elem(nodes);
+  }
+  field->vfield()->resize_values();
+  field->vfield()->set_value(3.0, VMesh::Elem::index_type(0));
+  field->vfield()->set_value(7.0, VMesh::Elem::index_type(1));
+
+  GetFieldBoundaryAlgo algo;
+  FieldHandle boundary;
+  MatrixHandle mapping;
+  ASSERT_TRUE(algo.run(field, boundary, mapping));
+
+  EXPECT_EQ(6, boundary->vmesh()->num_elems());
+  EXPECT_EQ(5, boundary->vmesh()->num_nodes());
+  std::vector<double> values;
+  boundary->vfield()->get_values(values);
+  EXPECT_EQ((std::vector<double>{ 3, 3, 3, 7, 7, 7 }), values);
+  ASSERT_TRUE(mapping != nullptr);
+  EXPECT_EQ(6, mapping->nrows());
+  EXPECT_EQ(2, mapping->ncols());
+}
+
 TEST(GetFieldBoundaryTest, CanLogErrorMessage)
 {
   GetFieldBoundaryAlgo algo;
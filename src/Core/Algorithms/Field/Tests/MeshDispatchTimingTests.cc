@@ -0,0 +1,214 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/GetCentroids.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/CalculateMeshCenterAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataFromNodeToElem.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // Six tets per unit cube, holding x + 2y + 3z on the nodes.
+  FieldHandle TetGrid(int n)
+  {
+    auto field = CubeGrid(n, FieldInformation(mesh_info_type::TETVOLMESH_E, databasis_info_type::LINEARDATA_E, data_info_type::DOUBLE_E));
+    VMesh* mesh = field->vmesh();
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_point(p, idx);
+      field->vfield()->set_value(p.x() + 2.0*p.y() + 3.0*p.z(), idx);
+    }
+    return field;
+  }
+
+  FieldHandle runOnField(AlgorithmBase& algo, FieldHandle field)
+  {
+    AlgorithmInput input;
+    input[Variables::InputField] = field;
+    return algo.run(input).get<Field>(Variables::OutputField);
+  }
+
+  // The loops below are the VMesh versions the algorithms used before they were
+  // ported to dispatch_mesh.
+
+  FieldHandle vmeshCentroids(FieldHandle field)
+  {
+    FieldInformation fo(field);
+    fo.make_pointcloudmesh();
+    fo.make_nodata();
+    VMesh* imesh = field->vmesh();
+    MeshHandle mesh = CreateMesh(fo);
+    VMesh* omesh = mesh->vmesh();
+
+    imesh->synchronize(Mesh::ELEMS_E);
+    VMesh::size_type num_elems = imesh->num_elems();
+    omesh->reserve_nodes(num_elems);
+    for (VMesh::Elem::index_type idx = 0; idx < num_elems; idx++)
+    {
+      Point p;
+      imesh->get_center(p, idx);
+      omesh->add_node(p);
+    }
+    return CreateField(fo, mesh);
+  }
+
+  Point vmeshWeightedElemCenter(FieldHandle field)
+  {
+    VMesh* imesh = field->vmesh();
+    Point c(0.0, 0.0, 0.0);
+    VMesh::size_type numElems = imesh->num_elems();
+    double size = 0.0;
+    for (VMesh::Elem::index_type idx = 0; idx < numElems; idx++)
+    {
+      Point p;
+      imesh->get_center(p, idx);
+      double weight = fabs(imesh->get_size(idx));
+      size += weight;
+      c = Point(c + weight*p);
+    }
+    return c*(1.0/size);
+  }
+
+  std::vector<double> vmeshNodeToElemAverage(FieldHandle field)
+  {
+    VMesh* mesh = field->vmesh();
+    VField* ifield = field->vfield();
+    std::vector<double> values(mesh->num_elems());
+
+    VMesh::Elem::iterator it, eit;
+    VMesh::Node::array_type nodearray;
+    mesh->begin(it);
+    mesh->end(eit);
+    while (it != eit)
+    {
+      mesh->get_nodes(nodearray, *it);
+      size_t nsize = nodearray.size();
+      double val(0), tval(0);
+      for (size_t p = 0; p < nsize; p++)
+      {
+        ifield->get_value(tval, nodearray[p]);
+        val += tval;
+      }
+      values[*it] = val*(1.0/static_cast<double>(nsize));
+      ++it;
+    }
+    return values;
+  }
+
+  const int GridSize = 50;
+}
+
+/// todo: switch these disabled tests to nightly mode. They time 750,000 tets through the
+/// typed mesh loop versus the VMesh loop.
+
+TEST(MeshDispatchTimingTests, DISABLED_GetCentroidsTimeToSolution)
+{
+  auto field = TetGrid(GridSize);
+
+  FieldHandle virt, typed;
+  {
+    ScopedTimer t("element centroids, VMesh loop");
+    virt = vmeshCentroids(field);
+  }
+  GetCentroids algo;
+  {
+    ScopedTimer t("element centroids, GetCentroids");
+    typed = runOnField(algo, field);
+  }
+
+  ASSERT_EQ(virt->vmesh()->num_nodes(), typed->vmesh()->num_nodes());
+  for (VMesh::Node::index_type idx = 0; idx < virt->vmesh()->num_nodes(); idx += 997)
+  {
+    Point expected, actual;
+    virt->vmesh()->get_center(expected, idx);
+    typed->vmesh()->get_center(actual, idx);
+    EXPECT_NEAR(0.0, (expected - actual).length(), 1e-12);
+  }
+}
+
+TEST(MeshDispatchTimingTests, DISABLED_CalculateMeshCenterTimeToSolution)
+{
+  auto field = TetGrid(GridSize);
+
+  Point expected;
+  {
+    ScopedTimer t("weighted element center, VMesh loop");
+    expected = vmeshWeightedElemCenter(field);
+  }
+  CalculateMeshCenterAlgo algo;
+  algo.setOption(Parameters::Method, "weightedElemCenter");
+  FieldHandle output;
+  {
+    ScopedTimer t("weighted element center, CalculateMeshCenter");
+    output = runOnField(algo, field);
+  }
+
+  Point actual;
+  output->vmesh()->get_center(actual, VMesh::Node::index_type(0));
+  EXPECT_NEAR(0.0, (expected - actual).length(), 1e-9);
+}
+
+TEST(MeshDispatchTimingTests, DISABLED_MapFieldDataFromNodeToElemTimeToSolution)
+{
+  auto field = TetGrid(GridSize);
+
+  std::vector<double> expected;
+  {
+    ScopedTimer t("node to element average, VMesh loop");
+    expected = vmeshNodeToElemAverage(field);
+  }
+  MapFieldDataFromNodeToElemAlgo algo;
+  algo.setOption(Variables::Method, "Average");
+  FieldHandle output;
+  {
+    ScopedTimer t("node to element average, MapFieldDataFromNodeToElem");
+    output = algo.runImpl(field);
+  }
+
+  std::vector<double> actual;
+  output->vfield()->get_values(actual);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(expected[i], actual[i], 1e-12);
+}
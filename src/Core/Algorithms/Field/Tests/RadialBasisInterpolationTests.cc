@@ -0,0 +1,153 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RadialBasisInterpolation.h>
+#include <Eigen/SVD>
+#include <random>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  std::vector<Point> randomPoints(size_t n, unsigned seed)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<Point> points;
+    for (size_t i = 0; i < n; ++i)
+      points.emplace_back(unit(gen), unit(gen), unit(gen));
+    return points;
+  }
+
+  double smooth(const Point& p)
+  {
+    return std::sin(2 * p.x()) + p.y() * p.z();
+  }
+
+  std::vector<double> sample(const std::vector<Point>& points)
+  {
+    std::vector<double> values;
+    for (const auto& p : points)
+      values.push_back(smooth(p));
+    return values;
+  }
+}
+
+TEST(RadialBasisInterpolationTests, ThinPlateMatchesDenseSVDSolution)
+{
+  const auto centers = randomPoints(200, 1);
+  const auto values = sample(centers);
+
+  const auto n = static_cast<int>(centers.size());
+  Eigen::MatrixXd sigma(n, n);
+  Eigen::VectorXd rhs(n);
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      const double r = (centers[i] - centers[j]).length();
+      sigma(i, j) = r == 0 ? 0 : r * r * std::log(r);
+    }
+    rhs(i) = values[i];
+  }
+  Eigen::VectorXd reference = sigma.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(rhs);
+
+  RadialBasisInterpolant rbf(centers, values, RadialBasisInterpolant::Kernel::ThinPlateSpline);
+  EXPECT_FALSE(rbf.usesPartitionOfUnity());
+
+  const auto targets = randomPoints(50, 2);
+  const auto result = rbf.evaluate(targets, std::numeric_limits<double>::max(), 0);
+  for (size_t k = 0; k < targets.size(); ++k)
+  {
+    double expected = 0;
+    for (int j = 0; j < n; ++j)
+    {
+      const double r = (targets[k] - centers[j]).length();
+      expected += reference(j) * (r == 0 ? 0 : r * r * std::log(r));
+    }
+    EXPECT_NEAR(expected, result[k], 1e-6);
+  }
+}
+
+TEST(RadialBasisInterpolationTests, PartitionOfUnityInterpolatesLargeSets)
+{
+  const auto centers = randomPoints(RadialBasisInterpolant::GlobalSolveLimit + 2000, 3);
+  const auto values = sample(centers);
+  RadialBasisInterpolant rbf(centers, values, RadialBasisInterpolant::Kernel::ThinPlateSpline);
+  EXPECT_TRUE(rbf.usesPartitionOfUnity());
+
+  for (size_t i = 0; i < centers.size(); i += 97)
+    EXPECT_NEAR(values[i], rbf.evaluate(centers[i]), 1e-5);
+
+  // Away from the boundary the blended patches approximate the sampled function closely.
+  auto targets = randomPoints(200, 4);
+  for (auto& p : targets)
+    p = Point(0.1, 0.1, 0.1) + 0.8 * Vector(p);
+  const auto result = rbf.evaluate(targets, std::numeric_limits<double>::max(), 0);
+  for (size_t k = 0; k < targets.size(); ++k)
+    EXPECT_NEAR(smooth(targets[k]), result[k], 1e-2);
+}
+
+TEST(RadialBasisInterpolationTests, WendlandInterpolatesCenters)
+{
+  const auto centers = randomPoints(3000, 5);
+  const auto values = sample(centers);
+  RadialBasisInterpolant rbf(centers, values, RadialBasisInterpolant::Kernel::WendlandC2);
+  EXPECT_GT(rbf.supportRadius(), 0);
+
+  for (size_t i = 0; i < centers.size(); i += 31)
+    EXPECT_NEAR(values[i], rbf.evaluate(centers[i]), 1e-8);
+}
+
+TEST(RadialBasisInterpolationTests, MaxDistanceDefaultsToAnyCenter)
+{
+  const std::vector<Point> centers { Point(0, 0, 0), Point(1, 0, 0) };
+  const std::vector<double> values { 1, 2 };
+  RadialBasisInterpolant rbf(centers, values, RadialBasisInterpolant::Kernel::ThinPlateSpline);
+
+  const auto result = rbf.evaluate({ Point(-0.1, 0, 0), Point(0.5, 0, 0), Point(5, 5, 5) }, 0.95, -7);
+  EXPECT_EQ(-7, result[0]);
+  EXPECT_NE(-7, result[1]);
+  EXPECT_EQ(-7, result[2]);
+}
+
+TEST(RadialBasisInterpolationTests, MaxDistanceCanUseNearestCenter)
+{
+  const std::vector<Point> centers { Point(0, 0, 0), Point(1, 0, 0) };
+  const std::vector<double> values { 1, 2 };
+  RadialBasisInterpolant rbf(centers, values, RadialBasisInterpolant::Kernel::ThinPlateSpline);
+
+  const auto result = rbf.evaluate({ Point(0.1, 0, 0), Point(5, 5, 5) }, 0.5, -7,
+    RadialBasisInterpolant::DistanceRule::NearestCenter);
+  EXPECT_NE(-7, result[0]);
+  EXPECT_EQ(-7, result[1]);
+}
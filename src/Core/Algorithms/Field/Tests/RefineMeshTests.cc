@@ -0,0 +1,178 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/RefineMeshTetVolAlgoV.h>
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/RefineMeshHexVolAlgoV.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <cmath>
+
+using namespace SCIRun;
+using namespace Core::Datatypes;
+using namespace Core::Geometry;
+using namespace Core::Algorithms;
+using namespace Fields;
+
+namespace
+{
+  /// A slightly sheared n^3 grid of hexes, or of six tets per hex, holding the
+  /// distance to a sphere around the center of the grid.
+  FieldHandle sphereGrid(const std::string& meshType, int n, int basisOrder)
+  {
+    FieldInformation fi(meshType, basisOrder, "double");
+    auto field = TestUtils::CubeGrid(n - 1, fi);
+    auto mesh = field->vmesh();
+
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_point(p, idx);
+      const int i = static_cast<int>(p.x()), j = static_cast<int>(p.y()), k = static_cast<int>(p.z());
+      mesh->set_point(Point(i + 0.1 * ((7 * i + 3 * j + k) % 5), j + 0.05 * ((i + 11 * j) % 3), k), idx);
+    }
+
+    auto vfield = field->vfield();
+    const Point center(n / 2.0, n / 2.0, n / 2.0);
+    for (VMesh::index_type idx = 0; idx < vfield->num_values(); ++idx)
+    {
+      Point p;
+      if (basisOrder == 1)
+        mesh->get_center(p, VMesh::Node::index_type(idx));
+      else
+        mesh->get_center(p, VMesh::Elem::index_type(idx));
+      vfield->set_value((p - center).length() - n / 3.0, idx);
+    }
+    return field;
+  }
+
+  /// Order independent moments of a refined field: the serial and the parallel
+  /// refinement number the new nodes differently.
+  struct RefinedSummary
+  {
+    VMesh::size_type numNodes, numElems;
+    double pointSum, elemCenterSum, valueSum, valueMoment;
+  };
+
+  RefinedSummary summarize(FieldHandle field)
+  {
+    auto mesh = field->vmesh();
+    auto vfield = field->vfield();
+    RefinedSummary s { mesh->num_nodes(), mesh->num_elems(), 0, 0, 0, 0 };
+    auto weight = [](const Point& p) { return p.x() + 2 * p.y() + 3 * p.z(); };
+
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_point(p, idx);
+      s.pointSum += weight(p);
+    }
+    for (VMesh::Elem::index_type idx = 0; idx < mesh->num_elems(); ++idx)
+    {
+      Point p;
+      mesh->get_center(p, idx);
+      s.elemCenterSum += weight(p);
+    }
+    for (VMesh::index_type idx = 0; idx < vfield->num_values(); ++idx)
+    {
+      double v;
+      Point p;
+      vfield->get_value(v, idx);
+      if (vfield->basis_order() == 1)
+        mesh->get_center(p, VMesh::Node::index_type(idx));
+      else
+        mesh->get_center(p, VMesh::Elem::index_type(idx));
+      s.valueSum += v;
+      s.valueMoment += v * weight(p);
+    }
+    return s;
+  }
+
+  void expectSummary(const RefinedSummary& expected, FieldHandle output)
+  {
+    ASSERT_TRUE(output != nullptr);
+    const auto actual = summarize(output);
+    EXPECT_EQ(expected.numNodes, actual.numNodes);
+    EXPECT_EQ(expected.numElems, actual.numElems);
+    EXPECT_NEAR(expected.pointSum, actual.pointSum, 1e-6 * std::abs(expected.pointSum));
+    EXPECT_NEAR(expected.elemCenterSum, actual.elemCenterSum, 1e-6 * std::abs(expected.elemCenterSum));
+    EXPECT_NEAR(expected.valueSum, actual.valueSum, 1e-6 * (1 + std::abs(expected.valueSum)));
+    EXPECT_NEAR(expected.valueMoment, actual.valueMoment, 1e-6 * (1 + std::abs(expected.valueMoment)));
+  }
+
+  struct RefineCase
+  {
+    const char* select;
+    double isoval;
+    int basisOrder;
+    RefinedSummary expected;
+  };
+}
+
+// Expected values come from the serial refinement the parallel passes replaced.
+TEST(RefineMeshTests, TetVolMatchesSerialRefinement)
+{
+  const RefineCase cases[] = {
+    { "all", 0.0, 1, { 729, 3072, 8964, 37776, 470.0797032, 4448.729824 } },
+    { "greaterthan", 0.5, 1, { 555, 2075, 6449, 23620.425, 498.0524471, 4888.8807 } },
+    { "lessthan", 0.0, 0, { 522, 2407, 6986.1, 31168.775, 386.8553969, 1688.455374 } },
+    { "all", 0.0, 0, { 729, 3072, 8964, 37776, 1037.434183, 7750.424556 } },
+  };
+
+  for (const auto& c : cases)
+  {
+    SCOPED_TRACE(c.select);
+    RefineMeshTetVolAlgoV algo;
+    FieldHandle output;
+    ASSERT_TRUE(algo.runImpl(sphereGrid("TetVolMesh", 5, c.basisOrder), output, c.select, c.isoval));
+    expectSummary(c.expected, output);
+  }
+}
+
+TEST(RefineMeshTests, HexVolMatchesSerialRefinement)
+{
+  const RefineCase cases[] = {
+    { "all", 0.0, 1, { 2197, 1728, 27017.9, 21251.7, 1296.169425, 12085.92396 } },
+    { "greaterthan", 2.0, 1, { 205, 114, 1872.085185, 1009.243981, 237.3531072, 1498.914447 } },
+    { "lessthan", 0.0, 0, { 1662, 1426, 22508.53333, 18775.06806, 253.0608686, 1695.216989 } },
+    { "all", 0.0, 0, { 2197, 1728, 27017.9, 21251.7, 536.4781355, 3763.648237 } },
+  };
+
+  for (const auto& c : cases)
+  {
+    SCOPED_TRACE(c.select);
+    RefineMeshHexVolAlgoV algo;
+    FieldHandle output;
+    ASSERT_TRUE(algo.runImpl(sphereGrid("HexVolMesh", 5, c.basisOrder), output, true, c.select, c.isoval));
+    expectSummary(c.expected, output);
+  }
+}
@@ -0,0 +1,214 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Algorithms/Legacy/Fields/Cleanup/ReorderMeshAlgo.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <numeric>
+#include <random>
+
+using namespace SCIRun;
+using namespace Core::Datatypes;
+using namespace Core::Geometry;
+using namespace Core::Algorithms;
+using namespace Fields;
+
+namespace
+{
+  double dataAt(const Point& p)
+  {
+    return p.x() + 10 * p.y() + 100 * p.z();
+  }
+
+  /// A structured grid of hexes whose nodes and elements are numbered at random.
+  FieldHandle shuffledHexGrid(int n)
+  {
+    FieldInformation fi("HexVolMesh", static_cast<int>(databasis_info_type::LINEARDATA_E), "double");
+    auto field = CreateField(fi);
+    auto mesh = field->vmesh();
+
+    std::mt19937 gen(11);
+    const auto numNodes = n * n * n;
+    std::vector<index_type> label(numNodes);
+    std::iota(label.begin(), label.end(), 0);
+    std::shuffle(label.begin(), label.end(), gen);
+    std::vector<Point> points(numNodes);
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+          points[label[i + n * (j + n * k)]] = Point(i, j, k);
+    for (const auto& p : points)
+      mesh->add_point(p);
+
+    std::vector<VMesh::Node::array_type> elems;
+    auto node = [&](int i, int j, int k) { return VMesh::Node::index_type(label[i + n * (j + n * k)]); };
+    for (int k = 0; k + 1 < n; ++k)
+      for (int j = 0; j + 1 < n; ++j)
+        for (int i = 0; i + 1 < n; ++i)
+        {
+          VMesh::Node::array_type hex(8);
+          hex[0] = node(i, j, k);
+          hex[1] = node(i + 1, j, k);
+          hex[2] = node(i + 1, j + 1, k);
+          hex[3] = node(i, j + 1, k);
+          hex[4] = node(i, j, k + 1);
+          hex[5] = node(i + 1, j, k + 1);
+          hex[6] = node(i + 1, j + 1, k + 1);
+          hex[7] = node(i, j + 1, k + 1);
+          elems.push_back(hex);
+        }
+    std::shuffle(elems.begin(), elems.end(), gen);
+    for (const auto& e : elems)
+      mesh->add_elem(e);
+
+    auto vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::Node::index_type i = 0; i < numNodes; ++i)
+      vfield->set_value(dataAt(points[i]), i);
+    return field;
+  }
+
+  void expectDataFollowsNodes(FieldHandle input, FieldHandle output, MatrixHandle nodePermutation)
+  {
+    auto mesh = output->vmesh();
+    auto field = output->vfield();
+    ASSERT_EQ(input->vmesh()->num_nodes(), mesh->num_nodes());
+    ASSERT_EQ(input->vmesh()->num_elems(), mesh->num_elems());
+
+    std::vector<double> before(mesh->num_nodes());
+    for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+    {
+      Point p;
+      double v;
+      mesh->get_center(p, i);
+      field->get_value(v, i);
+      EXPECT_EQ(dataAt(p), v);
+      input->vfield()->get_value(before[i], i);
+    }
+
+    auto P = castMatrix::toSparse(nodePermutation);
+    ASSERT_TRUE(P != nullptr);
+    Eigen::VectorXd permuted = *P * Eigen::Map<Eigen::VectorXd>(before.data(), before.size());
+    for (VMesh::Node::index_type i = 0; i < mesh->num_nodes(); ++i)
+    {
+      double v;
+      field->get_value(v, i);
+      EXPECT_EQ(v, permuted(static_cast<index_type>(i)));
+    }
+  }
+}
+
+TEST(ReorderMeshTests, ReverseCuthillMcKeeReducesBandwidth)
+{
+  auto input = shuffledHexGrid(10);
+  ReorderMeshAlgo algo;
+  algo.set(Parameters::MeasureSpeedup, false);
+
+  FieldHandle output;
+  MatrixHandle nodes, elems;
+  ReorderMeshStatistics stats;
+  ASSERT_TRUE(algo.run(input, output, nodes, elems, &stats));
+
+  expectDataFollowsNodes(input, output, nodes);
+  EXPECT_GT(stats.bandwidthBefore, 500);
+  EXPECT_LT(3 * stats.bandwidthAfter, stats.bandwidthBefore);
+  EXPECT_EQ(output->vmesh()->num_elems(), elems->nrows());
+}
+
+TEST(ReorderMeshTests, HilbertCurveImprovesLocality)
+{
+  auto input = shuffledHexGrid(10);
+  ReorderMeshAlgo algo;
+  algo.set(Parameters::MeasureSpeedup, false);
+  algo.setOption(Parameters::MeshOrdering, "Hilbert");
+
+  FieldHandle output;
+  MatrixHandle nodes, elems;
+  ReorderMeshStatistics stats;
+  ASSERT_TRUE(algo.run(input, output, nodes, elems, &stats));
+
+  expectDataFollowsNodes(input, output, nodes);
+  EXPECT_LT(stats.meanBandwidthAfter, 0.3 * stats.meanBandwidthBefore);
+}
+
+TEST(ReorderMeshTests, RepeatedNodesDoNotAddNeighbors)
+{
+  FieldInformation fi("TetVolMesh", static_cast<int>(databasis_info_type::LINEARDATA_E), "double");
+  auto input = CreateField(fi);
+  auto mesh = input->vmesh();
+
+  // A chain of tets, each sharing a face with the next, ends in a tet with a repeated node.
+  const int numNodes = 20;
+  for (int i = 0; i < numNodes; ++i)
+    mesh->add_point(Point(i, std::cos(i * 2.1), std::sin(i * 2.1)));
+  VMesh::Node::array_type tet(4);
+  for (int i = 0; i + 3 < numNodes; ++i)
+  {
+    for (int k = 0; k < 4; ++k)
+      tet[k] = i + k;
+    mesh->add_elem(tet);
+  }
+  tet[0] = numNodes - 3;
+  tet[1] = numNodes - 2;
+  tet[2] = tet[3] = numNodes - 1;
+  mesh->add_elem(tet);
+  input->vfield()->resize_values();
+  for (VMesh::Node::index_type i = 0; i < numNodes; ++i)
+  {
+    Point p;
+    mesh->get_center(p, i);
+    input->vfield()->set_value(dataAt(p), i);
+  }
+
+  ReorderMeshAlgo algo;
+  EXPECT_FALSE(algo.get(Parameters::MeasureSpeedup).toBool());
+
+  FieldHandle output;
+  MatrixHandle nodes, elems;
+  ReorderMeshStatistics stats;
+  ASSERT_TRUE(algo.run(input, output, nodes, elems, &stats));
+
+  EXPECT_EQ(3, stats.bandwidthBefore);
+  EXPECT_EQ(3, stats.bandwidthAfter);
+  expectDataFollowsNodes(input, output, nodes);
+}
+
+TEST(ReorderMeshTests, RejectsStructuredMeshes)
+{
+  FieldInformation fi("LatVolMesh", static_cast<int>(databasis_info_type::LINEARDATA_E), "double");
+  ReorderMeshAlgo algo;
+  FieldHandle output;
+  MatrixHandle nodes, elems;
+  EXPECT_FALSE(algo.run(CreateField(fi), output, nodes, elems));
+}
@@ -35,9 +35,36 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/SplitByConnectedRegion.h>
 #include <Core/Algorithms/Legacy/Fields/DomainFields/SplitFieldByDomainAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ConnectedComponents.h>
+#include <Core/Thread/Parallel.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  // Tets 0 and 2 share node 3; tet 1 stands alone.
+  FieldHandle threeTets()
+  {
+    FieldInformation fi("TetVolMesh", static_cast<int>(databasis_info_type::CONSTANTDATA_E), "double");
+    FieldHandle field = CreateField(fi);
+    auto vmesh = field->vmesh();
+    for (int j = 0; j < 11; ++j)
+      vmesh->add_point(Point(j, j % 2, j % 3));
+    VMesh::Node::array_type nodes(4);
+    const VMesh::Node::index_type tets[3][4] = { {0, 1, 2, 3}, {4, 5, 6, 7}, {3, 8, 9, 10} };
+    for (const auto& tet : tets)
+    {
+      nodes.assign(tet, tet + 4);
+      vmesh->add_elem(nodes);
+    }
+    field->vfield()->resize_values();
+    field->vfield()->set_all_values(1.0);
+    return field;
+  }
+}
 
 TEST(SplitByConnectedRegionTest, SplitFieldByConnectedRegionAlgoTetTests)
 {
@@ -421,3 +448,61 @@ TEST(SplitByConnectedRegionTest, DISABLED_SplitFieldByConnectedRegionAlgoTriTest
   EXPECT_EQ(result8->vmesh()->num_nodes(), 895);
 
 }
+
+TEST(ConnectedComponentsTest, ConcurrentJoinsGiveSmallestMemberOrder)
+{
+  const size_type size = 3000;
+  ConnectedComponents sets(size);
+  const int nproc = 8;
+  auto joinTriples = [&](int proc)
+  {
+    for (index_type j = (size*(proc+1))/nproc - 1; j >= (size*proc)/nproc; --j)
+    {
+      if (j % 3 != 2)
+        sets.join(j + 1, j);
+    }
+  };
+  Parallel::RunTasks(joinTriples, nproc);
+
+  std::vector<index_type> component;
+  EXPECT_EQ(size/3, sets.label(component));
+  for (index_type j = 0; j < size; ++j)
+    EXPECT_EQ(j/3, component[j]);
+}
+
+TEST(ConnectedComponentsTest, ElementsSharingANodeAreConnected)
+{
+  auto field = threeTets();
+
+  std::vector<index_type> component;
+  EXPECT_EQ(2, ConnectedComponents::labelElements(field->vmesh(), component));
+  EXPECT_EQ((std::vector<index_type>{ 0, 1, 0 }), component);
+}
+
+TEST(ConnectedComponentsTest, StructuredMeshIsOneComponent)
+{
+  auto field = SCIRun::TestUtils::CreateEmptyLatVol(4, 3, 2);
+
+  std::vector<index_type> component;
+  EXPECT_EQ(1, ConnectedComponents::labelElements(field->vmesh(), component));
+  EXPECT_EQ(std::vector<index_type>(6, 0), component);
+}
+
+TEST(SplitByConnectedRegionTest, RegionsKeepIndexOrder)
+{
+  SplitFieldByConnectedRegionAlgo algo;
+  algo.set(Parameters::SortDomainBySize, false);
+  algo.set(Parameters::SortAscending, false);
+
+  auto result = algo.run(threeTets());
+
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ(2, result[0]->vmesh()->num_elems());
+  EXPECT_EQ(7, result[0]->vmesh()->num_nodes());
+  EXPECT_EQ(1, result[1]->vmesh()->num_elems());
+  EXPECT_EQ(4, result[1]->vmesh()->num_nodes());
+
+  Point p;
+  result[0]->vmesh()->get_center(p, VMesh::Node::index_type(4));
+  EXPECT_EQ(Point(8, 0, 2), p);
+}
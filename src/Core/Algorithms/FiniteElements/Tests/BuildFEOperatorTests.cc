@@ -0,0 +1,205 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Legacy/FiniteElements/BuildMatrix/BuildFEMatrix.h>
+#include <Core/Algorithms/Legacy/FiniteElements/BuildMatrix/BuildFEOperator.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::FiniteElements;
+using namespace SCIRun::Core::Algorithms::Math;
+using ::testing::NotNull;
+
+namespace
+{
+  FieldHandle makeConductivityField(const std::string& meshType, const std::string& dataType)
+  {
+    FieldInformation fi(meshType, 0, dataType);
+    MeshHandle mesh = CreateMesh(fi, 7, 6, 5, Point(-1, -1, -1), Point(2, 1, 1));
+    FieldHandle field = CreateField(fi, mesh);
+    auto vmesh = field->vmesh();
+    auto vfield = field->vfield();
+
+    if (vmesh->is_structhexvolmesh())
+    {
+      // Shear the grid a bit, so the cells are no longer boxes
+      VMesh::Node::size_type nnodes;
+      vmesh->size(nnodes);
+      for (VMesh::Node::index_type n = 0; n < nnodes; ++n)
+      {
+        Point p;
+        vmesh->get_point(p, n);
+        vmesh->set_point(Point(p.x() + 0.1*p.z(), p.y() + 0.05*p.x()*p.x(), p.z()), n);
+      }
+    }
+
+    for (VMesh::index_type c = 0; c < vmesh->num_elems(); c++)
+    {
+      if (vfield->is_int())
+        vfield->set_value(static_cast<int>(c % 3), c);
+      else
+        vfield->set_value(1.0 + (c % 5), c);
+    }
+    return field;
+  }
+
+  SparseRowMatrixHandle buildMatrix(FieldHandle field, DenseMatrixHandle ctable)
+  {
+    BuildFEMatrixAlgo algo;
+    auto out = algo.run(withInputData((Variables::InputField, field)(BuildFEMatrixAlgo::Conductivity_Table, ctable)));
+    return out.get<SparseRowMatrix>(BuildFEMatrixAlgo::Stiffness_Matrix);
+  }
+
+  void expectSameProduct(FieldHandle field, DenseMatrixHandle ctable)
+  {
+    auto A = buildMatrix(field, ctable);
+    ASSERT_THAT(A, NotNull());
+
+    BuildFEOperatorAlgo algo;
+    LinearOperatorHandle op;
+    ASSERT_TRUE(algo.run(field, ctable, op));
+    ASSERT_THAT(op, NotNull());
+    ASSERT_EQ(A->nrows(), op->nrows());
+
+    DenseColumnMatrix x(DenseColumnMatrix::Random(op->nrows()));
+    DenseColumnMatrix expected = *A * x;
+
+    for (int nproc : { 1, 3, 8 })
+    {
+      DenseColumnMatrix r(op->nrows());
+      op->multiply(x, r, nproc);
+      EXPECT_TRUE(expected.isApprox(r, 1e-10)) << "nproc = " << nproc;
+
+      auto diag = op->buildDiagonal(nproc);
+      DenseColumnMatrix expectedDiag = A->diagonal();
+      EXPECT_TRUE(expectedDiag.isApprox(*diag, 1e-10)) << "nproc = " << nproc;
+    }
+  }
+}
+
+TEST(BuildFEOperatorAlgorithmTests, ThrowsForNullField)
+{
+  BuildFEOperatorAlgo algo;
+  LinearOperatorHandle op;
+  EXPECT_FALSE(algo.run(nullptr, nullptr, op));
+}
+
+TEST(BuildFEOperatorAlgorithmTests, RejectsUnstructuredMeshes)
+{
+  FieldInformation fi("TetVolMesh", 0, "double");
+  FieldHandle field = CreateField(fi);
+  BuildFEOperatorAlgo algo;
+  LinearOperatorHandle op;
+  EXPECT_FALSE(algo.run(field, nullptr, op));
+}
+
+TEST(BuildFEOperatorAlgorithmTests, GenericRunReturnsOperator)
+{
+  auto field = makeConductivityField("LatVolMesh", "double");
+  BuildFEOperatorAlgo algo;
+  auto out = algo.run(withInputData((Variables::InputField, field)));
+  auto wrapped = out.get<LinearOperatorObject>(BuildFEOperatorAlgo::Stiffness_Operator);
+  ASSERT_THAT(wrapped, NotNull());
+  ASSERT_THAT(wrapped->op(), NotNull());
+  EXPECT_EQ(buildMatrix(field, nullptr)->nrows(), wrapped->op()->nrows());
+}
+
+TEST(BuildFEOperatorAlgorithmTests, GenericRunThrowsForUnstructuredMeshes)
+{
+  FieldInformation fi("TetVolMesh", 0, "double");
+  FieldHandle field = CreateField(fi);
+  BuildFEOperatorAlgo algo;
+  EXPECT_THROW(algo.run(withInputData((Variables::InputField, field))), AlgorithmProcessingException);
+}
+
+TEST(BuildFEOperatorAlgorithmTests, MatchesAssembledMatrixForLatVolScalar)
+{
+  expectSameProduct(makeConductivityField("LatVolMesh", "double"), nullptr);
+}
+
+TEST(BuildFEOperatorAlgorithmTests, MatchesAssembledMatrixForLatVolTensorTable)
+{
+  DenseMatrixHandle ctable(boost::make_shared<DenseMatrix>(3, 6));
+  *ctable << 1.0, 0.1, 0.0, 2.0, 0.2, 3.0,
+             0.5, 0.0, 0.0, 0.5, 0.0, 0.5,
+             0.0, 0.0, 0.0, 0.0, 0.0, 0.0;
+  expectSameProduct(makeConductivityField("LatVolMesh", "int"), ctable);
+}
+
+TEST(BuildFEOperatorAlgorithmTests, MatchesAssembledMatrixForStructHexVol)
+{
+  expectSameProduct(makeConductivityField("StructHexVolMesh", "double"), nullptr);
+}
+
+TEST(BuildFEOperatorAlgorithmTests, UsesLessMemoryThanSparseMatrix)
+{
+  auto field = makeConductivityField("LatVolMesh", "double");
+  auto A = buildMatrix(field, nullptr);
+  BuildFEOperatorAlgo algo;
+  LinearOperatorHandle op;
+  ASSERT_TRUE(algo.run(field, nullptr, op));
+
+  auto sop = boost::dynamic_pointer_cast<StructuredFEOperator>(op);
+  ASSERT_THAT(sop, NotNull());
+  const size_t sparseBytes = A->nonZeros()*(sizeof(double) + sizeof(index_type)) + (A->nrows() + 1)*sizeof(index_type);
+  EXPECT_LT(sop->memoryUsage(), sparseBytes);
+}
+
+TEST(BuildFEOperatorAlgorithmTests, SolverGivesSameSolutionAsAssembledMatrix)
+{
+  auto field = makeConductivityField("LatVolMesh", "double");
+  auto A = buildMatrix(field, nullptr);
+  BuildFEOperatorAlgo build;
+  LinearOperatorHandle op;
+  ASSERT_TRUE(build.run(field, nullptr, op));
+
+  // Pure Neumann problem: use a right hand side with zero mean
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+  b->array() -= b->mean();
+
+  SolveLinearSystemAlgo solver;
+  solver.set(Variables::TargetError, 1e-10);
+  solver.set(Variables::MaxIterations, 2000);
+  DenseColumnMatrixHandle xMatrix, xOperator;
+  ASSERT_TRUE(solver.run(A, b, nullptr, xMatrix));
+  ASSERT_TRUE(solver.run(op, b, nullptr, xOperator));
+
+  EXPECT_TRUE(xMatrix->isApprox(*xOperator, 1e-6));
+}
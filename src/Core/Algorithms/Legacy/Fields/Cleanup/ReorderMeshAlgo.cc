@@ -0,0 +1,511 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/Cleanup/ReorderMeshAlgo.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/GeometryPrimitives/BBox.h>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <sstream>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+
+ALGORITHM_PARAMETER_DEF(Fields, MeshOrdering);
+ALGORITHM_PARAMETER_DEF(Fields, ReorderElements);
+ALGORITHM_PARAMETER_DEF(Fields, MeasureSpeedup);
+
+AlgorithmOutputName ReorderMeshAlgo::NodePermutation("NodePermutation");
+AlgorithmOutputName ReorderMeshAlgo::ElementPermutation("ElementPermutation");
+
+namespace
+{
+  /// Node adjacency in compressed rows: every pair of nodes sharing an element.
+  struct NodeGraph
+  {
+    std::vector<index_type> offsets;
+    std::vector<index_type> neighbors;
+
+    index_type degree(index_type node) const { return offsets[node + 1] - offsets[node]; }
+  };
+
+  NodeGraph buildNodeGraph(const std::vector<VMesh::Node::array_type>& elems, index_type numNodes)
+  {
+    NodeGraph graph;
+    graph.offsets.assign(numNodes + 1, 0);
+    // Count exactly what the fill below writes: degenerate elements repeat nodes.
+    for (const auto& nodes : elems)
+      for (auto a : nodes)
+        for (auto b : nodes)
+          if (a != b)
+            ++graph.offsets[a + 1];
+    std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+    std::vector<index_type> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    graph.neighbors.resize(graph.offsets.back());
+    for (const auto& nodes : elems)
+      for (auto a : nodes)
+        for (auto b : nodes)
+          if (a != b)
+            graph.neighbors[fill[a]++] = b;
+
+    // Drop the duplicates contributed by neighbouring elements.
+    index_type write = 0;
+    for (index_type n = 0; n < numNodes; ++n)
+    {
+      const auto begin = graph.neighbors.begin() + graph.offsets[n];
+      const auto end = graph.neighbors.begin() + graph.offsets[n + 1];
+      std::sort(begin, end);
+      const auto last = std::unique(begin, end);
+      graph.offsets[n] = write;
+      write = std::copy(begin, last, graph.neighbors.begin() + write) - graph.neighbors.begin();
+    }
+    graph.offsets[numNodes] = write;
+    graph.neighbors.resize(write);
+    return graph;
+  }
+
+  class CuthillMcKee
+  {
+  public:
+    explicit CuthillMcKee(const NodeGraph& graph) : graph_(graph), mark_(graph.offsets.size() - 1, 0) {}
+
+    /// Old node indices in their new order.
+    std::vector<index_type> order()
+    {
+      const auto numNodes = static_cast<index_type>(graph_.offsets.size() - 1);
+      std::vector<index_type> byDegree(numNodes);
+      std::iota(byDegree.begin(), byDegree.end(), 0);
+      std::stable_sort(byDegree.begin(), byDegree.end(),
+        [this](index_type a, index_type b) { return graph_.degree(a) < graph_.degree(b); });
+
+      std::vector<char> placed(numNodes, 0);
+      std::vector<index_type> result;
+      result.reserve(numNodes);
+      std::vector<index_type> next;
+      for (auto seed : byDegree)
+      {
+        if (placed[seed])
+          continue;
+        const auto root = peripheralNode(seed);
+        auto head = result.size();
+        result.push_back(root);
+        placed[root] = 1;
+        while (head < result.size())
+        {
+          const auto node = result[head++];
+          next.clear();
+          for (auto k = graph_.offsets[node]; k < graph_.offsets[node + 1]; ++k)
+          {
+            const auto n = graph_.neighbors[k];
+            if (!placed[n])
+            {
+              placed[n] = 1;
+              next.push_back(n);
+            }
+          }
+          std::stable_sort(next.begin(), next.end(),
+            [this](index_type a, index_type b) { return graph_.degree(a) < graph_.degree(b); });
+          result.insert(result.end(), next.begin(), next.end());
+        }
+      }
+      std::reverse(result.begin(), result.end());
+      return result;
+    }
+
+  private:
+    /// George-Liu search for a pseudo-peripheral node of the component of start.
+    index_type peripheralNode(index_type start)
+    {
+      auto root = start;
+      index_type eccentricity = -1;
+      for (int iteration = 0; iteration < 8; ++iteration)
+      {
+        index_type lastLevelStart = 0, depth = 0;
+        breadthFirst(root, lastLevelStart, depth);
+        if (depth <= eccentricity)
+          break;
+        eccentricity = depth;
+        auto best = levels_[lastLevelStart];
+        for (auto k = lastLevelStart; k < static_cast<index_type>(levels_.size()); ++k)
+          if (graph_.degree(levels_[k]) < graph_.degree(best))
+            best = levels_[k];
+        if (best == root)
+          break;
+        root = best;
+      }
+      return root;
+    }
+
+    void breadthFirst(index_type root, index_type& lastLevelStart, index_type& depth)
+    {
+      ++stamp_;
+      levels_.clear();
+      levels_.push_back(root);
+      mark_[root] = stamp_;
+      index_type levelStart = 0;
+      depth = 0;
+      for (;;)
+      {
+        const auto levelEnd = static_cast<index_type>(levels_.size());
+        for (auto k = levelStart; k < levelEnd; ++k)
+        {
+          const auto node = levels_[k];
+          for (auto j = graph_.offsets[node]; j < graph_.offsets[node + 1]; ++j)
+          {
+            const auto n = graph_.neighbors[j];
+            if (mark_[n] != stamp_)
+            {
+              mark_[n] = stamp_;
+              levels_.push_back(n);
+            }
+          }
+        }
+        lastLevelStart = levelStart;
+        if (static_cast<index_type>(levels_.size()) == levelEnd)
+          return;
+        levelStart = levelEnd;
+        ++depth;
+      }
+    }
+
+    const NodeGraph& graph_;
+    std::vector<int> mark_;
+    std::vector<index_type> levels_;
+    int stamp_ {0};
+  };
+
+  const int CurveBits = 21;
+
+  uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z)
+  {
+    uint64_t key = 0;
+    for (int b = CurveBits - 1; b >= 0; --b)
+      key = (key << 3) | ((x >> b & 1) << 2) | ((y >> b & 1) << 1) | (z >> b & 1);
+    return key;
+  }
+
+  /// Skilling's transform from axes to the transposed Hilbert index.
+  uint64_t hilbertKey(uint32_t x, uint32_t y, uint32_t z)
+  {
+    uint32_t X[3] = { x, y, z };
+    const uint32_t M = 1u << (CurveBits - 1);
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+      const uint32_t P = Q - 1;
+      for (int i = 0; i < 3; ++i)
+      {
+        if (X[i] & Q)
+          X[0] ^= P;
+        else
+        {
+          const uint32_t t = (X[0] ^ X[i]) & P;
+          X[0] ^= t;
+          X[i] ^= t;
+        }
+      }
+    }
+    for (int i = 1; i < 3; ++i)
+      X[i] ^= X[i - 1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+      if (X[2] & Q)
+        t ^= Q - 1;
+    for (int i = 0; i < 3; ++i)
+      X[i] ^= t;
+    return mortonKey(X[0], X[1], X[2]);
+  }
+
+  class CurveKeys
+  {
+  public:
+    CurveKeys(const BBox& box, bool hilbert) : hilbert_(hilbert), min_(box.get_min())
+    {
+      const auto diagonal = box.diagonal();
+      const double extent = std::max(diagonal.x(), std::max(diagonal.y(), diagonal.z()));
+      scale_ = extent > 0 ? ((1u << CurveBits) - 1) / extent : 0;
+    }
+
+    uint64_t operator()(const Point& p) const
+    {
+      const auto q = [this](double v, double lo)
+      {
+        return static_cast<uint32_t>(std::min(std::max((v - lo) * scale_, 0.0), double((1u << CurveBits) - 1)));
+      };
+      const auto x = q(p.x(), min_.x()), y = q(p.y(), min_.y()), z = q(p.z(), min_.z());
+      return hilbert_ ? hilbertKey(x, y, z) : mortonKey(x, y, z);
+    }
+
+  private:
+    bool hilbert_;
+    Point min_;
+    double scale_;
+  };
+
+  std::vector<index_type> sortByKey(const std::vector<uint64_t>& keys)
+  {
+    std::vector<index_type> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](index_type a, index_type b) { return keys[a] < keys[b]; });
+    return order;
+  }
+
+  std::vector<index_type> inverse(const std::vector<index_type>& order)
+  {
+    std::vector<index_type> position(order.size());
+    for (size_t k = 0; k < order.size(); ++k)
+      position[order[k]] = k;
+    return position;
+  }
+
+  MatrixHandle permutationMatrix(const std::vector<index_type>& order)
+  {
+    const auto n = static_cast<index_type>(order.size());
+    std::vector<SparseRowMatrix::Triplet> triplets;
+    triplets.reserve(n);
+    for (index_type k = 0; k < n; ++k)
+      triplets.emplace_back(k, order[k], 1.0);
+    auto mat = boost::make_shared<SparseRowMatrix>(n, n);
+    mat->setFromTriplets(triplets.begin(), triplets.end());
+    return mat;
+  }
+
+  void bandwidth(const NodeGraph& graph, const std::vector<index_type>& position, index_type& maximum, double& mean)
+  {
+    maximum = 0;
+    double sum = 0;
+    const auto numNodes = static_cast<index_type>(graph.offsets.size() - 1);
+    for (index_type n = 0; n < numNodes; ++n)
+    {
+      index_type row = 0;
+      for (auto k = graph.offsets[n]; k < graph.offsets[n + 1]; ++k)
+        row = std::max(row, std::abs(position[n] - position[graph.neighbors[k]]));
+      maximum = std::max(maximum, row);
+      sum += row;
+    }
+    mean = numNodes > 0 ? sum / numNodes : 0;
+  }
+
+  /// Seconds per product with a matrix that has the sparsity of the node graph.
+  double timeSpMV(const NodeGraph& graph, const std::vector<index_type>& position)
+  {
+    const auto numNodes = static_cast<index_type>(graph.offsets.size() - 1);
+    std::vector<SparseRowMatrix::Triplet> triplets;
+    triplets.reserve(graph.neighbors.size() + numNodes);
+    for (index_type n = 0; n < numNodes; ++n)
+    {
+      triplets.emplace_back(position[n], position[n], static_cast<double>(graph.degree(n)));
+      for (auto k = graph.offsets[n]; k < graph.offsets[n + 1]; ++k)
+        triplets.emplace_back(position[n], position[graph.neighbors[k]], -1.0);
+    }
+    SparseRowMatrix A(numNodes, numNodes);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+
+    Eigen::VectorXd x = Eigen::VectorXd::Ones(numNodes), y(numNodes);
+    const int repetitions = static_cast<int>(std::max<size_t>(3, 50000000 / std::max<size_t>(1, triplets.size())));
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r)
+    {
+      y.noalias() = A * x;
+      x(r % numNodes) += 1e-12 * y(0);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+  }
+}
+
+ReorderMeshAlgo::ReorderMeshAlgo()
+{
+  addOption(Parameters::MeshOrdering, "ReverseCuthillMcKee", "ReverseCuthillMcKee|Hilbert|Morton");
+  addParameter(Parameters::ReorderElements, true);
+  addParameter(Parameters::MeasureSpeedup, false);
+}
+
+bool ReorderMeshAlgo::run(FieldHandle input, FieldHandle& output,
+  MatrixHandle& nodePermutation, MatrixHandle& elementPermutation, ReorderMeshStatistics* statistics) const
+{
+  ScopedAlgorithmStatusReporter asr(this, "ReorderMesh");
+
+  if (!input)
+  {
+    error("No input field");
+    return false;
+  }
+
+  FieldInformation fi(input);
+  if (!(fi.is_tetvol() || fi.is_hexvol() || fi.is_trisurf() || fi.is_quadsurf()))
+  {
+    error("This algorithm only works on TetVol, HexVol, TriSurf and QuadSurf meshes");
+    return false;
+  }
+  if (fi.is_nonlinear())
+  {
+    error("This algorithm has not yet been defined for non-linear elements yet");
+    return false;
+  }
+
+  auto imesh = input->vmesh();
+  auto ifield = input->vfield();
+  const auto numNodes = imesh->num_nodes();
+  const auto numElems = imesh->num_elems();
+
+  std::vector<VMesh::Node::array_type> elems(numElems);
+  for (VMesh::Elem::index_type e = 0; e < numElems; ++e)
+    imesh->get_nodes(elems[e], e);
+  std::vector<Point> points(numNodes);
+  for (VMesh::Node::index_type n = 0; n < numNodes; ++n)
+    imesh->get_center(points[n], n);
+
+  const auto graph = buildNodeGraph(elems, numNodes);
+  const bool hilbert = checkOption(Parameters::MeshOrdering, "Hilbert");
+  const bool curve = hilbert || checkOption(Parameters::MeshOrdering, "Morton");
+
+  std::vector<index_type> nodeOrder, elemOrder;
+  std::vector<Point> elemCenters;
+  if (curve)
+  {
+    const CurveKeys key(imesh->get_bounding_box(), hilbert);
+    std::vector<uint64_t> keys(numNodes);
+    for (index_type n = 0; n < numNodes; ++n)
+      keys[n] = key(points[n]);
+    nodeOrder = sortByKey(keys);
+
+    keys.resize(numElems);
+    for (index_type e = 0; e < numElems; ++e)
+    {
+      Vector center(0, 0, 0);
+      for (auto n : elems[e])
+        center += Vector(points[n]);
+      keys[e] = key(Point(center / static_cast<double>(elems[e].size())));
+    }
+    elemOrder = sortByKey(keys);
+  }
+  else
+  {
+    nodeOrder = CuthillMcKee(graph).order();
+    const auto position = inverse(nodeOrder);
+    std::vector<uint64_t> keys(numElems);
+    for (index_type e = 0; e < numElems; ++e)
+    {
+      index_type first = numNodes;
+      for (auto n : elems[e])
+        first = std::min(first, position[n]);
+      keys[e] = static_cast<uint64_t>(first);
+    }
+    elemOrder = sortByKey(keys);
+  }
+
+  if (!get(Parameters::ReorderElements).toBool())
+    std::iota(elemOrder.begin(), elemOrder.end(), 0);
+
+  const auto nodePosition = inverse(nodeOrder);
+
+  output = CreateField(fi);
+  if (!output)
+  {
+    error("Could not allocate output field");
+    return false;
+  }
+  auto omesh = output->vmesh();
+  auto ofield = output->vfield();
+
+  omesh->node_reserve(numNodes);
+  for (auto n : nodeOrder)
+    omesh->add_point(points[n]);
+  omesh->elem_reserve(numElems);
+  for (auto e : elemOrder)
+  {
+    auto nodes = elems[e];
+    for (auto& n : nodes)
+      n = nodePosition[n];
+    omesh->add_elem(nodes);
+  }
+
+  ofield->resize_values();
+  if (ifield->basis_order() == 0)
+  {
+    for (index_type k = 0; k < numElems; ++k)
+      ofield->copy_value(ifield, VMesh::Elem::index_type(elemOrder[k]), VMesh::Elem::index_type(k));
+  }
+  else if (ifield->basis_order() == 1)
+  {
+    for (index_type k = 0; k < numNodes; ++k)
+      ofield->copy_value(ifield, VMesh::Node::index_type(nodeOrder[k]), VMesh::Node::index_type(k));
+  }
+
+  nodePermutation = permutationMatrix(nodeOrder);
+  elementPermutation = permutationMatrix(elemOrder);
+
+  ReorderMeshStatistics stats;
+  std::vector<index_type> identity(numNodes);
+  std::iota(identity.begin(), identity.end(), 0);
+  bandwidth(graph, identity, stats.bandwidthBefore, stats.meanBandwidthBefore);
+  bandwidth(graph, nodePosition, stats.bandwidthAfter, stats.meanBandwidthAfter);
+
+  std::ostringstream report;
+  report << "Node graph bandwidth: " << stats.bandwidthBefore << " -> " << stats.bandwidthAfter
+    << " (mean " << stats.meanBandwidthBefore << " -> " << stats.meanBandwidthAfter << ")";
+  if (get(Parameters::MeasureSpeedup).toBool() && numNodes > 0)
+  {
+    stats.spmvSecondsBefore = timeSpMV(graph, identity);
+    stats.spmvSecondsAfter = timeSpMV(graph, nodePosition);
+    report << "; SpMV " << stats.spmvSecondsBefore * 1e3 << " ms -> " << stats.spmvSecondsAfter * 1e3
+      << " ms (" << stats.spmvSecondsBefore / std::max(stats.spmvSecondsAfter, 1e-12) << "x)";
+  }
+  remark(report.str());
+
+  if (statistics)
+    *statistics = stats;
+  return true;
+}
+
+AlgorithmOutput ReorderMeshAlgo::run(const AlgorithmInput& input) const
+{
+  auto inputField = input.get<Field>(Variables::InputField);
+
+  FieldHandle outputField;
+  MatrixHandle nodes, elements;
+  if (!run(inputField, outputField, nodes, elements))
+    THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
+
+  AlgorithmOutput output;
+  output[Variables::OutputField] = outputField;
+  output[NodePermutation] = nodes;
+  output[ElementPermutation] = elements;
+  return output;
+}
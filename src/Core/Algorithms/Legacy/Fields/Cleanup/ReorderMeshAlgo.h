@@ -0,0 +1,81 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_CLEANUP_REORDERMESHALGO_H
+#define CORE_ALGORITHMS_FIELDS_CLEANUP_REORDERMESHALGO_H 1
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+namespace Core  {
+namespace Algorithms {
+namespace Fields {
+
+  ALGORITHM_PARAMETER_DECL(MeshOrdering);
+  ALGORITHM_PARAMETER_DECL(ReorderElements);
+  ALGORITHM_PARAMETER_DECL(MeasureSpeedup);
+
+  /// Bandwidth of the node graph (nodes sharing an element are neighbours) and the
+  /// time of a sparse matrix-vector product with that pattern, before and after.
+  struct SCISHARE ReorderMeshStatistics
+  {
+    SCIRun::index_type bandwidthBefore {0}, bandwidthAfter {0};
+    double meanBandwidthBefore {0}, meanBandwidthAfter {0};
+    double spmvSecondsBefore {0}, spmvSecondsAfter {0};
+  };
+
+  /// Renumbers the nodes and elements of a TetVol, HexVol, TriSurf or QuadSurf mesh
+  /// for memory locality, carrying the field data along.
+  ///
+  /// ReverseCuthillMcKee minimizes the bandwidth of the node graph, which suits
+  /// assembled FEM matrices and direct solvers; Hilbert and Morton sort nodes along a
+  /// space-filling curve, which keeps spatially close nodes close in memory for
+  /// mapping and rendering. Elements follow their nodes (RCM) or their centres (curves).
+  ///
+  /// The permutation matrices map old to new numbering: new_data = P * old_data.
+  class SCISHARE ReorderMeshAlgo : public AlgorithmBase
+  {
+  public:
+    ReorderMeshAlgo();
+
+    static AlgorithmOutputName NodePermutation;
+    static AlgorithmOutputName ElementPermutation;
+
+    bool run(FieldHandle input, FieldHandle& output,
+      Datatypes::MatrixHandle& nodePermutation, Datatypes::MatrixHandle& elementPermutation,
+      ReorderMeshStatistics* statistics = nullptr) const;
+
+    AlgorithmOutput run(const AlgorithmInput& input) const override;
+  };
+
+}}}}
+
+#endif
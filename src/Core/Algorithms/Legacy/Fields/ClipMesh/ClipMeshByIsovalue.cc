@@ -35,9 +35,11 @@
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/SparseRowMatrixFromMap.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Thread/Parallel.h>
 #include <unordered_map>
 
 #include <algorithm>
+#include <atomic>
 #include <set>
 
 
@@ -46,6 +48,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
 
 int tet_permute_table[15][4] = {
   { 0, 0, 0, 0 }, // 0x0
@@ -78,62 +81,211 @@ int tri_permute_table[7][3] = {
 
 namespace detail
 {
-  struct edgepair_t
+  /// An output node of the clipper: an input node (b == c == -1), a point on
+  /// an input edge (c == -1) or a point inside an input face, identified by
+  /// the sorted input nodes it was interpolated from.
+  struct ClipNodeKey
   {
-    VField::index_type first;
-    VField::index_type second;
-    double dfirst;
+    index_type a, b, c;
   };
 
-  struct edgepairhash
+  bool operator==(const ClipNodeKey& k1, const ClipNodeKey& k2)
   {
-    size_t operator()(const edgepair_t &a) const
+    return k1.a == k2.a && k1.b == k2.b && k1.c == k2.c;
+  }
+
+  struct ClipNodeKeyHash
+  {
+    size_t operator()(const ClipNodeKey& k) const
     {
-      std::hash<size_t> h;
-      return h(a.first ^ a.second);
+      std::hash<index_type> h;
+      return h(k.a) ^ (h(k.b) << 1) ^ (h(k.c) << 2);
     }
   };
 
-  typedef std::unordered_map<VField::index_type, VMesh::Node::index_type> node_hash_type;
-  typedef std::unordered_map<edgepair_t, VMesh::Node::index_type, edgepairhash> edge_hash_type;
+  typedef std::unordered_map<ClipNodeKey, index_type, ClipNodeKeyHash> clip_node_hash_type;
 
-  bool operator==(const edgepair_t &a, const edgepair_t &b)
+  /// Nodes and elements clipped from one contiguous range of input elements.
+  /// Nodes are numbered locally in the order they are first used.
+  class ClipBuffer
   {
-    return a.first == b.first && a.second == b.second;
-  }
+  public:
+    index_type node(VMesh::Node::index_type u, const Point& p)
+    {
+      return lookup({ u, -1, -1 }, p);
+    }
 
-  bool operator!=(const edgepair_t &a, const edgepair_t &b)
-  {
-    return !(a == b);
-  }
+    index_type edge(VMesh::Node::index_type u0, VMesh::Node::index_type u1, const Point& p)
+    {
+      if (u1 < u0) std::swap(u0, u1);
+      return lookup({ u0, u1, -1 }, p);
+    }
 
-  struct facetriple_t
-  {
-    VField::index_type first, second, third;
-    double dsecond, dthird;
+    index_type face(VMesh::Node::index_type u0, VMesh::Node::index_type u1, VMesh::Node::index_type u2, const Point& p)
+    {
+      if (u1 < u0) std::swap(u0, u1);
+      if (u2 < u1) std::swap(u1, u2);
+      if (u1 < u0) std::swap(u0, u1);
+      return lookup({ u0, u1, u2 }, p);
+    }
+
+    void add_elem(std::initializer_list<index_type> nodes)
+    {
+      elems.insert(elems.end(), nodes);
+    }
+
+    std::vector<ClipNodeKey> keys;
+    std::vector<Point> points;
+    /// Local node numbers, a fixed number per element
+    std::vector<index_type> elems;
+    /// Output node number of every local node, filled in by ClipBuffers::stitch
+    std::vector<index_type> global;
+
+  private:
+    index_type lookup(const ClipNodeKey& key, const Point& p)
+    {
+      auto inserted = map_.insert(std::make_pair(key, static_cast<index_type>(keys.size())));
+      if (inserted.second)
+      {
+        keys.push_back(key);
+        points.push_back(p);
+      }
+      return inserted.first->second;
+    }
+
+    clip_node_hash_type map_;
   };
 
-  bool operator==(const facetriple_t &a, const facetriple_t &b)
+  /// Per-thread clip buffers over a partition of the input elements, and the
+  /// step that stitches them into one output mesh. Output nodes are numbered
+  /// exactly as a serial clip over all elements would number them.
+  class ClipBuffers
   {
-    return a.first == b.first && a.second == b.second && a.third == b.third;
-  }
+  public:
+    ClipBuffers(VMesh* mesh, int nproc) :
+      buffers_(nproc), lowest_(mesh->num_nodes()), highest_(mesh->num_nodes())
+    {
+      for (auto& l : lowest_) l.store(nproc, std::memory_order_relaxed);
+      for (auto& h : highest_) h.store(-1, std::memory_order_relaxed);
+    }
 
-  bool operator!=(const facetriple_t &a, const facetriple_t &b)
-  {
-    return !(a == b);
-  }
+    ClipBuffer& chunk(int proc) { return buffers_[proc]; }
 
-  struct facetriplehash
-  {
-    size_t operator()(const facetriple_t &a) const
+    /// Record that the elements of this chunk use these input nodes. A node
+    /// used by one chunk only cannot produce output nodes in any other chunk.
+    void touch(int proc, const VMesh::Node::array_type& nodes)
     {
-      std::hash<size_t> h;
-      return h(a.first ^ a.second ^ a.third);
+      for (const auto& u : nodes)
+      {
+        int current = lowest_[u].load(std::memory_order_relaxed);
+        while (proc < current && !lowest_[u].compare_exchange_weak(current, proc, std::memory_order_relaxed)) {}
+        current = highest_[u].load(std::memory_order_relaxed);
+        while (proc > current && !highest_[u].compare_exchange_weak(current, proc, std::memory_order_relaxed)) {}
+      }
     }
-  };
 
-  typedef std::unordered_map<facetriple_t, VMesh::Node::index_type, facetriplehash> face_hash_type;
+    void stitch(size_t elemSize, VMesh* clipped, VField* field, VField* ofield, double isoval)
+    {
+      const int nproc = static_cast<int>(buffers_.size());
+
+      // Only nodes whose input nodes are all used by several chunks can be
+      // shared; the first chunk in element order that makes one owns it.
+      std::unordered_map<ClipNodeKey, std::pair<int, index_type>, ClipNodeKeyHash> owners;
+      std::vector<std::vector<char> > owned(nproc);
+      std::vector<index_type> offsets(nproc + 1, 0);
+      for (int proc = 0; proc < nproc; ++proc)
+      {
+        const auto& keys = buffers_[proc].keys;
+        owned[proc].assign(keys.size(), 1);
+        for (size_t q = 0; q < keys.size(); ++q)
+        {
+          if (shared(keys[q]) && !owners.insert(std::make_pair(keys[q], std::make_pair(proc, q))).second)
+            owned[proc][q] = 0;
+        }
+        offsets[proc + 1] = offsets[proc] + std::count(owned[proc].begin(), owned[proc].end(), 1);
+      }
 
+      auto numberOwned = [&](int proc)
+      {
+        auto& buffer = buffers_[proc];
+        buffer.global.resize(buffer.keys.size());
+        index_type next = offsets[proc];
+        for (size_t q = 0; q < buffer.keys.size(); ++q)
+          if (owned[proc][q]) buffer.global[q] = next++;
+      };
+      Parallel::RunTasks(numberOwned, nproc);
+
+      std::vector<ClipNodeKey> keys(offsets[nproc]);
+      std::vector<Point> points(offsets[nproc]);
+      auto resolveShared = [&](int proc)
+      {
+        auto& buffer = buffers_[proc];
+        for (size_t q = 0; q < buffer.keys.size(); ++q)
+        {
+          if (owned[proc][q])
+          {
+            keys[buffer.global[q]] = buffer.keys[q];
+            points[buffer.global[q]] = buffer.points[q];
+          }
+          else
+          {
+            const auto& owner = owners.find(buffer.keys[q])->second;
+            buffer.global[q] = buffers_[owner.first].global[owner.second];
+          }
+        }
+      };
+      Parallel::RunTasks(resolveShared, nproc);
+
+      clipped->node_reserve(points.size());
+      for (const auto& p : points)
+        clipped->add_point(p);
+
+      size_t num_elems = 0;
+      for (const auto& buffer : buffers_) num_elems += buffer.elems.size() / elemSize;
+      clipped->elem_reserve(num_elems);
+      VMesh::Node::array_type nnodes(elemSize);
+      for (const auto& buffer : buffers_)
+      {
+        for (size_t e = 0; e < buffer.elems.size(); e += elemSize)
+        {
+          for (size_t i = 0; i < elemSize; ++i)
+            nnodes[i] = buffer.global[buffer.elems[e + i]];
+          clipped->add_elem(nnodes);
+        }
+      }
+
+      // Input nodes keep their values; the break points on edges and faces
+      // get the isovalue.
+      ofield->resize_values();
+      const index_type num_nodes = keys.size();
+      auto values = [&](int proc)
+      {
+        const index_type start = (num_nodes*proc)/nproc;
+        const index_type end = (num_nodes*(proc+1))/nproc;
+        for (index_type q = start; q < end; ++q)
+        {
+          if (keys[q].b < 0)
+            ofield->copy_value(field, keys[q].a, q);
+          else
+            ofield->set_value(isoval, VMesh::Node::index_type(q));
+        }
+      };
+      Parallel::RunTasks(values, nproc);
+    }
+
+  private:
+    bool shared(const ClipNodeKey& key) const
+    {
+      auto multi = [this](index_type u)
+      {
+        return lowest_[u].load(std::memory_order_relaxed) != highest_[u].load(std::memory_order_relaxed);
+      };
+      return multi(key.a) && (key.b < 0 || multi(key.b)) && (key.c < 0 || multi(key.c));
+    }
+
+    std::vector<ClipBuffer> buffers_;
+    std::vector<std::atomic<int> > lowest_, highest_;
+  };
 }
 
 ALGORITHM_PARAMETER_DEF(Fields, LessThanIsoValue);
@@ -150,94 +302,8 @@ class ClipMeshByIsovalueAlgoTet {
   public:
     bool run(const AlgorithmBase* algo,FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const;
 
-  private:
-    VMesh::Node::index_type
-    edge_lookup(VField::index_type u0, VField::index_type u1, double d0,
-          const Point &p, detail::edge_hash_type &edgemap,
-          VMesh *clipped) const;
-
-    VMesh::Node::index_type
-    face_lookup(VField::index_type u0, VField::index_type u1, VField::index_type u2,
-          double d1, double d2,
-          const Point &p, detail::face_hash_type &facemap,
-          VMesh *clipped) const;
-
  };
 
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTet::edge_lookup(VField::index_type u0, VField::index_type u1, double d0, const Point &p, detail::edge_hash_type &edgemap, VMesh *clipped) const
-{
-  using namespace detail;
-  edgepair_t np;
-  if (u0 < u1)  { np.first = u0; np.second = u1; np.dfirst = d0; }
-  else { np.first = u1; np.second = u0; np.dfirst = 1.0 - d0; }
-
-  auto loc = edgemap.find(np);
-
-  if (loc == edgemap.end())
-  {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    edgemap[np] = nodeindex;
-    return nodeindex;
-  }
-  else
-  {
-   return loc->second;
-  }
-}
-
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTet::face_lookup(VField::index_type u0, VField::index_type u1, VField::index_type u2, double d1, double d2, const Point &p, detail::face_hash_type &facemap, VMesh *clipped) const
-{
-  using namespace detail;
-  facetriple_t nt;
-  if (u0 < u1)
-  {
-    if (u2 < u0)
-    {
-      nt.first = u2; nt.second = u0; nt.third = u1;
-      nt.dsecond = 1.0 - d1 - d2; nt.dthird = d1;
-    }
-    else if (u2 < u1)
-    {
-      nt.first = u0; nt.second = u2; nt.third = u1;
-      nt.dsecond = d2; nt.dthird = d1;
-    }
-    else
-    {
-      nt.first = u0; nt.second = u1; nt.third = u2;
-      nt.dsecond = d1; nt.dthird = d2;
-    }
-  }
-  else
-  {
-    if (u2 > u0)
-    {
-      nt.first = u1; nt.second = u0; nt.third = u2;
-      nt.dsecond = 1.0 - d1 - d2; nt.dthird = d2;
-    }
-    else if (u2 > u1)
-    {
-      nt.first = u1; nt.second = u2; nt.third = u0;
-      nt.dsecond = d2; nt.dthird = 1.0 - d1 - d2;
-    }
-    else
-    {
-      nt.first = u2; nt.second = u1; nt.third = u0;
-      nt.dsecond = d1; nt.dthird = 1.0 - d1 - d2;
-    }
-  }
-  const face_hash_type::iterator loc = facemap.find(nt);
-  if (loc == facemap.end())
-  {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    facemap[nt] = nodeindex;
-    return nodeindex;
-  }
-  else
-  {
-    return (*loc).second;
-  }
-}
-
 bool ClipMeshByIsovalueAlgoTet::run(const AlgorithmBase* algo, FieldHandle input, FieldHandle& output, MatrixHandle &/*mapping*/) const
 {
   VField* field = input->vfield();
@@ -245,13 +311,6 @@ bool ClipMeshByIsovalueAlgoTet::run(const AlgorithmBase* algo, FieldHandle input
   VMesh*  clipped = output->vmesh();
 
   using namespace detail;
-  node_hash_type nodemap;
-  edge_hash_type edgemap;
-  face_hash_type facemap;
-
-  VMesh::Node::array_type onodes(4);
-  std::vector<double> v(4);
-  std::vector<Point> p(4);
 
   double isoval = algo->get(Parameters::ScalarIsoValue).toDouble();
 
@@ -259,401 +318,162 @@ bool ClipMeshByIsovalueAlgoTet::run(const AlgorithmBase* algo, FieldHandle input
 
   VMesh::size_type num_elems = mesh->num_elems();
 
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
-  {
-    mesh->get_nodes(onodes, idx);
+  // Every thread clips a contiguous range of elements into its own buffer.
+  const int nproc = Parallel::NumCores();
+  ClipBuffers buffers(mesh, nproc);
 
-      // Get the values and compute an inside/outside mask.
-    VField::index_type inside = 0;
-    mesh->get_centers(p, onodes);
-    field->get_values(v,onodes);
-    for (size_t i = 0; i < onodes.size(); i++)
+  auto clip = [&](int proc)
+  {
+    ClipBuffer& buffer = buffers.chunk(proc);
+    VMesh::Node::array_type onodes(4);
+    std::vector<double> v(4);
+    std::vector<Point> p(4);
+
+    const index_type start = (num_elems*proc)/nproc;
+    const index_type end = (num_elems*(proc+1))/nproc;
+    for (VMesh::Elem::index_type idx=start; idx<end; idx++)
     {
-      inside = inside << 1;
-      if (v[i] > isoval)
-      {
-        inside |= 1;
-      }
-
-    }
-
-      // Invert the mask if we are doing less than.
-    if (lte) { inside = ~inside & 0xf; }
+      mesh->get_nodes(onodes, idx);
+      buffers.touch(proc, onodes);
 
-    if (inside == 0)
-    {
-        // Discard outside elements.
-    }
-    else if (inside == 0xf)
-    {
-        // Add this element to the new mesh.
-      VMesh::Node::array_type nnodes(onodes.size());
-      for (size_t i = 0; i<onodes.size(); i++)
+        // Get the values and compute an inside/outside mask.
+      VField::index_type inside = 0;
+      mesh->get_centers(p, onodes);
+      field->get_values(v,onodes);
+      for (size_t i = 0; i < onodes.size(); i++)
       {
-        if (nodemap.find((VField::index_type)onodes[i]) == nodemap.end())
+        inside = inside << 1;
+        if (v[i] > isoval)
         {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[i]);
-          nodemap[(VField::index_type)onodes[i]] = nodeindex;
-          nnodes[i] = nodeindex;
-        }
-        else
-        {
-          nnodes[i] = nodemap[(VField::index_type)onodes[i]];
+          inside |= 1;
         }
+
       }
 
-      clipped->add_elem(nnodes);
-    }
-    else if (inside == 0x8 || inside == 0x4 || inside == 0x2 || inside == 0x1)
-    {
-        // Lop off 3 points and add resulting tet to the new mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
+        // Invert the mask if we are doing less than.
+      if (lte) { inside = ~inside & 0xf; }
 
-      if (nodemap.find((VField::index_type)onodes[perm[0]]) == nodemap.end())
+      if (inside == 0)
       {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[0]]);
-        nodemap[(VField::index_type)onodes[perm[0]]] = nodeindex;
-        nnodes[0] = nodeindex;
+          // Discard outside elements.
       }
-      else
+      else if (inside == 0xf)
       {
-        nnodes[0] = nodemap[(VField::index_type)onodes[perm[0]]];
+          // Add this element to the new mesh.
+        buffer.add_elem({ buffer.node(onodes[0], p[0]), buffer.node(onodes[1], p[1]),
+                          buffer.node(onodes[2], p[2]), buffer.node(onodes[3], p[3]) });
       }
+      else if (inside == 0x8 || inside == 0x4 || inside == 0x2 || inside == 0x1)
+      {
+          // Lop off 3 points and add resulting tet to the new mesh.
+        const int *perm = tet_permute_table[inside];
 
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-      const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
-      const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
-
-
-      nnodes[1] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[1]],
-                              dl1, l1, edgemap, clipped);
-
-      nnodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[2]],
-                              dl2, l2, edgemap, clipped);
+        const index_type n0 = buffer.node(onodes[perm[0]], p[perm[0]]);
 
-      nnodes[3] = edge_lookup((VField::index_type)onodes[perm[0]],
-                              (VField::index_type)onodes[perm[3]],
-                              dl3, l3, edgemap, clipped);
+        const double imv = isoval - v[perm[0]];
+        const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+        const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+        const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+        const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+        const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
+        const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
 
-      clipped->add_elem(nnodes);
-    }
-    else if (inside == 0x7 || inside == 0xb || inside == 0xd || inside == 0xe)
-    {
-        // Lop off 1 point, break up the resulting quads and add the
-        // resulting tets to the mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
+        const index_type n1 = buffer.edge(onodes[perm[0]], onodes[perm[1]], l1);
+        const index_type n2 = buffer.edge(onodes[perm[0]], onodes[perm[2]], l2);
+        const index_type n3 = buffer.edge(onodes[perm[0]], onodes[perm[3]], l3);
 
-      VMesh::Node::index_type inodes[9];
-      for (size_t i = 1; i < 4; i++)
+        buffer.add_elem({ n0, n1, n2, n3 });
+      }
+      else if (inside == 0x7 || inside == 0xb || inside == 0xd || inside == 0xe)
       {
-        if (nodemap.find((VField::index_type)onodes[perm[i]]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[i]]);
-          nodemap[(VField::index_type)onodes[perm[i]]] = nodeindex;
-          inodes[i-1] = nodeindex;
-        }
-        else
+          // Lop off 1 point, break up the resulting quads and add the
+          // resulting tets to the mesh.
+        const int *perm = tet_permute_table[inside];
+
+        index_type inodes[9];
+        for (size_t i = 1; i < 4; i++)
         {
-          inodes[i-1] = nodemap[(VField::index_type)onodes[perm[i]]];
+          inodes[i-1] = buffer.node(onodes[perm[i]], p[perm[i]]);
         }
-      }
-
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-      const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
-      const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
-
-
-      inodes[3] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[1]],
-                              dl1, l1, edgemap, clipped);
-
-      inodes[4] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              dl2, l2, edgemap, clipped);
-
-      inodes[5] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              dl3, l3, edgemap, clipped);
-
-      const Point c1 = Interpolate(l1, l2, 0.5);
-      const Point c2 = Interpolate(l2, l3, 0.5);
-      const Point c3 = Interpolate(l3, l1, 0.5);
-
-      inodes[6] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              dl1*0.5, dl2*0.5,
-                              c1, facemap, clipped);
-      inodes[7] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl2*0.5, dl3*0.5,
-                              c2, facemap, clipped);
-      inodes[8] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              (index_type)onodes[perm[1]],
-                              dl3*0.5, dl1*0.5,
-                              c3, facemap, clipped);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[8];
-      nnodes[3] = inodes[6];
-      clipped->add_elem(nnodes);
 
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[4];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[2];
-      nnodes[1] = inodes[5];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[8];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[6];
-      nnodes[2] = inodes[8];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[8];
-      nnodes[2] = inodes[2];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[6];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[1];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[7];
-      nnodes[3] = inodes[2];
-      clipped->add_elem(nnodes);
-    }
-    else// if (inside == 0x3 || inside == 0x5 || inside == 0x6 ||
-          //     inside == 0x9 || inside == 0xa || inside == 0xc)
-    {
-        // Lop off two points, break the resulting quads, then add the
-        // new tets to the mesh.
-      const int *perm = tet_permute_table[inside];
-      VMesh::Node::array_type nnodes(4);
-
-      VMesh::Node::index_type inodes[8];
-      for (size_t i = 2; i < 4; i++)
+        const double imv = isoval - v[perm[0]];
+        const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+        const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+        const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+        const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+        const double dl3 = imv / (v[perm[3]] - v[perm[0]]);
+        const Point l3 = Interpolate(p[perm[0]], p[perm[3]], dl3);
+
+        inodes[3] = buffer.edge(onodes[perm[0]], onodes[perm[1]], l1);
+        inodes[4] = buffer.edge(onodes[perm[0]], onodes[perm[2]], l2);
+        inodes[5] = buffer.edge(onodes[perm[0]], onodes[perm[3]], l3);
+
+        const Point c1 = Interpolate(l1, l2, 0.5);
+        const Point c2 = Interpolate(l2, l3, 0.5);
+        const Point c3 = Interpolate(l3, l1, 0.5);
+
+        inodes[6] = buffer.face(onodes[perm[0]], onodes[perm[1]], onodes[perm[2]], c1);
+        inodes[7] = buffer.face(onodes[perm[0]], onodes[perm[2]], onodes[perm[3]], c2);
+        inodes[8] = buffer.face(onodes[perm[0]], onodes[perm[3]], onodes[perm[1]], c3);
+
+        buffer.add_elem({ inodes[0], inodes[3], inodes[8], inodes[6] });
+        buffer.add_elem({ inodes[1], inodes[4], inodes[6], inodes[7] });
+        buffer.add_elem({ inodes[2], inodes[5], inodes[7], inodes[8] });
+        buffer.add_elem({ inodes[0], inodes[6], inodes[8], inodes[7] });
+        buffer.add_elem({ inodes[0], inodes[8], inodes[2], inodes[7] });
+        buffer.add_elem({ inodes[0], inodes[6], inodes[7], inodes[1] });
+        buffer.add_elem({ inodes[0], inodes[1], inodes[7], inodes[2] });
+      }
+      else// if (inside == 0x3 || inside == 0x5 || inside == 0x6 ||
+            //     inside == 0x9 || inside == 0xa || inside == 0xc)
       {
-        if (nodemap.find((VField::index_type)onodes[perm[i]]) == nodemap.end())
-        {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[i]]);
-          nodemap[(VField::index_type)onodes[perm[i]]] = nodeindex;
-          inodes[i-2] = nodeindex;
-        }
-        else
+          // Lop off two points, break the resulting quads, then add the
+          // new tets to the mesh.
+        const int *perm = tet_permute_table[inside];
+
+        index_type inodes[8];
+        for (size_t i = 2; i < 4; i++)
         {
-          inodes[i-2] = nodemap[(VField::index_type)onodes[perm[i]]];
+          inodes[i-2] = buffer.node(onodes[perm[i]], p[perm[i]]);
         }
+        const double imv0 = isoval - v[perm[0]];
+        const double dl02 = imv0 / (v[perm[2]] - v[perm[0]]);
+        const Point l02 = Interpolate(p[perm[0]], p[perm[2]], dl02);
+        const double dl03 = imv0 / (v[perm[3]] - v[perm[0]]);
+        const Point l03 = Interpolate(p[perm[0]], p[perm[3]], dl03);
+
+        const double imv1 = isoval - v[perm[1]];
+        const double dl12 = imv1 / (v[perm[2]] - v[perm[1]]);
+        const Point l12 = Interpolate(p[perm[1]], p[perm[2]], dl12);
+        const double dl13 = imv1 / (v[perm[3]] - v[perm[1]]);
+        const Point l13 = Interpolate(p[perm[1]], p[perm[3]], dl13);
+
+        inodes[2] = buffer.edge(onodes[perm[0]], onodes[perm[2]], l02);
+        inodes[3] = buffer.edge(onodes[perm[0]], onodes[perm[3]], l03);
+        inodes[4] = buffer.edge(onodes[perm[1]], onodes[perm[2]], l12);
+        inodes[5] = buffer.edge(onodes[perm[1]], onodes[perm[3]], l13);
+
+        const Point c1 = Interpolate(l02, l03, 0.5);
+        const Point c2 = Interpolate(l12, l13, 0.5);
+
+        inodes[6] = buffer.face(onodes[perm[0]], onodes[perm[2]], onodes[perm[3]], c1);
+        inodes[7] = buffer.face(onodes[perm[1]], onodes[perm[2]], onodes[perm[3]], c2);
+
+        buffer.add_elem({ inodes[7], inodes[2], inodes[0], inodes[4] });
+        buffer.add_elem({ inodes[1], inodes[5], inodes[3], inodes[7] });
+        buffer.add_elem({ inodes[1], inodes[3], inodes[6], inodes[7] });
+        buffer.add_elem({ inodes[0], inodes[7], inodes[6], inodes[2] });
+        buffer.add_elem({ inodes[0], inodes[1], inodes[6], inodes[7] });
       }
-      const double imv0 = isoval - v[perm[0]];
-      const double dl02 = imv0 / (v[perm[2]] - v[perm[0]]);
-      const Point l02 = Interpolate(p[perm[0]], p[perm[2]], dl02);
-      const double dl03 = imv0 / (v[perm[3]] - v[perm[0]]);
-      const Point l03 = Interpolate(p[perm[0]], p[perm[3]], dl03);
-
-      const double imv1 = isoval - v[perm[1]];
-      const double dl12 = imv1 / (v[perm[2]] - v[perm[1]]);
-      const Point l12 = Interpolate(p[perm[1]], p[perm[2]], dl12);
-      const double dl13 = imv1 / (v[perm[3]] - v[perm[1]]);
-      const Point l13 = Interpolate(p[perm[1]], p[perm[3]], dl13);
-
-
-      inodes[2] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              dl02, l02, edgemap, clipped);
-      inodes[3] = edge_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[3]],
-                              dl03, l03, edgemap, clipped);
-      inodes[4] = edge_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              dl12, l12, edgemap, clipped);
-      inodes[5] = edge_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[3]],
-                              dl13, l13, edgemap, clipped);
-
-      const Point c1 = Interpolate(l02, l03, 0.5);
-      const Point c2 = Interpolate(l12, l13, 0.5);
-
-      inodes[6] = face_lookup((index_type)onodes[perm[0]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl02*0.5,
-                              dl03*0.5,
-                              c1, facemap, clipped);
-      inodes[7] = face_lookup((index_type)onodes[perm[1]],
-                              (index_type)onodes[perm[2]],
-                              (index_type)onodes[perm[3]],
-                              dl12*0.5,
-                              dl13*0.5,
-                              c2, facemap, clipped);
-
-      nnodes[0] = inodes[7];
-      nnodes[1] = inodes[2];
-      nnodes[2] = inodes[0];
-      nnodes[3] = inodes[4];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[5];
-      nnodes[2] = inodes[3];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[1];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[7];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[2];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[6];
-      nnodes[3] = inodes[7];
-      clipped->add_elem(nnodes);
     }
-  }
-
-  VField* ofield = output->vfield();
-  ofield->resize_values();
-  CopyProperties(*input, *output);
-
-    // Add the data values from the old field to the new field.
-  node_hash_type::iterator nmitr = nodemap.begin();
-  while (nmitr != nodemap.end())
-  {
-    ofield->copy_value(field,((*nmitr).first),((*nmitr).second));
-    ++nmitr;
-  }
-
-    // Put the isovalue at the edge break points.
-  edge_hash_type::iterator emitr = edgemap.begin();
-  while (emitr != edgemap.end())
-  {
-    ofield->set_value(isoval,((*emitr).second));
-    ++emitr;
-  }
+  };
+  Parallel::RunTasks(clip, nproc);
 
-    // Put the isovalue at the face break points.  Assumes linear
+    // Put the isovalue at the edge and face break points.  Assumes linear
     // interpolation across the faces (which seems safe, this is what we
     // used to cut with.)
-  face_hash_type::iterator fmitr = facemap.begin();
-  while (fmitr != facemap.end())
-  {
-    ofield->set_value(isoval,((*fmitr).second));
-    ++fmitr;
-  }
-
-  #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-  if (algo->get_bool("build_mapping"))
-  {
-      // Create the interpolant matrix.
-    const size_type nrows = clipped->num_nodes();
-    const size_type ncols = mesh->num_nodes();
-
-    std::vector<index_type> cctmp(nrows*3);
-    std::vector<double> dtmp(nrows*3);
-    SparseRowMatrix::Builder sparseBuilder;
-    const SparseRowMatrix::Rows& rr = sparseBuilder.allocate_rows(nrows + 1);
-
-    for (index_type i = 0; i < nrows * 3; i++)
-    {
-      cctmp[i] = -1;
-    }
-
-    size_type nnz = 0;
-
-      // Add the data values from the old field to the new field.
-    nmitr = nodemap.begin();
-    while (nmitr != nodemap.end())
-    {
-      cctmp[(*nmitr).second * 3] = (*nmitr).first;
-      dtmp[(*nmitr).second * 3 + 0] = 1.0;
-      nnz++;
-      ++nmitr;
-    }
-
-      // Insert the double hits into cc.
-      // Put the isovalue at the edge break points.
-    emitr = edgemap.begin();
-    while (emitr != edgemap.end())
-    {
-      cctmp[(*emitr).second * 3 + 0] = (*emitr).first.first;
-      cctmp[(*emitr).second * 3 + 1] = (*emitr).first.second;
-      dtmp[(*emitr).second * 3 + 0] = 1.0 - (*emitr).first.dfirst;
-      dtmp[(*emitr).second * 3 + 1] = (*emitr).first.dfirst;
-      nnz+=2;
-      ++emitr;
-    }
-
-      // Insert the double hits into cc.
-      // Put the isovalue at the edge break points.
-    fmitr = facemap.begin();
-    while (fmitr != facemap.end())
-    {
-      cctmp[(*fmitr).second * 3 + 0] = (*fmitr).first.first;
-      cctmp[(*fmitr).second * 3 + 1] = (*fmitr).first.second;
-      cctmp[(*fmitr).second * 3 + 2] = (*fmitr).first.third;
-      dtmp[(*fmitr).second * 3 + 0] =
-          1.0 - (*fmitr).first.dsecond - (*fmitr).first.dthird;;
-      dtmp[(*fmitr).second * 3 + 1] = (*fmitr).first.dsecond;
-      dtmp[(*fmitr).second * 3 + 2] = (*fmitr).first.dthird;
-      nnz+=3;
-
-      ++fmitr;
-    }
-
-    const SparseRowMatrix::Columns& cc = sparseBuilder.allocate_columns(nnz);
-    const SparseRowMatrix::Storage& d = sparseBuilder.allocate_data(nnz);
-
-    index_type j;
-    index_type counter = 0;
-    rr[0] = 0;
-    for (j = 0; j < nrows*3; j++)
-    {
-      if (j%3 == 0) { rr[j/3 + 1] = rr[j/3]; }
-      if (cctmp[j] != -1)
-      {
-        cc[counter] = cctmp[j];
-        d[counter] = dtmp[j];
-        rr[j/3 + 1]++;
-        counter++;
-      }
-    }
-    mapping = new SparseRowMatrix(nrows, ncols, sparseBuilder.build(), nnz);
-  }
-  #endif
+  buffers.stitch(4, clipped, field, output->vfield(), isoval);
+  CopyProperties(*input, *output);
 
   return (true);
 }
@@ -664,33 +484,8 @@ class ClipMeshByIsovalueAlgoTri
 {
   public:
     bool run(const AlgorithmBase* algo,FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const;
-
-private:
-    VMesh::Node::index_type
-    edge_lookup(VField::index_type u0, VField::index_type u1, double d0,
-          const Point &p, detail::edge_hash_type &edgemap,
-          VMesh *clipped) const;
 };
 
-VMesh::Node::index_type ClipMeshByIsovalueAlgoTri::edge_lookup(VField::index_type u0, VField::index_type u1, double d0, const Point &p, detail::edge_hash_type &edgemap, VMesh *clipped) const
-{
-  using namespace detail;
-  edgepair_t np;
-  if (u0 < u1)  { np.first = u0; np.second = u1; np.dfirst = d0; }
-  else { np.first = u1; np.second = u0; np.dfirst = 1.0 - d0; }
-  const auto loc = edgemap.find(np);
-  if (loc == edgemap.end())
-  {
-    const VMesh::Node::index_type nodeindex = clipped->add_point(p);
-    edgemap[np] = nodeindex;
-    return nodeindex;
-  }
-  else
-  {
-    return loc->second;
-  }
-}
-
 bool ClipMeshByIsovalueAlgoTri::run(const AlgorithmBase* algo, FieldHandle input, FieldHandle& output, MatrixHandle &) const
 {
   VField* field = input->vfield();
@@ -699,239 +494,104 @@ bool ClipMeshByIsovalueAlgoTri::run(const AlgorithmBase* algo, FieldHandle input
 
   using namespace detail;
 
-  node_hash_type nodemap;
-  edge_hash_type edgemap;
-
-  VMesh::Node::array_type onodes(3);
-  std::vector<double> v(3);
-  std::vector<Point>  p(3);
-
   double isoval = algo->get(Parameters::ScalarIsoValue).toDouble();
 
   bool lte = !algo->get(Parameters::LessThanIsoValue).toBool();
 
   VMesh::size_type num_elems = mesh->num_elems();
-  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
-  {
-    mesh->get_nodes(onodes, idx);
 
-    // Get the values and compute an inside/outside mask.
-    VField::index_type inside = 0;
-    mesh->get_centers(p, onodes);
-    field->get_values(v, onodes);
+  const int nproc = Parallel::NumCores();
+  ClipBuffers buffers(mesh, nproc);
 
-    for (size_t i = 0; i < onodes.size(); i++)
+  auto clip = [&](int proc)
+  {
+    ClipBuffer& buffer = buffers.chunk(proc);
+    VMesh::Node::array_type onodes(3);
+    std::vector<double> v(3);
+    std::vector<Point>  p(3);
+
+    const index_type start = (num_elems*proc)/nproc;
+    const index_type end = (num_elems*(proc+1))/nproc;
+    for (VMesh::Elem::index_type idx=start; idx<end; idx++)
     {
-      inside = inside << 1;
-      if (v[i] > isoval)
-      {
-        inside |= 1;
-      }
-    }
-
-    // Invert the mask if we are doing less than.
-    if (lte) { inside = ~inside & 0x7; }
+      mesh->get_nodes(onodes, idx);
+      buffers.touch(proc, onodes);
 
-    if (inside == 0)
-    {
-      // Discard outside elements.
-    }
-    else if (inside == 0x7)
-    {
-      // Add this element to the new mesh.
-      VMesh::Node::array_type nnodes(onodes.size());
+      // Get the values and compute an inside/outside mask.
+      VField::index_type inside = 0;
+      mesh->get_centers(p, onodes);
+      field->get_values(v, onodes);
 
-      for (size_t i = 0; i<onodes.size(); i++)
+      for (size_t i = 0; i < onodes.size(); i++)
       {
-        if (nodemap.find((VField::index_type)onodes[i]) == nodemap.end())
+        inside = inside << 1;
+        if (v[i] > isoval)
         {
-          const VMesh::Node::index_type nodeindex = clipped->add_point(p[i]);
-          nodemap[(VField::index_type)onodes[i]] = nodeindex;
-          nnodes[i] = nodeindex;
-        }
-        else
-        {
-          nnodes[i] = nodemap[(VField::index_type)onodes[i]];
+          inside |= 1;
         }
       }
 
-      clipped->add_elem(nnodes);
-    }
-    else if (inside == 0x1 || inside == 0x2 || inside == 0x4)
-    {
-      // Add the corner containing the inside point to the mesh.
-      const int *perm = tri_permute_table[inside];
-      VMesh::Node::array_type nnodes(onodes.size());
-      if (nodemap.find((VField::index_type)onodes[perm[0]]) == nodemap.end())
+      // Invert the mask if we are doing less than.
+      if (lte) { inside = ~inside & 0x7; }
+
+      if (inside == 0)
       {
-        const VMesh::Node::index_type nodeindex =
-            clipped->add_point(p[perm[0]]);
-        nodemap[(VField::index_type)onodes[perm[0]]] = nodeindex;
-        nnodes[0] = nodeindex;
+        // Discard outside elements.
       }
-      else
+      else if (inside == 0x7)
       {
-        nnodes[0] = nodemap[(VField::index_type)onodes[perm[0]]];
+        // Add this element to the new mesh.
+        buffer.add_elem({ buffer.node(onodes[0], p[0]), buffer.node(onodes[1], p[1]),
+                          buffer.node(onodes[2], p[2]) });
       }
+      else if (inside == 0x1 || inside == 0x2 || inside == 0x4)
+      {
+        // Add the corner containing the inside point to the mesh.
+        const int *perm = tri_permute_table[inside];
+        const index_type n0 = buffer.node(onodes[perm[0]], p[perm[0]]);
 
-      const double imv = isoval - v[perm[0]];
-
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-
-
-      nnodes[1] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (index_type)onodes[perm[1]],
-			      dl1, l1, edgemap, clipped);
+        const double imv = isoval - v[perm[0]];
 
-      nnodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (index_type)onodes[perm[2]],
-			      dl2, l2, edgemap, clipped);
+        const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+        const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+        const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+        const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
 
-      clipped->add_elem(nnodes);
-    }
-    else
-    {
-      // Lop off the one point that is outside of the mesh, then add
-      // the remaining quad to the mesh by dicing it into two
-      // triangles.
-      const int *perm = tri_permute_table[inside];
-      VMesh::Node::array_type inodes(4);
-      if (nodemap.find((index_type)onodes[perm[1]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[1]]);
-        nodemap[(VField::index_type)onodes[perm[1]]] = nodeindex;
-        inodes[0] = nodeindex;
-      }
-      else
-      {
-        inodes[0] = nodemap[(VField::index_type)onodes[perm[1]]];
-      }
+        const index_type n1 = buffer.edge(onodes[perm[0]], onodes[perm[1]], l1);
+        const index_type n2 = buffer.edge(onodes[perm[0]], onodes[perm[2]], l2);
 
-      if (nodemap.find((VField::index_type)onodes[perm[2]]) == nodemap.end())
-      {
-        const VMesh::Node::index_type nodeindex = clipped->add_point(p[perm[2]]);
-        nodemap[(VField::index_type)onodes[perm[2]]] = nodeindex;
-        inodes[1] = nodeindex;
+        buffer.add_elem({ n0, n1, n2 });
       }
       else
       {
-        inodes[1] = nodemap[(VField::index_type)onodes[perm[2]]];
+        // Lop off the one point that is outside of the mesh, then add
+        // the remaining quad to the mesh by dicing it into two
+        // triangles.
+        const int *perm = tri_permute_table[inside];
+        index_type inodes[4];
+        inodes[0] = buffer.node(onodes[perm[1]], p[perm[1]]);
+        inodes[1] = buffer.node(onodes[perm[2]], p[perm[2]]);
+
+        const double imv = isoval - v[perm[0]];
+        const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
+        const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
+        const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
+        const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
+
+        inodes[2] = buffer.edge(onodes[perm[0]], onodes[perm[1]], l1);
+        inodes[3] = buffer.edge(onodes[perm[0]], onodes[perm[2]], l2);
+
+        buffer.add_elem({ inodes[0], inodes[1], inodes[3] });
+        buffer.add_elem({ inodes[0], inodes[3], inodes[2] });
       }
-
-      const double imv = isoval - v[perm[0]];
-      const double dl1 = imv / (v[perm[1]] - v[perm[0]]);
-      const Point l1 = Interpolate(p[perm[0]], p[perm[1]], dl1);
-      const double dl2 = imv / (v[perm[2]] - v[perm[0]]);
-      const Point l2 = Interpolate(p[perm[0]], p[perm[2]], dl2);
-
-      inodes[2] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (VField::index_type)onodes[perm[1]],
-			      dl1, l1, edgemap, clipped);
-
-      inodes[3] = edge_lookup((VField::index_type)onodes[perm[0]],
-			      (VField::index_type)onodes[perm[2]],
-			      dl2, l2, edgemap, clipped);
-
-      VMesh::Node::array_type nnodes(onodes.size());
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[1];
-      nnodes[2] = inodes[3];
-      clipped->add_elem(nnodes);
-
-      nnodes[0] = inodes[0];
-      nnodes[1] = inodes[3];
-      nnodes[2] = inodes[2];
-      clipped->add_elem(nnodes);
     }
-  }
+  };
+  Parallel::RunTasks(clip, nproc);
 
-  VField* ofield = output->vfield();
-  ofield->resize_values();
+  // Input nodes keep their values, the edge break points get the isovalue.
+  buffers.stitch(3, clipped, field, output->vfield(), isoval);
   #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-   ofield->copy_properties(field);
-  #endif
-
-  // Add the data values from the old field to the new field.
-  node_hash_type::iterator nmitr = nodemap.begin();
-  while (nmitr != nodemap.end())
-  {
-    ofield->copy_value(field,((*nmitr).first),((*nmitr).second));
-    ++nmitr;
-  }
-
-  // Put the isovalue at the edge break points.
-  edge_hash_type::iterator emitr = edgemap.begin();
-  while (emitr != edgemap.end())
-  {
-    ofield->set_value(isoval, ((*emitr).second));
-    ++emitr;
-  }
-
-  #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-  if(algo->get_bool("build_mapping"))
-  {
-    // Create the interpolant matrix.
-
-    const size_type nrows = clipped->num_nodes();
-    const size_type ncols = mesh->num_nodes();
-    std::vector<index_type> cctmp(nrows*2);
-    std::vector<double> dtmp(nrows*2);
-    SparseRowMatrix::Builder sparseBuilder;
-    const SparseRowMatrix::Rows& rr = sparseBuilder.allocate_rows(nrows + 1);
-
-    for (index_type i = 0; i < nrows * 2; i++)
-    {
-      cctmp[i] = -1;
-    }
-
-    size_type nnz = 0;
-
-    // Add the data values from the old field to the new field.
-    nmitr = nodemap.begin();
-    while (nmitr != nodemap.end())
-    {
-      cctmp[(*nmitr).second * 2] = (*nmitr).first;
-      dtmp[(*nmitr).second * 2 + 0] = 1.0;
-      nnz++;
-      ++nmitr;
-    }
-
-    // Insert the double hits into cc.
-    // Put the isovalue at the edge break points.
-    emitr = edgemap.begin();
-    while (emitr != edgemap.end())
-    {
-      cctmp[(*emitr).second * 2 + 0] = (*emitr).first.first;
-      cctmp[(*emitr).second * 2 + 1] = (*emitr).first.second;
-      dtmp[(*emitr).second * 2 + 0] = 1.0 - (*emitr).first.dfirst;
-      dtmp[(*emitr).second * 2 + 1] = (*emitr).first.dfirst;
-      nnz+=2;
-      ++emitr;
-    }
-
-    const SparseRowMatrix::Columns& cc = sparseBuilder.allocate_columns(nnz);
-    const SparseRowMatrix::Storage& d = sparseBuilder.allocate_data(nnz);
-
-    index_type j;
-    index_type counter = 0;
-    rr[0] = 0;
-    for (j = 0; j < nrows*2; j++)
-    {
-      if (j%2 == 0) { rr[j/2 + 1] = rr[j/2]; }
-      if (cctmp[j] != -1)
-      {
-        cc[counter] = cctmp[j];
-        d[counter] = dtmp[j];
-        rr[j/2 + 1]++;
-        counter++;
-      }
-    }
-    mapping = new SparseRowMatrix(nrows, ncols, sparseBuilder.build(), nnz);
-  }
+   output->vfield()->copy_properties(field);
   #endif
 
   return (true);
@@ -975,74 +635,69 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
   VMesh*  mesh  = input->vmesh();
   VMesh*  clipped = output->vmesh();
 
-  // Get a list of the original boundary elements (code from FieldBoundary).
-  std::map<VMesh::DElem::index_type, VMesh::DElem::index_type> original_boundary;
+  // Flag the original boundary faces (code from FieldBoundary).
   mesh->synchronize(Mesh::ELEM_NEIGHBORS_E | Mesh::FACES_E);
 
-  // Walk all the cells in the mesh looking for faces on the boundary
-
   VMesh::size_type num_elems = mesh->num_elems();
-  VMesh::DElem::array_type delems;
-  VMesh::Elem::index_type nidx;
-
-  for (VMesh::Elem::index_type idx=0; idx< num_elems; idx++)
+  std::vector<char> original_boundary(mesh->num_delems(), 0);
+
+  // Walk all the cells in the mesh looking for faces on the boundary; a
+  // boundary face belongs to one cell only, so the ranges never collide.
+  // Also flag the hexes inside the isosurface.
+  std::vector<char> inside(num_elems, 0);
+  const int nproc = Parallel::NumCores();
+  auto classify = [&](int proc)
   {
-    // Get all the faces in the cell.
-    mesh->get_delems(delems, idx);
-
-    for (size_t j=0; j<delems.size(); j++)
+    VMesh::DElem::array_type delems;
+    VMesh::Node::array_type onodes;
+    VMesh::Elem::index_type nidx;
+    const index_type start = (num_elems*proc)/nproc;
+    const index_type end = (num_elems*(proc+1))/nproc;
+    for (VMesh::Elem::index_type idx=start; idx<end; idx++)
     {
-      if( !mesh->get_neighbor(nidx, idx, delems[j] ) )
+      // Get all the faces in the cell.
+      mesh->get_delems(delems, idx);
+
+      for (size_t j=0; j<delems.size(); j++)
       {
-        // Faces with no neighbors are on the boundary.
-        original_boundary[delems[j]] = delems[j];
+        if( !mesh->get_neighbor(nidx, idx, delems[j] ) )
+        {
+          // Faces with no neighbors are on the boundary.
+          original_boundary[delems[j]] = 1;
+        }
+      }
+
+      mesh->get_nodes(onodes, idx);
+      inside[idx] = 1;
+
+      for (size_t i = 0; i < onodes.size(); i++)
+      {
+        double v;
+        field->get_value(v, onodes[i]);
+
+        if( lte ? v > isoval : v < isoval )
+        {
+          inside[idx] = 0;
+          break;
+        }
       }
     }
-  }
+  };
+  Parallel::RunTasks(classify, nproc);
 
   // Create a map to help differentiate between new nodes created for
   // the inserted sheet, and the nodes on the stair stepped boundary.
-  std::map<VMesh::Node::index_type, VMesh::Node::index_type> clipped_to_original_nodemap;
+  std::vector<VMesh::Node::index_type> clipped_to_original_nodemap;
   typedef std::unordered_map<VField::index_type, VMesh::Node::index_type> hash_type;
 
   hash_type nodemap;
 
   std::vector<VMesh::Elem::index_type> elemmap;
 
-  // Find all of the hexes inside the isosurface and add them to the
-  // clipped mesh.
+  // Add the hexes inside the isosurface to the clipped mesh.
   for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
   {
-    bool inside = false;
-
-    VMesh::Node::array_type onodes;
-    mesh->get_nodes(onodes, idx);
-    inside = true;
-
-    for (size_t i = 0; i < onodes.size(); i++)
-    {
-      double v;
-      field->get_value(v, onodes[i]);
-
-      if( lte )
-      {
-        if( v > isoval )
-        {
-          inside = false;
-          break;
-        }
-      }
-      else
-      {
-        if( v < isoval )
-        {
-          inside = false;
-          break;
-        }
-      }
-    }
-
-    if (inside)
+    if (inside[idx])
     {
       VMesh::Node::array_type onodes;
       mesh->get_nodes(onodes, idx);
@@ -1057,7 +712,7 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
           Point np;
           mesh->get_center(np, onodes[i]);
           const VMesh::Node::index_type nodeindex = clipped->add_point(np);
-          clipped_to_original_nodemap[nodeindex] = onodes[i];
+          clipped_to_original_nodemap.push_back(onodes[i]);
           nodemap[(VField::index_type)onodes[i]] = nodeindex;
           nnodes[i] = nodeindex;
         }
@@ -1076,7 +731,7 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
   // We'll use this list of boundary elements (minus the elements from
   // the original boundary) so we know which nodes to project to the
   // isosurface to create the new sheet of hexes.
-  std::map<VMesh::Node::index_type, VMesh::Node::index_type> vertex_map;
+  std::vector<char> vertex_map;
 
   std::vector<VMesh::Node::index_type> node_list;
   std::vector<VMesh::DElem::index_type> face_list;
@@ -1086,6 +741,7 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
   // Walk all the cells in the clipped mesh to find the boundary faces.
 
   VMesh::size_type num_celems = clipped->num_elems();
+  vertex_map.assign(clipped->num_nodes(), 0);
   VMesh::DElem::array_type faces;
   VMesh::DElem::index_type old_face;
   VMesh::Node::array_type face_nodes;
@@ -1116,11 +772,7 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
         for (size_t j=0;j<4; j++) face_nodes[j] = clipped_to_original_nodemap[face_nodes[j]];
         if( mesh->get_delem( old_face, face_nodes) )
         {
-          auto bound_iter = original_boundary.find( old_face );
-          if( bound_iter != original_boundary.end() )
-          {
-            is_old_boundary = true;
-          }
+          is_old_boundary = original_boundary[old_face] != 0;
         }
 
         // Don't add the nodes from the faces of the original boundary
@@ -1137,11 +789,10 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
           VMesh::size_type size = nodes.size();
           for( i = 0; i < size; i++ )
           {
-            auto node_iter = vertex_map.find( *niter );
-            if( node_iter == vertex_map.end() )
+            if( !vertex_map[*niter] )
             {
               node_list.push_back( *niter );
-              vertex_map[*niter] = *niter;
+              vertex_map[*niter] = 1;
             }
             ++niter;
           }
@@ -1156,36 +807,33 @@ bool ClipMeshByIsovalueAlgoHex::run(const AlgorithmBase* algo, FieldHandle input
   // connectivity later.
   if (!tri_mesh->is_empty())
     tri_mesh->synchronize( Mesh::FIND_CLOSEST_ELEM_E );
-  std::map<VMesh::Node::index_type, VMesh::Node::index_type> new_map;
+  std::vector<VMesh::Node::index_type> new_map(clipped->num_nodes());
 
-  int cnt = 0;
-  for(size_t i = 0; i < node_list.size(); i++ )
+  // The projections are independent, so they run in parallel; the new nodes
+  // are added afterwards in list order.
+  std::vector<Point> projected(node_list.size());
+  const index_type num_projected = node_list.size();
+  auto project = [&](int proc)
   {
-    VMesh::Node::index_type this_node = node_list[i];
-    Point n_p;
-    clipped->get_center( n_p, this_node );
-
-    Point new_result;
-    VMesh::Elem::index_type face_id;
-    double dist;
-
-    tri_mesh->find_closest_elem(dist, new_result, face_id, n_p );
-
-    // Add the new node to the clipped mesh.
-    Point new_point( new_result );
-    VMesh::Node::index_type this_index = clipped->add_point( new_point );
-
-    // Create a map for the new node to a node on the boundary of the
-    // clipped mesh.
-    new_map[this_node] = this_index;
-    cnt++;
-    if (cnt == 100)
+    const index_type start = (num_projected*proc)/nproc;
+    const index_type end = (num_projected*(proc+1))/nproc;
+    for (index_type i = start; i < end; i++)
     {
-     cnt = 0;
-     #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
-      algo->update_progress(i,(size_type)(1.3*num_celems));
-     #endif
+      Point n_p;
+      clipped->get_center( n_p, node_list[i] );
+
+      VMesh::Elem::index_type face_id;
+      double dist;
+      tri_mesh->find_closest_elem(dist, projected[i], face_id, n_p );
     }
+  };
+  Parallel::RunTasks(project, nproc);
+
+  for(size_t i = 0; i < node_list.size(); i++ )
+  {
+    // Add the new node to the clipped mesh and map the node on the boundary
+    // of the clipped mesh to it.
+    new_map[node_list[i]] = clipped->add_point( projected[i] );
   }
 
   // For each quad on the clipped boundary we have a map to the new
@@ -33,6 +33,7 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -43,6 +44,38 @@ using namespace SCIRun::Core::Algorithms;
 
 ALGORITHM_PARAMETER_DEF(Fields, Location);
 
+namespace
+{
+  /// Copies the node locations or the element centers of a mesh into a point
+  /// array. Instantiated for each mesh class through dispatch_mesh().
+  class CopyLocations
+  {
+  public:
+    CopyLocations(bool elems, VMesh::size_type num, Point* points) :
+      elems_(elems), num_(num), points_(points) {}
+
+    template <class MESH>
+    void operator()(const MESH& mesh)
+    {
+      if (elems_)
+      {
+        for (VMesh::index_type p = 0; p < num_; p++)
+          mesh.get_center(points_[p], typename MESH::Elem::index_type(p));
+      }
+      else
+      {
+        for (VMesh::index_type p = 0; p < num_; p++)
+          mesh.get_point(points_[p], typename MESH::Node::index_type(p));
+      }
+    }
+
+  private:
+    bool elems_;
+    VMesh::size_type num_;
+    Point* points_;
+  };
+}
+
 ConvertMeshToPointCloudMeshAlgo::ConvertMeshToPointCloudMeshAlgo()
 {
   /// Do we want to get the location of the data nodes
@@ -120,30 +153,28 @@ bool ConvertMeshToPointCloudMeshAlgo::runImpl(FieldHandle input, FieldHandle& ou
 
     // Get number of elements
     VMesh::size_type num_elems = imesh->num_elems();
-    // reserve space to put nodes (performance)
-    omesh->reserve_nodes(num_elems);
+    // allocate the nodes up front, so the locations can be written in place
+    omesh->resize_nodes(num_elems);
 
     // Copy over the data locations
-    Point pnt;
-    for(VMesh::Elem::index_type p=0; p < num_elems; p++)
+    if (num_elems > 0)
     {
-      imesh->get_center(pnt,p);
-      omesh->add_point(pnt);
+      CopyLocations copy(true, num_elems, omesh->get_points_pointer());
+      dispatch_mesh(input, copy);
     }
   }
   else // if(ifield->basis_order() == 1)
   {
     // Get number of nodes
     VMesh::size_type num_nodes = imesh->num_nodes();
-    // reserve space to put nodes (performance)
-    omesh->reserve_nodes(num_nodes);
+    // allocate the nodes up front, so the locations can be written in place
+    omesh->resize_nodes(num_nodes);
 
     // Copy over the data locations
-    Point pnt;
-    for(VMesh::Node::index_type p=0; p < num_nodes; p++)
+    if (num_nodes > 0)
     {
-      imesh->get_point(pnt,p);
-      omesh->add_point(pnt);
+      CopyLocations copy(false, num_nodes, omesh->get_points_pointer());
+      dispatch_mesh(input, copy);
     }
   }
 
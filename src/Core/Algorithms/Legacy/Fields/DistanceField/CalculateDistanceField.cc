@@ -27,6 +27,7 @@
 
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
@@ -48,6 +49,8 @@ ALGORITHM_PARAMETER_DEF(Fields, Truncate);
 ALGORITHM_PARAMETER_DEF(Fields, TruncateDistance);
 ALGORITHM_PARAMETER_DEF(Fields, OutputFieldDatatype);
 ALGORITHM_PARAMETER_DEF(Fields, OutputValueField);
+ALGORITHM_PARAMETER_DEF(Fields, DistanceMethod);
+ALGORITHM_PARAMETER_DEF(Fields, NarrowBandWidth);
 
 CalculateDistanceFieldAlgo::CalculateDistanceFieldAlgo()
 {
@@ -55,6 +58,8 @@ CalculateDistanceFieldAlgo::CalculateDistanceFieldAlgo()
   addParameter(Truncate, false);
   addParameter(TruncateDistance, 1.0);
   addParameter(OutputValueField, false);
+  addParameter(NarrowBandWidth, 2.0);
+  addOption(DistanceMethod, "exact", "exact|fast sweeping");
   addOption(BasisType, "same as input","same as input|constant|linear");
   addOption(OutputFieldDatatype, "double","char|unsigned char|short|unsigned short|int|unsigned int|float|double");
 }
@@ -340,6 +345,38 @@ class CalculateDistanceFieldP : public Interruptible
 };
 }
 
+namespace detail
+{
+  // Exact distances for the samples near the object, swept out to the rest of the grid
+  void sweepDistanceField(const RegularGridDistanceTransform& grid, VMesh* objmesh, VField* ofield,
+    double max, double bandWidth)
+  {
+    const int nproc = Parallel::NumCores();
+    const auto band = grid.narrowBand(objmesh, bandWidth*grid.maxSpacing(), nproc);
+
+    std::vector<double> distance(grid.size(), max);
+    std::vector<char> fixed(grid.size(), 0);
+    auto exact = [&](int proc)
+    {
+      const size_t start = (band.size()*proc)/nproc;
+      const size_t end = (band.size()*(proc+1))/nproc;
+      VMesh::Elem::index_type fidx;
+      Point p2;
+      double val;
+      for (size_t b = start; b < end; b++)
+      {
+        const VMesh::index_type idx = band[b];
+        if (objmesh->find_closest_elem(val,p2,fidx,grid.point(idx),max)) distance[idx] = val;
+        fixed[idx] = 1;
+      }
+    };
+    Parallel::RunTasks(exact, nproc);
+
+    grid.propagate(distance, fixed, max, nproc);
+    ofield->set_values(distance);
+  }
+}
+
 //TODO refactor duplication
 
 bool
@@ -404,6 +441,20 @@ CalculateDistanceFieldAlgo::runImpl(FieldHandle input, FieldHandle object, Field
     return (false);
   }
 
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping"))
+  {
+    RegularGridDistanceTransform grid(imesh, ofield->basis_order());
+    if (grid.valid())
+    {
+      double max = DBL_MAX;
+      if (get(Parameters::Truncate).toBool()) max = get(Parameters::TruncateDistance).toDouble();
+
+      detail::sweepDistanceField(grid, objmesh, ofield, max, get(Parameters::NarrowBandWidth).toDouble());
+      return (true);
+    }
+    remark("Fast sweeping needs a LatVol or Image field with orthogonal axes and node or cell data; computing exact distances instead.");
+  }
+
   detail::CalculateDistanceFieldP palgo(imesh,objmesh,ofield,this);
   auto task_i = [&palgo](int i) { palgo.parallel(i, Parallel::NumCores()); };
   Parallel::RunTasks(task_i, Parallel::NumCores());
@@ -489,6 +540,11 @@ CalculateDistanceFieldAlgo::runImpl(FieldHandle input, FieldHandle object, Field
     return (false);
   }
 
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping"))
+  {
+    remark("The closest value field needs the closest element of every sample; computing exact distances.");
+  }
+
   detail::CalculateDistanceFieldP palgo(imesh,objmesh,objfield,dfield,vfield,this);
   auto task_i = [&palgo](int i) { palgo.parallel2(i, Parallel::NumCores()); };
   Parallel::RunTasks(task_i, Parallel::NumCores());
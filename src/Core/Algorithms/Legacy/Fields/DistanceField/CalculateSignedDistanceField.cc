@@ -27,6 +27,7 @@
 
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
@@ -57,196 +58,113 @@ class CalculateSignedDistanceFieldP : public Interruptible
       VMesh::size_type num_values = ofield->num_values();
       VMesh::size_type num_evalues = ofield->num_evalues();
 
-      double val = 0.0;
-      double epsilon = objmesh->get_epsilon();
       int cnt = 0;
 
       if (ofield->basis_order() == 0)
       {
-        VMesh::Elem::index_type fidx, fidx_n;
-        VMesh::Node::array_type nodes;
-        VMesh::DElem::array_type delems;
-        Vector n, k;
-        Point n0,n1,n2;
         VMesh::index_type start, end;
         range(proc,nproc,start,end,num_values);
 
         for (VMesh::Elem::index_type idx = start; idx < end; idx++)
         {
-
-          Point p, p1, p2;
+          Point p;
           imesh->get_center(p,idx);
-
-          objmesh->find_closest_elem(val,p2,fidx,p);
-          objmesh->get_nodes(nodes,fidx);
-          objmesh->get_center(n0,nodes[0]);
-          objmesh->get_center(n1,nodes[1]);
-          objmesh->get_center(n2,nodes[2]);
-
-          n = Cross(Vector(n1-n0),Vector(n2-n1));
-          k = Vector(p-p2); k.normalize();
-
-          double angle = Dot(n,k);
-          if (angle < -epsilon)
-          {
-            val = -val;
-          }
-          else if (angle > epsilon)
-          {
-          }
-          else
-          {
-            // trouble
-            if (val != 0.0)
-            {
-               objmesh->get_delems(delems,fidx);
-               double mindist = DBL_MAX;
-               double dist;
-               int edgeidx = 0;
-               for (size_t r=0; r<delems.size();r++)
-               {
-                 objmesh->get_nodes(nodes,delems[r]);
-                 objmesh->get_center(p1,nodes[0]);
-                 objmesh->get_center(p2,nodes[1]);
-
-                if (Dot(Vector(p-p2),Vector(p2-p1)) >= 0.0)
-                {
-                  Vector v = Vector(p-p2);
-                  dist  = Dot(v,v);
-                }
-                else if (Dot(Vector(p-p1),Vector(p1-p2)) >= 0.0)
-                {
-                  Vector v = Vector(p-p1);
-                  dist = Dot(v,v);
-                }
-                else
-                {
-                  Vector v1 = Vector(p1-p2);
-                  Vector v = Vector(p-p2)-v1*(Dot(Vector(p-p2),v1)/Dot(v1,v1));
-                  dist = Dot(v,v);
-                }
-
-                if (dist < mindist) { mindist = dist; edgeidx = r;}
-              }
-              objmesh->get_neighbor(fidx_n,fidx,delems[edgeidx]);
-              objmesh->get_nodes(nodes,fidx);
-              objmesh->get_center(n0,nodes[0]);
-              objmesh->get_center(n1,nodes[1]);
-              objmesh->get_center(n2,nodes[2]);
-              n = Cross(Vector(n1-n0),Vector(n2-n1));
-              k = Vector(p-p2);
-              k.normalize();
-              angle = Dot(n,k);
-              if (angle < 0) val = -(val);
-            }
-          }
-
-          ofield->set_value(val,idx);
+          ofield->set_value(signedDistance(p),idx);
           if (proc == 0) { cnt++; if (cnt == 100) { pr_->update_progress_max(idx,end); cnt = 0; } }
         }
       }
       else if (ofield->basis_order() == 1)
       {
-        VMesh::Elem::index_type fidx, fidx_n;
-        VMesh::Node::array_type nodes;
-        VMesh::DElem::array_type delems;
-
-        Vector n, k;
-        Point n0,n1,n2;
         VMesh::index_type start, end;
         range(proc,nproc,start,end,num_values);
 
         for (VMesh::Node::index_type idx =start; idx <end; idx++)
         {
-
-          Point p, p1, p2;
+          Point p;
           imesh->get_center(p,idx);
-          objmesh->find_closest_elem(val,p2,fidx,p);
-
-          objmesh->get_nodes(nodes,fidx);
-          objmesh->get_center(n0,nodes[0]);
-          objmesh->get_center(n1,nodes[1]);
-          objmesh->get_center(n2,nodes[2]);
-          n = Cross(Vector(n1-n0),Vector(n2-n1));
-          k = Vector(p-p2);
-          k.normalize();
-          double angle = Dot(n,k);
-          if (angle < -epsilon)
-          {
-            val = -val;
-          }
-          else if (angle > epsilon)
-          {
-          }
-          else
-          {
-            // trouble
-            if (val != 0.0)
-            {
-               objmesh->get_delems(delems,fidx);
-               double mindist = DBL_MAX;
-               double dist;
-               int edgeidx = 0;
-               for (size_t r=0; r<delems.size();r++)
-               {
-                 objmesh->get_nodes(nodes,delems[r]);
-                 objmesh->get_center(p1,nodes[0]);
-                 objmesh->get_center(p2,nodes[1]);
-
-                if (Dot(Vector(p-p2),Vector(p2-p1)) >= 0.0)
-                {
-                  Vector v = Vector(p-p2);
-                  dist  = Dot(v,v);
-                }
-                else if (Dot(Vector(p-p1),Vector(p1-p2)) >= 0.0)
-                {
-                  Vector v = Vector(p-p1);
-                  dist = Dot(v,v);
-                }
-                else
-                {
-                  Vector v1 = Vector(p1-p2);
-                  Vector v = Vector(p-p2)-v1*(Dot(Vector(p-p2),v1)/Dot(v1,v1));
-                  dist = Dot(v,v);
-                }
-
-                if (dist < mindist) { mindist = dist; edgeidx = r;}
-              }
-              objmesh->get_neighbor(fidx_n,fidx,delems[edgeidx]);
-              objmesh->get_nodes(nodes,fidx);
-              objmesh->get_center(n0,nodes[0]);
-              objmesh->get_center(n1,nodes[1]);
-              objmesh->get_center(n2,nodes[2]);
-              n = Cross(Vector(n1-n0),Vector(n2-n1));
-              k = Vector(p-p2);
-              k.normalize();
-              angle = Dot(n,k);
-              if (angle < 0.0) val = -(val);
-            }
-          }
-
-          ofield->set_value(val,idx);
+          ofield->set_value(signedDistance(p),idx);
           if (proc == 0) { cnt++; if (cnt == 100) { pr_->update_progress_max(idx,end); cnt = 0; } }
         }
       }
       else if (ofield->basis_order() > 1)
       {
-        VMesh::Elem::index_type fidx, fidx_n;
-        VMesh::Node::array_type nodes;
-        VMesh::DElem::array_type delems;
-
-        Vector n, k;
-        Point n0,n1,n2;
         VMesh::index_type start, end;
         range(proc,nproc,start,end,num_evalues);
 
         for (VMesh::ENode::index_type idx=start; idx < end; idx++)
         {
-
-          Point p, p1, p2;
+          Point p;
           imesh->get_center(p,idx);
-          objmesh->find_closest_elem(val,p2,fidx,p);
+          ofield->set_evalue(signedDistance(p),idx);
+          if (proc == 0) { cnt++; if (cnt == 100) { pr_->update_progress_max(idx,end); cnt = 0; } }
+        }
+      }
+    }
 
+    /// Distance to the closest surface element, negative on the side its normal points away from.
+    double signedDistance(const Point& p) const
+    {
+      double val = 0.0;
+      double epsilon = objmesh->get_epsilon();
+      VMesh::Elem::index_type fidx, fidx_n;
+      VMesh::Node::array_type nodes;
+      VMesh::DElem::array_type delems;
+      Vector n, k;
+      Point n0,n1,n2;
+      Point p1, p2;
+
+      objmesh->find_closest_elem(val,p2,fidx,p);
+      objmesh->get_nodes(nodes,fidx);
+      objmesh->get_center(n0,nodes[0]);
+      objmesh->get_center(n1,nodes[1]);
+      objmesh->get_center(n2,nodes[2]);
+
+      n = Cross(Vector(n1-n0),Vector(n2-n1));
+      k = Vector(p-p2); k.normalize();
+
+      double angle = Dot(n,k);
+      if (angle < -epsilon)
+      {
+        val = -val;
+      }
+      else if (angle > epsilon)
+      {
+      }
+      else
+      {
+        // trouble
+        if (val != 0.0)
+        {
+           objmesh->get_delems(delems,fidx);
+           double mindist = DBL_MAX;
+           double dist;
+           int edgeidx = 0;
+           for (size_t r=0; r<delems.size();r++)
+           {
+             objmesh->get_nodes(nodes,delems[r]);
+             objmesh->get_center(p1,nodes[0]);
+             objmesh->get_center(p2,nodes[1]);
+
+            if (Dot(Vector(p-p2),Vector(p2-p1)) >= 0.0)
+            {
+              Vector v = Vector(p-p2);
+              dist  = Dot(v,v);
+            }
+            else if (Dot(Vector(p-p1),Vector(p1-p2)) >= 0.0)
+            {
+              Vector v = Vector(p-p1);
+              dist = Dot(v,v);
+            }
+            else
+            {
+              Vector v1 = Vector(p1-p2);
+              Vector v = Vector(p-p2)-v1*(Dot(Vector(p-p2),v1)/Dot(v1,v1));
+              dist = Dot(v,v);
+            }
+
+            if (dist < mindist) { mindist = dist; edgeidx = r;}
+          }
+          objmesh->get_neighbor(fidx_n,fidx,delems[edgeidx]);
           objmesh->get_nodes(nodes,fidx);
           objmesh->get_center(n0,nodes[0]);
           objmesh->get_center(n1,nodes[1]);
@@ -254,65 +172,12 @@ class CalculateSignedDistanceFieldP : public Interruptible
           n = Cross(Vector(n1-n0),Vector(n2-n1));
           k = Vector(p-p2);
           k.normalize();
-          double angle = Dot(n,k);
-          if (angle < -epsilon)
-          {
-            val = -val;
-          }
-          else if (angle > epsilon)
-          {
-          }
-          else
-          {
-            // trouble
-            if (val != 0.0)
-            {
-               objmesh->get_delems(delems,fidx);
-               double mindist = DBL_MAX;
-               double dist;
-               int edgeidx = 0;
-               for (size_t r=0; r<delems.size();r++)
-               {
-                 objmesh->get_nodes(nodes,delems[r]);
-                 objmesh->get_center(p1,nodes[0]);
-                 objmesh->get_center(p2,nodes[1]);
-
-                if (Dot(Vector(p-p2),Vector(p2-p1)) >= 0.0)
-                {
-                  Vector v = Vector(p-p2);
-                  dist  = Dot(v,v);
-                }
-                else if (Dot(Vector(p-p1),Vector(p1-p2)) >= 0.0)
-                {
-                  Vector v = Vector(p-p1);
-                  dist = Dot(v,v);
-                }
-                else
-                {
-                  Vector v1 = Vector(p1-p2);
-                  Vector v = Vector(p-p2)-v1*(Dot(Vector(p-p2),v1)/Dot(v1,v1));
-                  dist = Dot(v,v);
-                }
-
-                if (dist < mindist) { mindist = dist; edgeidx = r;}
-              }
-              objmesh->get_neighbor(fidx_n,fidx,delems[edgeidx]);
-              objmesh->get_nodes(nodes,fidx);
-              objmesh->get_center(n0,nodes[0]);
-              objmesh->get_center(n1,nodes[1]);
-              objmesh->get_center(n2,nodes[2]);
-              n = Cross(Vector(n1-n0),Vector(n2-n1));
-              k = Vector(p-p2);
-              k.normalize();
-              angle = Dot(n,k);
-              if (angle < 0.0) val = -(val);
-            }
-          }
-
-          ofield->set_evalue(val,idx);
-          if (proc == 0) { cnt++; if (cnt == 100) { pr_->update_progress_max(idx,end); cnt = 0; } }
+          angle = Dot(n,k);
+          if (angle < 0) val = -(val);
         }
       }
+
+      return val;
     }
 
     void parallel2(int proc, int nproc)
@@ -661,6 +526,42 @@ class CalculateSignedDistanceFieldP : public Interruptible
 CalculateSignedDistanceFieldAlgo::CalculateSignedDistanceFieldAlgo()
 {
   addParameter(OutputValueField, false);
+  addParameter(Parameters::NarrowBandWidth, 2.0);
+  addOption(Parameters::DistanceMethod, "exact", "exact|fast sweeping");
+}
+
+namespace
+{
+  // Exact signed distances near the surface; the magnitudes are swept out to the rest of the
+  // grid and the signs are flooded in from the band afterwards.
+  void sweepSignedDistanceField(const RegularGridDistanceTransform& grid,
+    const CalculateSignedDistanceFieldP& palgo, VMesh* objmesh, VField* ofield, double bandWidth)
+  {
+    const int nproc = Parallel::NumCores();
+    const auto band = grid.narrowBand(objmesh, bandWidth*grid.maxSpacing(), nproc);
+
+    std::vector<double> distance(grid.size(), DBL_MAX);
+    std::vector<double> bandValues(band.size());
+    std::vector<char> fixed(grid.size(), 0);
+    auto exact = [&](int proc)
+    {
+      const size_t start = (band.size()*proc)/nproc;
+      const size_t end = (band.size()*(proc+1))/nproc;
+      for (size_t b = start; b < end; b++)
+      {
+        const VMesh::index_type idx = band[b];
+        bandValues[b] = palgo.signedDistance(grid.point(idx));
+        distance[idx] = std::fabs(bandValues[b]);
+        fixed[idx] = 1;
+      }
+    };
+    Parallel::RunTasks(exact, nproc);
+
+    grid.propagate(distance, fixed, DBL_MAX, nproc);
+    for (size_t b = 0; b < band.size(); b++) distance[band[b]] = bandValues[b];
+    grid.propagateSigns(distance, fixed);
+    ofield->set_values(distance);
+  }
 }
 
 bool
@@ -720,6 +621,18 @@ CalculateSignedDistanceFieldAlgo::run(FieldHandle input, FieldHandle object, Fie
 
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E|Mesh::EDGES_E);
   CalculateSignedDistanceFieldP palgo(imesh, objmesh, ofield, this);
+
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping"))
+  {
+    RegularGridDistanceTransform grid(imesh, ofield->basis_order());
+    if (grid.valid())
+    {
+      sweepSignedDistanceField(grid, palgo, objmesh, ofield, get(Parameters::NarrowBandWidth).toDouble());
+      return (true);
+    }
+    remark("Fast sweeping needs a LatVol or Image field with orthogonal axes and node or cell data; computing exact distances instead.");
+  }
+
   const int numThreads = Parallel::NumCores();
   auto task_i = [&palgo,numThreads](int i) { palgo.parallel(i, numThreads); };
   Parallel::RunTasks(task_i, numThreads);
@@ -800,6 +713,11 @@ CalculateSignedDistanceFieldAlgo::run(FieldHandle input, FieldHandle object, Fie
     return (true);
   }
 
+  if (checkOption(Parameters::DistanceMethod, "fast sweeping"))
+  {
+    remark("The closest value field needs the closest element of every sample; computing exact distances.");
+  }
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E|Mesh::EDGES_E);
 
   if (distance->basis_order() > 2)
@@ -0,0 +1,350 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
+#include <Core/Thread/Barrier.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <deque>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+RegularGridDistanceTransform::RegularGridDistanceTransform(VMesh* mesh, int basisOrder) :
+  valid_(false), h_{0.0, 0.0, 0.0}
+{
+  dims_[0] = dims_[1] = dims_[2] = 1;
+  if (!(mesh->is_latvolmesh() || mesh->is_imagemesh()) || basisOrder < 0 || basisOrder > 1)
+    return;
+
+  VMesh::dimension_type dims;
+  if (basisOrder == 0)
+    mesh->get_elem_dimensions(dims);
+  else
+    mesh->get_dimensions(dims);
+
+  for (size_t a = 0; a < dims.size() && a < 3; a++)
+    dims_[a] = dims[a];
+  if (size() == 0)
+    return;
+
+  // The samples of both meshes are an affine image of the index grid, so three neighbors of
+  // the first sample give the whole geometry.
+  const VMesh::index_type stride[3] = { 1, dims_[0], dims_[0]*dims_[1] };
+  auto center = [mesh, basisOrder](Point& p, VMesh::index_type idx)
+  {
+    if (basisOrder == 0)
+      mesh->get_center(p, VMesh::Elem::index_type(idx));
+    else
+      mesh->get_center(p, VMesh::Node::index_type(idx));
+  };
+
+  center(origin_, 0);
+  for (int a = 0; a < 3; a++)
+  {
+    if (dims_[a] > 1)
+    {
+      Point p;
+      center(p, stride[a]);
+      axes_[a] = p - origin_;
+      h_[a] = axes_[a].length();
+      if (h_[a] <= 0.0)
+        return;
+    }
+  }
+
+  for (int a = 0; a < 3; a++)
+    for (int b = a + 1; b < 3; b++)
+      if (h_[a] > 0.0 && h_[b] > 0.0 && std::fabs(Dot(axes_[a], axes_[b])) > 1e-8 * h_[a] * h_[b])
+        return;
+
+  valid_ = true;
+}
+
+double RegularGridDistanceTransform::maxSpacing() const
+{
+  return std::max(h_[0], std::max(h_[1], h_[2]));
+}
+
+Point RegularGridDistanceTransform::point(VMesh::index_type idx) const
+{
+  const VMesh::index_type i = idx % dims_[0];
+  const VMesh::index_type j = (idx / dims_[0]) % dims_[1];
+  const VMesh::index_type k = idx / (dims_[0]*dims_[1]);
+  return origin_ + axes_[0]*static_cast<double>(i) + axes_[1]*static_cast<double>(j) + axes_[2]*static_cast<double>(k);
+}
+
+std::vector<VMesh::index_type>
+RegularGridDistanceTransform::narrowBand(VMesh* objmesh, double margin, int nproc) const
+{
+  std::vector<char> marked(size(), 0);
+
+  // Threads own slabs along the last non trivial axis, so they never mark the same sample.
+  int split = 2;
+  while (split > 0 && dims_[split] == 1) split--;
+
+  const VMesh::size_type num_elems = objmesh->num_elems();
+  auto mark = [&](int proc)
+  {
+    const VMesh::index_type slab_start = (dims_[split]*proc)/nproc;
+    const VMesh::index_type slab_end = (dims_[split]*(proc+1))/nproc;
+
+    VMesh::Node::array_type nodes;
+    Point p;
+    for (VMesh::Elem::index_type e = 0; e < num_elems; e++)
+    {
+      objmesh->get_nodes(nodes, e);
+      double tmin[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+      double tmax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+      for (size_t r = 0; r < nodes.size(); r++)
+      {
+        objmesh->get_center(p, nodes[r]);
+        const Vector v = p - origin_;
+        for (int a = 0; a < 3; a++)
+        {
+          const double t = (h_[a] > 0.0) ? Dot(v, axes_[a])/(h_[a]*h_[a]) : 0.0;
+          tmin[a] = std::min(tmin[a], t);
+          tmax[a] = std::max(tmax[a], t);
+        }
+      }
+
+      VMesh::index_type lo[3], hi[3];
+      bool empty = false;
+      for (int a = 0; a < 3; a++)
+      {
+        const double grow = (h_[a] > 0.0) ? margin/h_[a] : 0.0;
+        lo[a] = static_cast<VMesh::index_type>(std::max(0.0, std::ceil(tmin[a] - grow)));
+        hi[a] = static_cast<VMesh::index_type>(std::min(static_cast<double>(dims_[a]-1), std::floor(tmax[a] + grow))) + 1;
+        if (a == split)
+        {
+          lo[a] = std::max(lo[a], slab_start);
+          hi[a] = std::min(hi[a], slab_end);
+        }
+        if (lo[a] >= hi[a]) empty = true;
+      }
+      if (empty) continue;
+
+      for (VMesh::index_type k = lo[2]; k < hi[2]; k++)
+        for (VMesh::index_type j = lo[1]; j < hi[1]; j++)
+          for (VMesh::index_type i = lo[0]; i < hi[0]; i++)
+            marked[i + dims_[0]*(j + dims_[1]*k)] = 1;
+    }
+  };
+  Parallel::RunTasks(mark, nproc);
+
+  std::vector<VMesh::index_type> band;
+  for (VMesh::index_type idx = 0; idx < static_cast<VMesh::index_type>(marked.size()); idx++)
+    if (marked[idx]) band.push_back(idx);
+  return band;
+}
+
+double RegularGridDistanceTransform::solve(const std::vector<double>& distance,
+  VMesh::index_type i, VMesh::index_type j, VMesh::index_type k) const
+{
+  const VMesh::index_type ijk[3] = { i, j, k };
+  const VMesh::index_type stride[3] = { 1, dims_[0], dims_[0]*dims_[1] };
+  const VMesh::index_type idx = i + stride[1]*j + stride[2]*k;
+
+  // Godunov upwind discretization: per axis only the smaller neighbor matters
+  std::pair<double,double> upwind[3];
+  int n = 0;
+  for (int a = 0; a < 3; a++)
+  {
+    if (dims_[a] == 1) continue;
+    double u = DBL_MAX;
+    if (ijk[a] > 0) u = distance[idx - stride[a]];
+    if (ijk[a] < static_cast<VMesh::index_type>(dims_[a]) - 1) u = std::min(u, distance[idx + stride[a]]);
+    if (u < DBL_MAX) upwind[n++] = std::make_pair(u, h_[a]);
+  }
+  if (n == 0) return DBL_MAX;
+  std::sort(upwind, upwind + n);
+
+  // Add axes in order of their upwind value until the solution no longer exceeds the next one
+  double u = upwind[0].first + upwind[0].second;
+  double A = 0.0, B = 0.0, C = -1.0;
+  for (int m = 0; m < n; m++)
+  {
+    if (m > 0 && u <= upwind[m].first) break;
+    const double w = 1.0/(upwind[m].second*upwind[m].second);
+    A += w;
+    B += w*upwind[m].first;
+    C += w*upwind[m].first*upwind[m].first;
+    const double disc = B*B - A*C;
+    if (disc < 0.0) break;
+    u = (B + std::sqrt(disc))/A;
+  }
+  return u;
+}
+
+void RegularGridDistanceTransform::sweep(std::vector<double>& distance, const std::vector<char>& fixed,
+  const int dir[3], const VMesh::index_type lo[3], const VMesh::index_type hi[3], double maxDistance,
+  int proc, int nproc, Barrier& barrier, char& changed) const
+{
+  const VMesh::index_type n[3] = { hi[0]-lo[0], hi[1]-lo[1], hi[2]-lo[2] };
+  const double tolerance = 1e-10*maxSpacing();
+  auto index = [&](int a, VMesh::index_type t) { return dir[a] > 0 ? lo[a] + t : hi[a] - 1 - t; };
+
+  const VMesh::index_type levels = n[0] + n[1] + n[2] - 2;
+  for (VMesh::index_type level = 0; level < levels; level++)
+  {
+    const VMesh::index_type t0_start = std::max<VMesh::index_type>(0, level - (n[1]-1) - (n[2]-1));
+    const VMesh::index_type t0_end = std::min<VMesh::index_type>(n[0]-1, level) + 1;
+    const VMesh::index_type count = std::max<VMesh::index_type>(0, t0_end - t0_start);
+    const VMesh::index_type start = t0_start + (count*proc)/nproc;
+    const VMesh::index_type end = t0_start + (count*(proc+1))/nproc;
+
+    for (VMesh::index_type t0 = start; t0 < end; t0++)
+    {
+      const VMesh::index_type t1_start = std::max<VMesh::index_type>(0, level - t0 - (n[2]-1));
+      const VMesh::index_type t1_end = std::min<VMesh::index_type>(n[1]-1, level - t0);
+      for (VMesh::index_type t1 = t1_start; t1 <= t1_end; t1++)
+      {
+        const VMesh::index_type i = index(0, t0), j = index(1, t1), k = index(2, level - t0 - t1);
+        const VMesh::index_type idx = i + dims_[0]*(j + dims_[1]*k);
+        if (fixed[idx]) continue;
+
+        const double u = solve(distance, i, j, k);
+        if (u < distance[idx] && u < maxDistance)
+        {
+          if (distance[idx] - u > tolerance) changed = 1;
+          distance[idx] = u;
+        }
+      }
+    }
+    barrier.wait();
+  }
+}
+
+void RegularGridDistanceTransform::propagate(std::vector<double>& distance, const std::vector<char>& fixed,
+  double maxDistance, int nproc) const
+{
+  // Only the box around the fixed samples grown by the cutoff can get a value below it
+  VMesh::index_type lo[3] = { static_cast<VMesh::index_type>(dims_[0]), static_cast<VMesh::index_type>(dims_[1]), static_cast<VMesh::index_type>(dims_[2]) };
+  VMesh::index_type hi[3] = { 0, 0, 0 };
+  for (VMesh::index_type idx = 0; idx < static_cast<VMesh::index_type>(size()); idx++)
+  {
+    if (!fixed[idx]) continue;
+    const VMesh::index_type ijk[3] = { idx % dims_[0], (idx / dims_[0]) % dims_[1], idx / (dims_[0]*dims_[1]) };
+    for (int a = 0; a < 3; a++)
+    {
+      lo[a] = std::min(lo[a], ijk[a]);
+      hi[a] = std::max(hi[a], ijk[a] + 1);
+    }
+  }
+  if (hi[0] == 0) return;
+
+  for (int a = 0; a < 3; a++)
+  {
+    if (maxDistance < DBL_MAX && h_[a] > 0.0)
+    {
+      const double grow = std::ceil(maxDistance/h_[a]);
+      lo[a] = static_cast<VMesh::index_type>(std::max(0.0, lo[a] - grow));
+      hi[a] = static_cast<VMesh::index_type>(std::min(static_cast<double>(dims_[a]), hi[a] + grow));
+    }
+    else
+    {
+      lo[a] = 0;
+      hi[a] = dims_[a];
+    }
+  }
+
+  const int directions[8][3] = { {1,1,1}, {-1,1,1}, {1,-1,1}, {-1,-1,1},
+                                 {1,1,-1}, {-1,1,-1}, {1,-1,-1}, {-1,-1,-1} };
+  // Each round of eight sweeps follows the characteristics one more time around obstacles;
+  // distance fields converge after a few rounds.
+  const int maxRounds = 16;
+  std::vector<char> changed(nproc, 0);
+  for (int round = 0; round < maxRounds; round++)
+  {
+    std::fill(changed.begin(), changed.end(), 0);
+    for (int d = 0; d < 8; d++)
+    {
+      if ((dims_[2] == 1 && directions[d][2] < 0) || (dims_[1] == 1 && directions[d][1] < 0)) continue;
+      Barrier barrier("RegularGridDistanceTransform", nproc);
+      auto task = [&](int proc)
+      {
+        sweep(distance, fixed, directions[d], lo, hi, maxDistance, proc, nproc, barrier, changed[proc]);
+      };
+      Parallel::RunTasks(task, nproc);
+    }
+    if (std::find(changed.begin(), changed.end(), 1) == changed.end()) break;
+  }
+}
+
+void RegularGridDistanceTransform::propagateSigns(std::vector<double>& distance, const std::vector<char>& fixed) const
+{
+  const VMesh::index_type stride[3] = { 1, dims_[0], dims_[0]*dims_[1] };
+  std::vector<char> visited(fixed);
+  std::vector<VMesh::index_type> region;
+  std::deque<VMesh::index_type> front;
+
+  for (VMesh::index_type seed = 0; seed < static_cast<VMesh::index_type>(size()); seed++)
+  {
+    if (visited[seed]) continue;
+
+    // Flood the region of unfixed samples and let its fixed border vote on the sign
+    region.clear();
+    double vote = 0.0;
+    visited[seed] = 1;
+    front.push_back(seed);
+    while (!front.empty())
+    {
+      const VMesh::index_type idx = front.front();
+      front.pop_front();
+      region.push_back(idx);
+      const VMesh::index_type ijk[3] = { idx % dims_[0], (idx / dims_[0]) % dims_[1], idx / (dims_[0]*dims_[1]) };
+      for (int a = 0; a < 3; a++)
+      {
+        for (int s = -1; s <= 1; s += 2)
+        {
+          const VMesh::index_type t = ijk[a] + s;
+          if (t < 0 || t >= static_cast<VMesh::index_type>(dims_[a])) continue;
+          const VMesh::index_type nidx = idx + s*stride[a];
+          if (fixed[nidx])
+          {
+            if (distance[nidx] > 0.0) vote += 1.0;
+            else if (distance[nidx] < 0.0) vote -= 1.0;
+          }
+          else if (!visited[nidx])
+          {
+            visited[nidx] = 1;
+            front.push_back(nidx);
+          }
+        }
+      }
+    }
+
+    if (vote < 0.0)
+      for (auto idx : region) distance[idx] = -distance[idx];
+  }
+}
@@ -0,0 +1,95 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_REGULARGRIDDISTANCETRANSFORM_H
+#define CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_REGULARGRIDDISTANCETRANSFORM_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/GeometryPrimitives/Vector.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+#include <vector>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Thread {
+      class Barrier;
+    }
+    namespace Algorithms {
+      namespace Fields {
+
+/// Distance transform on the sample points of a LatVol or Image field: the nodes for linear
+/// data, the cell centers for constant data. The caller computes exact distances in a narrow
+/// band around the object; propagate() extends them over the rest of the grid by solving
+/// |grad u| = 1 with a fast sweeping solver (Zhao, Math. Comp. 2005). Each sweep visits the
+/// grid in hyperplanes i+j+k = const whose samples are independent, so a sweep runs in
+/// parallel (Detrixhe, Gibou and Min, J. Comput. Phys. 2013). The cost is O(N) per sweep.
+class SCISHARE RegularGridDistanceTransform
+{
+  public:
+    RegularGridDistanceTransform(VMesh* mesh, int basisOrder);
+
+    /// False for other mesh types, for data that does not live on nodes or cells, and for
+    /// grids whose axes are not orthogonal.
+    bool valid() const { return valid_; }
+
+    VMesh::size_type size() const { return dims_[0]*dims_[1]*dims_[2]; }
+    double maxSpacing() const;
+    Core::Geometry::Point point(VMesh::index_type idx) const;
+
+    /// Samples within margin of the bounding box of any element of objmesh.
+    std::vector<VMesh::index_type> narrowBand(VMesh* objmesh, double margin, int nproc) const;
+
+    /// Fills in all samples that are not fixed. Unfixed entries must hold maxDistance (or
+    /// DBL_MAX for no cutoff) on entry; samples further than maxDistance from the fixed ones
+    /// are not visited and keep that value.
+    void propagate(std::vector<double>& distance, const std::vector<char>& fixed,
+      double maxDistance, int nproc) const;
+
+    /// Makes every unfixed sample take the sign of the fixed samples bordering its connected
+    /// region, for signed distances whose sign is only known in the band.
+    void propagateSigns(std::vector<double>& distance, const std::vector<char>& fixed) const;
+
+  private:
+    void sweep(std::vector<double>& distance, const std::vector<char>& fixed, const int dir[3],
+      const VMesh::index_type lo[3], const VMesh::index_type hi[3], double maxDistance,
+      int proc, int nproc, Core::Thread::Barrier& barrier, char& changed) const;
+    double solve(const std::vector<double>& distance, VMesh::index_type i, VMesh::index_type j,
+      VMesh::index_type k) const;
+
+    bool valid_;
+    VMesh::size_type dims_[3];
+    Core::Geometry::Point origin_;
+    Core::Geometry::Vector axes_[3];
+    double h_[3];
+};
+
+}}}}
+
+#endif
@@ -33,6 +33,7 @@
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <algorithm>
+#include <numeric>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms::Fields;
@@ -127,7 +128,6 @@ SplitFieldByDomainAlgo::runImpl(FieldHandle input, FieldList& output) const
 
 
   std::vector<VMesh::Node::index_type> idxarray(num_nodes);
-  std::vector<bool> newidxarray(num_nodes);
   VMesh::Node::array_type nodes;
   VMesh::Node::array_type newnodes;
   VMesh::Node::index_type node;
@@ -135,15 +135,28 @@ SplitFieldByDomainAlgo::runImpl(FieldHandle input, FieldList& output) const
   std::vector<int> labels;
   field->get_values(labels);
 
-  int flabel = 0;
-  if (labels.size()) flabel = labels[0];
-  for (size_t j=0; j<labels.size();j++) { if (labels[j] < flabel) flabel = labels[j]; }
+  // Group the elements by label once, lowest label first and elements in
+  // increasing order within a label, rather than rescanning all elements for
+  // every label: segmented volumes can carry hundreds of labels.
+  std::vector<index_type> order(num_elems);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&labels](index_type i1, index_type i2) { return labels[i1] < labels[i2]; });
+
+  // Nodes already copied into the current output field carry its number here,
+  // so the lookup table never needs to be cleared between labels.
+  std::vector<index_type> nodedomain(num_nodes, -1);
 
   index_type k = 0;
 
   int cnt = 0;
-  while (true)
+  size_t begin = 0;
+  while (begin < order.size())
   {
+    const int flabel = labels[order[begin]];
+    size_t end = begin;
+    while (end < order.size() && labels[order[end]] == flabel) end++;
+
     FieldHandle output_field = CreateField(fo);
 
     if (!output_field)
@@ -163,58 +176,55 @@ SplitFieldByDomainAlgo::runImpl(FieldHandle input, FieldList& output) const
       return(false);
     }
 
-    for (size_type p =0; p<num_nodes; p++) newidxarray[p] = true;
+    const index_type domain = static_cast<index_type>(output.size());
+    omesh->elem_reserve(end - begin);
 
-    for (VMesh::Elem::index_type idx=0; idx< num_elems; idx++)
+    for (size_t e = begin; e < end; e++)
     {
-      if (labels[idx] == flabel)
+      VMesh::Elem::index_type idx = order[e];
+      mesh->get_nodes(nodes,idx);
+      newnodes.resize(nodes.size());
+      for (size_t p=0; p< nodes.size(); p++)
       {
-        mesh->get_nodes(nodes,idx);
-        newnodes.resize(nodes.size());
-        for (size_t p=0; p< nodes.size(); p++)
-        {
-          node = nodes[p];
-          if (newidxarray[node])
-          {
-            Point pt;
-            mesh->get_center(pt,nodes[p]);
-            idxarray[node] = omesh->add_point(pt);
-            newidxarray[node] = false;
-          }
-          newnodes[p] = idxarray[node];
-        }
-        omesh->add_elem(newnodes);
-        cnt++;
-        if (cnt == 400)
+        node = nodes[p];
+        if (nodedomain[node] != domain)
         {
-          cnt = 0;
-          update_progress_max(k,num_elems);
+          Point pt;
+          mesh->get_center(pt,nodes[p]);
+          idxarray[node] = omesh->add_point(pt);
+          nodedomain[node] = domain;
         }
-        k++;
+        newnodes[p] = idxarray[node];
       }
+      omesh->add_elem(newnodes);
+      cnt++;
+      if (cnt == 400)
+      {
+        cnt = 0;
+        update_progress_max(k,num_elems);
+      }
+      k++;
     }
 
     ofield->resize_values();
     ofield->set_all_values(flabel);
     output.push_back(output_field);
 
-    int elabel = 0;
-    bool found = false;
+    begin = end;
+  }
 
-    for (VMesh::index_type lidx = 0; lidx < num_elems; lidx++)
+  // Fields without elements still produce one (empty) output, as before.
+  if (output.empty())
+  {
+    FieldHandle output_field = CreateField(fo);
+    if (!output_field)
     {
-      if (labels[lidx] > flabel)
-      {
-        if (!found) { elabel = labels[lidx]; found = true;}
-        if (labels[lidx] < elabel) elabel = labels[lidx];
-      }
+      error("Could not create output field");
+      return(false);
     }
-    // check whether we are done
-    if (!found) break;
-    flabel = elabel;
+    output.push_back(output_field);
   }
 
-
   if (get(Parameters::SortBySize).toBool())
   {
     std::vector<double> sizes(output.size());
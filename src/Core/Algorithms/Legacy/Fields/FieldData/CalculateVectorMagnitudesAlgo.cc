@@ -32,7 +32,9 @@
 #include <Core/Algorithms/Legacy/Fields/FieldData/CalculateVectorMagnitudesAlgo.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <algorithm>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms::Fields;
@@ -81,16 +83,18 @@ CalculateVectorMagnitudesAlgo::run(FieldHandle input, FieldHandle& output) const
   if (!mag)
    THROW_ALGORITHM_INPUT_ERROR("Could not access output field pointer");
 
-  int cnt = 0;
-  for (VMesh::Elem::index_type idx = 0; idx < num_elems; idx++)
+  // Vector is three packed doubles, so the data can be processed as one
+  // interleaved component array in blocks
+  static_assert(sizeof(Vector) == 3*sizeof(double), "Vector must be three packed doubles");
+  const VMesh::size_type blockSize = 1 << 16;
+  auto components = VectorComponents::interleaved(reinterpret_cast<const double*>(vec));
+  for (VMesh::size_type start = 0; start < num_elems; start += blockSize)
   {
-   mag[idx] = vec[idx].length();
-   cnt++;
-   if (cnt == 400)
-      {
-        cnt = 0;
-        update_progress_max(idx,num_elems);
-      }
+    VMesh::size_type count = std::min(blockSize, num_elems - start);
+    VectorComponents block = components;
+    block.x += 3*start; block.y += 3*start; block.z += 3*start;
+    FieldDataKernels::vectorLengths(block, count, mag + start);
+    update_progress_max(start + count, num_elems);
   }
   return (true);
 }
@@ -38,6 +38,7 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
 
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
@@ -48,176 +49,150 @@ using namespace SCIRun::Core::Logging;
 using namespace SCIRun::Core::Thread;
 using namespace SCIRun;
 
+enum class ElemToNodeMethod { Average, Max, Min, Sum, Median };
+
+/// The element values are copied out of the field once and the node loop is
+/// instantiated for each mesh class through dispatch_mesh(), so no virtual
+/// call is made per node.
 template <class DATA>
-bool
-  MapFieldDataFromElemToNodeT(const MapFieldDataFromElemToNodeAlgo *algo,
-  FieldHandle& input,
-  FieldHandle& output)
+class MapFieldDataFromElemToNodeT
 {
-  std::string method = algo->getOption(Variables::Method);
-
-  VField *ifield = input->vfield();
-  VField *ofield = output->vfield();
-
-  /// Make sure that the data vector has the same length
-  ofield->resize_fdata();
-
-  VMesh* mesh = input->vmesh();
-
-  VMesh::Elem::array_type elems;
-  VMesh::Node::iterator it, eit;
-  VMesh::Node::size_type sz;
-
-  mesh->synchronize(SCIRun::Mesh::NODE_NEIGHBORS_E);
-
-  mesh->begin(it);
-  mesh->end(eit);
-
-  mesh->size(sz);
-
-  index_type cnt = 0, c = 0;
-
-  if (method == "Interpolation")
+public:
+  MapFieldDataFromElemToNodeT(const MapFieldDataFromElemToNodeAlgo* algo,
+                              ElemToNodeMethod method,
+                              const std::vector<DATA>& ivalues,
+                              std::vector<DATA>& ovalues) :
+    algo_(algo), method_(method), ivalues_(ivalues), ovalues_(ovalues) {}
+
+  template <class MESH>
+  void operator()(const MESH& mesh)
   {
-    algo->remark("Interpolation of piecewise constant data is done by averaging adjoining values");
-  }
+    typename MESH::Node::size_type sz;
+    mesh.size(sz);
+    VMesh::size_type num_nodes = sz;
 
-  if ((method == "Interpolation") || (method == "Average"))
-  {
-    while (it != eit)
-    {
+    typename MESH::Elem::array_type elems;
+    std::vector<DATA> valarray;
+    index_type cnt = 0, c = 0;
 
-      mesh->get_elems(elems, *(it));
+    for (VMesh::index_type idx = 0; idx < num_nodes; idx++)
+    {
+      mesh.get_elems(elems, typename MESH::Node::index_type(idx));
       size_t nsize = elems.size();
-      DATA val(0);
-      DATA tval;
+      valarray.resize(nsize);
       for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval, elems[p]);
-        val += tval;
-      }
-      val = static_cast<DATA>(val*(1.0 / static_cast<double>(nsize)));
-      ofield->set_value(val, *(it));
-      ++it;
+        valarray[p] = ivalues_[static_cast<VMesh::index_type>(elems[p])];
+
+      ovalues_[idx] = combine(valarray);
+
       cnt++;
       if (cnt == 1000)
       {
         cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+        algo_->update_progress(c / num_nodes);
       }
     }
   }
-  else if (method == "Max")
+
+private:
+  DATA combine(std::vector<DATA>& valarray) const
   {
-    while (it != eit)
+    size_t nsize = valarray.size();
+    if (method_ == ElemToNodeMethod::Average)
+    {
+      DATA val(0);
+      for (size_t p = 0; p < nsize; p++)
+        val += valarray[p];
+      return static_cast<DATA>(val*(1.0 / static_cast<double>(nsize)));
+    }
+    else if (method_ == ElemToNodeMethod::Max)
     {
-
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
       DATA val(0);
-      DATA tval(0);
       if (nsize > 0)
       {
-        ifield->get_value(val, elems[0]);
+        val = valarray[0];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->get_value(tval, elems[p]);
-          if (tval > val) val = tval;
-        }
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+          if (valarray[p] > val) val = valarray[p];
       }
+      return val;
     }
-  }
-  else if (method == "Min")
-  {
-    while (it != eit)
+    else if (method_ == ElemToNodeMethod::Min)
     {
-
-      mesh->get_elems(elems, *it);
-      size_t nsize = elems.size();
       DATA val(0);
-      DATA tval(0);
       if (nsize > 0)
       {
-        ifield->get_value(val, elems[0]);
+        val = valarray[0];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->value(tval, elems[p]);
-          if (tval < val) val = tval;
-        }
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
+          if (valarray[p] < val) val = valarray[p];
       }
+      return val;
     }
-  }
-  else if (method == "Sum")
-  {
-    while (it != eit)
+    else if (method_ == ElemToNodeMethod::Sum)
     {
-
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
       DATA val(0);
-      DATA tval(0);
       for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval, elems[p]);
-        val += tval;
-      }
-      ofield->set_value(val, *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
-      }
+        val += valarray[p];
+      return val;
     }
+    // Median
+    sort(valarray.begin(), valarray.end());
+    int idx = static_cast<int>((valarray.size() / 2));
+    return valarray[idx];
   }
-  else if (method == "Median")
-  {
-    std::vector<DATA> valarray;
-    while (it != eit)
-    {
 
-      mesh->get_elems(elems, *(it));
-      size_t nsize = elems.size();
-      valarray.resize(nsize);
-      for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(valarray[p], elems[p]);
-      }
-      sort(valarray.begin(), valarray.end());
-      int idx = static_cast<int>((valarray.size() / 2));
-      ofield->set_value(valarray[idx], *(it));
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress(c / sz);
-      }
-    }
-  }
+  const MapFieldDataFromElemToNodeAlgo* algo_;
+  ElemToNodeMethod method_;
+  const std::vector<DATA>& ivalues_;
+  std::vector<DATA>& ovalues_;
+};
+
+template <class DATA>
+bool
+  MapFieldDataFromElemToNodeV(const MapFieldDataFromElemToNodeAlgo *algo,
+  FieldHandle& input,
+  FieldHandle& output)
+{
+  std::string method = algo->getOption(Variables::Method);
+
+  ElemToNodeMethod m;
+  if ((method == "Interpolation") || (method == "Average"))
+    m = ElemToNodeMethod::Average;
+  else if (method == "Max")
+    m = ElemToNodeMethod::Max;
+  else if (method == "Min")
+    m = ElemToNodeMethod::Min;
+  else if (method == "Sum")
+    m = ElemToNodeMethod::Sum;
+  else if (method == "Median")
+    m = ElemToNodeMethod::Median;
   else
   {
     algo->remark("Method is not implemented!");
     return false;
   }
 
+  VField *ifield = input->vfield();
+  VField *ofield = output->vfield();
+
+  /// Make sure that the data vector has the same length
+  ofield->resize_fdata();
+
+  VMesh* mesh = input->vmesh();
+  mesh->synchronize(SCIRun::Mesh::NODE_NEIGHBORS_E);
+
+  if (method == "Interpolation")
+  {
+    algo->remark("Interpolation of piecewise constant data is done by averaging adjoining values");
+  }
+
+  std::vector<DATA> ivalues;
+  ifield->get_values(ivalues);
+  std::vector<DATA> ovalues(ofield->num_values());
+
+  MapFieldDataFromElemToNodeT<DATA> mapping(algo, m, ivalues, ovalues);
+  dispatch_mesh(input, mapping);
+
+  ofield->set_values(ovalues);
   return true;
 }
 
@@ -276,32 +251,32 @@ FieldHandle MapFieldDataFromElemToNodeAlgo::runImpl(FieldHandle input_field) con
 
   if (input_field->vfield()->is_signed_integer())
   {
-    if(!MapFieldDataFromElemToNodeT<int>(this,input_field,output))
+    if(!MapFieldDataFromElemToNodeV<int>(this,input_field,output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output int field cannot be allocated");
     }
   }
   else if (input_field->vfield()->is_unsigned_integer())
   {
-    if(!MapFieldDataFromElemToNodeT<unsigned int>(this,input_field,output))
+    if(!MapFieldDataFromElemToNodeV<unsigned int>(this,input_field,output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output uint field cannot be allocated");
     }
   } else if (input_field->vfield()->is_scalar())
   {
-    if (!MapFieldDataFromElemToNodeT<double>(this,input_field,output))
+    if (!MapFieldDataFromElemToNodeV<double>(this,input_field,output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output scalar field cannot be allocated");
     }
   } else if (input_field->vfield()->is_vector())
   {
-    if (!MapFieldDataFromElemToNodeT<Vector>(this,input_field,output))
+    if (!MapFieldDataFromElemToNodeV<Vector>(this,input_field,output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output vector field cannot be allocated");
     }
   } else if (input_field->vfield()->is_tensor())
   {
-    if (!MapFieldDataFromElemToNodeT<Tensor>(this,input_field,output))
+    if (!MapFieldDataFromElemToNodeV<Tensor>(this,input_field,output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output tensor field cannot be allocated");
     }
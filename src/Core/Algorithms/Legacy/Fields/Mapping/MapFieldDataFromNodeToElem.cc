@@ -35,6 +35,7 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
 
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Geometry;
@@ -45,175 +46,145 @@ using namespace SCIRun::Core::Logging;
 using namespace SCIRun::Core::Thread;
 using namespace SCIRun;
 
-/// This is the basic algorithm behind the mapping algorithm
+enum class NodeToElemMethod { Average, Max, Min, Sum, Median };
+
+/// This is the basic algorithm behind the mapping algorithm. The node values
+/// are copied out of the field once and the element loop is instantiated for
+/// each mesh class through dispatch_mesh(), so no virtual call is made per
+/// element.
 
 template <class DATA>
-bool
-MapFieldDataFromNodeToElemT(const MapFieldDataFromNodeToElemAlgo* algo,
-                            FieldHandle& input,
-                            FieldHandle& output)
+class MapFieldDataFromNodeToElemT
 {
+public:
+  MapFieldDataFromNodeToElemT(const MapFieldDataFromNodeToElemAlgo* algo,
+                              NodeToElemMethod method,
+                              const std::vector<DATA>& ivalues,
+                              std::vector<DATA>& ovalues) :
+    algo_(algo), method_(method), ivalues_(ivalues), ovalues_(ovalues) {}
+
+  template <class MESH>
+  void operator()(const MESH& mesh)
+  {
+    typename MESH::Elem::size_type sz;
+    mesh.size(sz);
+    VMesh::size_type num_elems = sz;
 
-  /// Get the method the user selected.
-  /// Since we do a check of valid entries when then user sets the
-  /// algorithm, we can assume it is one of the specified ones
-   std::string method = algo->getOption(Variables::Method);
-  /// Get pointers to the virtual interfaces of the fields
-  /// We need these to obtain the data values
-
-  VField *ifield = input->vfield();
-  VField *ofield = output->vfield();
-
-  /// Make sure that the data vector has the same length
-  ofield->resize_fdata();
-
-  VMesh* mesh = input->vmesh();
-
-  VMesh::Elem::array_type elems;
-  VMesh::Elem::iterator it, eit;
-  VMesh::Elem::size_type sz;
-
-  VMesh::Node::array_type nodearray;
-
-  mesh->begin(it);
-  mesh->end(eit);
-  mesh->size(sz);
-  index_type cnt = 0, c = 0;
+    typename MESH::Node::array_type nodearray;
+    std::vector<DATA> valarray;
+    index_type cnt = 0, c = 0;
 
-  if ((method == "Average") || (method == "Interpolation"))
-  {
-    DATA tval(0);
-    while (it != eit)
+    for (VMesh::index_type idx = 0; idx < num_elems; idx++)
     {
-
-      mesh->get_nodes(nodearray, *it);
+      mesh.get_nodes(nodearray, typename MESH::Elem::index_type(idx));
       size_t nsize = nodearray.size();
-      DATA val(0);
+      valarray.resize(nsize);
       for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval,nodearray[p]);
-        val += tval;
-      }
+        valarray[p] = ivalues_[static_cast<VMesh::index_type>(nodearray[p])];
+
+      ovalues_[idx] = combine(valarray);
 
-      val = static_cast<DATA>(val * static_cast<double>((1.0 / static_cast<double>(nsize))));
-      ofield->set_value(val, *it);
-      ++it;
       cnt++;
       if (cnt == 1000)
       {
         cnt = 0; c += 1000;
-        algo->update_progress_max(c, sz);
+        algo_->update_progress_max(c, num_elems);
       }
     }
   }
-  else if (method == "Max")
+
+private:
+  DATA combine(std::vector<DATA>& valarray) const
   {
-    while (it != eit)
+    size_t nsize = valarray.size();
+    if (method_ == NodeToElemMethod::Average)
+    {
+      DATA val(0);
+      for (size_t p = 0; p < nsize; p++)
+        val += valarray[p];
+      return static_cast<DATA>(val * static_cast<double>((1.0 / static_cast<double>(nsize))));
+    }
+    else if (method_ == NodeToElemMethod::Max)
     {
-
-      mesh->get_nodes(nodearray, *it);
-      size_t nsize = nodearray.size();
       DATA val(0);
-      DATA tval(0);
       if (nsize > 0)
       {
-        ifield->get_value(val,nodearray[0]);
+        val = valarray[0];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->get_value(tval,nodearray[p]);
-          if (val < tval) val = tval;
-        }
-      }
-      ofield->set_value(val,*it);
-      ++it;
-      cnt++;
-      if (cnt==1000)
-      {
-        cnt=0; c+=1000;
-        algo->update_progress_max(c, sz);
+          if (val < valarray[p]) val = valarray[p];
       }
+      return val;
     }
-  }
-  else if (method == "Min")
-  {
-    DATA tval(0);
-    while (it != eit)
+    else if (method_ == NodeToElemMethod::Min)
     {
-
-      mesh->get_nodes(nodearray, *it);
-      size_t nsize = nodearray.size();
       DATA val(0);
       if (nsize > 0)
       {
-        ifield->get_value(val,nodearray[0]);
+        val = valarray[0];
         for (size_t p = 1; p < nsize; p++)
-        {
-          ifield->value(tval,nodearray[p]);
-          if (tval < val) val = tval;
-        }
-      }
-      ofield->set_value(val,*it);
-      ++it;
-      cnt++;
-      if (cnt==1000)
-      {
-        cnt=0; c+=1000;
-        algo->update_progress_max(c, sz);
+          if (valarray[p] < val) val = valarray[p];
       }
+      return val;
     }
-  }
-  else if (method == "Sum")
-  {
-    DATA tval(0);
-    while (it != eit)
+    else if (method_ == NodeToElemMethod::Sum)
     {
-
-      mesh->get_nodes(nodearray, *it);
-      size_t nsize = nodearray.size();
       DATA val(0);
       for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(tval,nodearray[p]);
-        val += tval;
-      }
-      ofield->set_value(val,*it);
-      ++it;
-      cnt++;
-      if (cnt==1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress_max(c, sz);
-      }
+        val += valarray[p];
+      return val;
     }
+    // Median
+    sort(valarray.begin(), valarray.end());
+    int idx = static_cast<int>((valarray.size() / 2));
+    return valarray[idx];
   }
-  else if (method == "Median")
-  {
-    std::vector<DATA> valarray;
-    while (it != eit)
-    {
 
-      mesh->get_nodes(nodearray, *it);
-      size_t nsize = nodearray.size();
-      valarray.resize(nsize);
-      for (size_t p = 0; p < nsize; p++)
-      {
-        ifield->get_value(valarray[p], nodearray[p]);
-      }
-      sort(valarray.begin(), valarray.end());
-      int idx = static_cast<int>((valarray.size() / 2));
-      ofield->set_value(valarray[idx], *it);
-      ++it;
-      cnt++;
-      if (cnt == 1000)
-      {
-        cnt = 0; c += 1000;
-        algo->update_progress_max(c, sz);
-      }
-    }
-  }
+  const MapFieldDataFromNodeToElemAlgo* algo_;
+  NodeToElemMethod method_;
+  const std::vector<DATA>& ivalues_;
+  std::vector<DATA>& ovalues_;
+};
+
+template <class DATA>
+bool
+MapFieldDataFromNodeToElemV(const MapFieldDataFromNodeToElemAlgo* algo,
+                            FieldHandle& input,
+                            FieldHandle& output)
+{
+  /// Get the method the user selected.
+  /// Since we do a check of valid entries when then user sets the
+  /// algorithm, we can assume it is one of the specified ones
+  std::string method = algo->getOption(Variables::Method);
+  NodeToElemMethod m;
+  if ((method == "Average") || (method == "Interpolation"))
+    m = NodeToElemMethod::Average;
+  else if (method == "Max")
+    m = NodeToElemMethod::Max;
+  else if (method == "Min")
+    m = NodeToElemMethod::Min;
+  else if (method == "Sum")
+    m = NodeToElemMethod::Sum;
+  else if (method == "Median")
+    m = NodeToElemMethod::Median;
   else
     return false;
 
+  /// Get pointers to the virtual interfaces of the fields
+  /// We need these to obtain the data values
+  VField *ifield = input->vfield();
+  VField *ofield = output->vfield();
+
+  /// Make sure that the data vector has the same length
+  ofield->resize_fdata();
+
+  std::vector<DATA> ivalues;
+  ifield->get_values(ivalues);
+  std::vector<DATA> ovalues(ofield->num_values());
+
+  MapFieldDataFromNodeToElemT<DATA> mapping(algo, m, ivalues, ovalues);
+  dispatch_mesh(input, mapping);
+
+  ofield->set_values(ovalues);
   return true;
 }
 
@@ -272,35 +243,35 @@ FieldHandle MapFieldDataFromNodeToElemAlgo::runImpl(FieldHandle input_field) con
 
   if (input_field->vfield()->is_signed_integer())
   {
-    if (!MapFieldDataFromNodeToElemT<int>(this, input_field, output))
+    if (!MapFieldDataFromNodeToElemV<int>(this, input_field, output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output int field cannot be allocated");
     }
   }
   else if (input_field->vfield()->is_unsigned_integer())
   {
-    if (!MapFieldDataFromNodeToElemT<unsigned int>(this, input_field, output))
+    if (!MapFieldDataFromNodeToElemV<unsigned int>(this, input_field, output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output uint field cannot be allocated");
     }
   }
   else if (input_field->vfield()->is_scalar())
   {
-    if (!MapFieldDataFromNodeToElemT<double>(this, input_field, output))
+    if (!MapFieldDataFromNodeToElemV<double>(this, input_field, output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output scalar field cannot be allocated");
     }
   }
   else if (input_field->vfield()->is_vector())
   {
-    if (!MapFieldDataFromNodeToElemT<Vector>(this, input_field, output))
+    if (!MapFieldDataFromNodeToElemV<Vector>(this, input_field, output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output vector field cannot be allocated");
     }
   }
   else if (input_field->vfield()->is_tensor())
   {
-    if (!MapFieldDataFromNodeToElemT<Tensor>(this, input_field, output))
+    if (!MapFieldDataFromNodeToElemV<Tensor>(this, input_field, output))
     {
       THROW_ALGORITHM_INPUT_ERROR("output tensor field cannot be allocated");
     }
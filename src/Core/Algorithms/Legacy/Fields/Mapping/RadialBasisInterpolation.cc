@@ -0,0 +1,576 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/Mapping/RadialBasisInterpolation.h>
+#include <Core/Utils/Exception.h>
+#include <Core/Thread/Parallel.h>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+ALGORITHM_PARAMETER_DEF(Fields, SupportRadius);
+ALGORITHM_PARAMETER_DEF(Fields, DistanceToNearestNode);
+
+namespace
+{
+  typedef std::array<double, 3> Coords;
+
+  double distance(const Coords& a, const Coords& b)
+  {
+    const double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+
+  double thinPlate(double r)
+  {
+    return r == 0 ? 0 : r * r * std::log(r);
+  }
+
+  double wendland(double r)
+  {
+    if (r >= 1)
+      return 0;
+    const double t = 1 - r;
+    return t * t * t * t * (4 * r + 1);
+  }
+
+  /// Static kd-tree over a point set. Every node keeps the box of space it is
+  /// responsible for; the leaf boxes tile the bounding box of the points.
+  class PointTree
+  {
+  public:
+    struct Node
+    {
+      Coords lo, hi;
+      size_t begin, end;
+      int left {-1}, right {-1};
+    };
+
+    PointTree(const std::vector<Coords>& points, size_t leafSize) : points_(points), index_(points.size())
+    {
+      for (size_t i = 0; i < index_.size(); ++i)
+        index_[i] = i;
+      Node root;
+      root.lo.fill(std::numeric_limits<double>::max());
+      root.hi.fill(-std::numeric_limits<double>::max());
+      for (const auto& p : points_)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          root.lo[k] = std::min(root.lo[k], p[k]);
+          root.hi[k] = std::max(root.hi[k], p[k]);
+        }
+      }
+      root.begin = 0;
+      root.end = points_.size();
+      nodes_.push_back(root);
+      if (!points_.empty())
+        split(0, leafSize);
+    }
+
+    /// Appends the indices of the points within radius of p.
+    void ball(const Coords& p, double radius, std::vector<size_t>& found) const
+    {
+      if (!nodes_.empty() && !points_.empty())
+        ball(0, p, radius, found);
+    }
+
+    /// Closest point to p, optionally ignoring the point with index skip.
+    size_t nearest(const Coords& p, double& best, size_t skip = std::numeric_limits<size_t>::max()) const
+    {
+      best = std::numeric_limits<double>::max();
+      size_t which = 0;
+      if (!points_.empty())
+        nearest(0, p, skip, best, which);
+      return which;
+    }
+
+    std::vector<const Node*> leaves() const
+    {
+      std::vector<const Node*> found;
+      for (const auto& node : nodes_)
+        if (node.left < 0)
+          found.push_back(&node);
+      return found;
+    }
+
+    const std::vector<size_t>& index() const { return index_; }
+
+  private:
+    static double boxDistance(const Node& node, const Coords& p)
+    {
+      double sum = 0;
+      for (int k = 0; k < 3; ++k)
+      {
+        const double d = std::max(std::max(node.lo[k] - p[k], p[k] - node.hi[k]), 0.0);
+        sum += d * d;
+      }
+      return std::sqrt(sum);
+    }
+
+    void split(int which, size_t leafSize)
+    {
+      auto node = nodes_[which];
+      if (node.end - node.begin <= leafSize)
+        return;
+
+      int axis = 0;
+      for (int k = 1; k < 3; ++k)
+        if (node.hi[k] - node.lo[k] > node.hi[axis] - node.lo[axis])
+          axis = k;
+      if (node.hi[axis] <= node.lo[axis])
+        return;
+
+      const auto middle = node.begin + (node.end - node.begin) / 2;
+      std::nth_element(index_.begin() + node.begin, index_.begin() + middle, index_.begin() + node.end,
+        [&](size_t a, size_t b) { return points_[a][axis] < points_[b][axis]; });
+      const double cut = points_[index_[middle]][axis];
+
+      Node left = node, right = node;
+      left.end = right.begin = middle;
+      left.hi[axis] = right.lo[axis] = cut;
+      left.left = left.right = right.left = right.right = -1;
+
+      nodes_.push_back(left);
+      nodes_[which].left = static_cast<int>(nodes_.size()) - 1;
+      nodes_.push_back(right);
+      nodes_[which].right = static_cast<int>(nodes_.size()) - 1;
+      split(nodes_[which].left, leafSize);
+      split(nodes_[which].right, leafSize);
+    }
+
+    void ball(int which, const Coords& p, double radius, std::vector<size_t>& found) const
+    {
+      const auto& node = nodes_[which];
+      if (boxDistance(node, p) > radius)
+        return;
+      if (node.left < 0)
+      {
+        for (auto i = node.begin; i < node.end; ++i)
+          if (distance(points_[index_[i]], p) <= radius)
+            found.push_back(index_[i]);
+        return;
+      }
+      ball(node.left, p, radius, found);
+      ball(node.right, p, radius, found);
+    }
+
+    void nearest(int which, const Coords& p, size_t skip, double& best, size_t& index) const
+    {
+      const auto& node = nodes_[which];
+      if (boxDistance(node, p) >= best)
+        return;
+      if (node.left < 0)
+      {
+        for (auto i = node.begin; i < node.end; ++i)
+        {
+          if (index_[i] == skip)
+            continue;
+          const double d = distance(points_[index_[i]], p);
+          if (d < best)
+          {
+            best = d;
+            index = index_[i];
+          }
+        }
+        return;
+      }
+      const bool leftFirst = boxDistance(nodes_[node.left], p) <= boxDistance(nodes_[node.right], p);
+      nearest(leftFirst ? node.left : node.right, p, skip, best, index);
+      nearest(leftFirst ? node.right : node.left, p, skip, best, index);
+    }
+
+    const std::vector<Coords>& points_;
+    std::vector<size_t> index_;
+    std::vector<Node> nodes_;
+  };
+
+  /// Solves the dense thin-plate system for a set of centres. The matrix has no
+  /// polynomial block, as in the original formulation of the module, and is solved
+  /// with LU. A rank-deficient system (e.g. duplicated centres) falls back to the
+  /// minimum-norm least-squares solution.
+  Eigen::VectorXd solveThinPlate(const std::vector<Coords>& centers, const std::vector<size_t>& which,
+    const std::vector<double>& values, bool parallel)
+  {
+    const auto n = static_cast<Eigen::Index>(which.size());
+    Eigen::MatrixXd sigma(n, n);
+    Eigen::VectorXd rhs(n);
+    auto fillRows = [&](Eigen::Index begin, Eigen::Index end)
+    {
+      for (auto i = begin; i < end; ++i)
+      {
+        for (Eigen::Index j = 0; j < n; ++j)
+          sigma(i, j) = thinPlate(distance(centers[which[i]], centers[which[j]]));
+        rhs(i) = values[which[i]];
+      }
+    };
+    if (parallel)
+    {
+      const int numProcs = static_cast<int>(Parallel::NumCores());
+      Parallel::RunTasks([&](int proc) { fillRows(proc * n / numProcs, (proc + 1) * n / numProcs); }, numProcs);
+    }
+    else
+      fillRows(0, n);
+
+    Eigen::VectorXd coefficients = sigma.partialPivLu().solve(rhs);
+    if (!coefficients.allFinite() || (sigma * coefficients - rhs).norm() > 1e-8 * (1 + rhs.norm()))
+      coefficients = sigma.completeOrthogonalDecomposition().solve(rhs);
+    return coefficients;
+  }
+
+  struct Patch
+  {
+    Coords center;
+    double radius;
+    std::vector<size_t> centers;
+    Eigen::VectorXd coefficients;
+  };
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Fields {
+
+  class RadialBasisInterpolantPrivate
+  {
+  public:
+    // Partition-of-unity patches are built from kd-tree cells holding this many
+    // centres; each local problem also takes in the neighbours its patch overlaps.
+    static const size_t PatchCellSize = 64;
+    static const size_t MinimumPatchCenters = 16;
+
+    RadialBasisInterpolantPrivate(const std::vector<Point>& centers, const std::vector<double>& values,
+      RadialBasisInterpolant::Kernel kernel, double supportRadius) :
+      kernel_(kernel), values_(values), centers_(toCoords(centers)), tree_(centers_, 16)
+    {
+      if (centers.size() != values.size())
+        THROW_INVALID_ARGUMENT("Number of radial basis centres and values differ.");
+      if (centers.empty())
+        THROW_INVALID_ARGUMENT("Radial basis interpolation needs at least one centre.");
+
+      boxMin_ = boxMax_ = centers_[0];
+      for (const auto& c : centers_)
+      {
+        for (int d = 0; d < 3; ++d)
+        {
+          boxMin_[d] = std::min(boxMin_[d], c[d]);
+          boxMax_[d] = std::max(boxMax_[d], c[d]);
+        }
+      }
+
+      if (kernel_ == RadialBasisInterpolant::Kernel::WendlandC2)
+        solveWendland(supportRadius > 0 ? supportRadius : automaticSupportRadius());
+      else if (centers_.size() <= RadialBasisInterpolant::GlobalSolveLimit)
+      {
+        std::vector<size_t> all(centers_.size());
+        for (size_t i = 0; i < all.size(); ++i)
+          all[i] = i;
+        coefficients_ = solveThinPlate(centers_, all, values_, true);
+      }
+      else
+        buildPatches();
+    }
+
+    double evaluate(const Coords& p) const
+    {
+      if (kernel_ == RadialBasisInterpolant::Kernel::WendlandC2)
+      {
+        std::vector<size_t> found;
+        tree_.ball(p, support_, found);
+        double sum = offset_;
+        for (auto j : found)
+          sum += coefficients_(j) * wendland(distance(p, centers_[j]) / support_);
+        return sum;
+      }
+
+      if (patches_.empty())
+      {
+        double sum = 0;
+        for (size_t j = 0; j < centers_.size(); ++j)
+          sum += coefficients_(j) * thinPlate(distance(p, centers_[j]));
+        return sum;
+      }
+
+      std::vector<size_t> found;
+      patchTree_->ball(p, maxPatchRadius_, found);
+      double sum = 0, weights = 0;
+      for (auto k : found)
+      {
+        const auto& patch = patches_[k];
+        const double w = wendland(distance(p, patch.center) / patch.radius);
+        if (w > 0)
+        {
+          sum += w * evaluatePatch(patch, p);
+          weights += w;
+        }
+      }
+      if (weights > 0)
+        return sum / weights;
+
+      // Outside every patch: extrapolate with the closest one.
+      double d;
+      return evaluatePatch(patches_[patchTree_->nearest(p, d)], p);
+    }
+
+    bool usesPartitionOfUnity() const { return !patches_.empty(); }
+
+    double nearestCenterDistance(const Coords& p) const
+    {
+      double d;
+      tree_.nearest(p, d);
+      return d;
+    }
+
+    bool anyCenterFartherThan(const Coords& p, double maxDistance) const
+    {
+      // The farthest corner of the bounding box bounds the distance to every centre
+      double far2 = 0;
+      for (int d = 0; d < 3; ++d)
+      {
+        const double e = std::max(std::abs(p[d] - boxMin_[d]), std::abs(p[d] - boxMax_[d]));
+        far2 += e * e;
+      }
+      if (far2 <= maxDistance * maxDistance)
+        return false;
+
+      for (const auto& c : centers_)
+      {
+        if (distance(p, c) > maxDistance)
+          return true;
+      }
+      return false;
+    }
+
+    static std::vector<Coords> toCoords(const std::vector<Point>& points)
+    {
+      std::vector<Coords> coords(points.size());
+      for (size_t i = 0; i < points.size(); ++i)
+        coords[i] = {{ points[i].x(), points[i].y(), points[i].z() }};
+      return coords;
+    }
+
+    RadialBasisInterpolant::Kernel kernel_;
+    double support_ {0};
+    double offset_ {0};
+
+  private:
+    /// Five times the mean spacing between neighbouring centres, which puts a
+    /// few hundred centres within the support of each one.
+    double automaticSupportRadius() const
+    {
+      const size_t stride = std::max<size_t>(1, centers_.size() / 2048);
+      double sum = 0;
+      size_t counted = 0;
+      for (size_t i = 0; i < centers_.size(); i += stride)
+      {
+        double d;
+        tree_.nearest(centers_[i], d, i);
+        if (d > 0 && d < std::numeric_limits<double>::max())
+        {
+          sum += d;
+          ++counted;
+        }
+      }
+      return counted > 0 ? 5.0 * sum / counted : 1.0;
+    }
+
+    void solveWendland(double support)
+    {
+      support_ = support;
+      const auto n = centers_.size();
+      std::vector<std::vector<Eigen::Triplet<double>>> rows(n);
+      const int numProcs = static_cast<int>(Parallel::NumCores());
+      Parallel::RunTasks([&](int proc)
+      {
+        std::vector<size_t> found;
+        for (size_t i = proc * n / numProcs; i < (proc + 1) * n / numProcs; ++i)
+        {
+          found.clear();
+          tree_.ball(centers_[i], support_, found);
+          for (auto j : found)
+          {
+            // Lower triangle only; SimplicialLDLT reads the lower half.
+            if (j <= i)
+              rows[i].emplace_back(static_cast<int>(i), static_cast<int>(j), wendland(distance(centers_[i], centers_[j]) / support_));
+          }
+        }
+      }, numProcs);
+
+      std::vector<Eigen::Triplet<double>> triplets;
+      for (const auto& row : rows)
+        triplets.insert(triplets.end(), row.begin(), row.end());
+      Eigen::SparseMatrix<double> sigma(n, n);
+      sigma.setFromTriplets(triplets.begin(), triplets.end());
+
+      // A compactly supported interpolant decays to zero away from the centres, so
+      // fit the deviation from the mean value instead of the values themselves.
+      Eigen::VectorXd rhs(n);
+      for (size_t i = 0; i < n; ++i)
+        rhs(i) = values_[i];
+      offset_ = rhs.mean();
+      rhs.array() -= offset_;
+
+      Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> solver(sigma);
+      if (solver.info() != Eigen::Success)
+        THROW_INVALID_STATE("Could not factor the radial basis system; are there duplicate centres?");
+      coefficients_ = solver.solve(rhs);
+    }
+
+    void buildPatches()
+    {
+      PointTree cells(centers_, PatchCellSize);
+      const auto leaves = cells.leaves();
+      patches_.resize(leaves.size());
+
+      double rootDiagonal = 0;
+      for (const auto& c : centers_)
+        rootDiagonal = std::max(rootDiagonal, distance(c, centers_.front()));
+      const double minimumRadius = std::max(1e-6 * rootDiagonal, std::numeric_limits<double>::min());
+
+      const int numProcs = static_cast<int>(Parallel::NumCores());
+      Parallel::RunTasks([&](int proc)
+      {
+        for (size_t k = proc; k < leaves.size(); k += numProcs)
+        {
+          auto& patch = patches_[k];
+          const auto& cell = *leaves[k];
+          double halfDiagonal = 0;
+          for (int d = 0; d < 3; ++d)
+          {
+            patch.center[d] = 0.5 * (cell.lo[d] + cell.hi[d]);
+            halfDiagonal += 0.25 * (cell.hi[d] - cell.lo[d]) * (cell.hi[d] - cell.lo[d]);
+          }
+          // Enlarging the sphere around the cell makes neighbouring patches overlap, so
+          // every point of the bounding box has a positive weight.
+          patch.radius = std::max(1.25 * std::sqrt(halfDiagonal), minimumRadius);
+
+          auto radius = patch.radius;
+          const auto wanted = std::min(MinimumPatchCenters, centers_.size());
+          for (;;)
+          {
+            patch.centers.clear();
+            tree_.ball(patch.center, radius, patch.centers);
+            if (patch.centers.size() >= wanted)
+              break;
+            radius *= 1.5;
+          }
+          patch.coefficients = solveThinPlate(centers_, patch.centers, values_, false);
+        }
+      }, numProcs);
+
+      patchCenters_.resize(patches_.size());
+      for (size_t k = 0; k < patches_.size(); ++k)
+      {
+        patchCenters_[k] = patches_[k].center;
+        maxPatchRadius_ = std::max(maxPatchRadius_, patches_[k].radius);
+      }
+      patchTree_.reset(new PointTree(patchCenters_, 8));
+    }
+
+    double evaluatePatch(const Patch& patch, const Coords& p) const
+    {
+      double sum = 0;
+      for (size_t j = 0; j < patch.centers.size(); ++j)
+        sum += patch.coefficients(j) * thinPlate(distance(p, centers_[patch.centers[j]]));
+      return sum;
+    }
+
+    std::vector<double> values_;
+    std::vector<Coords> centers_;
+    Coords boxMin_, boxMax_;
+    PointTree tree_;
+    Eigen::VectorXd coefficients_;
+    std::vector<Patch> patches_;
+    std::vector<Coords> patchCenters_;
+    boost::shared_ptr<PointTree> patchTree_;
+    double maxPatchRadius_ {0};
+  };
+
+}}}}
+
+RadialBasisInterpolant::RadialBasisInterpolant(const std::vector<Point>& centers, const std::vector<double>& values,
+  Kernel kernel, double supportRadius) :
+  impl_(boost::make_shared<RadialBasisInterpolantPrivate>(centers, values, kernel, supportRadius))
+{
+}
+
+RadialBasisInterpolant::Kernel RadialBasisInterpolant::kernel() const
+{
+  return impl_->kernel_;
+}
+
+double RadialBasisInterpolant::supportRadius() const
+{
+  return impl_->support_;
+}
+
+bool RadialBasisInterpolant::usesPartitionOfUnity() const
+{
+  return impl_->usesPartitionOfUnity();
+}
+
+double RadialBasisInterpolant::evaluate(const Point& p) const
+{
+  return impl_->evaluate({{ p.x(), p.y(), p.z() }});
+}
+
+std::vector<double> RadialBasisInterpolant::evaluate(const std::vector<Point>& points,
+  double maxDistance, double outsideValue, DistanceRule rule) const
+{
+  const auto coords = RadialBasisInterpolantPrivate::toCoords(points);
+  std::vector<double> result(points.size());
+  const bool checkDistance = maxDistance < std::numeric_limits<double>::max();
+  const auto n = points.size();
+  const int numProcs = static_cast<int>(Parallel::NumCores());
+  Parallel::RunTasks([&](int proc)
+  {
+    for (size_t i = proc * n / numProcs; i < (proc + 1) * n / numProcs; ++i)
+    {
+      const bool outside = checkDistance && (rule == DistanceRule::NearestCenter
+        ? impl_->nearestCenterDistance(coords[i]) > maxDistance
+        : impl_->anyCenterFartherThan(coords[i], maxDistance));
+      if (outside)
+        result[i] = outsideValue;
+      else
+        result[i] = impl_->evaluate(coords[i]);
+    }
+  }, numProcs);
+  return result;
+}
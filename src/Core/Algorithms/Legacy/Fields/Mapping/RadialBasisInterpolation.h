@@ -0,0 +1,92 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_MAPPING_RADIALBASISINTERPOLATION_H
+#define CORE_ALGORITHMS_FIELDS_MAPPING_RADIALBASISINTERPOLATION_H 1
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+        ALGORITHM_PARAMETER_DECL(SupportRadius);
+        ALGORITHM_PARAMETER_DECL(DistanceToNearestNode);
+
+        class RadialBasisInterpolantPrivate;
+
+        /// Interpolates scalar values given at scattered centres with radial basis functions.
+        ///
+        /// The thin-plate spline r^2 log(r) is a global kernel. Up to GlobalSolveLimit centres
+        /// its dense system is solved directly, which reproduces the original SVD solution.
+        /// Beyond that the domain is covered by overlapping patches, each with its own small
+        /// thin-plate problem, and the local interpolants are blended with a partition of unity.
+        ///
+        /// The Wendland C2 kernel (1 - r/s)^4 (4r/s + 1) vanishes beyond the support radius s,
+        /// so its system is sparse and positive definite and is factored with a sparse LDLT.
+        class SCISHARE RadialBasisInterpolant
+        {
+        public:
+          enum class Kernel { ThinPlateSpline, WendlandC2 };
+          /// How a point is tested against the maximum distance: AnyCenter gives the outside
+          /// value as soon as one centre is farther away (the original module behaviour),
+          /// NearestCenter only when the closest centre is.
+          enum class DistanceRule { AnyCenter, NearestCenter };
+          static const size_t GlobalSolveLimit = 4000;
+
+          /// A support radius of zero picks one from the spacing of the centres.
+          RadialBasisInterpolant(const std::vector<Geometry::Point>& centers, const std::vector<double>& values,
+            Kernel kernel, double supportRadius = 0);
+
+          Kernel kernel() const;
+          double supportRadius() const;
+          bool usesPartitionOfUnity() const;
+
+          double evaluate(const Geometry::Point& p) const;
+
+          /// Evaluates at all points in parallel. Points that are out of maxDistance under
+          /// the given rule are given outsideValue.
+          std::vector<double> evaluate(const std::vector<Geometry::Point>& points,
+            double maxDistance, double outsideValue, DistanceRule rule = DistanceRule::AnyCenter) const;
+
+        private:
+          boost::shared_ptr<RadialBasisInterpolantPrivate> impl_;
+        };
+
+      }
+    }
+  }
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
 
 #include <Core/GeometryPrimitives/Vector.h>
 
@@ -43,6 +44,67 @@ using namespace SCIRun::Core::Geometry;
 
 ALGORITHM_PARAMETER_DEF(Fields, Method);
 
+namespace
+{
+  /// Sums node centers, element centers or size weighted element centers.
+  /// Instantiated for each mesh class through dispatch_mesh().
+  class SumCenters
+  {
+  public:
+    explicit SumCenters(const std::string& method) :
+      sum(0.0,0.0,0.0), weight(0.0), method_(method) {}
+
+    template <class MESH>
+    void operator()(const MESH& mesh)
+    {
+      if (method_ == "nodeCenter")
+      {
+        typename MESH::Node::size_type numNodes;
+        mesh.size(numNodes);
+        for (VMesh::index_type idx = 0; idx < numNodes; idx++)
+        {
+          Point p;
+          mesh.get_center(p, typename MESH::Node::index_type(idx));
+          sum += p;
+        }
+        weight = static_cast<double>(numNodes);
+      }
+      else if (method_ == "elemCenter")
+      {
+        typename MESH::Elem::size_type numElems;
+        mesh.size(numElems);
+        for (VMesh::index_type idx = 0; idx < numElems; idx++)
+        {
+          Point p;
+          mesh.get_center(p, typename MESH::Elem::index_type(idx));
+          sum += p;
+        }
+        weight = static_cast<double>(numElems);
+      }
+      else if (method_ == "weightedElemCenter")
+      {
+        typename MESH::Elem::size_type numElems;
+        mesh.size(numElems);
+        for (VMesh::index_type idx = 0; idx < numElems; idx++)
+        {
+          Point p;
+          typename MESH::Elem::index_type elem(idx);
+          mesh.get_center(p, elem);
+          double w = fabs(mesh.get_size(elem));
+          sum += w*p;
+          weight += w;
+        }
+      }
+    }
+
+    Point sum;
+    double weight;
+
+  private:
+    const std::string& method_;
+  };
+}
+
 CalculateMeshCenterAlgo::CalculateMeshCenterAlgo()
 {
   // set parameters defaults UI
@@ -83,48 +145,14 @@ AlgorithmOutput CalculateMeshCenterAlgo::run(const AlgorithmInput& input) const
 
   Point center(0.0,0.0,0.0);
 
-  if(method=="nodeCenter")
+  if(method=="nodeCenter" || method=="elemCenter" || method=="weightedElemCenter")
   {
-    Point c(0.0,0.0,0.0);
-    VField::size_type numNodes=imesh->num_nodes();
-    for(VMesh::Node::index_type idx=0;idx<numNodes;idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      c=Point(c+p);
-    }
-    if(numNodes)
-    {
-      center=(c*(1.0/static_cast<double>(numNodes)));
-    }
-  }
-  else if(method=="elemCenter")
-  {
-    Point c(0.0,0.0,0.0);
-    VField::size_type numElems=imesh->num_elems();
-    for(VMesh::Elem::index_type idx=0;idx<numElems;idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      c=Point(c+p);
-    }
-    center=(c*(1.0/static_cast<double>(numElems)));
-  }
-  else if(method=="weightedElemCenter")
-  {
-    Point c(0.0,0.0,0.0);
-    VField::size_type numElems=imesh->num_elems();
-    double size=0.0;
-    double weight;
-    for(VMesh::Elem::index_type idx=0;idx<numElems;idx++)
+    SumCenters sum(method);
+    dispatch_mesh(inputField, sum);
+    if(method!="nodeCenter" || sum.weight > 0.0)
     {
-      Point p;
-      imesh->get_center(p,idx);
-      weight=fabs(imesh->get_size(idx));
-      size+=weight;
-      c=Point(c+weight*p);
+      center=(sum.sum*(1.0/sum.weight));
     }
-    center=(c*(1.0/size));
   }
   else if(method=="boundingBoxCenter")
   {
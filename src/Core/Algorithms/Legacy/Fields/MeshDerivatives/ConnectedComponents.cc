@@ -0,0 +1,132 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ConnectedComponents.h>
+#include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Thread/Parallel.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+ConnectedComponents::ConnectedComponents(size_type size) : parent_(size)
+{
+  for (index_type j = 0; j < size; ++j)
+    parent_[j].store(j, std::memory_order_relaxed);
+}
+
+index_type ConnectedComponents::find(index_type a) const
+{
+  for (;;)
+  {
+    index_type p = parent_[a].load();
+    if (p == a)
+      return a;
+    const index_type gp = parent_[p].load();
+    // Path halving: gp is an ancestor of a, so losing this race is harmless.
+    if (gp != p)
+      parent_[a].compare_exchange_weak(p, gp);
+    a = gp;
+  }
+}
+
+void ConnectedComponents::join(index_type a, index_type b)
+{
+  for (;;)
+  {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return;
+    if (a < b)
+      std::swap(a, b);
+    // Hang the larger root under the smaller one; retry if another thread
+    // attached something to a in the meantime.
+    index_type expected = a;
+    if (parent_[a].compare_exchange_strong(expected, b))
+      return;
+  }
+}
+
+size_type ConnectedComponents::label(std::vector<index_type>& component) const
+{
+  const size_type size = static_cast<size_type>(parent_.size());
+  component.resize(size);
+
+  const int nproc = Parallel::NumCores();
+  auto roots = [&](int proc)
+  {
+    const index_type start = (size*proc)/nproc;
+    const index_type end = (size*(proc+1))/nproc;
+    for (index_type j = start; j < end; ++j)
+      component[j] = find(j);
+  };
+  Parallel::RunTasks(roots, nproc);
+
+  // A root is the smallest index of its set, so it is numbered before any
+  // other member is reached.
+  size_type count = 0;
+  for (index_type j = 0; j < size; ++j)
+    component[j] = (component[j] == j) ? count++ : component[component[j]];
+  return count;
+}
+
+size_type ConnectedComponents::labelElements(VMesh* mesh, std::vector<index_type>& component)
+{
+  const size_type num_elems = mesh->num_elems();
+
+  if (mesh->is_structuredmesh())
+  {
+    component.assign(num_elems, 0);
+    return num_elems > 0 ? 1 : 0;
+  }
+
+  mesh->synchronize(Mesh::NODE_NEIGHBORS_E);
+  const size_type num_nodes = mesh->num_nodes();
+
+  ConnectedComponents sets(num_elems);
+
+  // Every node ties together the elements around it.
+  const int nproc = Parallel::NumCores();
+  auto connect = [&](int proc)
+  {
+    const index_type start = (num_nodes*proc)/nproc;
+    const index_type end = (num_nodes*(proc+1))/nproc;
+    VMesh::Elem::array_type elems;
+    for (VMesh::Node::index_type node = start; node < end; ++node)
+    {
+      mesh->get_elems(elems, node);
+      for (size_t p = 1; p < elems.size(); ++p)
+        sets.join(elems[0], elems[p]);
+    }
+  };
+  Parallel::RunTasks(connect, nproc);
+
+  return sets.label(component);
+}
@@ -0,0 +1,75 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_CONNECTEDCOMPONENTS_H
+#define CORE_ALGORITHMS_FIELDS_MESHDERIVATIVES_CONNECTEDCOMPONENTS_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <boost/noncopyable.hpp>
+#include <atomic>
+#include <vector>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Fields {
+
+  /// Concurrent union-find over the indices 0..size-1.
+  ///
+  /// Sets are always linked under their smaller root, so the root of a set is its
+  /// smallest index no matter in which order or on which threads join() runs. That
+  /// makes the final numbering deterministic: components are numbered in order of
+  /// their smallest member, which is the order a serial flood fill would find them.
+  class SCISHARE ConnectedComponents : boost::noncopyable
+  {
+  public:
+    explicit ConnectedComponents(size_type size);
+
+    /// Merge the sets holding a and b. Safe to call from several threads.
+    void join(index_type a, index_type b);
+    /// Smallest index in the set holding a.
+    index_type find(index_type a) const;
+
+    /// Fill component with the number of the set each index belongs to and return
+    /// the number of sets.
+    size_type label(std::vector<index_type>& component) const;
+
+    /// Components of the elements of a mesh, where elements sharing a node are
+    /// connected. A structured mesh is a single component, so it does not need
+    /// its node neighbors synchronized.
+    static size_type labelElements(VMesh* mesh, std::vector<index_type>& component);
+
+  private:
+    mutable std::vector<std::atomic<index_type> > parent_;
+  };
+
+}}}}
+
+#endif
@@ -29,13 +29,11 @@
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/GetCentroids.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
-#include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
-#include <unordered_map>
-#include <Core/Algorithms/Legacy/Fields/RegisterWithCorrespondences.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
@@ -45,6 +43,48 @@ using namespace SCIRun::Core::Geometry;
 
 ALGORITHM_PARAMETER_DEF(Fields, Centroids);
 
+namespace
+{
+  /// Writes the centers of the nodes, edges, faces, cells, elements or
+  /// delements of a mesh into a point array. Instantiated for each mesh class
+  /// through dispatch_mesh().
+  class CollectCenters
+  {
+  public:
+    CollectCenters(const std::string& centroids, VMesh::size_type num, Point* centers) :
+      centroids_(centroids), num_(num), centers_(centers) {}
+
+    template <class MESH>
+    void operator()(const MESH& mesh)
+    {
+      if (centroids_ == "Node")
+        collect<typename MESH::Node::index_type>(mesh);
+      else if (centroids_ == "Edge")
+        collect<typename MESH::Edge::index_type>(mesh);
+      else if (centroids_ == "Face")
+        collect<typename MESH::Face::index_type>(mesh);
+      else if (centroids_ == "Cell")
+        collect<typename MESH::Cell::index_type>(mesh);
+      else if (centroids_ == "Element")
+        collect<typename MESH::Elem::index_type>(mesh);
+      else if (centroids_ == "DElement")
+        collect<typename MESH::DElem::index_type>(mesh);
+    }
+
+  private:
+    template <class INDEX, class MESH>
+    void collect(const MESH& mesh)
+    {
+      for (VMesh::index_type idx = 0; idx < num_; idx++)
+        mesh.get_center(centers_[idx], INDEX(idx));
+    }
+
+    const std::string& centroids_;
+    VMesh::size_type num_;
+    Point* centers_;
+  };
+}
+
 GetCentroids::GetCentroids()
 {
   addOption(Parameters::Centroids,"Element","Node|Edge|Face|Cell|Element|DElement");
@@ -67,134 +107,66 @@ AlgorithmOutput GetCentroids::run(const AlgorithmInput& input) const
   centroids=getOption(Parameters::Centroids);
 
   VMesh* imesh = inputField->vmesh();
-  MeshHandle mesh = CreateMesh(fo);
-  VMesh* omesh = mesh->vmesh();
 
   AlgorithmOutput outputField;
 
+  VMesh::size_type num_centers = 0;
   if (centroids=="Element")
   {
     imesh->synchronize(Mesh::ELEMS_E);
-    VField::size_type num_elems = imesh->num_elems();
-    omesh->reserve_nodes(num_elems);
-    for (VMesh::Elem::index_type idx=0; idx < num_elems; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
-
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
-
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+    num_centers = imesh->num_elems();
   }
   else if (centroids=="Node")
   {
     imesh->synchronize(Mesh::NODES_E);
-    VMesh::size_type num_nodes = imesh->num_nodes();
-    omesh->reserve_nodes(num_nodes);
-    for (VMesh::Node::index_type idx=0; idx < num_nodes; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
-
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
-
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+    num_centers = imesh->num_nodes();
   }
   else if (centroids=="Edge")
   {
     imesh->synchronize(Mesh::EDGES_E);
-
-    VMesh::size_type num_edges = imesh->num_edges();
-    omesh->reserve_nodes(num_edges);
-    for (VMesh::Edge::index_type idx=0; idx < num_edges; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
-
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
-
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+    num_centers = imesh->num_edges();
   }
   else if (centroids=="Face")
   {
     imesh->synchronize(Mesh::FACES_E);
-    VMesh::Face::size_type num_faces;
-    imesh->size(num_faces);
-    omesh->reserve_nodes(num_faces);
-    for (VMesh::Face::index_type idx=0; idx < num_faces; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
-
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
-
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+    num_centers = imesh->num_faces();
   }
   else if (centroids=="Cell")
   {
     imesh->synchronize(Mesh::CELLS_E);
-    VMesh::size_type num_cells = imesh->num_cells();
-    omesh->reserve_nodes(num_cells);
-    for (VMesh::Cell::index_type idx=0; idx < num_cells; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
-
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+    num_centers = imesh->num_cells();
   }
   else if (centroids=="DElement")
   {
     imesh->synchronize(Mesh::DELEMS_E);
+    num_centers = imesh->num_delems();
+  }
+  else
+  {
+    outputField[Variables::OutputField] = output;
+    return outputField;
+  }
 
-    VMesh::size_type num_delems = imesh->num_delems();
-    omesh->reserve_nodes(num_delems);
+  MeshHandle mesh = CreateMesh(fo);
+  VMesh* omesh = mesh->vmesh();
 
-    for (VMesh::DElem::index_type idx=0; idx < num_delems; idx++)
-    {
-      Point p;
-      imesh->get_center(p,idx);
-      omesh->add_node(p);
-    }
+  // The centers are written straight into the point array of the output
+  // mesh, with the input mesh resolved to its own class for the loop.
+  omesh->resize_nodes(num_centers);
+  if (num_centers > 0)
+  {
+    CollectCenters collect(centroids, num_centers, omesh->get_points_pointer());
+    dispatch_mesh(inputField, collect);
+  }
 
-    output = CreateField(fo,mesh);
-    output->vfield()->resize_values();
+  output = CreateField(fo,mesh);
+  output->vfield()->resize_values();
 
-    if(omesh->num_nodes()==0)
-    {
-      warning("No. of nodes equal to zero! Empty matrix will get generated");
-    }
+  if(omesh->num_nodes()==0)
+  {
+    warning("No. of nodes equal to zero! Empty matrix will get generated");
   }
+
   outputField[Variables::OutputField] = output;
   return outputField;
 }
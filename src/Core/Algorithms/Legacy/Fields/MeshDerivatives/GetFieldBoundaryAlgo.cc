@@ -36,14 +36,16 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/PropertyManagerExtensions.h>
+#include <Core/Thread/Parallel.h>
 
-#include <unordered_map>
+#include <atomic>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 AlgorithmOutputName GetFieldBoundaryAlgo::BoundaryField("BoundaryField");
 AlgorithmOutputName GetFieldBoundaryAlgo::MappingMatrix("Mapping");
@@ -53,23 +55,172 @@ GetFieldBoundaryAlgo::GetFieldBoundaryAlgo()
   addOption(AlgorithmParameterName("mapping"),"auto","auto|node|elem|none");
 }
 
-struct IndexHash
+namespace
 {
-  size_t operator()(const index_type &idx) const
-    { return (static_cast<size_t>(idx)); }
-};
+  /// Exterior faces of a mesh in element order, as the serial walk over the
+  /// elements finds them, with the boundary nodes numbered by first appearance.
+  struct BoundaryFaces
+  {
+    /// Input element owning each face
+    std::vector<index_type> elems;
+    /// Face p uses faceNodes[offsets[p]] up to faceNodes[offsets[p+1]]
+    std::vector<index_type> offsets;
+    /// Output node numbers of the faces
+    std::vector<index_type> faceNodes;
+    /// Input node of each output node
+    std::vector<index_type> nodes;
+  };
+
+  void findBoundaryFaces(VMesh* imesh, BoundaryFaces& boundary)
+  {
+    imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
+
+    const size_type num_elems = imesh->num_elems();
+    const size_type num_nodes = imesh->num_nodes();
+    const int nproc = Parallel::NumCores();
+
+    /// Faces without a neighbor are exterior; every thread collects the faces
+    /// of a contiguous range of elements.
+    std::vector<std::vector<index_type> > chunkElems(nproc), chunkSizes(nproc), chunkNodes(nproc);
+    auto collect = [&](int proc)
+    {
+      const index_type start = (num_elems*proc)/nproc;
+      const index_type end = (num_elems*(proc+1))/nproc;
+      VMesh::DElem::array_type delems;
+      VMesh::Node::array_type inodes;
+      VMesh::Elem::index_type nci;
+      for (VMesh::Elem::index_type ci = start; ci < end; ++ci)
+      {
+        imesh->get_delems(delems, ci);
+        for (size_t p = 0; p < delems.size(); p++)
+        {
+          if (imesh->get_neighbor(nci, ci, delems[p])) continue;
+          imesh->get_nodes(inodes, delems[p]);
+          chunkElems[proc].push_back(ci);
+          chunkSizes[proc].push_back(inodes.size());
+          chunkNodes[proc].insert(chunkNodes[proc].end(), inodes.begin(), inodes.end());
+        }
+      }
+    };
+    Parallel::RunTasks(collect, nproc);
+
+    std::vector<index_type> faceStart(nproc + 1, 0), nodeStart(nproc + 1, 0);
+    for (int proc = 0; proc < nproc; ++proc)
+    {
+      faceStart[proc + 1] = faceStart[proc] + chunkElems[proc].size();
+      nodeStart[proc + 1] = nodeStart[proc] + chunkNodes[proc].size();
+    }
+    const index_type num_faces = faceStart[nproc];
+    const index_type num_corners = nodeStart[nproc];
+
+    boundary.elems.resize(num_faces);
+    boundary.offsets.resize(num_faces + 1);
+    boundary.faceNodes.resize(num_corners);
+    boundary.offsets[num_faces] = num_corners;
+
+    /// First position at which each input node occurs in the face list
+    std::vector<std::atomic<index_type> > first(num_nodes);
+    for (auto& f : first) f.store(num_corners, std::memory_order_relaxed);
+
+    auto concatenate = [&](int proc)
+    {
+      std::copy(chunkElems[proc].begin(), chunkElems[proc].end(), boundary.elems.begin() + faceStart[proc]);
+      std::copy(chunkNodes[proc].begin(), chunkNodes[proc].end(), boundary.faceNodes.begin() + nodeStart[proc]);
+      index_type offset = nodeStart[proc];
+      for (size_t p = 0; p < chunkSizes[proc].size(); ++p)
+      {
+        boundary.offsets[faceStart[proc] + p] = offset;
+        offset += chunkSizes[proc][p];
+      }
+      for (index_type q = nodeStart[proc]; q < nodeStart[proc + 1]; ++q)
+      {
+        auto& f = first[boundary.faceNodes[q]];
+        index_type current = f.load(std::memory_order_relaxed);
+        while (q < current && !f.compare_exchange_weak(current, q, std::memory_order_relaxed)) {}
+      }
+    };
+    Parallel::RunTasks(concatenate, nproc);
+
+    /// Number the nodes by first appearance: count first occurrences per
+    /// range, prefix sum the counts and let every range fill in its part.
+    auto isFirst = [&](index_type q)
+    {
+      return first[boundary.faceNodes[q]].load(std::memory_order_relaxed) == q;
+    };
+    std::vector<index_type> counts(nproc + 1, 0);
+    auto count = [&](int proc)
+    {
+      const index_type start = (num_corners*proc)/nproc;
+      const index_type end = (num_corners*(proc+1))/nproc;
+      for (index_type q = start; q < end; ++q)
+        if (isFirst(q)) counts[proc + 1]++;
+    };
+    Parallel::RunTasks(count, nproc);
+    for (int proc = 0; proc < nproc; ++proc)
+      counts[proc + 1] += counts[proc];
+
+    boundary.nodes.resize(counts[nproc]);
+    std::vector<index_type> renumber(num_nodes);
+    auto number = [&](int proc)
+    {
+      const index_type start = (num_corners*proc)/nproc;
+      const index_type end = (num_corners*(proc+1))/nproc;
+      index_type next = counts[proc];
+      for (index_type q = start; q < end; ++q)
+      {
+        if (isFirst(q))
+        {
+          renumber[boundary.faceNodes[q]] = next;
+          boundary.nodes[next++] = boundary.faceNodes[q];
+        }
+      }
+    };
+    Parallel::RunTasks(number, nproc);
+
+    auto relabel = [&](int proc)
+    {
+      const index_type start = (num_corners*proc)/nproc;
+      const index_type end = (num_corners*(proc+1))/nproc;
+      for (index_type q = start; q < end; ++q)
+        boundary.faceNodes[q] = renumber[boundary.faceNodes[q]];
+    };
+    Parallel::RunTasks(relabel, nproc);
+  }
+
+  void addBoundaryFaces(VMesh* imesh, VMesh* omesh, const BoundaryFaces& boundary)
+  {
+    const index_type num_onodes = boundary.nodes.size();
+    std::vector<Point> points(num_onodes);
+    const int nproc = Parallel::NumCores();
+    auto centers = [&](int proc)
+    {
+      const index_type start = (num_onodes*proc)/nproc;
+      const index_type end = (num_onodes*(proc+1))/nproc;
+      for (index_type q = start; q < end; ++q)
+        imesh->get_center(points[q], VMesh::Node::index_type(boundary.nodes[q]));
+    };
+    Parallel::RunTasks(centers, nproc);
+
+    omesh->node_reserve(num_onodes);
+    for (const auto& point : points)
+      omesh->add_node(point);
+
+    omesh->elem_reserve(boundary.elems.size());
+    VMesh::Node::array_type onodes;
+    for (size_t p = 0; p + 1 < boundary.offsets.size(); ++p)
+    {
+      onodes.assign(boundary.faceNodes.begin() + boundary.offsets[p],
+        boundary.faceNodes.begin() + boundary.offsets[p + 1]);
+      omesh->add_elem(onodes);
+    }
+  }
+}
 
 bool
 GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle& mapping) const
 {
   ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
 
-  /// Define types we need for mapping
-  using hash_map_type = std::unordered_map<index_type,index_type,IndexHash>;
-
-  hash_map_type node_map;
-  hash_map_type elem_map;
-
   /// Check whether we have an input field
   if (!input)
   {
@@ -123,62 +274,9 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle&
   auto ifield = input->vfield();
   auto ofield = output->vfield();
 
-  imesh->synchronize(Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
-
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems;
-  VMesh::Node::array_type inodes;
-  VMesh::Node::array_type onodes;
-  VMesh::Node::index_type a;
-
-  inodes.clear();
-  onodes.clear();
-  Point point;
-
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-
-  imesh->begin(be);
-  imesh->end(ee);
-
-  while (be != ee)
-  {
-
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
-    {
-      auto includeface = false;
-
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
-
-      if (includeface)
-      {
-        imesh->get_nodes(inodes, delems[p]);
-        onodes.resize(inodes.size());
-
-        for (size_t q = 0; q < inodes.size(); q++)
-        {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
-          {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
-        }
-        elem_map[omesh->add_elem(onodes)] = ci;
-      }
-    }
-    ++be;
-  }
+  BoundaryFaces boundary;
+  findBoundaryFaces(imesh, boundary);
+  addBoundaryFaces(imesh, omesh, boundary);
 
   mapping.reset();
 
@@ -209,14 +307,9 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle&
     std::vector<T> tripletList;
     tripletList.reserve(nrows);
 
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.elems.size(); ++p)
     {
-      tripletList.push_back(T(it->first, it->second, 1));
-      ++it;
+      tripletList.push_back(T(p, boundary.elems[p], 1));
     }
     SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
     mat->setFromTriplets(tripletList.begin(), tripletList.end());
@@ -245,14 +338,9 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle&
     std::vector<T> tripletList;
     tripletList.reserve(nrows);
 
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.nodes.size(); ++p)
     {
-      tripletList.push_back(T(it->second, it->first, 1));
-      ++it;
+      tripletList.push_back(T(p, boundary.nodes[p], 1));
     }
     SparseRowMatrixHandle mat(new SparseRowMatrix(nrows, ncols));
     mat->setFromTriplets(tripletList.begin(), tripletList.end());
@@ -261,34 +349,17 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output, MatrixHandle&
 
   if (ifield->basis_order() == 0)
   {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.elems.size(); ++p)
     {
-
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);
-
       /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      ofield->copy_value(ifield,VMesh::Elem::index_type(boundary.elems[p]),VMesh::Elem::index_type(p));
     }
   }
   else if (input->basis_order() == 1)
   {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.nodes.size(); ++p)
     {
-
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      ofield->copy_value(ifield,VMesh::Node::index_type(boundary.nodes[p]),VMesh::Node::index_type(p));
     }
   }
 
@@ -307,12 +378,6 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
 {
   ScopedAlgorithmStatusReporter asr(this, "GetFieldBoundary");
 
-  /// Define types we need for mapping
-  using hash_map_type = std::unordered_map<index_type,index_type,IndexHash>;
-
-  hash_map_type node_map;
-  hash_map_type elem_map;
-
   /// Check whether we have an input field
   if (!input)
   {
@@ -366,92 +431,25 @@ GetFieldBoundaryAlgo::run(FieldHandle input, FieldHandle& output) const
   auto ifield = input->vfield();
   auto ofield = output->vfield();
 
-  imesh->synchronize(Mesh::DELEMS_E|Mesh::ELEM_NEIGHBORS_E);
-
-  /// These are all virtual iterators, virtual index_types and array_types
-  VMesh::Elem::iterator be, ee;
-  VMesh::Elem::index_type nci, ci;
-  VMesh::DElem::array_type delems;
-  VMesh::Node::array_type inodes;
-  VMesh::Node::array_type onodes;
-  VMesh::Node::index_type a;
-
-  inodes.clear();
-  onodes.clear();
-  Point point;
-
-  /// This algorithm was copy from the original dynamic compiled version
-  /// and was slightly adapted to work here:
-
-  imesh->begin(be);
-  imesh->end(ee);
-
-  while (be != ee)
-  {
-
-    ci = *be;
-    imesh->get_delems(delems, ci);
-    for (size_t p = 0; p < delems.size(); p++)
-    {
-      auto includeface = false;
-
-      if (!(imesh->get_neighbor(nci, ci, delems[p]))) includeface = true;
-
-      if (includeface)
-      {
-        imesh->get_nodes(inodes, delems[p]);
-        if (onodes.size() == 0) onodes.resize(inodes.size());
-        for (size_t q = 0; q < onodes.size(); q++)
-        {
-          a = inodes[q];
-          auto it = node_map.find(a);
-          if (it == node_map.end())
-          {
-            imesh->get_center(point, a);
-            onodes[q] = omesh->add_node(point);
-            node_map[a] = onodes[q];
-          }
-          else
-          {
-            onodes[q] = node_map[a];
-          }
-        }
-        elem_map[omesh->add_elem(onodes)] = ci;
-      }
-    }
-    ++be;
-  }
+  BoundaryFaces boundary;
+  findBoundaryFaces(imesh, boundary);
+  addBoundaryFaces(imesh, omesh, boundary);
 
   ofield->resize_fdata();
 
   if (ifield->basis_order() == 0)
   {
-    hash_map_type::iterator it, it_end;
-    it = elem_map.begin();
-    it_end = elem_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.elems.size(); ++p)
     {
-      VMesh::Elem::index_type idx1((*it).second);
-      VMesh::Elem::index_type idx2((*it).first);
-
       /// Copying values
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      ofield->copy_value(ifield,VMesh::Elem::index_type(boundary.elems[p]),VMesh::Elem::index_type(p));
     }
   }
   else if (input->basis_order() == 1)
   {
-    hash_map_type::iterator it, it_end;
-    it = node_map.begin();
-    it_end = node_map.end();
-
-    while (it != it_end)
+    for (size_t p = 0; p < boundary.nodes.size(); ++p)
     {
-      VMesh::Node::index_type idx1((*it).first);
-      VMesh::Node::index_type idx2((*it).second);
-      ofield->copy_value(ifield,idx1,idx2);
-      ++it;
+      ofield->copy_value(ifield,VMesh::Node::index_type(boundary.nodes[p]),VMesh::Node::index_type(p));
     }
   }
 
@@ -28,6 +28,7 @@
 
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Legacy/Fields/MeshDerivatives/SplitByConnectedRegion.h>
+#include <Core/Algorithms/Legacy/Fields/MeshDerivatives/ConnectedComponents.h>
 #include <Core/Algorithms/Legacy/Fields/DomainFields/SplitFieldByDomainAlgo.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
@@ -110,6 +111,7 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
   {
     output.push_back(input);
     remark("Structured meshes consist always of one piece. Hence there is no algorithm to perform.");
+    return output;
   }
 
   if (fi.is_pointcloudmesh())
@@ -120,70 +122,31 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
   VField* ifield = input->vfield();
   VMesh*  imesh  = input->vmesh();
 
-  VField::index_type k = 0;
-
   VMesh::size_type num_nodes = imesh->num_nodes();
   VMesh::size_type num_elems = imesh->num_elems();
 
-  VField::size_type surfsize = static_cast<VField::size_type>(pow(num_elems, 2.0 / 3.0));
-  std::vector<VMesh::Elem::index_type> buffer;
-  buffer.reserve(surfsize);
-
-  imesh->synchronize(Mesh::NODE_NEIGHBORS_E|Mesh::ELEM_NEIGHBORS_E|Mesh::DELEMS_E);
-
-  std::vector<index_type> elemmap(num_elems, 0);
-  std::vector<index_type> nodemap(num_nodes, 0);
-  std::vector<index_type> renumber(num_nodes,0);
-  std::vector<short> visited(num_elems, 0);
+  std::vector<index_type> elemmap;
+  const size_type k = ConnectedComponents::labelElements(imesh, elemmap);
 
+  // Bucket elements and nodes per region in one sweep, in increasing index
+  // order, instead of rescanning the whole mesh for every region.
+  std::vector<std::vector<index_type> > regionelems(k), regionnodes(k);
+  std::vector<index_type> nodemap(num_nodes, -1);
   VMesh::Node::array_type nnodes;
-  VMesh::Elem::array_type neighbors;
-
   for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
   {
-    // if list of elements to process is empty ad the next one
-    if (buffer.size() == 0)
-    {
-      if(visited[idx] == 0) { buffer.push_back(idx); k++; }
-    }
-
-    if (buffer.size() > 0)
-    {
-      for (size_t i=0; i< buffer.size(); i++)
-      {
-        VField::index_type j = buffer[i];
-        if (visited[j] > 0) { continue; }
-        visited[j] = 1;
-
-        imesh->get_nodes(nnodes,buffer[i]);
-        for (size_t q=0; q<nnodes.size(); q++)
-        {
-          imesh->get_elems(neighbors,nnodes[q]);
-          for (size_t p=0; p<neighbors.size(); p++)
-          {
-            if(visited[neighbors[p]] == 0)
-            {
-              buffer.push_back(neighbors[p]);
-              visited[neighbors[p]] = -1;
-            }
-          }
-        }
-
-        if (j >= static_cast<index_type>(elemmap.size())) elemmap.resize(j+1);
-
-        elemmap[j] = k;
-        for (size_t p=0;p<nnodes.size();p++)
-        {
-          if (static_cast<size_t>(nnodes[p]) >= nodemap.size())
-            nodemap.resize(nnodes[p]+1);
-          nodemap[nnodes[p]] = k;
-        }
-      }
-      buffer.clear();
-    }
+    regionelems[elemmap[idx]].push_back(idx);
+    imesh->get_nodes(nnodes,idx);
+    for (size_t p=0; p<nnodes.size(); p++) nodemap[nnodes[p]] = elemmap[idx];
+  }
+  for (VMesh::Node::index_type idx=0; idx<num_nodes; idx++)
+  {
+    if (nodemap[idx] >= 0) regionnodes[nodemap[idx]].push_back(idx);
   }
 
- output.resize(k);
+  std::vector<index_type> renumber(num_nodes,0);
+
+  output.resize(k);
   for (size_type p=0; p<k; p++)
   {
     VField* ofield;
@@ -191,11 +154,8 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     MeshHandle mesh;
     FieldHandle field;
 
-    VField::size_type nn = 0;
-    VField::size_type ne = 0;
-
-    for (VField::index_type q=0;q<num_nodes;q++) if (nodemap[q] == p+1) nn++;
-    for (VField::index_type q=0;q<num_elems;q++) if (elemmap[q] == p+1) ne++;
+    const std::vector<index_type>& nodes = regionnodes[p];
+    const std::vector<index_type>& elems = regionelems[p];
 
     mesh = CreateMesh(fi);
     if (!mesh)
@@ -204,8 +164,8 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     }
     omesh = mesh->vmesh();
 
-    omesh->node_reserve(nn);
-    omesh->elem_reserve(ne);
+    omesh->node_reserve(nodes.size());
+    omesh->elem_reserve(elems.size());
 
     field = CreateField(fi,mesh);
     if (field == nullptr)
@@ -217,27 +177,21 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     output[p] = field;
 
     Point point;
-    for (index_type q=0;q<num_nodes;q++)
+    for (auto q : nodes)
     {
-      if (nodemap[q] == p+1)
-      {
-        imesh->get_center(point,VMesh::Node::index_type(q));
-        renumber[q] = omesh->add_point(point);
-      }
+      imesh->get_center(point,VMesh::Node::index_type(q));
+      renumber[q] = omesh->add_point(point);
     }
 
     VMesh::Node::array_type elemnodes;
-    for (index_type q=0;q<num_elems;q++)
+    for (auto q : elems)
     {
-      if (elemmap[q] == p+1)
+      imesh->get_nodes(elemnodes,VMesh::Elem::index_type(q));
+      for (size_t r=0; r< elemnodes.size(); r++)
       {
-        imesh->get_nodes(elemnodes,VMesh::Elem::index_type(q));
-        for (size_t r=0; r< elemnodes.size(); r++)
-        {
-          elemnodes[r] = VMesh::Node::index_type(renumber[elemnodes[r]]);
-        }
-        omesh->add_elem(elemnodes);
+        elemnodes[r] = VMesh::Node::index_type(renumber[elemnodes[r]]);
       }
+      omesh->add_elem(elemnodes);
     }
 
     ofield->resize_fdata();
@@ -245,24 +199,18 @@ std::vector<FieldHandle> SplitFieldByConnectedRegionAlgo::run(FieldHandle input)
     if (ifield->basis_order() == 1)
     {
       VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_nodes;q++)
+      for (auto q : nodes)
       {
-        if (nodemap[q] == p+1)
-        {
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
+        ofield->copy_value(ifield,q,qq); qq++;
       }
     }
 
     if (ifield->basis_order() == 0)
     {
       VField::index_type qq = 0;
-      for (VField::index_type q=0;q<num_elems;q++)
+      for (auto q : elems)
       {
-        if (elemmap[q] == p+1)
-        {
-          ofield->copy_value(ifield,q,qq); qq++;
-        }
+        ofield->copy_value(ifield,q,qq); qq++;
       }
     }
 
@@ -0,0 +1,123 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/NodePairTable.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Thread/TaskPool.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  bool entry_less(const NodePairTable::Entry& a, const NodePairTable::Entry& b)
+  {
+    if (a.second != b.second) return a.second < b.second;
+    return a.source < b.source;
+  }
+}
+
+NodePairTable::NodePairTable(std::vector<entry_list_type>& lists, VMesh::size_type num_nodes)
+  : offsets_(num_nodes + 1, 0)
+{
+  const int nproc = Parallel::NumCores();
+  const int nlists = static_cast<int>(lists.size());
+
+  // Bucket the entries by first node: count, prefix sum, scatter.
+  std::vector<std::atomic<VMesh::index_type> > cursor(num_nodes);
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    for (int l = proc; l < nlists; l += nproc)
+      for (const auto& e : lists[l])
+        cursor[e.first].fetch_add(1, std::memory_order_relaxed);
+  }, nproc);
+
+  std::vector<VMesh::index_type> start(num_nodes + 1, 0);
+  for (VMesh::index_type j = 0; j < num_nodes; j++)
+  {
+    start[j + 1] = start[j] + cursor[j].load(std::memory_order_relaxed);
+    cursor[j].store(start[j], std::memory_order_relaxed);
+  }
+
+  std::vector<Entry> bucketed(start[num_nodes]);
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    for (int l = proc; l < nlists; l += nproc)
+    {
+      for (const auto& e : lists[l])
+        bucketed[cursor[e.first].fetch_add(1, std::memory_order_relaxed)] = e;
+      entry_list_type().swap(lists[l]);
+    }
+  }, nproc);
+
+  // Sort each bucket and keep the first entry of every pair. The order within
+  // a bucket after the scatter is arbitrary; sorting on source as well makes
+  // the surviving entry deterministic.
+  std::vector<VMesh::index_type> unique(num_nodes, 0);
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type node_start = (num_nodes*proc)/nproc;
+    const VMesh::index_type node_end = (num_nodes*(proc+1))/nproc;
+    for (VMesh::index_type j = node_start; j < node_end; j++)
+    {
+      auto first = bucketed.begin() + start[j];
+      auto last = bucketed.begin() + start[j + 1];
+      std::sort(first, last, entry_less);
+      unique[j] = std::unique(first, last,
+        [](const Entry& a, const Entry& b) { return a.second == b.second; }) - first;
+    }
+  }, nproc);
+
+  for (VMesh::index_type j = 0; j < num_nodes; j++)
+    offsets_[j + 1] = offsets_[j] + unique[j];
+
+  entries_.resize(offsets_[num_nodes]);
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type node_start = (num_nodes*proc)/nproc;
+    const VMesh::index_type node_end = (num_nodes*(proc+1))/nproc;
+    for (VMesh::index_type j = node_start; j < node_end; j++)
+      std::copy(bucketed.begin() + start[j], bucketed.begin() + start[j] + unique[j],
+        entries_.begin() + offsets_[j]);
+  }, nproc);
+}
+
+VMesh::index_type NodePairTable::find(VMesh::index_type first, VMesh::index_type second) const
+{
+  const auto begin = entries_.begin() + offsets_[first];
+  const auto end = entries_.begin() + offsets_[first + 1];
+  const auto it = std::lower_bound(begin, end, second,
+    [](const Entry& e, VMesh::index_type value) { return e.second < value; });
+  if (it == end || it->second != second) return -1;
+  return static_cast<VMesh::index_type>(it - entries_.begin());
+}
@@ -0,0 +1,82 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_ALGORITHMS_FIELDS_REFINEMESH_NODEPAIRTABLE_H
+#define CORE_ALGORITHMS_FIELDS_REFINEMESH_NODEPAIRTABLE_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <vector>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun{
+  namespace Core{
+    namespace Algorithms{
+      namespace Fields{
+
+        /// Numbers the new nodes a refinement places on node pairs (edges, face
+        /// diagonals) of the input mesh.
+        ///
+        /// Pairs are gathered per thread, then sorted by first node, second node and
+        /// source, and made unique. The numbering therefore depends only on the mesh,
+        /// not on which thread saw a pair first, and every pair keeps the smallest
+        /// source that reported it. Pairs are ordered, so (a,b) and (b,a) are
+        /// different entries.
+        class SCISHARE NodePairTable
+        {
+        public:
+          struct Entry
+          {
+            VMesh::index_type first;
+            VMesh::index_type second;
+            /// Caller-defined tag, e.g. the element that needs the new node.
+            VMesh::index_type source;
+          };
+          typedef std::vector<Entry> entry_list_type;
+
+          /// Build the table from one list of entries per thread; the lists are
+          /// cleared. All first nodes must be smaller than num_nodes.
+          NodePairTable(std::vector<entry_list_type>& lists, VMesh::size_type num_nodes);
+
+          VMesh::size_type size() const { return static_cast<VMesh::size_type>(entries_.size()); }
+          const Entry& operator[](VMesh::index_type idx) const { return entries_[idx]; }
+
+          /// Index of the pair (first, second), or -1 if it is not in the table.
+          VMesh::index_type find(VMesh::index_type first, VMesh::index_type second) const;
+
+        private:
+          std::vector<VMesh::index_type> offsets_;
+          std::vector<Entry> entries_;
+        };
+
+      }
+    }
+  }
+}
+
+#endif
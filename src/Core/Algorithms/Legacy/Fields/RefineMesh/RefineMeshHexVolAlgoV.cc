@@ -35,9 +35,13 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/NodePairTable.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Thread/TaskPool.h>
 
 //STL classes needed
 #include <algorithm>
+#include <atomic>
 #include <set>
 
 using namespace SCIRun;
@@ -46,6 +50,7 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 
 int pattern_table[256][2];
 SCIRun::Core::Geometry::Point hcoords[8];
@@ -263,37 +268,6 @@ VMesh::Node::index_type RefineMeshHexVolAlgoV::add_point(VMesh *refined,
       return refined->add_point(inbetween);
     };
 
-VMesh::Node::index_type RefineMeshHexVolAlgoV::add_point_convex(VMesh *refined,
-                                      VMesh::Node::array_type &nodes,
-                                      const int *reorder,
-                                      VMesh::index_type a,
-                                      VMesh::index_type b,
-                                      std::vector<double>& ivalues,
-                                      int basis_order) const
-    {
-      VMesh::index_type ra = reorder[a];
-      VMesh::index_type rb = reorder[b];
-      Point coordsp = Interpolate(hcoords[ra], hcoords[rb], 1.0/3.0);
-
-      const Point inbetween = RIinterpolate(refined, nodes, coordsp);
-
-      if (basis_order == 1) ivalues.push_back(RIinterpolateV(ivalues,nodes,coordsp));
-      return refined->add_point(inbetween);
-    };
-
-
-VMesh::Node::index_type RefineMeshHexVolAlgoV::add_point_convex(VMesh *refined,
-                                      VMesh::Node::array_type &nodes,
-                                      const Point& coordsp,
-                                      std::vector<double>& ivalues,
-                                      int basis_order) const
-    {
-      const Point inbetween = RIinterpolate(refined, nodes, coordsp);
-      if (basis_order == 1) ivalues.push_back(RIinterpolateV(ivalues,nodes,coordsp));
-      return refined->add_point(inbetween);
-    };
-
-
 VMesh::Node::index_type RefineMeshHexVolAlgoV::lookup(VMesh *refined,
                                    edge_hash_type &edgemap,
                                    VMesh::Node::array_type &nodes,
@@ -321,32 +295,6 @@ VMesh::Node::index_type RefineMeshHexVolAlgoV::lookup(VMesh *refined,
       }
     };
 
-VMesh::Node::index_type RefineMeshHexVolAlgoV::lookup_convex(VMesh *refined,
-                                   edge_hash_type &edgemap,
-                                   VMesh::Node::array_type &onodes,
-                                   const int *reorder,
-                                   VMesh::index_type a,
-                                   VMesh::index_type b,
-                                   std::vector<double>& ivalues,
-                                   int basis_order) const
-    {
-      edgepair_t ep;
-      ep.first = onodes[reorder[a]];
-      ep.second = onodes[reorder[b]];
-      const edge_hash_type::iterator loc = edgemap.find(ep);
-      if (loc == edgemap.end())
-      {
-        const VMesh::Node::index_type newnode =
-          add_point_convex(refined, onodes, reorder, a, b, ivalues, basis_order);
-        edgemap[ep] = newnode;
-        return newnode;
-      }
-      else
-      {
-        return (*loc).second;
-      }
-    };
-
 void
 RefineMeshHexVolAlgoV::dice(VMesh *refined,
                            edge_hash_type &emap,
@@ -501,6 +449,886 @@ RefineMeshHexVolAlgoV::dice(VMesh *refined,
   }
 }
 
+namespace
+{
+  // Convex split of one hex, following the pattern from pattern_table. New
+  // nodes come from the builder:
+  //   shared(onodes, ro, a, b)   node a third of the way from corner ro[a] to
+  //                              ro[b], shared with the neighbors of the pair
+  //   interior(onodes, ...)      node inside the element, at the given local
+  //                              coordinates
+  // and each child hex is passed to builder.elem(). Returns false if the
+  // pattern cannot be split.
+  template <class BUILDER>
+  bool split_hex_convex(BUILDER& builder, VMesh::Node::array_type& onodes,
+                        int pattern, int which)
+  {
+    VMesh::Node::array_type nnodes(8);
+
+    if (pattern == 0)
+    {
+      // Nodes are the same order, so just add the element.
+      builder.elem(onodes);
+    }
+    else if (pattern == 1)
+    {
+      const int *ro = hex_reorder_table[which];
+
+      VMesh::Node::index_type i06node =
+          builder.interior(onodes, ro, 0, 6);
+
+      // Add this corner.
+      nnodes[0] = onodes[ro[0]];
+      nnodes[1] = builder.shared(onodes, ro, 0, 1);
+      nnodes[2] = builder.shared(onodes, ro, 0, 2);
+      nnodes[3] = builder.shared(onodes, ro, 0, 3);
+      nnodes[4] = builder.shared(onodes, ro, 0, 4);
+      nnodes[5] = builder.shared(onodes, ro, 0, 5);
+      nnodes[6] = i06node;
+      nnodes[7] = builder.shared(onodes, ro, 0, 7);
+      builder.elem(nnodes);
+
+      // Add the other three pieces.
+      nnodes[0] = builder.shared(onodes, ro, 0, 1);
+      nnodes[1] = onodes[ro[1]];
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = builder.shared(onodes, ro, 0, 2);
+      nnodes[4] = builder.shared(onodes, ro, 0, 5);
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = i06node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 3);
+      nnodes[1] = builder.shared(onodes, ro, 0, 2);
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = onodes[ro[3]];
+      nnodes[4] = builder.shared(onodes, ro, 0, 7);
+      nnodes[5] = i06node;
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 4);
+      nnodes[1] = builder.shared(onodes, ro, 0, 5);
+      nnodes[2] = i06node;
+      nnodes[3] = builder.shared(onodes, ro, 0, 7);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+    }
+    else if (pattern == 2)
+    {
+      const int *ro = hex_reorder_table[which];
+
+     VMesh::Node::index_type i06node =
+        builder.interior(onodes, ro, 0, 6);
+     VMesh::Node::index_type i17node =
+        builder.interior(onodes, ro, 1, 7);
+     VMesh::Node::index_type i60node =
+        builder.interior(onodes, ro, 6, 0);
+     VMesh::Node::index_type i71node =
+        builder.interior(onodes, ro, 7, 1);
+
+      // Leading edge.
+      nnodes[0] = onodes[ro[0]];
+      nnodes[1] = builder.shared(onodes, ro, 0, 1);
+      nnodes[2] = builder.shared(onodes, ro, 0, 2);
+      nnodes[3] = builder.shared(onodes, ro, 0, 3);
+      nnodes[4] = builder.shared(onodes, ro, 0, 4);
+      nnodes[5] = builder.shared(onodes, ro, 0, 5);
+      nnodes[6] = i06node;
+      nnodes[7] = builder.shared(onodes, ro, 0, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 1);
+      nnodes[1] = builder.shared(onodes, ro, 1, 0);
+      nnodes[2] = builder.shared(onodes, ro, 1, 3);
+      nnodes[3] = builder.shared(onodes, ro, 0, 2);
+      nnodes[4] = builder.shared(onodes, ro, 0, 5);
+      nnodes[5] = builder.shared(onodes, ro, 1, 4);
+      nnodes[6] = i17node;
+      nnodes[7] = i06node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 0);
+      nnodes[1] = onodes[ro[1]];
+      nnodes[2] = builder.shared(onodes, ro, 1, 2);
+      nnodes[3] = builder.shared(onodes, ro, 1, 3);
+      nnodes[4] = builder.shared(onodes, ro, 1, 4);
+      nnodes[5] = builder.shared(onodes, ro, 1, 5);
+      nnodes[6] = builder.shared(onodes, ro, 1, 6);
+      nnodes[7] = i17node;
+      builder.elem(nnodes);
+
+      // Top center
+      nnodes[0] = builder.shared(onodes, ro, 0, 3);
+      nnodes[1] = builder.shared(onodes, ro, 0, 2);
+      nnodes[2] = builder.shared(onodes, ro, 3, 1);
+      nnodes[3] = onodes[ro[3]];
+      nnodes[4] = builder.shared(onodes, ro, 0, 7);
+      nnodes[5] = i06node;
+      nnodes[6] = i71node;
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 2);
+      nnodes[1] = builder.shared(onodes, ro, 1, 3);
+      nnodes[2] = builder.shared(onodes, ro, 2, 0);
+      nnodes[3] = builder.shared(onodes, ro, 3, 1);
+      nnodes[4] = i06node;
+      nnodes[5] = i17node;
+      nnodes[6] = i60node;
+      nnodes[7] = i71node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 3);
+      nnodes[1] = builder.shared(onodes, ro, 1, 2);
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = builder.shared(onodes, ro, 2, 0);
+      nnodes[4] = i17node;
+      nnodes[5] = builder.shared(onodes, ro, 1, 6);
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = i60node;
+      builder.elem(nnodes);
+
+      // Front Center
+      nnodes[0] = builder.shared(onodes, ro, 0, 4);
+      nnodes[1] = builder.shared(onodes, ro, 0, 5);
+      nnodes[2] = i06node;
+      nnodes[3] = builder.shared(onodes, ro, 0, 7);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = builder.shared(onodes, ro, 4, 1);
+      nnodes[6] = i71node;
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 5);
+      nnodes[1] = builder.shared(onodes, ro, 1, 4);
+      nnodes[2] = i17node;
+      nnodes[3] = i06node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 1);
+      nnodes[5] = builder.shared(onodes, ro, 5, 0);
+      nnodes[6] = i60node;
+      nnodes[7] = i71node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 4);
+      nnodes[1] = builder.shared(onodes, ro, 1, 5);
+      nnodes[2] = builder.shared(onodes, ro, 1, 6);
+      nnodes[3] = i17node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 0);
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = i60node;
+      builder.elem(nnodes);
+
+      // Outside wedges
+      nnodes[0] = builder.shared(onodes, ro, 3, 1);
+      nnodes[1] = builder.shared(onodes, ro, 2, 0);
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = onodes[ro[3]];
+      nnodes[4] = i71node;
+      nnodes[5] = i60node;
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 4, 1);
+      nnodes[1] = builder.shared(onodes, ro, 5, 0);
+      nnodes[2] = i60node;
+      nnodes[3] = i71node;
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+    }
+    else if (pattern == 4)
+    {
+      const int *ro = hex_reorder_table[which];
+
+      // Interior
+     VMesh::Node::index_type i06node =
+        builder.interior(onodes, ro, 0, 6);
+     VMesh::Node::index_type i17node =
+        builder.interior(onodes, ro, 1, 7);
+     VMesh::Node::index_type i24node =
+        builder.interior(onodes, ro, 2, 4);
+     VMesh::Node::index_type i35node =
+        builder.interior(onodes, ro, 3, 5);
+
+
+      const Point i06 = Interpolate(hcoords[ro[0]], hcoords[ro[6]], 1.0/3.0);
+      const Point i17 = Interpolate(hcoords[ro[1]], hcoords[ro[7]], 1.0/3.0);
+      const Point i24 = Interpolate(hcoords[ro[2]], hcoords[ro[4]], 1.0/3.0);
+      const Point i35 = Interpolate(hcoords[ro[3]], hcoords[ro[5]], 1.0/3.0);
+      const Point i42a = Interpolate(hcoords[ro[4]], hcoords[ro[2]], 1.0/3.0);
+      const Point i53a = Interpolate(hcoords[ro[5]], hcoords[ro[3]], 1.0/3.0);
+      const Point i60a = Interpolate(hcoords[ro[6]], hcoords[ro[0]], 1.0/3.0);
+      const Point i71a = Interpolate(hcoords[ro[7]], hcoords[ro[1]], 1.0/3.0);
+      const Point i42 = Interpolate(i06, i42a, 0.5);
+      const Point i53 = Interpolate(i17, i53a, 0.5);
+      const Point i60 = Interpolate(i24, i60a, 0.5);
+      const Point i71 = Interpolate(i35, i71a, 0.5);
+
+     VMesh::Node::index_type i42node =
+        builder.interior(onodes, i42);
+     VMesh::Node::index_type i53node =
+        builder.interior(onodes, i53);
+     VMesh::Node::index_type i60node =
+        builder.interior(onodes, i60);
+     VMesh::Node::index_type i71node =
+        builder.interior(onodes, i71);
+
+      // Top Front
+      nnodes[0] = onodes[ro[0]];
+      nnodes[1] = builder.shared(onodes, ro, 0, 1);
+      nnodes[2] = builder.shared(onodes, ro, 0, 2);
+      nnodes[3] = builder.shared(onodes, ro, 0, 3);
+      nnodes[4] = builder.shared(onodes, ro, 0, 4);
+      nnodes[5] = builder.shared(onodes, ro, 0, 5);
+      nnodes[6] = i06node;
+      nnodes[7] = builder.shared(onodes, ro, 0, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 1);
+      nnodes[1] = builder.shared(onodes, ro, 1, 0);
+      nnodes[2] = builder.shared(onodes, ro, 1, 3);
+      nnodes[3] = builder.shared(onodes, ro, 0, 2);
+      nnodes[4] = builder.shared(onodes, ro, 0, 5);
+      nnodes[5] = builder.shared(onodes, ro, 1, 4);
+      nnodes[6] = i17node;
+      nnodes[7] = i06node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 0);
+      nnodes[1] = onodes[ro[1]];
+      nnodes[2] = builder.shared(onodes, ro, 1, 2);
+      nnodes[3] = builder.shared(onodes, ro, 1, 3);
+      nnodes[4] = builder.shared(onodes, ro, 1, 4);
+      nnodes[5] = builder.shared(onodes, ro, 1, 5);
+      nnodes[6] = builder.shared(onodes, ro, 1, 6);
+      nnodes[7] = i17node;
+      builder.elem(nnodes);
+
+      // Top Center
+      nnodes[0] = builder.shared(onodes, ro, 0, 3);
+      nnodes[1] = builder.shared(onodes, ro, 0, 2);
+      nnodes[2] = builder.shared(onodes, ro, 3, 1);
+      nnodes[3] = builder.shared(onodes, ro, 3, 0);
+      nnodes[4] = builder.shared(onodes, ro, 0, 7);
+      nnodes[5] = i06node;
+      nnodes[6] = i35node;
+      nnodes[7] = builder.shared(onodes, ro, 3, 4);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 2);
+      nnodes[1] = builder.shared(onodes, ro, 1, 3);
+      nnodes[2] = builder.shared(onodes, ro, 2, 0);
+      nnodes[3] = builder.shared(onodes, ro, 3, 1);
+      nnodes[4] = i06node;
+      nnodes[5] = i17node;
+      nnodes[6] = i24node;
+      nnodes[7] = i35node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 3);
+      nnodes[1] = builder.shared(onodes, ro, 1, 2);
+      nnodes[2] = builder.shared(onodes, ro, 2, 1);
+      nnodes[3] = builder.shared(onodes, ro, 2, 0);
+      nnodes[4] = i17node;
+      nnodes[5] = builder.shared(onodes, ro, 1, 6);
+      nnodes[6] = builder.shared(onodes, ro, 2, 5);
+      nnodes[7] = i24node;
+      builder.elem(nnodes);
+
+      // Top Back
+      nnodes[0] = builder.shared(onodes, ro, 3, 0);
+      nnodes[1] = builder.shared(onodes, ro, 3, 1);
+      nnodes[2] = builder.shared(onodes, ro, 3, 2);
+      nnodes[3] = onodes[ro[3]];
+      nnodes[4] = builder.shared(onodes, ro, 3, 4);
+      nnodes[5] = i35node;
+      nnodes[6] = builder.shared(onodes, ro, 3, 6);
+      nnodes[7] = builder.shared(onodes, ro, 3, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 3, 1);
+      nnodes[1] = builder.shared(onodes, ro, 2, 0);
+      nnodes[2] = builder.shared(onodes, ro, 2, 3);
+      nnodes[3] = builder.shared(onodes, ro, 3, 2);
+      nnodes[4] = i35node;
+      nnodes[5] = i24node;
+      nnodes[6] = builder.shared(onodes, ro, 2, 7);
+      nnodes[7] = builder.shared(onodes, ro, 3, 6);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 2, 0);
+      nnodes[1] = builder.shared(onodes, ro, 2, 1);
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = builder.shared(onodes, ro, 2, 3);
+      nnodes[4] = i24node;
+      nnodes[5] = builder.shared(onodes, ro, 2, 5);
+      nnodes[6] = builder.shared(onodes, ro, 2, 6);
+      nnodes[7] = builder.shared(onodes, ro, 2, 7);
+      builder.elem(nnodes);
+
+      // Front
+      nnodes[0] = builder.shared(onodes, ro, 0, 4);
+      nnodes[1] = builder.shared(onodes, ro, 0, 5);
+      nnodes[2] = i06node;
+      nnodes[3] = builder.shared(onodes, ro, 0, 7);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = builder.shared(onodes, ro, 4, 1);
+      nnodes[6] = i42node;
+      nnodes[7] = builder.shared(onodes, ro, 4, 3);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 5);
+      nnodes[1] = builder.shared(onodes, ro, 1, 4);
+      nnodes[2] = i17node;
+      nnodes[3] = i06node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 1);
+      nnodes[5] = builder.shared(onodes, ro, 5, 0);
+      nnodes[6] = i53node;
+      nnodes[7] = i42node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 4);
+      nnodes[1] = builder.shared(onodes, ro, 1, 5);
+      nnodes[2] = builder.shared(onodes, ro, 1, 6);
+      nnodes[3] = i17node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 0);
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = builder.shared(onodes, ro, 5, 2);
+      nnodes[7] = i53node;
+      builder.elem(nnodes);
+
+      // Center
+      nnodes[0] = builder.shared(onodes, ro, 0, 7);
+      nnodes[1] = i06node;
+      nnodes[2] = i35node;
+      nnodes[3] = builder.shared(onodes, ro, 3, 4);
+      nnodes[4] = builder.shared(onodes, ro, 4, 3);
+      nnodes[5] = i42node;
+      nnodes[6] = i71node;
+      nnodes[7] = builder.shared(onodes, ro, 7, 0);
+      builder.elem(nnodes);
+
+      nnodes[0] = i06node;
+      nnodes[1] = i17node;
+      nnodes[2] = i24node;
+      nnodes[3] = i35node;
+      nnodes[4] = i42node;
+      nnodes[5] = i53node;
+      nnodes[6] = i60node;
+      nnodes[7] = i71node;
+      builder.elem(nnodes);
+
+      nnodes[0] = i17node;
+      nnodes[1] = builder.shared(onodes, ro, 1, 6);
+      nnodes[2] = builder.shared(onodes, ro, 2, 5);
+      nnodes[3] = i24node;
+      nnodes[4] = i53node;
+      nnodes[5] = builder.shared(onodes, ro, 5, 2);
+      nnodes[6] = builder.shared(onodes, ro, 6, 1);
+      nnodes[7] = i60node;
+      builder.elem(nnodes);
+
+      // Back
+      nnodes[0] = builder.shared(onodes, ro, 3, 4);
+      nnodes[1] = i35node;
+      nnodes[2] = builder.shared(onodes, ro, 3, 6);
+      nnodes[3] = builder.shared(onodes, ro, 3, 7);
+      nnodes[4] = builder.shared(onodes, ro, 7, 0);
+      nnodes[5] = i71node;
+      nnodes[6] = builder.shared(onodes, ro, 7, 2);
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = i35node;
+      nnodes[1] = i24node;
+      nnodes[2] = builder.shared(onodes, ro, 2, 7);
+      nnodes[3] = builder.shared(onodes, ro, 3, 6);
+      nnodes[4] = i71node;
+      nnodes[5] = i60node;
+      nnodes[6] = builder.shared(onodes, ro, 6, 3);
+      nnodes[7] = builder.shared(onodes, ro, 7, 2);
+      builder.elem(nnodes);
+
+      nnodes[0] = i24node;
+      nnodes[1] = builder.shared(onodes, ro, 2, 5);
+      nnodes[2] = builder.shared(onodes, ro, 2, 6);
+      nnodes[3] = builder.shared(onodes, ro, 2, 7);
+      nnodes[4] = i60node;
+      nnodes[5] = builder.shared(onodes, ro, 6, 1);
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = builder.shared(onodes, ro, 6, 3);
+      builder.elem(nnodes);
+
+      // Bottom Center
+      nnodes[0] = builder.shared(onodes, ro, 4, 3);
+      nnodes[1] = i42node;
+      nnodes[2] = i71node;
+      nnodes[3] = builder.shared(onodes, ro, 7, 0);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = builder.shared(onodes, ro, 4, 1);
+      nnodes[6] = builder.shared(onodes, ro, 7, 2);
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = i42node;
+      nnodes[1] = i53node;
+      nnodes[2] = i60node;
+      nnodes[3] = i71node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 1);
+      nnodes[5] = builder.shared(onodes, ro, 5, 0);
+      nnodes[6] = builder.shared(onodes, ro, 6, 3);
+      nnodes[7] = builder.shared(onodes, ro, 7, 2);
+      builder.elem(nnodes);
+
+      nnodes[0] = i53node;
+      nnodes[1] = builder.shared(onodes, ro, 5, 2);
+      nnodes[2] = builder.shared(onodes, ro, 6, 1);
+      nnodes[3] = i60node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 0);
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = builder.shared(onodes, ro, 6, 3);
+      builder.elem(nnodes);
+
+      // Bottom
+      nnodes[0] = builder.shared(onodes, ro, 4, 1);
+      nnodes[1] = builder.shared(onodes, ro, 5, 0);
+      nnodes[2] = builder.shared(onodes, ro, 6, 3);
+      nnodes[3] = builder.shared(onodes, ro, 7, 2);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+    }
+    else if (pattern == 8)
+    {
+      const int *ro = hex_reorder_table[which];
+
+      // Interior
+     VMesh::Node::index_type i06node =
+        builder.interior(onodes, ro, 0, 6);
+     VMesh::Node::index_type i17node =
+        builder.interior(onodes, ro, 1, 7);
+     VMesh::Node::index_type i24node =
+        builder.interior(onodes, ro, 2, 4);
+     VMesh::Node::index_type i35node =
+        builder.interior(onodes, ro, 3, 5);
+     VMesh::Node::index_type i42node =
+        builder.interior(onodes, ro, 4, 2);
+     VMesh::Node::index_type i53node =
+        builder.interior(onodes, ro, 5, 3);
+     VMesh::Node::index_type i60node =
+        builder.interior(onodes, ro, 6, 0);
+     VMesh::Node::index_type i71node =
+        builder.interior(onodes, ro, 7, 1);
+
+      // Top Front
+      nnodes[0] = onodes[ro[0]];
+      nnodes[1] = builder.shared(onodes, ro, 0, 1);
+      nnodes[2] = builder.shared(onodes, ro, 0, 2);
+      nnodes[3] = builder.shared(onodes, ro, 0, 3);
+      nnodes[4] = builder.shared(onodes, ro, 0, 4);
+      nnodes[5] = builder.shared(onodes, ro, 0, 5);
+      nnodes[6] = i06node;
+      nnodes[7] = builder.shared(onodes, ro, 0, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 1);
+      nnodes[1] = builder.shared(onodes, ro, 1, 0);
+      nnodes[2] = builder.shared(onodes, ro, 1, 3);
+      nnodes[3] = builder.shared(onodes, ro, 0, 2);
+      nnodes[4] = builder.shared(onodes, ro, 0, 5);
+      nnodes[5] = builder.shared(onodes, ro, 1, 4);
+      nnodes[6] = i17node;
+      nnodes[7] = i06node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 0);
+      nnodes[1] = onodes[ro[1]];
+      nnodes[2] = builder.shared(onodes, ro, 1, 2);
+      nnodes[3] = builder.shared(onodes, ro, 1, 3);
+      nnodes[4] = builder.shared(onodes, ro, 1, 4);
+      nnodes[5] = builder.shared(onodes, ro, 1, 5);
+      nnodes[6] = builder.shared(onodes, ro, 1, 6);
+      nnodes[7] = i17node;
+      builder.elem(nnodes);
+
+      // Top Center
+      nnodes[0] = builder.shared(onodes, ro, 0, 3);
+      nnodes[1] = builder.shared(onodes, ro, 0, 2);
+      nnodes[2] = builder.shared(onodes, ro, 3, 1);
+      nnodes[3] = builder.shared(onodes, ro, 3, 0);
+      nnodes[4] = builder.shared(onodes, ro, 0, 7);
+      nnodes[5] = i06node;
+      nnodes[6] = i35node;
+      nnodes[7] = builder.shared(onodes, ro, 3, 4);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 2);
+      nnodes[1] = builder.shared(onodes, ro, 1, 3);
+      nnodes[2] = builder.shared(onodes, ro, 2, 0);
+      nnodes[3] = builder.shared(onodes, ro, 3, 1);
+      nnodes[4] = i06node;
+      nnodes[5] = i17node;
+      nnodes[6] = i24node;
+      nnodes[7] = i35node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 3);
+      nnodes[1] = builder.shared(onodes, ro, 1, 2);
+      nnodes[2] = builder.shared(onodes, ro, 2, 1);
+      nnodes[3] = builder.shared(onodes, ro, 2, 0);
+      nnodes[4] = i17node;
+      nnodes[5] = builder.shared(onodes, ro, 1, 6);
+      nnodes[6] = builder.shared(onodes, ro, 2, 5);
+      nnodes[7] = i24node;
+      builder.elem(nnodes);
+
+      // Top Back
+      nnodes[0] = builder.shared(onodes, ro, 3, 0);
+      nnodes[1] = builder.shared(onodes, ro, 3, 1);
+      nnodes[2] = builder.shared(onodes, ro, 3, 2);
+      nnodes[3] = onodes[ro[3]];
+      nnodes[4] = builder.shared(onodes, ro, 3, 4);
+      nnodes[5] = i35node;
+      nnodes[6] = builder.shared(onodes, ro, 3, 6);
+      nnodes[7] = builder.shared(onodes, ro, 3, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 3, 1);
+      nnodes[1] = builder.shared(onodes, ro, 2, 0);
+      nnodes[2] = builder.shared(onodes, ro, 2, 3);
+      nnodes[3] = builder.shared(onodes, ro, 3, 2);
+      nnodes[4] = i35node;
+      nnodes[5] = i24node;
+      nnodes[6] = builder.shared(onodes, ro, 2, 7);
+      nnodes[7] = builder.shared(onodes, ro, 3, 6);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 2, 0);
+      nnodes[1] = builder.shared(onodes, ro, 2, 1);
+      nnodes[2] = onodes[ro[2]];
+      nnodes[3] = builder.shared(onodes, ro, 2, 3);
+      nnodes[4] = i24node;
+      nnodes[5] = builder.shared(onodes, ro, 2, 5);
+      nnodes[6] = builder.shared(onodes, ro, 2, 6);
+      nnodes[7] = builder.shared(onodes, ro, 2, 7);
+      builder.elem(nnodes);
+
+      // Front
+      nnodes[0] = builder.shared(onodes, ro, 0, 4);
+      nnodes[1] = builder.shared(onodes, ro, 0, 5);
+      nnodes[2] = i06node;
+      nnodes[3] = builder.shared(onodes, ro, 0, 7);
+      nnodes[4] = builder.shared(onodes, ro, 4, 0);
+      nnodes[5] = builder.shared(onodes, ro, 4, 1);
+      nnodes[6] = i42node;
+      nnodes[7] = builder.shared(onodes, ro, 4, 3);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 0, 5);
+      nnodes[1] = builder.shared(onodes, ro, 1, 4);
+      nnodes[2] = i17node;
+      nnodes[3] = i06node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 1);
+      nnodes[5] = builder.shared(onodes, ro, 5, 0);
+      nnodes[6] = i53node;
+      nnodes[7] = i42node;
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 1, 4);
+      nnodes[1] = builder.shared(onodes, ro, 1, 5);
+      nnodes[2] = builder.shared(onodes, ro, 1, 6);
+      nnodes[3] = i17node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 0);
+      nnodes[5] = builder.shared(onodes, ro, 5, 1);
+      nnodes[6] = builder.shared(onodes, ro, 5, 2);
+      nnodes[7] = i53node;
+      builder.elem(nnodes);
+
+      // Center
+      nnodes[0] = builder.shared(onodes, ro, 0, 7);
+      nnodes[1] = i06node;
+      nnodes[2] = i35node;
+      nnodes[3] = builder.shared(onodes, ro, 3, 4);
+      nnodes[4] = builder.shared(onodes, ro, 4, 3);
+      nnodes[5] = i42node;
+      nnodes[6] = i71node;
+      nnodes[7] = builder.shared(onodes, ro, 7, 0);
+      builder.elem(nnodes);
+
+      nnodes[0] = i06node;
+      nnodes[1] = i17node;
+      nnodes[2] = i24node;
+      nnodes[3] = i35node;
+      nnodes[4] = i42node;
+      nnodes[5] = i53node;
+      nnodes[6] = i60node;
+      nnodes[7] = i71node;
+      builder.elem(nnodes);
+
+      nnodes[0] = i17node;
+      nnodes[1] = builder.shared(onodes, ro, 1, 6);
+      nnodes[2] = builder.shared(onodes, ro, 2, 5);
+      nnodes[3] = i24node;
+      nnodes[4] = i53node;
+      nnodes[5] = builder.shared(onodes, ro, 5, 2);
+      nnodes[6] = builder.shared(onodes, ro, 6, 1);
+      nnodes[7] = i60node;
+      builder.elem(nnodes);
+
+      // Back
+      nnodes[0] = builder.shared(onodes, ro, 3, 4);
+      nnodes[1] = i35node;
+      nnodes[2] = builder.shared(onodes, ro, 3, 6);
+      nnodes[3] = builder.shared(onodes, ro, 3, 7);
+      nnodes[4] = builder.shared(onodes, ro, 7, 0);
+      nnodes[5] = i71node;
+      nnodes[6] = builder.shared(onodes, ro, 7, 2);
+      nnodes[7] = builder.shared(onodes, ro, 7, 3);
+      builder.elem(nnodes);
+
+      nnodes[0] = i35node;
+      nnodes[1] = i24node;
+      nnodes[2] = builder.shared(onodes, ro, 2, 7);
+      nnodes[3] = builder.shared(onodes, ro, 3, 6);
+      nnodes[4] = i71node;
+      nnodes[5] = i60node;
+      nnodes[6] = builder.shared(onodes, ro, 6, 3);
+      nnodes[7] = builder.shared(onodes, ro, 7, 2);
+      builder.elem(nnodes);
+
+      nnodes[0] = i24node;
+      nnodes[1] = builder.shared(onodes, ro, 2, 5);
+      nnodes[2] = builder.shared(onodes, ro, 2, 6);
+      nnodes[3] = builder.shared(onodes, ro, 2, 7);
+      nnodes[4] = i60node;
+      nnodes[5] = builder.shared(onodes, ro, 6, 1);
+      nnodes[6] = builder.shared(onodes, ro, 6, 2);
+      nnodes[7] = builder.shared(onodes, ro, 6, 3);
+      builder.elem(nnodes);
+
+      // Bottom Front
+      nnodes[0] = builder.shared(onodes, ro, 4, 0);
+      nnodes[1] = builder.shared(onodes, ro, 4, 1);
+      nnodes[2] = i42node;
+      nnodes[3] = builder.shared(onodes, ro, 4, 3);
+      nnodes[4] = onodes[ro[4]];
+      nnodes[5] = builder.shared(onodes, ro, 4, 5);
+      nnodes[6] = builder.shared(onodes, ro, 4, 6);
+      nnodes[7] = builder.shared(onodes, ro, 4, 7);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 4, 1);
+      nnodes[1] = builder.shared(onodes, ro, 5, 0);
+      nnodes[2] = i53node;
+      nnodes[3] = i42node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 5);
+      nnodes[5] = builder.shared(onodes, ro, 5, 4);
+      nnodes[6] = builder.shared(onodes, ro, 5, 7);
+      nnodes[7] = builder.shared(onodes, ro, 4, 6);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 5, 0);
+      nnodes[1] = builder.shared(onodes, ro, 5, 1);
+      nnodes[2] = builder.shared(onodes, ro, 5, 2);
+      nnodes[3] = i53node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 4);
+      nnodes[5] = onodes[ro[5]];
+      nnodes[6] = builder.shared(onodes, ro, 5, 6);
+      nnodes[7] = builder.shared(onodes, ro, 5, 7);
+      builder.elem(nnodes);
+
+      // Bottom Center
+      nnodes[0] = builder.shared(onodes, ro, 4, 3);
+      nnodes[1] = i42node;
+      nnodes[2] = i71node;
+      nnodes[3] = builder.shared(onodes, ro, 7, 0);
+      nnodes[4] = builder.shared(onodes, ro, 4, 7);
+      nnodes[5] = builder.shared(onodes, ro, 4, 6);
+      nnodes[6] = builder.shared(onodes, ro, 7, 5);
+      nnodes[7] = builder.shared(onodes, ro, 7, 4);
+      builder.elem(nnodes);
+
+      nnodes[0] = i42node;
+      nnodes[1] = i53node;
+      nnodes[2] = i60node;
+      nnodes[3] = i71node;
+      nnodes[4] = builder.shared(onodes, ro, 4, 6);
+      nnodes[5] = builder.shared(onodes, ro, 5, 7);
+      nnodes[6] = builder.shared(onodes, ro, 6, 4);
+      nnodes[7] = builder.shared(onodes, ro, 7, 5);
+      builder.elem(nnodes);
+
+      nnodes[0] = i53node;
+      nnodes[1] = builder.shared(onodes, ro, 5, 2);
+      nnodes[2] = builder.shared(onodes, ro, 6, 1);
+      nnodes[3] = i60node;
+      nnodes[4] = builder.shared(onodes, ro, 5, 7);
+      nnodes[5] = builder.shared(onodes, ro, 5, 6);
+      nnodes[6] = builder.shared(onodes, ro, 6, 5);
+      nnodes[7] = builder.shared(onodes, ro, 6, 4);
+      builder.elem(nnodes);
+
+      nnodes[0] = builder.shared(onodes, ro, 7, 0);
+      nnodes[1] = i71node;
+      nnodes[2] = builder.shared(onodes, ro, 7, 2);
+      nnodes[3] = builder.shared(onodes, ro, 7, 3);
+      nnodes[4] = builder.shared(onodes, ro, 7, 4);
+      nnodes[5] = builder.shared(onodes, ro, 7, 5);
+      nnodes[6] = builder.shared(onodes, ro, 7, 6);
+      nnodes[7] = onodes[ro[7]];
+      builder.elem(nnodes);
+
+      nnodes[0] = i71node;
+      nnodes[1] = i60node;
+      nnodes[2] = builder.shared(onodes, ro, 6, 3);
+      nnodes[3] = builder.shared(onodes, ro, 7, 2);
+      nnodes[4] = builder.shared(onodes, ro, 7, 5);
+      nnodes[5] = builder.shared(onodes, ro, 6, 4);
+      nnodes[6] = builder.shared(onodes, ro, 6, 7);
+      nnodes[7] = builder.shared(onodes, ro, 7, 6);
+      builder.elem(nnodes);
+
+      nnodes[0] = i60node;
+      nnodes[1] = builder.shared(onodes, ro, 6, 1);
+      nnodes[2] = builder.shared(onodes, ro, 6, 2);
+      nnodes[3] = builder.shared(onodes, ro, 6, 3);
+      nnodes[4] = builder.shared(onodes, ro, 6, 4);
+      nnodes[5] = builder.shared(onodes, ro, 6, 5);
+      nnodes[6] = onodes[ro[6]];
+      nnodes[7] = builder.shared(onodes, ro, 6, 7);
+      builder.elem(nnodes);
+    }
+    else
+    {
+      // non convex, cannot replace.
+      return (false);
+    }
+
+    return (true);
+  }
+
+  // First pass of the parallel convex split: records the node pairs that get
+  // a shared node and counts the interior nodes and children.
+  class HexConvexCounter
+  {
+    public:
+      explicit HexConvexCounter(NodePairTable::entry_list_type& pairs) :
+        source_elem(0), num_nodes(0), num_elems(0), pairs_(pairs), first_pair_(0) {}
+
+      VMesh::Node::index_type shared(VMesh::Node::array_type& onodes,
+                                     const int* ro, int a, int b)
+      {
+        // The source remembers which element and corners define the node.
+        pairs_.push_back({ onodes[ro[a]], onodes[ro[b]], 64*source_elem + 8*ro[a] + ro[b] });
+        return (0);
+      }
+
+      VMesh::Node::index_type interior(VMesh::Node::array_type&, const int*, int, int)
+      { return (num_nodes++); }
+      VMesh::Node::index_type interior(VMesh::Node::array_type&, const Point&)
+      { return (num_nodes++); }
+
+      void elem(VMesh::Node::array_type&) { num_elems++; }
+
+      void begin_elem(VMesh::index_type idx)
+      {
+        source_elem = idx;
+        first_pair_ = pairs_.size();
+      }
+
+      // An element asks for most of its pairs several times; keep one entry
+      // per pair so the table only sorts the copies shared with neighbors.
+      void end_elem()
+      {
+        auto first = pairs_.begin() + first_pair_;
+        std::sort(first, pairs_.end(),
+          [](const NodePairTable::Entry& a, const NodePairTable::Entry& b)
+          { return (a.first < b.first || (a.first == b.first && a.second < b.second)); });
+        pairs_.erase(std::unique(first, pairs_.end(),
+          [](const NodePairTable::Entry& a, const NodePairTable::Entry& b)
+          { return (a.first == b.first && a.second == b.second); }), pairs_.end());
+      }
+
+      VMesh::index_type source_elem;
+      VMesh::size_type  num_nodes;
+      VMesh::size_type  num_elems;
+
+    private:
+      NodePairTable::entry_list_type& pairs_;
+      size_t first_pair_;
+  };
+
+  // Second pass: writes the interior nodes and children at their final
+  // indices. Shared nodes are looked up in the numbered pair table.
+  class HexConvexWriter
+  {
+    public:
+      HexConvexWriter(VMesh* mesh, VMesh* refined, const NodePairTable& pairs,
+                      std::vector<double>& ivalues, std::vector<double>& evalues,
+                      int basis_order) :
+        source_elem(0), next_node(0), next_elem(0), mesh_(mesh), refined_(refined),
+        cells_(refined->get_elems_pointer()), num_nodes_(mesh->num_nodes()), pairs_(pairs),
+        ivalues_(ivalues), evalues_(evalues), basis_order_(basis_order) {}
+
+      VMesh::Node::index_type shared(VMesh::Node::array_type& onodes,
+                                     const int* ro, int a, int b)
+      {
+        return (num_nodes_ + pairs_.find(onodes[ro[a]], onodes[ro[b]]));
+      }
+
+      VMesh::Node::index_type interior(VMesh::Node::array_type& onodes,
+                                       const int* ro, int a, int b)
+      {
+        return (interior(onodes, Interpolate(hcoords[ro[a]], hcoords[ro[b]], 1.0/3.0)));
+      }
+
+      VMesh::Node::index_type interior(VMesh::Node::array_type& onodes,
+                                       const Point& coordsp)
+      {
+        const VMesh::Node::index_type idx(next_node++);
+        refined_->set_point(RIinterpolate(mesh_, onodes, coordsp), idx);
+        if (basis_order_ == 1) ivalues_[idx] = RIinterpolateV(ivalues_, onodes, coordsp);
+        return (idx);
+      }
+
+      void elem(VMesh::Node::array_type& nnodes)
+      {
+        if (basis_order_ == 0) evalues_[next_elem] = ivalues_[source_elem];
+        // Write the cell array directly; set_nodes may take the mesh lock.
+        for (int k = 0; k < 8; k++) cells_[8*next_elem + k] = nnodes[k];
+        next_elem++;
+      }
+
+      VMesh::index_type source_elem;
+      VMesh::index_type next_node;
+      VMesh::index_type next_elem;
+
+    private:
+      VMesh* mesh_;
+      VMesh* refined_;
+      VMesh::index_type* cells_;
+      VMesh::size_type num_nodes_;
+      const NodePairTable& pairs_;
+      std::vector<double>& ivalues_;
+      std::vector<double>& evalues_;
+      int basis_order_;
+  };
+}
+
+
 
 
 RefineMeshHexVolAlgoV::RefineMeshHexVolAlgoV()
@@ -531,7 +1359,6 @@ runImpl(FieldHandle input, FieldHandle& output, bool convex,
 
   edge_hash_type emap;
   VMesh::Node::array_type onodes(8);
-  VMesh::Node::array_type nnodes(8);
 
   // Copy all of the nodes from mesh to refined.  They won't change,
   // we only add nodes.
@@ -701,795 +1528,95 @@ runImpl(FieldHandle input, FieldHandle& output, bool convex,
     while (changed);
 
 
-    VMesh::Elem::iterator bi, ei;
-    mesh->begin(bi); mesh->end(ei);
-
-    unsigned int cnt = 0;
-    unsigned int loopcnt = 0;
+    // Split in parallel. The first pass collects the node pairs that get a
+    // shared node and counts the interior nodes and children of each range of
+    // elements. Once the pairs are numbered, the second pass writes all new
+    // nodes and children at their final indices, in input element order.
+    const int nproc = Parallel::NumCores();
+    std::vector<NodePairTable::entry_list_type> lists(nproc);
+    std::vector<VMesh::size_type> num_inodes(nproc + 1, 0);
+    std::vector<VMesh::size_type> num_children(nproc + 1, 0);
 
-    VMesh::Elem::size_type sz; mesh->size(sz);
-
-    while (bi != ei)
+    auto get_pattern = [&](VMesh::Node::array_type& nodes, int& which)
     {
-				cnt++; if (cnt == 100) { loopcnt +=cnt; cnt = 0; this->update_progress_max(loopcnt,sz);  }
-
-      mesh->get_nodes(onodes, *bi);
-
-      // Get the values and compute an inside/outside mask.
       unsigned int inside = 0;
-      unsigned int inside_count = 0;
-      for (unsigned int i = 0; i < onodes.size(); i++)
+      for (unsigned int i = 0; i < nodes.size(); i++)
       {
         inside = inside << 1;
-        if (values[onodes[i]])
-        {
-          inside |= 1;
-          inside_count++;
-        }
+        if (values[nodes[i]]) inside |= 1;
       }
+      which = pattern_table[inside][1];
+      return (pattern_table[inside][0]);
+    };
 
-      const int pattern = pattern_table[inside][0];
-      const int which = pattern_table[inside][1];
-
-      if (pattern == 0)
-      {
-        // Nodes are the same order, so just add the element.
-        refined->add_elem(onodes);
-        if (basis_order == 0) evalues.push_back(ivalues[*bi]);
-      }
-      else if (pattern == 1)
-      {
-        const int *ro = hex_reorder_table[which];
-
-        VMesh::Node::index_type i06node =
-            add_point_convex(refined, onodes, ro, 0, 6,ivalues,basis_order);
-
-        // Add this corner.
-        nnodes[0] = onodes[ro[0]];
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[6] = i06node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Add the other three pieces.
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[1] = onodes[ro[1]];
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = i06node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = onodes[ro[3]];
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[5] = i06node;
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[2] = i06node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-        if (basis_order == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
-      }
-      else if (pattern == 2)
-      {
-        const int *ro = hex_reorder_table[which];
-
-       VMesh::Node::index_type i06node =
-          add_point_convex(refined, onodes, ro, 0, 6,ivalues,basis_order);
-       VMesh::Node::index_type i17node =
-          add_point_convex(refined, onodes, ro, 1, 7,ivalues,basis_order);
-       VMesh::Node::index_type i60node =
-          add_point_convex(refined, onodes, ro, 6, 0,ivalues,basis_order);
-       VMesh::Node::index_type i71node =
-          add_point_convex(refined, onodes, ro, 7, 1,ivalues,basis_order);
-
-        // Leading edge.
-        nnodes[0] = onodes[ro[0]];
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[6] = i06node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[6] = i17node;
-        nnodes[7] = i06node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[1] = onodes[ro[1]];
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[7] = i17node;
-        refined->add_elem(nnodes);
-
-        // Top center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[3] = onodes[ro[3]];
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[5] = i06node;
-        nnodes[6] = i71node;
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[4] = i06node;
-        nnodes[5] = i17node;
-        nnodes[6] = i60node;
-        nnodes[7] = i71node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[4] = i17node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = i60node;
-        refined->add_elem(nnodes);
-
-        // Front Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[2] = i06node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[6] = i71node;
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[2] = i17node;
-        nnodes[3] = i06node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[6] = i60node;
-        nnodes[7] = i71node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[3] = i17node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = i60node;
-        refined->add_elem(nnodes);
-
-        // Outside wedges
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = onodes[ro[3]];
-        nnodes[4] = i71node;
-        nnodes[5] = i60node;
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[2] = i60node;
-        nnodes[3] = i71node;
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        if (basis_order == 0) evalues.insert(evalues.end(),11,ivalues[*bi]);
-      }
-      else if (pattern == 4)
+    std::atomic<bool> not_convex(false);
+    TaskPool::Instance().runTasks([&](int proc)
+    {
+      const VMesh::index_type start = (num_elems*proc)/nproc;
+      const VMesh::index_type end = (num_elems*(proc+1))/nproc;
+      VMesh::Node::array_type nodes(8);
+      HexConvexCounter counter(lists[proc]);
+      for (VMesh::Elem::index_type idx = start; idx < end; idx++)
       {
-        const int *ro = hex_reorder_table[which];
-
-        // Interior
-       VMesh::Node::index_type i06node =
-          add_point_convex(refined, onodes, ro, 0, 6,ivalues,basis_order);
-       VMesh::Node::index_type i17node =
-          add_point_convex(refined, onodes, ro, 1, 7,ivalues,basis_order);
-       VMesh::Node::index_type i24node =
-          add_point_convex(refined, onodes, ro, 2, 4,ivalues,basis_order);
-       VMesh::Node::index_type i35node =
-          add_point_convex(refined, onodes, ro, 3, 5,ivalues,basis_order);
-
-
-        const Point i06 = Interpolate(hcoords[ro[0]], hcoords[ro[6]], 1.0/3.0);
-        const Point i17 = Interpolate(hcoords[ro[1]], hcoords[ro[7]], 1.0/3.0);
-        const Point i24 = Interpolate(hcoords[ro[2]], hcoords[ro[4]], 1.0/3.0);
-        const Point i35 = Interpolate(hcoords[ro[3]], hcoords[ro[5]], 1.0/3.0);
-        const Point i42a = Interpolate(hcoords[ro[4]], hcoords[ro[2]], 1.0/3.0);
-        const Point i53a = Interpolate(hcoords[ro[5]], hcoords[ro[3]], 1.0/3.0);
-        const Point i60a = Interpolate(hcoords[ro[6]], hcoords[ro[0]], 1.0/3.0);
-        const Point i71a = Interpolate(hcoords[ro[7]], hcoords[ro[1]], 1.0/3.0);
-        const Point i42 = Interpolate(i06, i42a, 0.5);
-        const Point i53 = Interpolate(i17, i53a, 0.5);
-        const Point i60 = Interpolate(i24, i60a, 0.5);
-        const Point i71 = Interpolate(i35, i71a, 0.5);
-
-       VMesh::Node::index_type i42node =
-          add_point_convex(refined, onodes, i42,ivalues,basis_order);
-       VMesh::Node::index_type i53node =
-          add_point_convex(refined, onodes, i53,ivalues,basis_order);
-       VMesh::Node::index_type i60node =
-          add_point_convex(refined, onodes, i60,ivalues,basis_order);
-       VMesh::Node::index_type i71node =
-          add_point_convex(refined, onodes, i71,ivalues,basis_order);
-
-        // Top Front
-        nnodes[0] = onodes[ro[0]];
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[6] = i06node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[6] = i17node;
-        nnodes[7] = i06node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[1] = onodes[ro[1]];
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[7] = i17node;
-        refined->add_elem(nnodes);
-
-        // Top Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 0,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[5] = i06node;
-        nnodes[6] = i35node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[4] = i06node;
-        nnodes[5] = i17node;
-        nnodes[6] = i24node;
-        nnodes[7] = i35node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 1,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[4] = i17node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[7] = i24node;
-        refined->add_elem(nnodes);
-
-        // Top Back
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 2,ivalues,basis_order);
-        nnodes[3] = onodes[ro[3]];
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[5] = i35node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 2,ivalues,basis_order);
-        nnodes[4] = i35node;
-        nnodes[5] = i24node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 1,ivalues,basis_order);
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 3,ivalues,basis_order);
-        nnodes[4] = i24node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Front
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[2] = i06node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[6] = i42node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[2] = i17node;
-        nnodes[3] = i06node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[6] = i53node;
-        nnodes[7] = i42node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[3] = i17node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[7] = i53node;
-        refined->add_elem(nnodes);
-
-        // Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[1] = i06node;
-        nnodes[2] = i35node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        nnodes[5] = i42node;
-        nnodes[6] = i71node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i06node;
-        nnodes[1] = i17node;
-        nnodes[2] = i24node;
-        nnodes[3] = i35node;
-        nnodes[4] = i42node;
-        nnodes[5] = i53node;
-        nnodes[6] = i60node;
-        nnodes[7] = i71node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i17node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[3] = i24node;
-        nnodes[4] = i53node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[7] = i60node;
-        refined->add_elem(nnodes);
-
-        // Back
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[1] = i35node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 7,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        nnodes[5] = i71node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i35node;
-        nnodes[1] = i24node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[4] = i71node;
-        nnodes[5] = i60node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i24node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 6,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[4] = i60node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Bottom Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        nnodes[1] = i42node;
-        nnodes[2] = i71node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i42node;
-        nnodes[1] = i53node;
-        nnodes[2] = i60node;
-        nnodes[3] = i71node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i53node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[3] = i60node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Bottom
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-        if (basis_order == 0) evalues.insert(evalues.end(),22,ivalues[*bi]);
+        mesh->get_nodes(nodes, idx);
+        int which;
+        const int pattern = get_pattern(nodes, which);
+        counter.begin_elem(idx);
+        if (!split_hex_convex(counter, nodes, pattern, which))
+          not_convex = true;
+        counter.end_elem();
       }
-      else if (pattern == 8)
+      num_inodes[proc + 1] = counter.num_nodes;
+      num_children[proc + 1] = counter.num_elems;
+    }, nproc);
+
+    if (not_convex)
+      warning("Element not convex, cannot replace.");
+
+    const NodePairTable pairs(lists, num_nodes);
+    for (int proc = 0; proc < nproc; proc++)
+    {
+      num_inodes[proc + 1] += num_inodes[proc];
+      num_children[proc + 1] += num_children[proc];
+    }
+
+    const VMesh::size_type num_snodes = num_nodes + pairs.size();
+    refined->resize_nodes(num_snodes + num_inodes[nproc]);
+    refined->resize_elems(num_children[nproc]);
+    if (basis_order == 1) ivalues.resize(num_snodes + num_inodes[nproc]);
+    if (basis_order == 0) evalues.resize(num_children[nproc]);
+
+    TaskPool::Instance().runTasks([&](int proc)
+    {
+      // Shared nodes, computed from the first element that needs them.
+      const VMesh::index_type pstart = (pairs.size()*proc)/nproc;
+      const VMesh::index_type pend = (pairs.size()*(proc+1))/nproc;
+      VMesh::Node::array_type nodes(8);
+      for (VMesh::index_type idx = pstart; idx < pend; idx++)
       {
-        const int *ro = hex_reorder_table[which];
-
-        // Interior
-       VMesh::Node::index_type i06node =
-          add_point_convex(refined, onodes, ro, 0, 6,ivalues,basis_order);
-       VMesh::Node::index_type i17node =
-          add_point_convex(refined, onodes, ro, 1, 7,ivalues,basis_order);
-       VMesh::Node::index_type i24node =
-          add_point_convex(refined, onodes, ro, 2, 4,ivalues,basis_order);
-       VMesh::Node::index_type i35node =
-          add_point_convex(refined, onodes, ro, 3, 5,ivalues,basis_order);
-       VMesh::Node::index_type i42node =
-          add_point_convex(refined, onodes, ro, 4, 2,ivalues,basis_order);
-       VMesh::Node::index_type i53node =
-          add_point_convex(refined, onodes, ro, 5, 3,ivalues,basis_order);
-       VMesh::Node::index_type i60node =
-          add_point_convex(refined, onodes, ro, 6, 0,ivalues,basis_order);
-       VMesh::Node::index_type i71node =
-          add_point_convex(refined, onodes, ro, 7, 1,ivalues,basis_order);
-
-        // Top Front
-        nnodes[0] = onodes[ro[0]];
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[6] = i06node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[6] = i17node;
-        nnodes[7] = i06node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 0,ivalues,basis_order);
-        nnodes[1] = onodes[ro[1]];
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[7] = i17node;
-        refined->add_elem(nnodes);
-
-        // Top Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 0,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[5] = i06node;
-        nnodes[6] = i35node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 2,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[4] = i06node;
-        nnodes[5] = i17node;
-        nnodes[6] = i24node;
-        nnodes[7] = i35node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 3,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 1,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[4] = i17node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[7] = i24node;
-        refined->add_elem(nnodes);
-
-        // Top Back
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 2,ivalues,basis_order);
-        nnodes[3] = onodes[ro[3]];
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[5] = i35node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 2,ivalues,basis_order);
-        nnodes[4] = i35node;
-        nnodes[5] = i24node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 2, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 1,ivalues,basis_order);
-        nnodes[2] = onodes[ro[2]];
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 3,ivalues,basis_order);
-        nnodes[4] = i24node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 2, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Front
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[2] = i06node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 0,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[6] = i42node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 5,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[2] = i17node;
-        nnodes[3] = i06node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[6] = i53node;
-        nnodes[7] = i42node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 1, 4,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 5,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[3] = i17node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 1,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[7] = i53node;
-        refined->add_elem(nnodes);
-
-        // Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 0, 7,ivalues,basis_order);
-        nnodes[1] = i06node;
-        nnodes[2] = i35node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        nnodes[5] = i42node;
-        nnodes[6] = i71node;
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i06node;
-        nnodes[1] = i17node;
-        nnodes[2] = i24node;
-        nnodes[3] = i35node;
-        nnodes[4] = i42node;
-        nnodes[5] = i53node;
-        nnodes[6] = i60node;
-        nnodes[7] = i71node;
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i17node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 1, 6,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[3] = i24node;
-        nnodes[4] = i53node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[7] = i60node;
-        refined->add_elem(nnodes);
-
-        // Back
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 3, 4,ivalues,basis_order);
-        nnodes[1] = i35node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 7,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        nnodes[5] = i71node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i35node;
-        nnodes[1] = i24node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 3, 6,ivalues,basis_order);
-        nnodes[4] = i71node;
-        nnodes[5] = i60node;
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i24node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 2, 5,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 2, 6,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 2, 7,ivalues,basis_order);
-        nnodes[4] = i60node;
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 2,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Bottom Front
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[2] = i42node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        nnodes[4] = onodes[ro[4]];
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 4, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 4, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 1,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[2] = i53node;
-        nnodes[3] = i42node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 5,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 4,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 5, 7,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 4, 6,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 5, 0,ivalues,basis_order);
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[3] = i53node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 4,ivalues,basis_order);
-        nnodes[5] = onodes[ro[5]];
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 5, 6,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 5, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        // Bottom Center
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 4, 3,ivalues,basis_order);
-        nnodes[1] = i42node;
-        nnodes[2] = i71node;
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 7,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 4, 6,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 7, 5,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 4,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i42node;
-        nnodes[1] = i53node;
-        nnodes[2] = i60node;
-        nnodes[3] = i71node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 4, 6,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 7,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 4,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 5,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i53node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 5, 2,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[3] = i60node;
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 5, 7,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 5, 6,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 5,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 6, 4,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = lookup_convex(refined, emap, onodes, ro, 7, 0,ivalues,basis_order);
-        nnodes[1] = i71node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 7, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 7, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 7, 5,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 7, 6,ivalues,basis_order);
-        nnodes[7] = onodes[ro[7]];
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i71node;
-        nnodes[1] = i60node;
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 7, 2,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 7, 5,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 6, 4,ivalues,basis_order);
-        nnodes[6] = lookup_convex(refined, emap, onodes, ro, 6, 7,ivalues,basis_order);
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 7, 6,ivalues,basis_order);
-        refined->add_elem(nnodes);
-
-        nnodes[0] = i60node;
-        nnodes[1] = lookup_convex(refined, emap, onodes, ro, 6, 1,ivalues,basis_order);
-        nnodes[2] = lookup_convex(refined, emap, onodes, ro, 6, 2,ivalues,basis_order);
-        nnodes[3] = lookup_convex(refined, emap, onodes, ro, 6, 3,ivalues,basis_order);
-        nnodes[4] = lookup_convex(refined, emap, onodes, ro, 6, 4,ivalues,basis_order);
-        nnodes[5] = lookup_convex(refined, emap, onodes, ro, 6, 5,ivalues,basis_order);
-        nnodes[6] = onodes[ro[6]];
-        nnodes[7] = lookup_convex(refined, emap, onodes, ro, 6, 7,ivalues,basis_order);
-        refined->add_elem(nnodes);
-        if (basis_order == 0) evalues.insert(evalues.end(),27,ivalues[*bi]);
+        const VMesh::index_type source = pairs[idx].source;
+        mesh->get_nodes(nodes, VMesh::Elem::index_type(source/64));
+        const Point coordsp = Interpolate(hcoords[(source/8)%8], hcoords[source%8], 1.0/3.0);
+        const VMesh::Node::index_type nidx(num_nodes + idx);
+        refined->set_point(RIinterpolate(mesh, nodes, coordsp), nidx);
+        if (basis_order == 1) ivalues[nidx] = RIinterpolateV(ivalues, nodes, coordsp);
       }
-      else
+
+      const VMesh::index_type start = (num_elems*proc)/nproc;
+      const VMesh::index_type end = (num_elems*(proc+1))/nproc;
+      HexConvexWriter writer(mesh, refined, pairs, ivalues, evalues, basis_order);
+      writer.next_node = num_snodes + num_inodes[proc];
+      writer.next_elem = num_children[proc];
+      for (VMesh::Elem::index_type idx = start; idx < end; idx++)
       {
-        // non convex, emit error.
-        std::cout << "Element not convex, cannot replace.\n";
+        mesh->get_nodes(nodes, idx);
+        int which;
+        const int pattern = get_pattern(nodes, which);
+        writer.source_elem = idx;
+        split_hex_convex(writer, nodes, pattern, which);
       }
-      ++bi;
-    }
+    }, nproc);
+    refined->clear_synchronization();
 		}
   else
   {
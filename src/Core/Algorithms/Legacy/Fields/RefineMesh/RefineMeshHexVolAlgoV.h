@@ -64,20 +64,6 @@ namespace SCIRun{
             std::vector<double>& ivalues,
             int basis_order) const;
 
-          VMesh::Node::index_type add_point_convex(VMesh *refined,
-            VMesh::Node::array_type &nodes,
-            const Geometry::Point& coordsp,
-            std::vector<double>& ivalues,
-            int basis_order) const;
-
-          VMesh::Node::index_type add_point_convex(VMesh *refined,
-            VMesh::Node::array_type &nodes,
-            const int *reorder,
-            VMesh::index_type a,
-            VMesh::index_type b,
-            std::vector<double>& ivalues,
-            int basis_order) const;
-
 
           void dice(VMesh *refined,
             edge_hash_type &emap,
@@ -98,14 +84,6 @@ namespace SCIRun{
             double factor,
             std::vector<double>& ivalues,
             int basis_order) const;
-          VMesh::Node::index_type lookup_convex(VMesh *refined,
-            edge_hash_type &edgemap,
-            VMesh::Node::array_type &onodes,
-            const int *reorder,
-            VMesh::index_type a,
-            VMesh::index_type b,
-            std::vector<double>& ivalues,
-            int basis_order) const;
         };
       }
     }
@@ -37,6 +37,9 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Legacy/Fields/RefineMesh/NodePairTable.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Thread/TaskPool.h>
 
 //STL classes needed
 //#include <sci_hash_map.h>
@@ -51,764 +54,607 @@ using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 
-RefineMeshTetVolAlgoV::RefineMeshTetVolAlgoV()
-{
-
-}
-
-bool
-RefineMeshTetVolAlgoV::runImpl(FieldHandle input, FieldHandle& output,
-                      const std::string& select, double isoval) const
+namespace
 {
-  FieldInformation fi(input);
+  // Edges of a tet in the order used by the split table below.
+  const int tet_edges[6][2] = { {0,1}, {1,2}, {2,0}, {0,3}, {1,3}, {2,3} };
 
-  fi.make_tetvolmesh();
-
-  output = CreateField(fi);
-
-  if (!output)
+  // Split one tet. n holds the corner nodes (0-3) followed by the new node on
+  // each edge (4-9), or 0 if the edge is not refined. The child tets are
+  // written to children, four nodes each, and their number is returned.
+  int split_tet(const VMesh::index_type* n, VMesh::index_type* children)
   {
-    error("Could not create an output field");
-    return (false);
-  }
-
-  VField* field   = input->vfield();
-  VMesh*  mesh    = input->vmesh();
-  VMesh*  refined = output->vmesh();
-  VField* rfield  = output->vfield();
-
-  VMesh::Node::array_type onodes(4);
-
-  mesh->synchronize(Mesh::EDGES_E);
-
-  VMesh::size_type num_nodes = mesh->num_nodes();
-  VMesh::size_type num_elems = mesh->num_elems();
-  std::vector<bool> values(num_nodes,false);
+    const VMesh::index_type i0 = n[0], i1 = n[1], i2 = n[2], i3 = n[3];
+    const VMesh::index_type i4 = n[4], i5 = n[5], i6 = n[6];
+    const VMesh::index_type i7 = n[7], i8 = n[8], i9 = n[9];
 
-  // Deal with data stored at different locations
-  // If data is on the elements make sure that all nodes
-  // of that element pass requirement.
-
-  std::vector<double> ivalues;
-  std::vector<double> evalues;
-
-  if (field->basis_order() == 0)
-  {
-    field->get_values(ivalues);
-
-    if (select == "equal")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
-      {
-        mesh->get_nodes(onodes,i);
-        if (ivalues[i] == isoval)
-          for (size_t j=0; j< onodes.size(); j++)
-            values[onodes[j]] = true;
-      }
-    }
-    else if (select == "lessthan")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
-      {
-        mesh->get_nodes(onodes,i);
-        if (ivalues[i] < isoval)
-          for (size_t j=0; j< onodes.size(); j++)
-            values[onodes[j]] = true;
-      }
-    }
-    else if (select == "greaterthan")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
-      {
-        mesh->get_nodes(onodes,i);
-        if (ivalues[i] > isoval)
-          for (size_t j=0; j< onodes.size(); j++)
-            values[onodes[j]] = true;
-      }
-    }
-    else if (select == "all")
-    {
-      for (size_t j=0;j<values.size();j++) values[j] = true;
-    }
-    else
+    int count = 0;
+    auto add = [&](VMesh::index_type a, VMesh::index_type b,
+                   VMesh::index_type c, VMesh::index_type d)
     {
-      error("Unknown region selection method encountered");
-      return (false);
-    }
-  }
-  else if (field->basis_order() == 1)
-  {
-    field->get_values(ivalues);
-
-    if (select == "equal")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
-      {
-        if (ivalues[i] == isoval) values[i] = true;
-      }
-    }
-    else if (select == "lessthan")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
-      {
-        if (ivalues[i] < isoval) values[i] = true;
-      }
-    }
-    else if (select == "greaterthan")
-    {
-      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
-      {
-        if (ivalues[i] > isoval) values[i] = true;
-      }
-    }
-    else if (select == "all")
-    {
-      for (size_t j=0;j<values.size();j++) values[j] = true;
-    }
-    else
-    {
-      error("RefineMesh: Unknown region selection method encountered");
-      return (false);
-    }
-
-  }
-  else
-  {
-    for (size_t j=0;j<values.size();j++) values[j] = true;
-  }
-
-  // Copy all of the nodes from mesh to refined.  They won't change,
-  // we only add nodes.
-
-  VMesh::Node::iterator bni, eni;
-  mesh->begin(bni); mesh->end(eni);
-  while (bni != eni)
-  {
-    Point p;
-    mesh->get_point(p, *bni);
-    refined->add_point(p);
-    ++bni;
-  }
-
-  std::vector<VMesh::index_type> enodes(mesh->num_edges(),0);
-
-  VMesh::Node::array_type nodes(2);
-  Point p0, p1,p2, p3, p;
-  VMesh::Edge::iterator be, ee;
-  mesh->begin(be); mesh->end(ee);
-
-  // add all additional nodes we need
-  while (be != ee)
-  {
-    mesh->get_nodes(nodes,*be);
-    if ((values[nodes[0]] == true) || (values[nodes[1]] == true))
-    {
-      mesh->get_center(p0,nodes[0]);
-      mesh->get_center(p1,nodes[1]);
-
-      p = (p0 + p1).asPoint()*0.5;
-
-      enodes[*be] = refined->add_point(p);
-      if(field->basis_order() == 1)
-      {
-        ivalues.push_back(0.5*(ivalues[nodes[0]]+ivalues[nodes[1]]));
-      }
-    }
-    ++be;
-  }
-
-
-  VMesh::Edge::array_type oedges(6);
-  VMesh::Node::array_type nnodes(4);
-
-  VMesh::Elem::iterator bi, ei;
-  mesh->begin(bi); mesh->end(ei);
-
-  unsigned int cnt = 0;
-  unsigned int loopcnt = 0;
-
-  VMesh::Elem::size_type sz; mesh->size(sz);
-
-
-  while (bi != ei)
-  {
-			cnt++; if (cnt == 100) { loopcnt +=cnt; cnt = 0;}// algo->update_progress(loopcnt,sz);  }
-    mesh->get_nodes(onodes, *bi);
-    mesh->get_edges(oedges, *bi);
-
-    VMesh::index_type i0 = onodes[0];
-    VMesh::index_type i1 = onodes[1];
-    VMesh::index_type i2 = onodes[2];
-    VMesh::index_type i3 = onodes[3];
-    VMesh::index_type i4 = enodes[oedges[0]];
-    VMesh::index_type i5 = enodes[oedges[1]];
-    VMesh::index_type i6 = enodes[oedges[2]];
-    VMesh::index_type i7 = enodes[oedges[3]];
-    VMesh::index_type i8 = enodes[oedges[4]];
-    VMesh::index_type i9 = enodes[oedges[5]];
+      VMesh::index_type* child = children + 4*count++;
+      child[0] = a; child[1] = b; child[2] = c; child[3] = d;
+    };
 
     if (i4==0 && i5 == 0 && i6 == 0 && i7==0 && i8 == 0 && i9 == 0)
     {
-      refined->add_elem(onodes);
-      if(field->basis_order() == 0) evalues.push_back(ivalues[*bi]);
+      add(i0, i1, i2, i3);
     }
     else if (i4 > 0 && i5 > 0 && i6 > 0 && i7 > 0 && i8 > 0 && i9 > 0)
     {
-      nnodes[0] =i4; nnodes[1] = i1; nnodes[2] = i5; nnodes[3] = i8;
-      refined->add_elem(nnodes);
-      nnodes[0] =i4; nnodes[1] = i8; nnodes[2] = i5; nnodes[3] = i7;
-      refined->add_elem(nnodes);
-      nnodes[0] =i7; nnodes[1] = i8; nnodes[2] = i5; nnodes[3] = i9;
-      refined->add_elem(nnodes);
-      nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i5; nnodes[3] = i7;
-      refined->add_elem(nnodes);
-      nnodes[0] =i6; nnodes[1] = i7; nnodes[2] = i5; nnodes[3] = i9;
-      refined->add_elem(nnodes);
-      nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-      refined->add_elem(nnodes);
-      nnodes[0] =i7; nnodes[1] = i8; nnodes[2] = i9; nnodes[3] = i3;
-      refined->add_elem(nnodes);
-      nnodes[0] =i6; nnodes[1] = i5; nnodes[2] = i2; nnodes[3] = i9;
-      refined->add_elem(nnodes);
-      if(field->basis_order() == 0) evalues.insert(evalues.end(),8,ivalues[*bi]);
+      add(i4, i1, i5, i8);
+      add(i4, i8, i5, i7);
+      add(i7, i8, i5, i9);
+      add(i6, i4, i5, i7);
+      add(i6, i7, i5, i9);
+      add(i0, i4, i6, i7);
+      add(i7, i8, i9, i3);
+      add(i6, i5, i2, i9);
     }
     else if (i5 == 0 && i8 == 0 && i9 == 0)
     {
       if ( i1 < i2 && i2 <i3)
       { //Checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i1; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i4, i1, i6, i7);
+        add(i6, i1, i2, i7);
+        add(i7, i1, i2, i3);
       }
       else if (i1 < i3 && i3 < i2)
       { // checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i1; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i1; nnodes[2] = i6; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i4, i1, i6, i7);
+        add(i7, i1, i6, i3);
+        add(i6, i1, i2, i3);
       }
       else if (i2< i1 && i1 < i3)
       { // checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i1;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i6, i4, i2, i7);
+        add(i7, i4, i2, i1);
+        add(i7, i1, i2, i3);
       }
       else if (i2 < i3 && i3 < i1)
       { // checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i1;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i6, i4, i2, i7);
+        add(i7, i4, i2, i3);
+        add(i3, i4, i2, i1);
       }
       else if (i3 < i1 && i1 < i2)
       { // checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i6; nnodes[2] = i7; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i1; nnodes[1] = i6; nnodes[2] = i4; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i1; nnodes[1] = i2; nnodes[2] = i6; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i4, i6, i7, i3);
+        add(i1, i6, i4, i3);
+        add(i1, i2, i6, i3);
       }
       else
       { // checked orientation
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i6; nnodes[2] = i7; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i2; nnodes[2] = i6; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i4, i6, i7, i3);
+        add(i4, i2, i6, i3);
+        add(i4, i1, i2, i3);
       }
     }
     else if (i4 == 0 && i7 == 0 && i8 == 0)
     {
       if ( i0 < i1 && i1 <i3)
       { //Checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i0; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i6, i0, i5, i9);
+        add(i5, i0, i1, i9);
+        add(i9, i0, i1, i3);
       }
       else if (i0 < i3 && i3 < i1)
       { // checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i0; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i0; nnodes[2] = i5; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i6, i0, i5, i9);
+        add(i9, i0, i5, i3);
+        add(i5, i0, i1, i3);
       }
       else if (i1< i0 && i0 < i3)
       { // checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i5, i6, i1, i9);
+        add(i9, i6, i1, i0);
+        add(i9, i0, i1, i3);
       }
       else if (i1 < i3 && i3 < i0)
       { // checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i5, i6, i1, i9);
+        add(i9, i6, i1, i3);
+        add(i3, i6, i1, i0);
       }
       else if (i3 < i0 && i0 < i1)
       { // checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i5; nnodes[2] = i9; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i0; nnodes[1] = i5; nnodes[2] = i6; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i0; nnodes[1] = i1; nnodes[2] = i5; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i6, i5, i9, i3);
+        add(i0, i5, i6, i3);
+        add(i0, i1, i5, i3);
       }
       else
       { // checked orientation
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i5; nnodes[2] = i9; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i1; nnodes[2] = i5; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i6, i5, i9, i3);
+        add(i6, i1, i5, i3);
+        add(i6, i0, i1, i3);
       }
     }
     else if (i6 == 0 && i9 == 0 && i7 == 0)
     {
       if ( i2 < i0 && i0 <i3)
       { //Checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i2; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i5, i2, i4, i8);
+        add(i4, i2, i0, i8);
+        add(i8, i2, i0, i3);
       }
       else if (i2 < i3 && i3 < i0)
       { // checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i2; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i2; nnodes[2] = i4; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i5, i2, i4, i8);
+        add(i8, i2, i4, i3);
+        add(i4, i2, i0, i3);
       }
       else if (i0< i2 && i2 < i3)
       { // checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i4, i5, i0, i8);
+        add(i8, i5, i0, i2);
+        add(i8, i2, i0, i3);
       }
       else if (i0 < i3 && i3 < i2)
       { // checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i4, i5, i0, i8);
+        add(i8, i5, i0, i3);
+        add(i3, i5, i0, i2);
       }
       else if (i3 < i2 && i2 < i0)
       { // checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i4; nnodes[2] = i8; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i4; nnodes[2] = i5; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i0; nnodes[2] = i4; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i5, i4, i8, i3);
+        add(i2, i4, i5, i3);
+        add(i2, i0, i4, i3);
       }
       else
       { // checked orientation
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i4; nnodes[2] = i8; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i0; nnodes[2] = i4; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i5, i4, i8, i3);
+        add(i5, i0, i4, i3);
+        add(i5, i2, i0, i3);
       }
     }
     else if (i5 == 0 && i6 == 0 && i4 == 0)
     {
       if ( i2 < i1 && i1 <i0)
       { //Checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i2; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i2; nnodes[2] = i1; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i2; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i9, i2, i8, i7);
+        add(i8, i2, i1, i7);
+        add(i7, i2, i1, i0);
       }
       else if (i2 < i0 && i0 < i1)
       { // checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i2; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i2; nnodes[2] = i8; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i2; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i9, i2, i8, i7);
+        add(i7, i2, i8, i0);
+        add(i8, i2, i1, i0);
       }
       else if (i1< i2 && i2 < i0)
       { // checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i9; nnodes[2] = i1; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i9; nnodes[2] = i1; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i2; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i8, i9, i1, i7);
+        add(i7, i9, i1, i2);
+        add(i7, i2, i1, i0);
       }
       else if (i1 < i0 && i0 < i2)
       { // checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i9; nnodes[2] = i1; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i9; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i0; nnodes[1] = i9; nnodes[2] = i1; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i8, i9, i1, i7);
+        add(i7, i9, i1, i0);
+        add(i0, i9, i1, i2);
       }
       else if (i0 < i2 && i2 < i1)
       { // checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i8; nnodes[2] = i7; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i8; nnodes[2] = i9; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i1; nnodes[2] = i8; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i9, i8, i7, i0);
+        add(i2, i8, i9, i0);
+        add(i2, i1, i8, i0);
       }
       else
       { // checked orientation
-        nnodes[0] =i3; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i8; nnodes[2] = i7; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i1; nnodes[2] = i8; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i2; nnodes[2] = i1; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),4,ivalues[*bi]);
+        add(i3, i9, i8, i7);
+        add(i9, i8, i7, i0);
+        add(i9, i1, i8, i0);
+        add(i9, i2, i1, i0);
       }
     }
     else if (i8 == 0)
     {
       if (i1 < i3)
       {
-        nnodes[0] =i2; nnodes[1] = i5; nnodes[2] = i9; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i1; nnodes[2] = i3; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i5; nnodes[2] = i1; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i4; nnodes[2] = i1; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i7; nnodes[2] = i6; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i2, i5, i9, i6);
+        add(i9, i1, i3, i7);
+        add(i9, i5, i1, i4);
+        add(i9, i6, i5, i4);
+        add(i9, i4, i1, i7);
+        add(i7, i4, i6, i9);
+        add(i4, i7, i6, i0);
       }
       else
       {
-        nnodes[0] =i2; nnodes[1] = i5; nnodes[2] = i9; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i5; nnodes[2] = i1; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i5; nnodes[2] = i3; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i5; nnodes[2] = i7; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i7; nnodes[2] = i6; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i7; nnodes[3] = i0;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i2, i5, i9, i6);
+        add(i3, i5, i1, i4);
+        add(i3, i5, i4, i7);
+        add(i9, i5, i3, i7);
+        add(i9, i5, i7, i6);
+        add(i5, i7, i6, i4);
+        add(i6, i4, i7, i0);
       }
     }
     else if (i9 == 0)
     {
       if (i2 < i3)
       {
-        nnodes[0] =i0; nnodes[1] = i6; nnodes[2] = i7; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i2; nnodes[2] = i3; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i6; nnodes[2] = i2; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i5; nnodes[2] = i2; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i8; nnodes[2] = i4; nnodes[3] = i1;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i0, i6, i7, i4);
+        add(i7, i2, i3, i8);
+        add(i7, i6, i2, i5);
+        add(i7, i4, i6, i5);
+        add(i7, i5, i2, i8);
+        add(i8, i5, i4, i7);
+        add(i5, i8, i4, i1);
       }
       else
       {
-        nnodes[0] =i0; nnodes[1] = i6; nnodes[2] = i7; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i6; nnodes[2] = i2; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i6; nnodes[2] = i3; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i6; nnodes[2] = i8; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i8; nnodes[2] = i4; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i8; nnodes[3] = i1;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i0, i6, i7, i4);
+        add(i3, i6, i2, i5);
+        add(i3, i6, i5, i8);
+        add(i7, i6, i3, i8);
+        add(i7, i6, i8, i4);
+        add(i6, i8, i4, i5);
+        add(i4, i5, i8, i1);
       }
     }
     else if (i7 == 0)
     {
       if (i0 < i3)
       {
-        nnodes[0] =i1; nnodes[1] = i4; nnodes[2] = i8; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i0; nnodes[2] = i3; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i4; nnodes[2] = i0; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i6; nnodes[2] = i0; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i9; nnodes[2] = i5; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i1, i4, i8, i5);
+        add(i8, i0, i3, i9);
+        add(i8, i4, i0, i6);
+        add(i8, i5, i4, i6);
+        add(i8, i6, i0, i9);
+        add(i9, i6, i5, i8);
+        add(i6, i9, i5, i2);
       }
       else
       {
-        nnodes[0] =i1; nnodes[1] = i4; nnodes[2] = i8; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i4; nnodes[2] = i0; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i3; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i4; nnodes[2] = i3; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i4; nnodes[2] = i9; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i9; nnodes[2] = i5; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i9; nnodes[3] = i2;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i1, i4, i8, i5);
+        add(i3, i4, i0, i6);
+        add(i3, i4, i6, i9);
+        add(i8, i4, i3, i9);
+        add(i8, i4, i9, i5);
+        add(i4, i9, i5, i6);
+        add(i5, i6, i9, i2);
       }
     }
     else if (i6 == 0)
     {
       if (i2 < i0)
       {
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i2; nnodes[2] = i0; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i2; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i8; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i9; nnodes[2] = i2; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i9; nnodes[2] = i8; nnodes[3] = i4;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i7; nnodes[2] = i8; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i4, i2, i0, i7);
+        add(i4, i5, i2, i9);
+        add(i4, i8, i5, i9);
+        add(i4, i9, i2, i7);
+        add(i7, i9, i8, i4);
+        add(i9, i7, i8, i3);
       }
       else
       {
-        nnodes[0] =i1; nnodes[1] = i5; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i0; nnodes[1] = i5; nnodes[2] = i2; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i0; nnodes[1] = i5; nnodes[2] = i9; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i0; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i5; nnodes[2] = i7; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i7; nnodes[2] = i8; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i9; nnodes[2] = i7; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i1, i5, i4, i8);
+        add(i0, i5, i2, i9);
+        add(i0, i5, i9, i7);
+        add(i4, i5, i0, i7);
+        add(i4, i5, i7, i8);
+        add(i5, i7, i8, i9);
+        add(i8, i9, i7, i3);
       }
     }
     else if (i5 == 0)
     {
       if (i1 < i2)
       {
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i1; nnodes[2] = i2; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i1; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i7; nnodes[2] = i4; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i8; nnodes[2] = i1; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i8; nnodes[2] = i7; nnodes[3] = i6;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i9; nnodes[2] = i7; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i6, i1, i2, i9);
+        add(i6, i4, i1, i8);
+        add(i6, i7, i4, i8);
+        add(i6, i8, i1, i9);
+        add(i9, i8, i7, i6);
+        add(i8, i9, i7, i3);
       }
       else
       {
-        nnodes[0] =i0; nnodes[1] = i4; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i4; nnodes[2] = i1; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i2; nnodes[1] = i4; nnodes[2] = i8; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i2; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i4; nnodes[2] = i9; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i4; nnodes[1] = i9; nnodes[2] = i7; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i8; nnodes[2] = i9; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i0, i4, i6, i7);
+        add(i2, i4, i1, i8);
+        add(i2, i4, i8, i9);
+        add(i6, i4, i2, i9);
+        add(i6, i4, i9, i7);
+        add(i4, i9, i7, i8);
+        add(i7, i8, i9, i3);
       }
     }
     else if (i4 == 0)
     {
       if (i0 < i1)
       {
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i0; nnodes[2] = i1; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i0; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i9; nnodes[2] = i6; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i7; nnodes[2] = i0; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i8; nnodes[1] = i7; nnodes[2] = i9; nnodes[3] = i5;
-        refined->add_elem(nnodes);
-        nnodes[0] =i7; nnodes[1] = i8; nnodes[2] = i9; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i5, i0, i1, i8);
+        add(i5, i6, i0, i7);
+        add(i5, i9, i6, i7);
+        add(i5, i7, i0, i8);
+        add(i8, i7, i9, i5);
+        add(i7, i8, i9, i3);
       }
       else
       {
-        nnodes[0] =i2; nnodes[1] = i6; nnodes[2] = i5; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i1; nnodes[1] = i6; nnodes[2] = i0; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i1; nnodes[1] = i6; nnodes[2] = i7; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i1; nnodes[3] = i8;
-        refined->add_elem(nnodes);
-        nnodes[0] =i5; nnodes[1] = i6; nnodes[2] = i8; nnodes[3] = i9;
-        refined->add_elem(nnodes);
-        nnodes[0] =i6; nnodes[1] = i8; nnodes[2] = i9; nnodes[3] = i7;
-        refined->add_elem(nnodes);
-        nnodes[0] =i9; nnodes[1] = i7; nnodes[2] = i8; nnodes[3] = i3;
-        refined->add_elem(nnodes);
-        if(field->basis_order() == 0) evalues.insert(evalues.end(),7,ivalues[*bi]);
+        add(i2, i6, i5, i9);
+        add(i1, i6, i0, i7);
+        add(i1, i6, i7, i8);
+        add(i5, i6, i1, i8);
+        add(i5, i6, i8, i9);
+        add(i6, i8, i9, i7);
+        add(i9, i7, i8, i3);
       }
     }
-    ++bi;
+
+    return count;
   }
+}
+
+RefineMeshTetVolAlgoV::RefineMeshTetVolAlgoV()
+{
+
+}
+
+bool
+RefineMeshTetVolAlgoV::runImpl(FieldHandle input, FieldHandle& output,
+                      const std::string& select, double isoval) const
+{
+  FieldInformation fi(input);
+
+  fi.make_tetvolmesh();
+
+  output = CreateField(fi);
+
+  if (!output)
+  {
+    error("Could not create an output field");
+    return (false);
+  }
+
+  VField* field   = input->vfield();
+  VMesh*  mesh    = input->vmesh();
+  VMesh*  refined = output->vmesh();
+  VField* rfield  = output->vfield();
+
+  VMesh::Node::array_type onodes(4);
+
+  VMesh::size_type num_nodes = mesh->num_nodes();
+  VMesh::size_type num_elems = mesh->num_elems();
+  std::vector<bool> values(num_nodes,false);
+
+  // Deal with data stored at different locations
+  // If data is on the elements make sure that all nodes
+  // of that element pass requirement.
+
+  std::vector<double> ivalues;
+  std::vector<double> evalues;
+
+  if (field->basis_order() == 0)
+  {
+    field->get_values(ivalues);
+
+    if (select == "equal")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
+      {
+        mesh->get_nodes(onodes,i);
+        if (ivalues[i] == isoval)
+          for (size_t j=0; j< onodes.size(); j++)
+            values[onodes[j]] = true;
+      }
+    }
+    else if (select == "lessthan")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
+      {
+        mesh->get_nodes(onodes,i);
+        if (ivalues[i] < isoval)
+          for (size_t j=0; j< onodes.size(); j++)
+            values[onodes[j]] = true;
+      }
+    }
+    else if (select == "greaterthan")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_elems; i++)
+      {
+        mesh->get_nodes(onodes,i);
+        if (ivalues[i] > isoval)
+          for (size_t j=0; j< onodes.size(); j++)
+            values[onodes[j]] = true;
+      }
+    }
+    else if (select == "all")
+    {
+      for (size_t j=0;j<values.size();j++) values[j] = true;
+    }
+    else
+    {
+      error("Unknown region selection method encountered");
+      return (false);
+    }
+  }
+  else if (field->basis_order() == 1)
+  {
+    field->get_values(ivalues);
+
+    if (select == "equal")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
+      {
+        if (ivalues[i] == isoval) values[i] = true;
+      }
+    }
+    else if (select == "lessthan")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
+      {
+        if (ivalues[i] < isoval) values[i] = true;
+      }
+    }
+    else if (select == "greaterthan")
+    {
+      for (VMesh::Elem::index_type i=0; i<num_nodes; i++)
+      {
+        if (ivalues[i] > isoval) values[i] = true;
+      }
+    }
+    else if (select == "all")
+    {
+      for (size_t j=0;j<values.size();j++) values[j] = true;
+    }
+    else
+    {
+      error("RefineMesh: Unknown region selection method encountered");
+      return (false);
+    }
+
+  }
+  else
+  {
+    for (size_t j=0;j<values.size();j++) values[j] = true;
+  }
+
+  // Number the edges that get a new node in advance. Every element reports
+  // its refined edges, and the sorted table gives each unique edge its node
+  // index, so all later passes can run per element without shared lookups.
+  const int nproc = Parallel::NumCores();
+  std::vector<NodePairTable::entry_list_type> lists(nproc);
+
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type start = (num_elems*proc)/nproc;
+    const VMesh::index_type end = (num_elems*(proc+1))/nproc;
+    VMesh::Node::array_type nodes(4);
+    for (VMesh::Elem::index_type idx = start; idx < end; idx++)
+    {
+      mesh->get_nodes(nodes, idx);
+      for (int k = 0; k < 6; k++)
+      {
+        const VMesh::index_type a = nodes[tet_edges[k][0]];
+        const VMesh::index_type b = nodes[tet_edges[k][1]];
+        if (a != b && (values[a] || values[b]))
+          lists[proc].push_back({ std::min(a, b), std::max(a, b), idx });
+      }
+    }
+  }, nproc);
+
+  const NodePairTable edges(lists, num_nodes);
+  const VMesh::size_type num_rnodes = num_nodes + edges.size();
+  const int basis_order = field->basis_order();
+
+  // The original nodes keep their indices; edge nodes follow in table order.
+  refined->resize_nodes(num_rnodes);
+  if (basis_order == 1) ivalues.resize(num_rnodes);
+
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type start = (num_nodes*proc)/nproc;
+    const VMesh::index_type end = (num_nodes*(proc+1))/nproc;
+    Point p;
+    for (VMesh::Node::index_type idx = start; idx < end; idx++)
+    {
+      mesh->get_point(p, idx);
+      refined->set_point(p, idx);
+    }
+
+    const VMesh::index_type estart = (edges.size()*proc)/nproc;
+    const VMesh::index_type eend = (edges.size()*(proc+1))/nproc;
+    Point p0, p1;
+    for (VMesh::index_type idx = estart; idx < eend; idx++)
+    {
+      const NodePairTable::Entry& e = edges[idx];
+      mesh->get_center(p0, VMesh::Node::index_type(e.first));
+      mesh->get_center(p1, VMesh::Node::index_type(e.second));
+      refined->set_point((p0 + p1).asPoint()*0.5, VMesh::Node::index_type(num_nodes + idx));
+      if (basis_order == 1)
+        ivalues[num_nodes + idx] = 0.5*(ivalues[e.first] + ivalues[e.second]);
+    }
+  }, nproc);
+
+  // Split the elements in two passes over the same ranges: count the children
+  // of each range, then write them at the range's offset. This keeps the
+  // children in input element order.
+  auto split = [&](VMesh::Elem::index_type idx, VMesh::Node::array_type& nodes,
+                   VMesh::index_type* children)
+  {
+    mesh->get_nodes(nodes, idx);
+    VMesh::index_type n[10];
+    for (int k = 0; k < 4; k++) n[k] = nodes[k];
+    for (int k = 0; k < 6; k++)
+    {
+      const VMesh::index_type a = nodes[tet_edges[k][0]];
+      const VMesh::index_type b = nodes[tet_edges[k][1]];
+      const VMesh::index_type e = (a == b) ? -1 : edges.find(std::min(a, b), std::max(a, b));
+      n[4+k] = (e < 0) ? 0 : num_nodes + e;
+    }
+    return split_tet(n, children);
+  };
+
+  std::vector<VMesh::size_type> num_children(nproc + 1, 0);
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type start = (num_elems*proc)/nproc;
+    const VMesh::index_type end = (num_elems*(proc+1))/nproc;
+    VMesh::Node::array_type nodes(4);
+    VMesh::index_type children[32];
+    for (VMesh::Elem::index_type idx = start; idx < end; idx++)
+      num_children[proc + 1] += split(idx, nodes, children);
+  }, nproc);
+
+  for (int proc = 0; proc < nproc; proc++)
+    num_children[proc + 1] += num_children[proc];
+
+  refined->resize_elems(num_children[nproc]);
+  if (basis_order == 0) evalues.resize(num_children[nproc]);
+
+  // The children are written straight into the cell array: set_nodes may
+  // update the synchronization tables under the mesh lock, which would
+  // serialize the threads. The tables are reset once all cells are in place.
+  VMesh::index_type* cells = refined->get_elems_pointer();
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const VMesh::index_type start = (num_elems*proc)/nproc;
+    const VMesh::index_type end = (num_elems*(proc+1))/nproc;
+    VMesh::Node::array_type nodes(4);
+    VMesh::index_type children[32];
+    VMesh::index_type cidx = num_children[proc];
+    for (VMesh::Elem::index_type idx = start; idx < end; idx++)
+    {
+      const int count = split(idx, nodes, children);
+      for (int c = 0; c < count; c++, cidx++)
+      {
+        for (int k = 0; k < 4; k++) cells[4*cidx + k] = children[4*c + k];
+        if (basis_order == 0) evalues[cidx] = ivalues[idx];
+      }
+    }
+  }, nproc);
+  refined->clear_synchronization();
 
   rfield->resize_values();
   if (rfield->basis_order() == 0) rfield->set_values(evalues);
@@ -675,13 +675,15 @@ bool GenerateStreamLinesAlgo::runImpl(FieldHandle input, FieldHandle seeds, Fiel
   }
 
   const bool autoParams = get(Parameters::AutoParameters).toBool();
+  // The integrators walk from element to element across the dual elements
+  // before falling back to the locate grid.
   if (autoParams)
   {
-    mesh->synchronize(Mesh::EPSILON_E | Mesh::ELEM_LOCATE_E | Mesh::EDGES_E | Mesh::FACES_E);
+    mesh->synchronize(Mesh::EPSILON_E | Mesh::ELEM_LOCATE_E | Mesh::EDGES_E | Mesh::FACES_E | Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
   }
   else
   {
-    mesh->synchronize(Mesh::EPSILON_E | Mesh::ELEM_LOCATE_E | Mesh::FACES_E);
+    mesh->synchronize(Mesh::EPSILON_E | Mesh::ELEM_LOCATE_E | Mesh::FACES_E | Mesh::DELEMS_E | Mesh::ELEM_NEIGHBORS_E);
   }
 
   bool success = false;
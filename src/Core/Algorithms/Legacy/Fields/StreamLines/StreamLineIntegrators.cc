@@ -33,6 +33,8 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <algorithm>
+#include <cfloat>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
@@ -49,7 +51,112 @@ StreamLineIntegrators::interpolate( const Point &p,
   //  vfield_->interpolate(v, p);
   //  return (v.safe_normalize() > 0.0);
 
-  return vfield_->interpolate(v, p);
+  if (!locate(p))
+    return (false);
+
+  vfield_->interpolate(v, coords_, elem_);
+  return (true);
+}
+
+
+// Maximum number of elements visited before giving up on walking
+static const int max_walk_steps = 8;
+
+bool
+StreamLineIntegrators::locate(const Point &p)
+{
+  VMesh* mesh = vfield_->vmesh();
+
+  // Regular grids compute the element index from the point directly.
+  if (mesh->is_regularmesh() || elem_ < 0 || !walk_)
+    return (mesh->locate(elem_, coords_, p));
+
+  // Consecutive sub-steps nearly always stay in the same element or move
+  // to a neighbor, so walk from the last element toward the point.
+  VMesh::Elem::index_type elem = elem_, previous = -1, next;
+  for (int step = 0; step < max_walk_steps; step++)
+  {
+    if (mesh->get_coords(coords_, p, elem))
+    {
+      elem_ = elem;
+      return (true);
+    }
+
+    if (!walk(mesh, p, elem, previous, next))
+      break;
+
+    previous = elem;
+    elem = next;
+  }
+
+  return (mesh->locate(elem_, coords_, p));
+}
+
+
+/// Pick the neighbor of element 'from' that is the next one on the way to
+/// point p. coords_ must hold the local coordinates of p relative to 'from'.
+bool
+StreamLineIntegrators::walk(VMesh* mesh, const Point &p,
+                            VMesh::Elem::index_type from,
+                            VMesh::Elem::index_type previous,
+                            VMesh::Elem::index_type &next)
+{
+  VMesh::Node::array_type nodes;
+  mesh->get_nodes(nodes, from);
+
+  const size_t dim = mesh->dimensionality();
+  if (dim > 0 && nodes.size() == dim + 1 && mesh->is_linearmesh())
+  {
+    // Simplices: leave through the face opposite to the node with the most
+    // negative barycentric coordinate.
+    double lambda = 1.0;
+    for (size_t k = 0; k < dim; k++)
+      lambda -= coords_[k];
+
+    size_t exit_node = 0;
+    for (size_t k = 0; k < dim; k++)
+    {
+      if (coords_[k] < lambda)
+      {
+        lambda = coords_[k];
+        exit_node = k + 1;
+      }
+    }
+
+    VMesh::DElem::array_type delems;
+    VMesh::Node::array_type dnodes;
+    mesh->get_delems(delems, from);
+    for (size_t r = 0; r < delems.size(); r++)
+    {
+      mesh->get_nodes(dnodes, delems[r]);
+      if (std::find(dnodes.begin(), dnodes.end(), nodes[exit_node]) == dnodes.end())
+        return (mesh->get_neighbor(next, from, delems[r]));
+    }
+    return (false);
+  }
+
+  // Other element types: move to the neighbor whose center is closest.
+  VMesh::Elem::array_type neighbors;
+  mesh->get_neighbors(neighbors, from);
+
+  double mindist = DBL_MAX;
+  bool found = false;
+  Point center;
+  for (size_t r = 0; r < neighbors.size(); r++)
+  {
+    if (neighbors[r] == previous)
+      continue;
+
+    mesh->get_center(center, neighbors[r]);
+    const double dist = (center - p).length2();
+    if (dist < mindist)
+    {
+      mindist = dist;
+      next = neighbors[r];
+      found = true;
+    }
+  }
+  return (found);
 }
 
 
@@ -259,6 +366,9 @@ StreamLineIntegrators::ComputeRKFTerms(Vector v[6],       // storage for terms
 void
 StreamLineIntegrators::integrate(IntegrationMethod method)
 {
+  // The seed may be anywhere in the mesh, so start with a full locate.
+  elem_ = -1;
+
   switch ( method )
   {
   case IntegrationMethod::AdamsBashforth:
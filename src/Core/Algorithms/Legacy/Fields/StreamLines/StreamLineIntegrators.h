@@ -33,6 +33,7 @@
 #define CORE_ALGORITHMS_FIELDS_STREAMLINES_STREAMLINEINTEGRATORS_H 1
 
 #include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/GeometryPrimitives/Point.h>
 #include <Core/GeometryPrimitives/Vector.h>
 
@@ -78,6 +79,7 @@ namespace SCIRun {
           double step_size_;                    // initial step size
           unsigned int max_steps_;              // max number of steps
           VField* vfield_;     // the field
+          bool walk_ {true};   // false locates every sub-step with a full mesh search
 
           std::vector<Geometry::Point> nodes_;                // storage for points
 
@@ -87,6 +89,17 @@ namespace SCIRun {
             double s);        // current step size
 
           bool interpolate(const Geometry::Point &p, Geometry::Vector &v);
+
+          // Point location that starts from the element of the previous
+          // sub-step and walks to a neighbor before falling back to the
+          // search grid of the mesh.
+          bool locate(const Geometry::Point &p);
+          bool walk(VMesh* mesh, const Geometry::Point &p,
+            VMesh::Elem::index_type from, VMesh::Elem::index_type previous,
+            VMesh::Elem::index_type &next);
+
+          VMesh::Elem::index_type elem_ {-1};    // element of the last located point
+          VMesh::coords_type coords_;           // local coordinates in elem_
         };
 
       }
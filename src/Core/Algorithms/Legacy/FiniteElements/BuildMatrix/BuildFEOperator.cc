@@ -0,0 +1,506 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Legacy/FiniteElements/BuildMatrix/BuildFEOperator.h>
+#include <Core/Algorithms/Legacy/FiniteElements/BuildMatrix/BuildFEMatrix.h>
+
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/GeometryPrimitives/Tensor.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Thread/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Algorithms::FiniteElements;
+
+namespace
+{
+  const int NumHexNodes = 8;
+  const int HexMatrixSize = NumHexNodes*NumHexNodes;
+  const int NumTensorComponents = 6;
+
+  // Jacobian J(a,b) = dx_b/dxi_a of a trilinear hexahedron at one quadrature
+  // point, dN holds the derivatives of the 8 basis functions in xi, eta, zeta.
+  double hexJacobian(const double* xyz, const double* dN, double* J)
+  {
+    for (int a = 0; a < 3; a++)
+    {
+      double jx = 0.0, jy = 0.0, jz = 0.0;
+      for (int l = 0; l < NumHexNodes; l++)
+      {
+        const double d = dN[a*NumHexNodes + l];
+        jx += d*xyz[3*l];
+        jy += d*xyz[3*l+1];
+        jz += d*xyz[3*l+2];
+      }
+      J[3*a] = jx; J[3*a+1] = jy; J[3*a+2] = jz;
+    }
+    return J[0]*(J[4]*J[8] - J[5]*J[7]) - J[1]*(J[3]*J[8] - J[5]*J[6]) + J[2]*(J[3]*J[7] - J[4]*J[6]);
+  }
+
+  // Element stiffness matrix of a trilinear hexahedron for the symmetric
+  // conductivity C = (xx,xy,xz,yy,yz,zz). This is the same integral as
+  // FEMBuilder::build_local_matrix, computed for all rows at once.
+  bool hexElementMatrix(const double* xyz, const double* C,
+                        const std::vector<double>& qweights,
+                        const std::vector<double>& qderivatives,
+                        double* ke)
+  {
+    std::fill(ke, ke + HexMatrixSize, 0.0);
+
+    for (size_t q = 0; q < qweights.size(); q++)
+    {
+      const double* dN = &qderivatives[q*3*NumHexNodes];
+      double J[9];
+      const double detJ = hexJacobian(xyz, dN, J);
+      if (detJ <= 0.0)
+        return false;
+
+      const double idet = 1.0/detJ;
+      const double Ji[9] = {
+        (J[4]*J[8] - J[5]*J[7])*idet, (J[2]*J[7] - J[1]*J[8])*idet, (J[1]*J[5] - J[2]*J[4])*idet,
+        (J[5]*J[6] - J[3]*J[8])*idet, (J[0]*J[8] - J[2]*J[6])*idet, (J[2]*J[3] - J[0]*J[5])*idet,
+        (J[3]*J[7] - J[4]*J[6])*idet, (J[1]*J[6] - J[0]*J[7])*idet, (J[0]*J[4] - J[1]*J[3])*idet };
+
+      const double w = qweights[q]*detJ;
+
+      // Gradients of the basis functions in world coordinates and the
+      // same gradients multiplied with the weighted conductivity tensor
+      double gx[NumHexNodes], gy[NumHexNodes], gz[NumHexNodes];
+      double cx[NumHexNodes], cy[NumHexNodes], cz[NumHexNodes];
+      for (int l = 0; l < NumHexNodes; l++)
+      {
+        const double dxi = dN[l], deta = dN[NumHexNodes + l], dzeta = dN[2*NumHexNodes + l];
+        gx[l] = Ji[0]*dxi + Ji[1]*deta + Ji[2]*dzeta;
+        gy[l] = Ji[3]*dxi + Ji[4]*deta + Ji[5]*dzeta;
+        gz[l] = Ji[6]*dxi + Ji[7]*deta + Ji[8]*dzeta;
+        cx[l] = w*(C[0]*gx[l] + C[1]*gy[l] + C[2]*gz[l]);
+        cy[l] = w*(C[1]*gx[l] + C[3]*gy[l] + C[4]*gz[l]);
+        cz[l] = w*(C[2]*gx[l] + C[4]*gy[l] + C[5]*gz[l]);
+      }
+
+      for (int i = 0; i < NumHexNodes; i++)
+      {
+        double* row = ke + i*NumHexNodes;
+        for (int j = 0; j < NumHexNodes; j++)
+          row[j] += gx[i]*cx[j] + gy[i]*cy[j] + gz[i]*cz[j];
+      }
+    }
+    return true;
+  }
+}
+
+const double* StructuredFEOperator::conductivity(index_type cell) const
+{
+  if (!cell_index_.empty())
+    return &conductivity_[cell_index_[cell]*ncomp_];
+  return &conductivity_[cell*ncomp_];
+}
+
+// Fills the 8x8 element matrix, returns false for cells without conductivity
+bool StructuredFEOperator::elementMatrix(index_type cell, const index_type* nodes, double* ke) const
+{
+  const double* C = conductivity(cell);
+  double tensor[NumTensorComponents];
+
+  if (ncomp_ == 1)
+  {
+    if (C[0] == 0.0)
+      return false;
+
+    if (points_.empty())
+    {
+      const double* iso = &unit_matrices_[NumTensorComponents*HexMatrixSize];
+      for (int m = 0; m < HexMatrixSize; m++)
+        ke[m] = C[0]*iso[m];
+      return true;
+    }
+    tensor[0] = C[0]; tensor[1] = 0.0; tensor[2] = 0.0;
+    tensor[3] = C[0]; tensor[4] = 0.0; tensor[5] = C[0];
+  }
+  else
+  {
+    if (std::all_of(C, C + NumTensorComponents, [](double c) { return c == 0.0; }))
+      return false;
+
+    if (points_.empty())
+    {
+      std::fill(ke, ke + HexMatrixSize, 0.0);
+      for (int c = 0; c < NumTensorComponents; c++)
+      {
+        if (C[c] == 0.0)
+          continue;
+        const double* unit = &unit_matrices_[c*HexMatrixSize];
+        for (int m = 0; m < HexMatrixSize; m++)
+          ke[m] += C[c]*unit[m];
+      }
+      return true;
+    }
+    std::copy(C, C + NumTensorComponents, tensor);
+  }
+
+  double xyz[3*NumHexNodes];
+  for (int l = 0; l < NumHexNodes; l++)
+  {
+    const double* p = &points_[3*nodes[l]];
+    xyz[3*l] = p[0]; xyz[3*l+1] = p[1]; xyz[3*l+2] = p[2];
+  }
+  // Jacobians were checked when building the operator
+  hexElementMatrix(xyz, tensor, qweights_, qderivatives_, ke);
+  return true;
+}
+
+// Calls kernel(cell, nodes) for every cell that has at least one node in the
+// row range [begin, end). Cells on the border of the range are visited by
+// both threads sharing them, each one only updating its own rows.
+template <class CellKernel>
+void StructuredFEOperator::visitCells(index_type begin, index_type end, CellKernel kernel) const
+{
+  const index_type ni = ni_;
+  const index_type nij = ni_*nj_;
+
+  index_type kfirst = begin / nij;
+  if (kfirst > 0) kfirst--;
+  const index_type klast = std::min((end - 1) / nij, nk_ - 2);
+
+  index_type nodes[NumHexNodes];
+  for (index_type k = kfirst; k <= klast; k++)
+  {
+    for (index_type j = 0; j < nj_ - 1; j++)
+    {
+      const index_type row = ni*(j + nj_*k);
+      if (row + nij + 2*ni <= begin) continue;
+      if (row >= end) return;
+
+      for (index_type i = 0; i < ni - 1; i++)
+      {
+        // Same node order as LatVolMesh::get_nodes for a cell
+        const index_type base = row + i;
+        nodes[0] = base;       nodes[1] = base + 1;
+        nodes[2] = base+ni+1;  nodes[3] = base + ni;
+        nodes[4] = base + nij; nodes[5] = base + nij + 1;
+        nodes[6] = base+nij+ni+1; nodes[7] = base + nij + ni;
+
+        if (nodes[6] < begin || nodes[0] >= end)
+          continue;
+
+        kernel(i + (ni - 1)*(j + (nj_ - 1)*k), nodes);
+      }
+    }
+  }
+}
+
+void StructuredFEOperator::apply(const double* x, double* r, index_type begin, index_type end) const
+{
+  std::fill(r + begin, r + end, 0.0);
+
+  double ke[HexMatrixSize];
+  visitCells(begin, end, [&](index_type cell, const index_type* nodes)
+  {
+    if (!elementMatrix(cell, nodes, ke))
+      return;
+
+    double xe[NumHexNodes];
+    for (int l = 0; l < NumHexNodes; l++)
+      xe[l] = x[nodes[l]];
+
+    for (int l = 0; l < NumHexNodes; l++)
+    {
+      if (nodes[l] < begin || nodes[l] >= end)
+        continue;
+      const double* row = ke + l*NumHexNodes;
+      double sum = 0.0;
+      for (int m = 0; m < NumHexNodes; m++)
+        sum += row[m]*xe[m];
+      r[nodes[l]] += sum;
+    }
+  });
+}
+
+void StructuredFEOperator::diagonal(double* r, index_type begin, index_type end) const
+{
+  std::fill(r + begin, r + end, 0.0);
+
+  double ke[HexMatrixSize];
+  visitCells(begin, end, [&](index_type cell, const index_type* nodes)
+  {
+    if (!elementMatrix(cell, nodes, ke))
+      return;
+
+    for (int l = 0; l < NumHexNodes; l++)
+    {
+      if (nodes[l] >= begin && nodes[l] < end)
+        r[nodes[l]] += ke[l*NumHexNodes + l];
+    }
+  });
+}
+
+size_t StructuredFEOperator::memoryUsage() const
+{
+  return sizeof(*this) +
+    sizeof(double)*(qweights_.capacity() + qderivatives_.capacity() +
+      conductivity_.capacity() + unit_matrices_.capacity() + points_.capacity()) +
+    sizeof(int)*cell_index_.capacity();
+}
+
+bool
+BuildFEOperatorAlgo::run(FieldHandle input, DenseMatrixHandle ctable, LinearOperatorHandle& output) const
+{
+  ScopedAlgorithmStatusReporter s(this, "BuildFEOperator");
+
+  if (!input)
+  {
+    error("Could not obtain input field");
+    return false;
+  }
+
+  auto field = input->vfield();
+  auto mesh = input->vmesh();
+
+  if (!mesh->is_latvolmesh() && !mesh->is_structhexvolmesh())
+  {
+    error("The matrix-free operator is only available for LatVolMesh and StructHexVolMesh, use BuildFEMatrix for other meshes");
+    return false;
+  }
+
+  if (field->is_vector())
+  {
+    error("This function has not yet been defined for elements with vector data");
+    return false;
+  }
+
+  if (field->basis_order() != 0)
+  {
+    error("This function has only been defined for data that is located at the elements");
+    return false;
+  }
+
+  if (ctable)
+  {
+    if ((ctable->ncols() != 1)&&(ctable->ncols() != 6)&&(ctable->ncols() != 9))
+    {
+      error("Conductivity table needs to have 1, 6, or 9 columns");
+      return false;
+    }
+    if (ctable->nrows() == 0)
+    {
+      error("ConductivityTable is empty");
+      return false;
+    }
+  }
+
+  VMesh::dimension_type dims;
+  mesh->get_dimensions(dims);
+  if (dims.size() != 3 || dims[0] < 2 || dims[1] < 2 || dims[2] < 2)
+  {
+    error("Mesh needs at least two nodes in every direction");
+    return false;
+  }
+
+  boost::shared_ptr<StructuredFEOperator> op(new StructuredFEOperator);
+  op->ni_ = dims[0];
+  op->nj_ = dims[1];
+  op->nk_ = dims[2];
+  const size_type ncells = (dims[0] - 1)*(dims[1] - 1)*(dims[2] - 1);
+
+  // Same integration scheme as BuildFEMatrix uses for hexahedral elements
+  std::vector<VMesh::coords_type> qpoints;
+  std::vector<double> qweights;
+  mesh->get_gaussian_scheme(qpoints, qweights, 2);
+  const double vol = mesh->get_element_size();
+  for (size_t q = 0; q < qpoints.size(); q++)
+  {
+    std::vector<double> d;
+    mesh->get_derivate_weights(qpoints[q], d, 1);
+    if (d.size() != 3*NumHexNodes)
+    {
+      error("Unexpected number of basis derivatives for a hexahedral element");
+      return false;
+    }
+    op->qweights_.push_back(qweights[q]*vol);
+    op->qderivatives_.insert(op->qderivatives_.end(), d.begin(), d.end());
+  }
+
+  if (ctable)
+  {
+    const size_type n = ctable->ncols();
+    const size_type ntable = ctable->nrows();
+    auto data = ctable->data();
+
+    op->ncomp_ = (n == 1) ? 1 : NumTensorComponents;
+    op->conductivity_.reserve(ntable*op->ncomp_);
+    for (size_type p = 0; p < ntable; p++)
+    {
+      const double* t = data + p*n;
+      if (n == 1)
+        op->conductivity_.push_back(t[0]);
+      else if (n == 6)
+        op->conductivity_.insert(op->conductivity_.end(), t, t + 6);
+      else
+      {
+        const double sym[NumTensorComponents] = { t[0], t[1], t[2], t[4], t[5], t[8] };
+        op->conductivity_.insert(op->conductivity_.end(), sym, sym + NumTensorComponents);
+      }
+    }
+
+    op->cell_index_.resize(ncells);
+    for (VMesh::index_type c = 0; c < ncells; c++)
+    {
+      int idx;
+      field->get_value(idx, c);
+      if (idx < 0 || idx >= ntable)
+      {
+        error("Conductivity index is outside the range of the conductivity table");
+        return false;
+      }
+      op->cell_index_[c] = idx;
+    }
+  }
+  else if (field->is_tensor())
+  {
+    op->ncomp_ = NumTensorComponents;
+    op->conductivity_.resize(ncells*NumTensorComponents);
+    Tensor tensor;
+    for (VMesh::index_type c = 0; c < ncells; c++)
+    {
+      field->get_value(tensor, c);
+      double* C = &op->conductivity_[c*NumTensorComponents];
+      C[0] = tensor.val(0,0); C[1] = tensor.val(0,1); C[2] = tensor.val(0,2);
+      C[3] = tensor.val(1,1); C[4] = tensor.val(1,2); C[5] = tensor.val(2,2);
+    }
+  }
+  else
+  {
+    op->ncomp_ = 1;
+    op->conductivity_.resize(ncells);
+    for (VMesh::index_type c = 0; c < ncells; c++)
+      field->get_value(op->conductivity_[c], c);
+  }
+
+  if (mesh->is_latvolmesh())
+  {
+    // All cells of a LatVol have the same shape, so one set of element
+    // matrices, one per tensor component, describes the whole mesh
+    VMesh::Node::array_type nodes;
+    mesh->get_nodes(nodes, VMesh::Elem::index_type(0));
+    double xyz[3*NumHexNodes];
+    for (int l = 0; l < NumHexNodes; l++)
+    {
+      Point p;
+      mesh->get_point(p, nodes[l]);
+      xyz[3*l] = p.x(); xyz[3*l+1] = p.y(); xyz[3*l+2] = p.z();
+    }
+
+    op->unit_matrices_.assign((NumTensorComponents + 1)*HexMatrixSize, 0.0);
+    for (int c = 0; c < NumTensorComponents; c++)
+    {
+      double C[NumTensorComponents] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      C[c] = 1.0;
+      if (!hexElementMatrix(xyz, C, op->qweights_, op->qderivatives_, &op->unit_matrices_[c*HexMatrixSize]))
+      {
+        error("Mesh has elements with negative jacobians, check the order of the nodes that define an element");
+        return false;
+      }
+    }
+
+    double* iso = &op->unit_matrices_[NumTensorComponents*HexMatrixSize];
+    for (int m = 0; m < HexMatrixSize; m++)
+      iso[m] = op->unit_matrices_[m] + op->unit_matrices_[3*HexMatrixSize + m] + op->unit_matrices_[5*HexMatrixSize + m];
+  }
+  else
+  {
+    const size_type nnodes = op->nrows();
+    op->points_.resize(3*nnodes);
+    for (VMesh::index_type n = 0; n < nnodes; n++)
+    {
+      Point p;
+      mesh->get_point(p, VMesh::Node::index_type(n));
+      op->points_[3*n] = p.x(); op->points_[3*n+1] = p.y(); op->points_[3*n+2] = p.z();
+    }
+
+    // Check the jacobians once here, so the products do not need to
+    const int nproc = Parallel::NumCores();
+    std::atomic<bool> valid(true);
+    const StructuredFEOperator& sop = *op;
+    Parallel::RunTasks([&](int proc)
+    {
+      const index_type begin = proc*(nnodes/nproc);
+      const index_type end = (proc == nproc - 1) ? nnodes : (proc + 1)*(nnodes/nproc);
+      if (begin >= end)
+        return;
+      sop.visitCells(begin, end, [&](index_type, const index_type* cellNodes)
+      {
+        double xyz[3*NumHexNodes];
+        for (int l = 0; l < NumHexNodes; l++)
+          std::copy_n(&sop.points_[3*cellNodes[l]], 3, xyz + 3*l);
+        for (size_t q = 0; q < sop.qweights_.size(); q++)
+        {
+          double J[9];
+          if (hexJacobian(xyz, &sop.qderivatives_[q*3*NumHexNodes], J) <= 0.0)
+            valid = false;
+        }
+      });
+    }, nproc);
+
+    if (!valid)
+    {
+      error("Mesh has elements with negative jacobians, check the order of the nodes that define an element");
+      return false;
+    }
+  }
+
+  output = op;
+  return true;
+}
+
+const AlgorithmOutputName BuildFEOperatorAlgo::Stiffness_Operator("Stiffness_Operator");
+
+AlgorithmOutput BuildFEOperatorAlgo::run(const AlgorithmInput& input) const
+{
+  auto field = input.get<Field>(Variables::InputField);
+  auto ctable = input.get<DenseMatrix>(BuildFEMatrixAlgo::Conductivity_Table);
+
+  LinearOperatorHandle op;
+  if (!run(field, ctable, op))
+    THROW_ALGORITHM_PROCESSING_ERROR("False returned on legacy run call.");
+
+  AlgorithmOutput output;
+  output[Stiffness_Operator] = boost::make_shared<LinearOperatorObject>(op);
+  return output;
+}
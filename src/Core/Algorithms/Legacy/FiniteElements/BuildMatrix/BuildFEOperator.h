@@ -0,0 +1,114 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef CORE_ALGORITHMS_FINITEELEMENTS_BUILDFEOPERATOR_H
+#define CORE_ALGORITHMS_FINITEELEMENTS_BUILDFEOPERATOR_H 1
+
+#include <vector>
+#include <Core/Datatypes/Datatype.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Math/ParallelAlgebra/LinearOperator.h>
+#include <Core/Algorithms/Legacy/FiniteElements/share.h>
+
+namespace SCIRun {
+	namespace Core {
+		namespace Algorithms {
+			namespace FiniteElements {
+
+/// Matrix-free stiffness operator for LatVolMesh and StructHexVolMesh fields
+/// with constant basis conductivities. It computes the same product as the
+/// SparseRowMatrix of BuildFEMatrixAlgo, but only stores the conductivity per
+/// cell (or an index into the conductivity table), plus the node positions for
+/// StructHexVol meshes. The element matrices are recomputed from the regular
+/// grid stencil on every product.
+class SCISHARE StructuredFEOperator : public Math::LinearOperator
+{
+  public:
+    size_type nrows() const override { return ni_*nj_*nk_; }
+    void apply(const double* x, double* r, index_type begin, index_type end) const override;
+    void diagonal(double* r, index_type begin, index_type end) const override;
+    bool isSymmetric() const override { return true; }
+
+    /// Number of bytes held by the operator
+    size_t memoryUsage() const;
+
+  private:
+    friend class BuildFEOperatorAlgo;
+    StructuredFEOperator() {}
+
+    template <class CellKernel>
+    void visitCells(index_type begin, index_type end, CellKernel kernel) const;
+    bool elementMatrix(index_type cell, const index_type* nodes, double* ke) const;
+    const double* conductivity(index_type cell) const;
+
+    size_type ni_ = 0, nj_ = 0, nk_ = 0;
+
+    // Gaussian quadrature of the unit hexahedron: weight*element size and
+    // the derivatives of the 8 basis functions (24 values) per point
+    std::vector<double> qweights_;
+    std::vector<double> qderivatives_;
+
+    // Conductivities stored as 1 (isotropic) or 6 (xx,xy,xz,yy,yz,zz) values,
+    // either per cell or per table entry if cell_index_ is used
+    int ncomp_ = 1;
+    std::vector<double> conductivity_;
+    std::vector<int> cell_index_;
+
+    // LatVol: element matrices for a unit value of each tensor component,
+    // followed by the isotropic one. All cells share the same geometry.
+    std::vector<double> unit_matrices_;
+    // StructHexVol: node positions (x,y,z per node)
+    std::vector<double> points_;
+};
+
+/// Datatype wrapper so the operator can be passed through an AlgorithmOutput
+class SCISHARE LinearOperatorObject : public Datatypes::Datatype
+{
+  public:
+    explicit LinearOperatorObject(Math::LinearOperatorHandle op) : op_(op) {}
+    Math::LinearOperatorHandle op() const { return op_; }
+    LinearOperatorObject* clone() const override { return new LinearOperatorObject(op_); }
+    std::string dynamic_type_name() const override { return "LinearOperatorObject"; }
+  private:
+    Math::LinearOperatorHandle op_;
+};
+
+class SCISHARE BuildFEOperatorAlgo : public AlgorithmBase
+{
+  public:
+    static const AlgorithmOutputName Stiffness_Operator;
+
+    bool run(FieldHandle input, Datatypes::DenseMatrixHandle ctable, Math::LinearOperatorHandle& output) const;
+    AlgorithmOutput run(const AlgorithmInput &) const override;
+};
+
+}}}}
+
+#endif
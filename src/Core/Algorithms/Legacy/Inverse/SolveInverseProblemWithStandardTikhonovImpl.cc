@@ -40,6 +40,7 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 
 #include <Core/Utils/Exception.h>
+#include <Eigen/Eigenvalues>
 
 using namespace SCIRun;
 using namespace Core;
@@ -64,6 +65,13 @@ using namespace Inverse;
         //
         //      A^-1 = M3 * G^-1 * M4
         //...........................................................................................................
+        if (decomposition_)
+        {
+            // x = M3 V * diag(1/(mu + lambda^2)) * V^T y, with V^T y kept for all time samples
+            const DenseColumnMatrix scale = (decomposition_->mu.array() + lambda * lambda).inverse().matrix();
+            return decomposition_->M3V * (scale.asDiagonal() * Vty);
+        }
+
         const int sizeB = M1.ncols();
         const int sizeSolution = M3.nrows();
         const int numTimeSamples = y.ncols();
@@ -90,6 +98,38 @@ using namespace Inverse;
 //////// fi compute inverse solution
 ////////////////////////
 
+/////// factor once
+///////////////
+    TikhonovPencilDecompositionHandle SolveInverseProblemWithStandardTikhonovImpl::decompose()
+    {
+        if (!decomposition_)
+        {
+            // M1 is symmetric semi-definite and M2 symmetric positive definite, so the generalized
+            // self-adjoint solver applies and returns V normalized as V^T M2 V = I.
+            Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> pencil(M1, M2, Eigen::ComputeEigenvectors | Eigen::Ax_lBx);
+            if (pencil.info() != Eigen::Success)
+                BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Could not decompose the Tikhonov system matrices."));
+
+            auto decomposition = boost::make_shared<TikhonovPencilDecomposition>();
+            decomposition->mu = pencil.eigenvalues();
+            decomposition->V = pencil.eigenvectors();
+            decomposition->M3V = M3 * decomposition->V;
+            useDecomposition(decomposition);
+        }
+        return decomposition_;
+    }
+
+    void SolveInverseProblemWithStandardTikhonovImpl::useDecomposition(TikhonovPencilDecompositionHandle decomposition)
+    {
+        ENSURE_DIMENSIONS_MATCH(decomposition->V.nrows(), M1.nrows(), "Cached Tikhonov decomposition does not match the system size.");
+        ENSURE_DIMENSIONS_MATCH(decomposition->M3V.nrows(), M3.nrows(), "Cached Tikhonov decomposition does not match the solution size.");
+
+        decomposition_ = decomposition;
+        Vty = decomposition_->V.transpose() * y;
+    }
+//////// fi factor once
+////////////////////////
+
 /////// precomputeInverseMatrices
 ///////////////
     void SolveInverseProblemWithStandardTikhonovImpl::preAllocateInverseMatrices(const DenseMatrix& forwardMatrix, const
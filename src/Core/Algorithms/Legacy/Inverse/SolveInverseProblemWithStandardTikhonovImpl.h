@@ -34,6 +34,7 @@
 #include <Core/Algorithms/Legacy/Inverse/TikhonovImpl.h>
 #include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Algorithms/Legacy/Inverse/share.h>
 
 namespace SCIRun {
@@ -41,6 +42,19 @@ namespace Core {
   namespace Algorithms {
     namespace Inverse {
 
+      /// Generalized eigendecomposition of the pencil (M1, M2): M1 V = M2 V diag(mu), V^T M2 V = I.
+      /// Then (M1 + lambda^2 M2)^-1 = V diag(1 / (mu + lambda^2)) V^T, so once it exists every
+      /// lambda costs a diagonal scaling and one product. It only depends on the forward matrix,
+      /// the weightings and the problem type, not on the measured data.
+      struct SCISHARE TikhonovPencilDecomposition
+      {
+        Datatypes::DenseColumnMatrix mu;
+        Datatypes::DenseMatrix V;
+        Datatypes::DenseMatrix M3V;
+      };
+
+      typedef SharedPointer<TikhonovPencilDecomposition> TikhonovPencilDecompositionHandle;
+
       class SCISHARE SolveInverseProblemWithStandardTikhonovImpl final : public TikhonovImpl
       {
        public:
@@ -50,13 +64,20 @@ namespace Core {
             const Datatypes::DenseMatrix& sourceWeighting,
             const Datatypes::DenseMatrix& sensorWeighting,
             const TikhonovAlgoAbstractBase::AlgorithmChoice regularizationChoice, const int regularizationSolutionSubcase,
-            const int regularizationResidualSubcase)
+            const int regularizationResidualSubcase,
+            TikhonovPencilDecompositionHandle decomposition = TikhonovPencilDecompositionHandle())
         {
           preAllocateInverseMatrices(forwardMatrix, measuredData, sourceWeighting,
               sensorWeighting, regularizationChoice, regularizationSolutionSubcase,
               regularizationResidualSubcase);
+          if (decomposition)
+            useDecomposition(decomposition);
         }
 
+        /// Decompose the pencil once; afterwards computeInverseSolution no longer factors G.
+        TikhonovPencilDecompositionHandle decompose();
+        TikhonovPencilDecompositionHandle decomposition() const { return decomposition_; }
+
        private:
         Datatypes::DenseMatrix M1;
         Datatypes::DenseMatrix M2;
@@ -64,6 +85,11 @@ namespace Core {
         Datatypes::DenseMatrix M4;
         Datatypes::DenseMatrix y;
 
+        TikhonovPencilDecompositionHandle decomposition_;
+        Datatypes::DenseMatrix Vty;
+
+        void useDecomposition(TikhonovPencilDecompositionHandle decomposition);
+
         void preAllocateInverseMatrices(const Datatypes::DenseMatrix& forwardMatrix,
             const Datatypes::DenseMatrix& measuredData,
             const Datatypes::DenseMatrix& sourceWeighting,
@@ -107,6 +107,21 @@ void SolveInverseProblemWithTSVD_impl::preAlocateInverseMatrices(const
 	        Uy = svd_MatrixU.transpose() * (measuredData_);
 }
 
+void SolveInverseProblemWithTSVD_impl::preAlocateInverseMatrices(const
+  DenseMatrix& forwardMatrix_, const DenseMatrix& measuredData_ ,
+  const Math::RandomizedSVDParameters& truncation)
+{
+
+	    // Compute only the leading singular triplets, the truncation point never goes past them
+	        Math::RandomizedSVD(truncation).compute(Math::DenseColumnBlockSource(forwardMatrix_), svd_MatrixU, svd_SingularValues, svd_MatrixV);
+
+	    // determine rank
+	        rank = (svd_SingularValues.array() > 0.0).count();
+
+	    // Compute the projection of data y on the left singular vectors
+	        Uy = svd_MatrixU.transpose() * (measuredData_);
+}
+
 //////////////////////////////////////////////////////////////////////
 // THIS FUNCTION returns regularized solution by tikhonov method
 //////////////////////////////////////////////////////////////////////
@@ -114,7 +129,7 @@ DenseMatrix SolveInverseProblemWithTSVD_impl::computeInverseSolution( double lam
 {
 
     // prealocate matrices
-        const int N = svd_MatrixV.cols();
+        const int N = svd_MatrixV.rows();
         const int M = svd_MatrixU.rows();
         const int numTimeSamples = Uy.ncols();
         DenseMatrix solution(DenseMatrix::Zero(N,numTimeSamples));
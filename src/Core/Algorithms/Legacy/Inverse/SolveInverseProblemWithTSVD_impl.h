@@ -43,6 +43,7 @@
 #include <Core/Logging/LoggerFwd.h>
 
 #include <Core/Algorithms/Legacy/Inverse/TikhonovImpl.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
 
 #include <Core/Algorithms/Legacy/Inverse/share.h>
 
@@ -67,6 +68,12 @@ namespace Inverse {
 										preAlocateInverseMatrices( forwardMatrix_,  measuredData_ ,  sourceWeighting_,  sensorWeighting_);
                                     };
 
+				// randomized truncated SVD of the forward matrix, for when only the leading singular triplets are needed
+				SolveInverseProblemWithTSVD_impl(const SCIRun::Core::Datatypes::DenseMatrix& forwardMatrix_, const SCIRun::Core::Datatypes::DenseMatrix& measuredData_ , const Math::RandomizedSVDParameters& truncation)
+                                    {
+										preAlocateInverseMatrices( forwardMatrix_,  measuredData_, truncation);
+                                    };
+
 		    private:
 
 				// Data Members
@@ -80,6 +87,7 @@ namespace Inverse {
 				// Methods
 				void preAlocateInverseMatrices(const SCIRun::Core::Datatypes::DenseMatrix& forwardMatrix_, const SCIRun::Core::Datatypes::DenseMatrix& measuredData_ , const SCIRun::Core::Datatypes::DenseMatrix& sourceWeighting_, const SCIRun::Core::Datatypes::DenseMatrix& sensorWeighting_, const SCIRun::Core::Datatypes::DenseMatrix& matrixU_, const SCIRun::Core::Datatypes::DenseMatrix& singularValues_, const SCIRun::Core::Datatypes::DenseMatrix& matrixV_);
 				void preAlocateInverseMatrices(const SCIRun::Core::Datatypes::DenseMatrix& forwardMatrix_, const SCIRun::Core::Datatypes::DenseMatrix& measuredData_ , const SCIRun::Core::Datatypes::DenseMatrix& sourceWeighting_, const SCIRun::Core::Datatypes::DenseMatrix& sensorWeighting_);
+				void preAlocateInverseMatrices(const SCIRun::Core::Datatypes::DenseMatrix& forwardMatrix_, const SCIRun::Core::Datatypes::DenseMatrix& measuredData_ , const Math::RandomizedSVDParameters& truncation);
 
                         SCIRun::Core::Datatypes::DenseMatrix computeInverseSolution( double truncationPoint, bool inverseCalculation) const override;
 				std::vector<double> computeLambdaArray( double lambdaMin, double lambdaMax, int nLambda ) const override;
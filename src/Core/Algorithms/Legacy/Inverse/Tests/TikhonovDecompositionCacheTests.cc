@@ -0,0 +1,181 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
+#include <Core/Algorithms/Legacy/Inverse/SolveInverseProblemWithStandardTikhonovImpl.h>
+#include <Core/Datatypes/DenseMatrix.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Inverse;
+
+namespace
+{
+  DenseMatrixHandle forwardMatrix(double scale)
+  {
+    auto forward = boost::make_shared<DenseMatrix>(8, 6);
+    for (int i = 0; i < 8; ++i)
+      for (int j = 0; j < 6; ++j)
+        (*forward)(i, j) = scale / (1.0 + i + j) + (i == j ? 1.0 : 0.0);
+    return forward;
+  }
+
+  DenseMatrixHandle weighting(int n, double diagonal)
+  {
+    auto w = boost::make_shared<DenseMatrix>(DenseMatrix::Identity(n, n));
+    (*w)(0, 0) = diagonal;
+    return w;
+  }
+
+  DenseMatrixHandle measured(double offset)
+  {
+    auto y = boost::make_shared<DenseMatrix>(8, 1);
+    for (int i = 0; i < 8; ++i)
+      (*y)(i, 0) = std::sin(i + offset);
+    return y;
+  }
+
+  class TikhonovDecompositionCacheTest : public ::testing::Test
+  {
+  protected:
+    TikhonovDecompositionCacheTest()
+    {
+      input[TikhonovAlgoAbstractBase::ForwardMatrix] = forwardMatrix(1.0);
+      input[TikhonovAlgoAbstractBase::MeasuredPotentials] = measured(0.0);
+      input[TikhonovAlgoAbstractBase::WeightingInSourceSpace] = weighting(6, 1.0);
+      input[TikhonovAlgoAbstractBase::WeightingInSensorSpace] = weighting(8, 1.0);
+    }
+
+    static void configure(TikhonovAlgoAbstractBase& algo, bool reuse)
+    {
+      algo.set(Parameters::TikhonovImplementation, std::string("standardTikhonov"));
+      algo.setOption(Parameters::RegularizationMethod, "single");
+      algo.set(Parameters::LambdaFromDirectEntry, 0.1);
+      algo.set(Parameters::ReuseDecomposition, reuse);
+    }
+
+    DenseMatrix solve(const AlgorithmInput& in)
+    {
+      return *cached.run(in).get<DenseMatrix>(TikhonovAlgoAbstractBase::InverseSolution);
+    }
+
+    static DenseMatrix freshSolve(const AlgorithmInput& in)
+    {
+      TikhonovAlgoAbstractBase algo;
+      configure(algo, false);
+      return *algo.run(in).get<DenseMatrix>(TikhonovAlgoAbstractBase::InverseSolution);
+    }
+
+    static void expectSameSolution(const DenseMatrix& expected, const DenseMatrix& actual)
+    {
+      ASSERT_EQ(expected.rows(), actual.rows());
+      for (int i = 0; i < expected.rows(); ++i)
+        EXPECT_NEAR(expected(i, 0), actual(i, 0), 1e-10);
+    }
+
+    AlgorithmInput input;
+    TikhonovAlgoAbstractBase cached;
+  };
+}
+
+TEST_F(TikhonovDecompositionCacheTest, ReuseIsOnByDefault)
+{
+  TikhonovAlgoAbstractBase algo;
+  EXPECT_TRUE(algo.get(Parameters::ReuseDecomposition).toBool());
+}
+
+TEST_F(TikhonovDecompositionCacheTest, CachedSolutionMatchesFreshSolve)
+{
+  configure(cached, true);
+  expectSameSolution(freshSolve(input), solve(input));
+  ASSERT_TRUE(cached.cachedDecomposition() != nullptr);
+
+  expectSameSolution(freshSolve(input), solve(input));
+}
+
+TEST_F(TikhonovDecompositionCacheTest, NewMeasuredDataReusesDecomposition)
+{
+  configure(cached, true);
+  solve(input);
+  auto decomposition = cached.cachedDecomposition();
+
+  input[TikhonovAlgoAbstractBase::MeasuredPotentials] = measured(0.7);
+  auto solution = solve(input);
+
+  EXPECT_EQ(decomposition, cached.cachedDecomposition());
+  expectSameSolution(freshSolve(input), solution);
+}
+
+TEST_F(TikhonovDecompositionCacheTest, NewForwardMatrixInvalidatesDecomposition)
+{
+  configure(cached, true);
+  solve(input);
+  auto decomposition = cached.cachedDecomposition();
+
+  input[TikhonovAlgoAbstractBase::ForwardMatrix] = forwardMatrix(3.0);
+  auto solution = solve(input);
+
+  EXPECT_NE(decomposition, cached.cachedDecomposition());
+  expectSameSolution(freshSolve(input), solution);
+}
+
+TEST_F(TikhonovDecompositionCacheTest, NewSourceWeightingInvalidatesDecomposition)
+{
+  configure(cached, true);
+  solve(input);
+  auto decomposition = cached.cachedDecomposition();
+
+  input[TikhonovAlgoAbstractBase::WeightingInSourceSpace] = weighting(6, 4.0);
+  auto solution = solve(input);
+
+  EXPECT_NE(decomposition, cached.cachedDecomposition());
+  expectSameSolution(freshSolve(input), solution);
+}
+
+TEST_F(TikhonovDecompositionCacheTest, NewSensorWeightingInvalidatesDecomposition)
+{
+  configure(cached, true);
+  solve(input);
+  auto decomposition = cached.cachedDecomposition();
+
+  input[TikhonovAlgoAbstractBase::WeightingInSensorSpace] = weighting(8, 0.25);
+  auto solution = solve(input);
+
+  EXPECT_NE(decomposition, cached.cachedDecomposition());
+  expectSameSolution(freshSolve(input), solution);
+}
+
+TEST_F(TikhonovDecompositionCacheTest, DisabledReuseKeepsNoDecomposition)
+{
+  configure(cached, false);
+  expectSameSolution(freshSolve(input), solve(input));
+  EXPECT_TRUE(cached.cachedDecomposition() == nullptr);
+}
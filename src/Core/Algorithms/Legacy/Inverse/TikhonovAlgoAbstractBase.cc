@@ -42,11 +42,13 @@
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Core/Math/MiscMath.h>
 #include <unsupported/Eigen/Splines>
+#include <algorithm>
 
 // SCIRun structural
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Logging/Log.h>
+#include <Core/Thread/Parallel.h>
 #include <Core/Utils/Exception.h>
 
 using namespace SCIRun;
@@ -84,6 +86,7 @@ ALGORITHM_PARAMETER_DEF(Inverse, LambdaMax);
 ALGORITHM_PARAMETER_DEF(Inverse, LambdaNum);
 ALGORITHM_PARAMETER_DEF(Inverse, LambdaResolution);
 ALGORITHM_PARAMETER_DEF(Inverse, LambdaSliderValue);
+ALGORITHM_PARAMETER_DEF(Inverse, ReuseDecomposition);
 // ALGORITHM_PARAMETER_DEF( Inverse, LambdaCorner);
 // ALGORITHM_PARAMETER_DEF( Inverse, LCurveText);
 ALGORITHM_PARAMETER_DEF(Inverse, regularizationSolutionSubcase);
@@ -100,6 +103,12 @@ TikhonovAlgoAbstractBase::TikhonovAlgoAbstractBase()
   addParameter(Parameters::LambdaNum, 200);
   addParameter(Parameters::LambdaResolution, 1e-6);
   addParameter(Parameters::LambdaSliderValue, 0);
+  addParameter(Parameters::ReuseDecomposition, true);
+  addOption(Math::Parameters::SVDMethod, "full", "full|randomized");
+  addParameter(Math::Parameters::TruncationRank, 10);
+  addParameter(Math::Parameters::Oversampling, 10);
+  addParameter(Math::Parameters::PowerIterations, 2);
+  addParameter(Math::Parameters::ColumnBlockSize, 1024);
   addParameter(Parameters::regularizationSolutionSubcase, static_cast<int>(AlgorithmSolutionSubcase::solution_constrained));
   addParameter(Parameters::regularizationResidualSubcase, static_cast<int>(AlgorithmResidualSubcase::residual_constrained));
 }
@@ -208,9 +217,30 @@ AlgorithmOutput TikhonovAlgoAbstractBase::run(const AlgorithmInput& input) const
     int regularizationSolutionSubcase = get(Parameters::regularizationSolutionSubcase).toInt();
     int regularizationResidualSubcase = get(Parameters::regularizationResidualSubcase).toInt();
 
-    algoImpl = std::make_shared<SolveInverseProblemWithStandardTikhonovImpl>(*forwardMatrix,
-        *measuredData, *sourceWeighting, *sensorWeighting, regularizationChoice,
-        regularizationSolutionSubcase, regularizationResidualSubcase);
+    if (get(Parameters::ReuseDecomposition).toBool())
+    {
+      // Inputs are immutable once sent downstream, so their ids identify the system matrices.
+      auto idOf = [&input](const AlgorithmInputName& name)
+      {
+        auto m = input.get<Matrix>(name);
+        return m ? m->id() : -1;
+      };
+      DecompositionKey key(idOf(ForwardMatrix), idOf(WeightingInSourceSpace),
+        idOf(WeightingInSensorSpace), static_cast<int>(regularizationChoice));
+      if (key != decompositionKey_)
+        decomposition_.reset();
+
+      auto standardImpl = std::make_shared<SolveInverseProblemWithStandardTikhonovImpl>(*forwardMatrix,
+          *measuredData, *sourceWeighting, *sensorWeighting, regularizationChoice,
+          regularizationSolutionSubcase, regularizationResidualSubcase, decomposition_);
+      decomposition_ = standardImpl->decompose();
+      decompositionKey_ = key;
+      algoImpl = standardImpl;
+    }
+    else
+      algoImpl = std::make_shared<SolveInverseProblemWithStandardTikhonovImpl>(*forwardMatrix,
+          *measuredData, *sourceWeighting, *sensorWeighting, regularizationChoice,
+          regularizationSolutionSubcase, regularizationResidualSubcase);
   }
   else if (implOption == "TikhonovSVD")
   {
@@ -237,7 +267,10 @@ AlgorithmOutput TikhonovAlgoAbstractBase::run(const AlgorithmInput& input) const
     auto matrixV = castMatrix::toDense(input.get<Matrix>(TikhonovAlgoAbstractBase::matrixV));
 
     // If there is a missing matrix from the precomputed SVD input
-    if (!matrixU || !singularValues || !matrixV)
+    if ((!matrixU || !singularValues || !matrixV) && getOption(Math::Parameters::SVDMethod) == "randomized")
+      algoImpl = std::make_shared<SolveInverseProblemWithTSVD_impl>(
+          *forwardMatrix, *measuredData, Math::randomizedSVDParameters(*this));
+    else if (!matrixU || !singularValues || !matrixV)
       algoImpl = std::make_shared<SolveInverseProblemWithTSVD_impl>(
           *forwardMatrix, *measuredData, *sourceWeighting, *sensorWeighting);
     else
@@ -314,53 +347,63 @@ double TikhonovAlgoAbstractBase::computeLcurve(
 
   auto lambdaArray = algoImpl.computeLambdaArray(lambdaMin, lambdaMax, nLambda);
 
-  DenseMatrix CAx, Rx;
-  DenseMatrix solution;
-
   lambdaArray[0] = lambdaMin;
 
-  // for all lambdas
-  for (int j = 0; j < nLambda; j++)
-  {
-    solution = algoImpl.computeInverseSolution(lambdaArray[j], false);
-    lambdamatrix->put(j, 0, lambdaArray[j]);
+  auto forward = castMatrix::toDense(forwardMatrix);
+  auto measured = castMatrix::toDense(measuredData);
+  auto sourceW = sourceWeighting ? castMatrix::toDense(sourceWeighting) : nullptr;
+  auto sensorW = sensorWeighting ? castMatrix::toDense(sensorWeighting) : nullptr;
+
+  // Each lambda is independent, so the candidates are split over the cores. With a cached
+  // decomposition a candidate only costs a few matrix products.
+  const int numProcs = std::max(1, std::min(static_cast<int>(Thread::Parallel::NumCores()), nLambda));
+  std::vector<char> sizeMismatch(numProcs, 0);
 
-    // if using source regularization matrix, apply it to compute Rx (for the eta computations)
-    if (sourceWeighting)
+  auto evaluateLambdas = [&](int proc)
+  {
+    DenseMatrix CAx, Rx;
+    for (int j = proc; j < nLambda; j += numProcs)
     {
-      if (solution.nrows() ==
-          sourceWeighting->ncols())  // check that regularization matrix and solution match sizes
+      DenseMatrix solution = algoImpl.computeInverseSolution(lambdaArray[j], false);
+
+      // if using source regularization matrix, apply it to compute Rx (for the eta computations)
+      if (sourceW)
       {
-        auto sw = castMatrix::toDense(sourceWeighting);
-        Rx = (*sw) * solution;
+        if (solution.nrows() != sourceW->ncols())  // check that regularization matrix and solution match sizes
+        {
+          sizeMismatch[proc] = 1;
+          return;
+        }
+        Rx = (*sourceW) * solution;
       }
       else
-      {
-        BOOST_THROW_EXCEPTION(AlgorithmProcessingException()
-                              << ErrorMessage(" Solution weighting matrix unexpectedly does not "
-                                              "fit to compute the weighted solution norm. "));
-      }
-    }
-    else
-      Rx = solution;
+        Rx = solution;
 
-    auto forward = castMatrix::toDense(forwardMatrix);
-    auto Ax = (*forward) * solution;
-    auto measured = castMatrix::toDense(measuredData);
-    auto residualSolution = Ax - (*measured);
+      DenseMatrix residualSolution = (*forward) * solution - (*measured);
 
-    // if using source regularization matrix, apply it to compute Rx (for the eta computations)
-    if (sensorWeighting)
-    {
-      auto sw = castMatrix::toDense(sensorWeighting);
-      CAx = (*sw) * residualSolution;
+      // if using sensor weighting matrix, apply it to compute CAx (for the rho computations)
+      if (sensorW)
+        CAx = (*sensorW) * residualSolution;
+      else
+        CAx = residualSolution;
+
+      // compute rho and eta. Using Frobenious norm when using matrices
+      rho[j] = CAx.norm();
+      eta[j] = Rx.norm();
     }
-    else
-      CAx = residualSolution;
+  };
+  Thread::Parallel::RunTasks(evaluateLambdas, numProcs);
 
-    // compute rho and eta. Using Frobenious norm when using matrices
-    rho[j] = CAx.norm();
-    eta[j] = Rx.norm();
+  if (std::find(sizeMismatch.begin(), sizeMismatch.end(), 1) != sizeMismatch.end())
+  {
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException()
+                          << ErrorMessage(" Solution weighting matrix unexpectedly does not "
+                                          "fit to compute the weighted solution norm. "));
+  }
+
+  for (int j = 0; j < nLambda; j++)
+  {
+    lambdamatrix->put(j, 0, lambdaArray[j]);
     lambdamatrix->put(j, 1, rho[j]);
     lambdamatrix->put(j, 2, eta[j]);
   }
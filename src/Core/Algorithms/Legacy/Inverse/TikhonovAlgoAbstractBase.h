@@ -34,6 +34,7 @@
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Algorithms/Legacy/Inverse/TikhonovImpl.h>
 #include <Core/Algorithms/Legacy/Inverse/share.h>
+#include <tuple>
 
 namespace SCIRun {
 namespace Core {
@@ -51,9 +52,12 @@ namespace Core {
       ALGORITHM_PARAMETER_DECL(LambdaNum);
       ALGORITHM_PARAMETER_DECL(LambdaResolution);
       ALGORITHM_PARAMETER_DECL(LambdaSliderValue);
+      ALGORITHM_PARAMETER_DECL(ReuseDecomposition);
       // ALGORITHM_PARAMETER_DECL(LambdaCorner);
       // ALGORITHM_PARAMETER_DECL(LCurveText);
 
+      struct TikhonovPencilDecomposition;
+
       class SCISHARE TikhonovAlgoAbstractBase : virtual public AlgorithmBase
       {
        public:
@@ -104,9 +108,18 @@ namespace Core {
 
         bool checkInputMatrixSizes(const AlgorithmInput& input) const;
 
+        // decomposition the next standard Tikhonov run reuses if the system matrices are unchanged
+        SharedPointer<TikhonovPencilDecomposition> cachedDecomposition() const { return decomposition_; }
+
        private:
         static Datatypes::DenseColumnMatrix InterpolateCurvatureWithSplines(
             const Datatypes::DenseMatrix& samplePoints);
+
+        // standard Tikhonov decomposition of the last (forward, source weighting, sensor weighting,
+        // problem type) inputs, kept so new measured data does not trigger a refactorization
+        typedef std::tuple<int, int, int, int> DecompositionKey;
+        mutable DecompositionKey decompositionKey_ {-1, -1, -1, -1};
+        mutable SharedPointer<TikhonovPencilDecomposition> decomposition_;
       };
 
     }
@@ -41,6 +41,15 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
 
+ComputePCAAlgo::ComputePCAAlgo()
+{
+    addOption(Parameters::SVDMethod, "full", "full|randomized");
+    addParameter(Parameters::TruncationRank, 10);
+    addParameter(Parameters::Oversampling, 10);
+    addParameter(Parameters::PowerIterations, 2);
+    addParameter(Parameters::ColumnBlockSize, 1024);
+}
+
 //Let's do some math.
 //Algorithm:
 void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, DenseMatrixHandle& PrinVals, DenseMatrixHandle& RightPrinMat) const{
@@ -51,8 +60,13 @@ void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, Den
         THROW_ALGORITHM_INPUT_ERROR("Input has a zero dimension.");
     }
 
+    //Randomized mode: only the leading components, any matrix type.
+    if (getOption(Parameters::SVDMethod) == "randomized")
+    {
+        run(MatrixColumnBlockSource(input), LeftPrinMat, PrinVals, RightPrinMat);
+    }
     //Input matrix: nxm
-    if (matrixIs::dense(input))
+    else if (matrixIs::dense(input))
     {
         //First, we have to center the data.
         auto denseInputCentered = centerData(input);
@@ -78,6 +92,18 @@ void ComputePCAAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftPrinMat, Den
     }
 }
 
+//Randomized PCA: the columns are centered block by block, so the centered matrix is never formed.
+void ComputePCAAlgo::run(const ColumnBlockSource& source, DenseMatrixHandle& LeftPrinMat, DenseMatrixHandle& PrinVals, DenseMatrixHandle& RightPrinMat) const
+{
+    DenseMatrix U, V;
+    DenseColumnMatrix S;
+    RandomizedSVD(randomizedSVDParameters(*this)).compute(CenteredColumnBlockSource(source), U, S, V);
+
+    LeftPrinMat = boost::make_shared<DenseMatrix>(U);
+    PrinVals = boost::make_shared<DenseMatrix>(S);
+    RightPrinMat = boost::make_shared<DenseMatrix>(V);
+}
+
 //Centers input matrix.
 DenseMatrix ComputePCAAlgo::centerData(MatrixHandle input_matrix)
 {
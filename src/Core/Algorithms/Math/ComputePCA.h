@@ -32,6 +32,7 @@
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
 #include <Core/Algorithms/Math/share.h>
 
 namespace SCIRun {
@@ -42,12 +43,14 @@ namespace SCIRun {
                 class SCISHARE ComputePCAAlgo : public AlgorithmBase
                 {
                 public:
-                    ComputePCAAlgo() {}
+                    ComputePCAAlgo();
 
                     static AlgorithmOutputName LeftPrincipalMatrix;
                     static AlgorithmOutputName PrincipalValues;
                     static AlgorithmOutputName RightPrincipalMatrix;
                     void run(Datatypes::MatrixHandle input_matrix, Datatypes::DenseMatrixHandle& LeftPrinMat, Datatypes::DenseMatrixHandle& PrinVals, Datatypes::DenseMatrixHandle& RightPrinMat) const;
+                    /// Randomized truncated PCA, centering and reading the matrix one column block at a time.
+                    void run(const ColumnBlockSource& source, Datatypes::DenseMatrixHandle& LeftPrinMat, Datatypes::DenseMatrixHandle& PrinVals, Datatypes::DenseMatrixHandle& RightPrinMat) const;
                     AlgorithmOutput run(const AlgorithmInput& input) const override;
                     static Datatypes::DenseMatrix centerData(Datatypes::MatrixHandle input_matrix);
                 };
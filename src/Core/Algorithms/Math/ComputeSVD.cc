@@ -40,13 +40,26 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
 
+ComputeSVDAlgo::ComputeSVDAlgo()
+{
+  addOption(Parameters::SVDMethod, "full", "full|randomized");
+  addParameter(Parameters::TruncationRank, 10);
+  addParameter(Parameters::Oversampling, 10);
+  addParameter(Parameters::PowerIterations, 2);
+  addParameter(Parameters::ColumnBlockSize, 1024);
+}
+
 void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat) const
 {
   if (input->nrows() == 0 || input->ncols() == 0){
 
     THROW_ALGORITHM_INPUT_ERROR("Input has a zero dimension.");
 }
-  if (matrixIs::dense(input))
+  if (getOption(Parameters::SVDMethod) == "randomized")
+  {
+    run(MatrixColumnBlockSource(input), LeftSingMat, SingVals, RightSingMat);
+  }
+  else if (matrixIs::dense(input))
   {
     auto denseInput = castMatrix::toDense(input);
 
@@ -64,6 +77,16 @@ void ComputeSVDAlgo::run(MatrixHandle input, DenseMatrixHandle& LeftSingMat, Den
   }
 }
 
+void ComputeSVDAlgo::run(const ColumnBlockSource& source, DenseMatrixHandle& LeftSingMat, DenseMatrixHandle& SingVals, DenseMatrixHandle& RightSingMat) const
+{
+  DenseMatrix U, V;
+  DenseColumnMatrix S;
+  RandomizedSVD(randomizedSVDParameters(*this)).compute(source, U, S, V);
+
+  LeftSingMat = boost::make_shared<DenseMatrix>(U);
+  SingVals = boost::make_shared<DenseMatrix>(S);
+  RightSingMat = boost::make_shared<DenseMatrix>(V);
+}
 
 AlgorithmOutput ComputeSVDAlgo::run(const AlgorithmInput& input) const
 {
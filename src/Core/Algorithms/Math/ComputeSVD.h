@@ -28,6 +28,7 @@
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
 #include <Core/Algorithms/Math/share.h>
 
 namespace SCIRun {
@@ -38,12 +39,14 @@ namespace SCIRun {
 			class SCISHARE ComputeSVDAlgo : public AlgorithmBase
 			{
 				public:
-					ComputeSVDAlgo() {}
+					ComputeSVDAlgo();
 
 					static AlgorithmOutputName LeftSingularMatrix;
 					static AlgorithmOutputName SingularValues;
 					static AlgorithmOutputName RightSingularMatrix;
 					void run(Datatypes::MatrixHandle input_matrix, Datatypes::DenseMatrixHandle& LeftSingMat, Datatypes::DenseMatrixHandle& SingVals, Datatypes::DenseMatrixHandle& RightSingMat) const;
+					/// Randomized truncated SVD, reading the matrix one column block at a time.
+					void run(const ColumnBlockSource& source, Datatypes::DenseMatrixHandle& LeftSingMat, Datatypes::DenseMatrixHandle& SingVals, Datatypes::DenseMatrixHandle& RightSingMat) const;
                                         AlgorithmOutput run(const AlgorithmInput& input) const override;
 			};
 
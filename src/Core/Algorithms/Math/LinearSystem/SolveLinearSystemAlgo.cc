@@ -33,22 +33,30 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
 #include <Core/Algorithms/Math/ParallelAlgebra/ParallelLinearAlgebra.h>
+#include <Core/Algorithms/Math/ParallelAlgebra/LinearOperator.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Thread/TaskPool.h>
+#include <Eigen/SparseCholesky>
 
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::Math;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+
+ALGORITHM_PARAMETER_DEF(Math, SolverPrecision);
 
 SolveLinearSystemAlgo::SolveLinearSystemAlgo()
 {
   // For solver
-  addOption(Variables::Method,"cg","jacobi|cg|bicg|minres");
+  addOption(Variables::Method,"cg","jacobi|cg|pipecg|bicg|minres|ldlt");
   addOption(Variables::Preconditioner,"Jacobi","None|Jacobi");
+  addOption(Parameters::SolverPrecision,"double","double|mixed");
 
   addParameter(Variables::TargetError, 1e-5);
   addParameter(Variables::MaxIterations, 500);
@@ -78,14 +86,28 @@ public:
   bool run(SparseRowMatrixHandle a, DenseColumnMatrixHandle b,
             DenseColumnMatrixHandle x0, DenseColumnMatrixHandle& x,
             DenseColumnMatrixHandle& convergence) const;
+  bool run(LinearOperatorHandle a, DenseColumnMatrixHandle b,
+            DenseColumnMatrixHandle x0, DenseColumnMatrixHandle& x,
+            DenseColumnMatrixHandle& convergence) const;
+  bool run(SinglePrecisionMatrixHandle a, DenseColumnMatrixHandle b,
+            DenseColumnMatrixHandle x0, DenseColumnMatrixHandle& x,
+            DenseColumnMatrixHandle& convergence) const;
+
+  // Overrides the algorithm's target error, for the inner solves of iterative refinement
+  void setTargetError(double tolerance) { tolerance_ = tolerance; }
 protected:
+  bool run(SolverInputs& matrices, DenseColumnMatrixHandle& x,
+            DenseColumnMatrixHandle& convergence) const;
+
   const AlgorithmBase* algo_;
   std::string pre_conditioner_;
+  double tolerance_;
   DenseColumnMatrixHandle convergence_;
 };
 
 SolveLinearSystemParallelAlgo::SolveLinearSystemParallelAlgo(const AlgorithmBase* base) : algo_(base),
   pre_conditioner_(base->getOption(Variables::Preconditioner)),
+  tolerance_(base->get(Variables::TargetError).toDouble()),
   convergence_(new DenseColumnMatrix(base->get(Variables::MaxIterations).toInt()))
 {
 }
@@ -99,9 +121,39 @@ SolveLinearSystemParallelAlgo::run(SparseRowMatrixHandle a, DenseColumnMatrixHan
   matrices.A = a;
   matrices.b = b;
   matrices.x0 = x0;
+  return run(matrices, x, convergence);
+}
 
+bool
+SolveLinearSystemParallelAlgo::run(LinearOperatorHandle a, DenseColumnMatrixHandle b,
+                                   DenseColumnMatrixHandle x0, DenseColumnMatrixHandle& x,
+                                   DenseColumnMatrixHandle& convergence) const
+{
+  SolverInputs matrices;
+  matrices.Op = a;
+  matrices.b = b;
+  matrices.x0 = x0;
+  return run(matrices, x, convergence);
+}
+
+bool
+SolveLinearSystemParallelAlgo::run(SinglePrecisionMatrixHandle a, DenseColumnMatrixHandle b,
+                                   DenseColumnMatrixHandle x0, DenseColumnMatrixHandle& x,
+                                   DenseColumnMatrixHandle& convergence) const
+{
+  SolverInputs matrices;
+  matrices.Af = a;
+  matrices.b = b;
+  matrices.x0 = x0;
+  return run(matrices, x, convergence);
+}
+
+bool
+SolveLinearSystemParallelAlgo::run(SolverInputs& matrices, DenseColumnMatrixHandle& x,
+                                   DenseColumnMatrixHandle& convergence) const
+{
   // Create output matrix
-  auto size = x0->nrows();
+  auto size = matrices.x0->nrows();
   x = boost::make_shared<DenseColumnMatrix>(size);
 
   // Copy output matrix pointer
@@ -140,7 +192,7 @@ bool SolveLinearSystemCGAlgo::parallel(ParallelLinearAlgebra& PLA, SolverInputs&
   ParallelLinearAlgebra::ParallelMatrix A;
   ParallelLinearAlgebra::ParallelVector B, X, X0, XMIN, DIAG, R, Z, P;
 
-  double tolerance =     algo_->get(Variables::TargetError).toDouble();
+  double tolerance =     tolerance_;
   int    max_iter =      algo_->get(Variables::MaxIterations).toInt();
 
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
@@ -149,7 +201,7 @@ bool SolveLinearSystemCGAlgo::parallel(ParallelLinearAlgebra& PLA, SolverInputs&
 #endif
   int    niter = 0;
 
-  if ( !PLA.add_matrix(matrices.A, A) ||
+  if ( !PLA.add_matrix(matrices, A) ||
        !PLA.add_vector(matrices.b, B) ||
        !PLA.add_vector(matrices.x0, X0) ||
        !PLA.add_vector(matrices.x, XMIN))
@@ -338,6 +390,148 @@ bool SolveLinearSystemCGAlgo::parallel(ParallelLinearAlgebra& PLA, SolverInputs&
 }
 
 
+//------------------------------------------------------------------
+// Pipelined (Chronopoulos-Gear) CG Solver with simple preconditioner
+// Same iterates as CG in exact arithmetic, but both inner products of an iteration come
+// from one reduction fused with the matrix product, and all vector updates take one pass.
+
+class SolveLinearSystemPipelinedCGAlgo : public SolveLinearSystemParallelAlgo
+{
+  public:
+    explicit SolveLinearSystemPipelinedCGAlgo(const AlgorithmBase* base) : SolveLinearSystemParallelAlgo(base) {}
+    bool parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const override;
+};
+
+bool SolveLinearSystemPipelinedCGAlgo::parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
+{
+  ParallelLinearAlgebra::ParallelMatrix A;
+  ParallelLinearAlgebra::ParallelVector B, X, X0, XMIN, DIAG, R, U, W, P, S;
+
+  double tolerance =     tolerance_;
+  int    max_iter =      algo_->get(Variables::MaxIterations).toInt();
+  int    niter = 0;
+
+  if ( !PLA.add_matrix(matrices, A) ||
+       !PLA.add_vector(matrices.b, B) ||
+       !PLA.add_vector(matrices.x0, X0) ||
+       !PLA.add_vector(matrices.x, XMIN))
+  {
+    if (PLA.first())
+      algo_->error("Could not link matrices");
+    PLA.wait();
+    return (false);
+  }
+  if ( !PLA.new_vector(X) ||
+       !PLA.new_vector(DIAG) ||
+       !PLA.new_vector(R) ||
+       !PLA.new_vector(U) ||
+       !PLA.new_vector(W) ||
+       !PLA.new_vector(P) ||
+       !PLA.new_vector(S))
+  {
+    if (PLA.first())
+      algo_->error("Could not allocate enough memory for algorithm");
+    PLA.wait();
+    return (false);
+  }
+
+  PLA.copy(X0,X);
+  PLA.copy(X0,XMIN);
+  PLA.zeros(P);
+  PLA.zeros(S);
+
+  // Build a preconditioner
+  if (pre_conditioner_ == "Jacobi")
+  {
+    PLA.absdiag(A,DIAG);
+    double max = PLA.max(DIAG);
+    PLA.absthreshold_invert(DIAG,DIAG,1e-18*max);
+  }
+  else
+  {
+    PLA.ones(DIAG);
+  }
+
+  PLA.mult(A,X,R);
+  PLA.sub(B,R,R);
+  PLA.mult(R,DIAG,U);
+
+  double bnorm = PLA.norm(B);
+  double gamma, delta, rr;
+  PLA.mult_dots(A,U,W,R,delta,gamma,rr);
+  double error = sqrt(rr)/bnorm;
+
+  double xmin = error;
+  double orig = error;
+
+  if (error <= tolerance)
+  {
+    if (PLA.first())
+    {
+      std::ostringstream ostr;
+      ostr << "Solver found solution with error = " << error;
+      algo_->remark(ostr.str());
+    }
+    PLA.wait();
+
+    return (true);
+  }
+
+  double alpha = gamma/delta;
+  double beta = 0.0;
+
+  int cnt = 0;
+  double log_target = log(tolerance);
+  double log_orig =  log(orig);
+  double log_scale = log_orig - log_target;
+
+  while (niter < max_iter)
+  {
+    PLA.cg_update(alpha,beta,U,W,P,S,X,R,DIAG);
+
+    double gamma_new;
+    PLA.mult_dots(A,U,W,R,delta,gamma_new,rr);
+    error = sqrt(rr)/bnorm;
+    if (error < xmin)
+      xmin = error;
+    if (PLA.first())
+      (*convergence_)[niter] = xmin;
+
+    niter++;
+
+    if (error <= tolerance)
+      break;
+
+    beta = gamma_new/gamma;
+    alpha = gamma_new/(delta - beta*gamma_new/alpha);
+    gamma = gamma_new;
+
+    cnt++;
+    if (cnt == 20)
+    {
+      cnt = 0;
+      algo_->update_progress((log_orig-log(error))/log_scale);
+    }
+  }
+
+  // Tracking the best iterate would cost a pass per iteration, the last one is returned
+  PLA.copy(X,XMIN);
+
+  if (PLA.first())
+  {
+    std::ostringstream ostr;
+    if (error <= tolerance)
+      ostr << "Solver converged after " << niter << " iterations with error " << error;
+    else
+      ostr << "Solver stopped after " << niter << " iterations. Error was " << error;
+    algo_->remark(ostr.str());
+  }
+
+  PLA.wait();
+
+  return true;
+}
+
 //------------------------------------------------------------------
 // BICG Solver with simple preconditioner
 class SolveLinearSystemBICGAlgo : public SolveLinearSystemParallelAlgo
@@ -359,7 +553,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   ParallelLinearAlgebra::ParallelVector B, X, X0, XMIN;
   ParallelLinearAlgebra::ParallelVector DIAG, R, R1, Z, Z1, P, P1;
 
-  double tolerance =     algo_->get(Variables::TargetError).toDouble();
+  double tolerance =     tolerance_;
   int    max_iter =      algo_->get(Variables::MaxIterations).toInt();
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
   int    callback_step = algo_->get_int("callback_step");
@@ -368,7 +562,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   int    callback_step_cnt =0;
 
   // Create matrices and vectors that we need for this algorithm
-  if ( !PLA.add_matrix(matrices.A,A) ||
+  if ( !PLA.add_matrix(matrices, A) ||
        !PLA.add_vector(matrices.b,B) ||
        !PLA.add_vector(matrices.x0,X0) ||
        !PLA.add_vector(matrices.x,XMIN) ||
@@ -575,7 +769,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   ParallelLinearAlgebra::ParallelVector DIAG, R, V, VOLD, VV;
   ParallelLinearAlgebra::ParallelVector VOLDER, M, MOLD, MOLDER, XCG;
 
-  double tolerance =     algo_->get(Variables::TargetError).toDouble();
+  double tolerance =     tolerance_;
   int    max_iter =      algo_->get(Variables::MaxIterations).toInt();
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
   int    callback_step = algo_->get_int("callback_step");
@@ -584,7 +778,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   int    callback_step_cnt =0;
 
   // Create matrices and vectors that we need for this algorithm
-  if ( !PLA.add_matrix(matrices.A,A) ||
+  if ( !PLA.add_matrix(matrices, A) ||
        !PLA.add_vector(matrices.b,B) ||
        !PLA.add_vector(matrices.x0,X0) ||
        !PLA.add_vector(matrices.x,XMIN) ||
@@ -925,7 +1119,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   ParallelLinearAlgebra::ParallelVector B, X, X0, XMIN;
   ParallelLinearAlgebra::ParallelVector DIAG,Z;
 
-  double tolerance =     algo_->get(Variables::TargetError).toDouble();
+  double tolerance =     tolerance_;
   int    max_iter =      algo_->get(Variables::MaxIterations).toInt();
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
   int    callback_step = algo_->get_int("callback_step");
@@ -934,7 +1128,7 @@ parallel(ParallelLinearAlgebra& PLA, SolverInputs& matrices) const
   int    callback_step_cnt =0;
 
   // Create matrices and vectors that we need for this algorithm
-  if ( !PLA.add_matrix(matrices.A,A) ||
+  if ( !PLA.add_matrix(matrices, A) ||
        !PLA.add_vector(matrices.b,B) ||
        !PLA.add_vector(matrices.x0,X0) ||
        !PLA.add_vector(matrices.x,XMIN) ||
@@ -1076,11 +1270,133 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
   return run(A,b,x0,x,convergence);
 }
 
-bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
-  DenseColumnMatrixHandle b,
+namespace
+{
+  // bicg needs A^T*x, a matrix-free operator only provides it when symmetric
+  bool hasTransposedProduct(const SparseRowMatrixHandle&) { return true; }
+  bool hasTransposedProduct(const LinearOperatorHandle& A) { return A->isSymmetric(); }
+
+  // ldlt and mixed precision need the assembled entries, a matrix-free operator has none
+  SparseRowMatrixHandle assembled(const SparseRowMatrixHandle& A) { return A; }
+  SparseRowMatrixHandle assembled(const LinearOperatorHandle&) { return nullptr; }
+
+  // r = b - A*x, formed in double precision over row blocks
+  void residual(const SparseRowMatrix& A, const DenseColumnMatrix& b, const DenseColumnMatrix& x,
+    DenseColumnMatrix& r)
+  {
+    const SCIRun::index_type n = A.nrows();
+    const int nproc = static_cast<int>(std::max<SCIRun::index_type>(1, std::min<SCIRun::index_type>(Parallel::NumCores(), n / 1000)));
+    Parallel::RunTasks([&](int proc)
+    {
+      const SCIRun::index_type end = n * (proc + 1) / nproc;
+      for (SCIRun::index_type i = n * proc / nproc; i < end; ++i)
+      {
+        double sum = 0.0;
+        for (SparseRowMatrix::InnerIterator it(A, i); it; ++it)
+          sum += it.value() * x[it.index()];
+        r[i] = b[i] - sum;
+      }
+    }, nproc);
+  }
+
+  const int maxRefinementSteps = 30;
+  // The inner solves run on a single precision matrix, so asking them for a larger
+  // reduction of the correction residual than this is wasted work
+  const double minInnerTolerance = 1e-5;
+
+  // Iterative refinement: the correction equation A*d = r is solved by the Krylov method on a
+  // single precision copy of A, while r = b - A*x is formed with the double precision matrix.
+  // x therefore reaches the same tolerance as a solve done entirely in double precision.
+  template <class InnerSolver>
+  void refineInMixedPrecision(const AlgorithmBase* algo, const SparseRowMatrixHandle& A,
+    const DenseColumnMatrixHandle& b, const DenseColumnMatrixHandle& x0, DenseColumnMatrixHandle& x)
+  {
+    const double tolerance = algo->get(Variables::TargetError).toDouble();
+    const double bnorm = b->norm();
+    x = boost::make_shared<DenseColumnMatrix>(*x0);
+    if (bnorm == 0.0)
+    {
+      x->setZero();
+      return;
+    }
+
+    auto Af = boost::make_shared<SinglePrecisionMatrix>(*A);
+    auto r = boost::make_shared<DenseColumnMatrix>(b->nrows());
+    auto zero = boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Zero(b->nrows()));
+    residual(*A, *b, *x, *r);
+    double error = r->norm() / bnorm;
+
+    int step = 0;
+    for (; step < maxRefinementSteps && error > tolerance; ++step)
+    {
+      InnerSolver inner(algo);
+      inner.setTargetError(std::max(tolerance / error, minInnerTolerance));
+      DenseColumnMatrixHandle d, convergence;
+      inner.run(Af, r, zero, d, convergence);
+
+      *x += *d;
+      residual(*A, *b, *x, *r);
+      const double next = r->norm() / bnorm;
+      if (next >= error)
+      {
+        // single precision no longer resolves the correction, A is too ill-conditioned
+        *x -= *d;
+        break;
+      }
+      error = next;
+    }
+
+    std::ostringstream ostr;
+    if (error <= tolerance)
+      ostr << "Mixed precision solver converged after " << step << " refinement steps with error " << error;
+    else
+      ostr << "Mixed precision solver stopped after " << step << " refinement steps. Error was " << error;
+    algo->remark(ostr.str());
+  }
+}
+
+struct SolveLinearSystemAlgo::DirectFactorization
+{
+  typedef Eigen::SparseMatrix<double> ColumnMajor;
+  // AMD ordering keeps the fill of the FE stiffness matrices low; only the lower half is read
+  Eigen::SimplicialLDLT<ColumnMajor, Eigen::Lower, Eigen::AMDOrdering<ColumnMajor::StorageIndex>> ldlt;
+};
+
+SCIRun::SharedPointer<const SolveLinearSystemAlgo::DirectFactorization>
+SolveLinearSystemAlgo::factorize(SparseRowMatrixHandle A) const
+{
+  FactorizationKey key(A->id(), A->nrows(), A->nonZeros());
+  if (factorization_ && key == factorizationKey_)
+  {
+    remark("Reusing factorization of the system matrix");
+    return factorization_;
+  }
+  factorization_.reset();
+
+  const DirectFactorization::ColumnMajor lhs(*A);
+  const double asymmetry = (lhs - DirectFactorization::ColumnMajor(lhs.transpose())).norm();
+  if (asymmetry > 1e-12 * lhs.norm())
+  {
+    THROW_ALGORITHM_INPUT_ERROR("The ldlt method needs a symmetric matrix A");
+  }
+
+  auto factorization = boost::make_shared<DirectFactorization>();
+  factorization->ldlt.compute(lhs);
+  if (factorization->ldlt.info() != Eigen::Success)
+  {
+    BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << LinearAlgebraErrorMessage("LDLT factorization failed, matrix A is singular"));
+  }
+
+  factorizationKey_ = key;
+  factorization_ = factorization;
+  return factorization_;
+}
+
+template <class SystemMatrix>
+bool SolveLinearSystemAlgo::solve(SystemMatrix A,
+                           DenseColumnMatrixHandle b,
                            DenseColumnMatrixHandle x0,
-                           DenseColumnMatrixHandle& x,
-                           DenseColumnMatrixHandle& /*convergence*/) const
+                           DenseColumnMatrixHandle& x) const
 {
   ScopedAlgorithmStatusReporter ssr(this, "SolveLinearSystem");
   ENSURE_ALGORITHM_INPUT_NOT_NULL(A, "No matrix A is given");
@@ -1147,6 +1463,31 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
 
   std::string method = getOption(Variables::Method);
 
+  if (method == "bicg" && !hasTransposedProduct(A))
+  {
+    THROW_ALGORITHM_INPUT_ERROR("The bicg method is only available for symmetric matrix-free operators");
+  }
+
+  if (getOption(Parameters::SolverPrecision) == "mixed")
+  {
+    if (method != "cg" && method != "pipecg" && method != "bicg")
+    {
+      THROW_ALGORITHM_INPUT_ERROR("Mixed precision is only available for the cg, pipecg and bicg methods");
+    }
+    auto sparse = assembled(A);
+    if (!sparse)
+    {
+      THROW_ALGORITHM_INPUT_ERROR("Mixed precision needs an assembled sparse matrix A");
+    }
+    if (method == "cg")
+      refineInMixedPrecision<SolveLinearSystemCGAlgo>(this, sparse, b, x0, x);
+    else if (method == "pipecg")
+      refineInMixedPrecision<SolveLinearSystemPipelinedCGAlgo>(this, sparse, b, x0, x);
+    else
+      refineInMixedPrecision<SolveLinearSystemBICGAlgo>(this, sparse, b, x0, x);
+    return true;
+  }
+
   DenseColumnMatrixHandle conv;
   if (method == "cg")
   {
@@ -1156,6 +1497,14 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
       BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Conjugate Gradient method failed"));
     }
   }
+  else if (method == "pipecg")
+  {
+    SolveLinearSystemPipelinedCGAlgo algo(this);
+    if(!algo.run(A,b,x0,x,conv))
+    {
+      BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Pipelined Conjugate Gradient method failed"));
+    }
+  }
   else if (method == "bicg")
   {
     SolveLinearSystemBICGAlgo algo(this);
@@ -1180,6 +1529,16 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
       BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("MINRES method failed"));
     }
   }
+  else if (method == "ldlt")
+  {
+    auto sparse = assembled(A);
+    if (!sparse)
+    {
+      THROW_ALGORITHM_INPUT_ERROR("The ldlt method needs an assembled sparse matrix A");
+    }
+    auto factorization = factorize(sparse);
+    x = boost::make_shared<DenseColumnMatrix>(factorization->ldlt.solve(*b));
+  }
   else
     BOOST_THROW_EXCEPTION(AlgorithmProcessingException() << ErrorMessage("Unknown solver method"));
 
@@ -1200,9 +1559,86 @@ bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
   return true;
 }
 
+bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
+                           DenseColumnMatrixHandle b,
+                           DenseColumnMatrixHandle x0,
+                           DenseColumnMatrixHandle& x,
+                           DenseColumnMatrixHandle& /*convergence*/) const
+{
+  return solve(A, b, x0, x);
+}
+
+bool SolveLinearSystemAlgo::run(LinearOperatorHandle A,
+                           DenseColumnMatrixHandle b,
+                           DenseColumnMatrixHandle x0,
+                           DenseColumnMatrixHandle& x) const
+{
+  return solve(A, b, x0, x);
+}
+
+bool SolveLinearSystemAlgo::run(SparseRowMatrixHandle A,
+                           DenseMatrixHandle B,
+                           DenseMatrixHandle& X) const
+{
+  ScopedAlgorithmStatusReporter ssr(this, "SolveLinearSystem");
+  ENSURE_ALGORITHM_INPUT_NOT_NULL(A, "No matrix A is given");
+  ENSURE_ALGORITHM_INPUT_NOT_NULL(B, "No matrix B is given");
+
+  if (getOption(Variables::Method) != "ldlt")
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Several right-hand sides are only supported by the ldlt method");
+  }
+
+  if (A->nrows() != A->ncols())
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Matrix A is not square");
+  }
+
+  if (A->nrows() != B->nrows())
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Matrix A and B do not have the same number of rows");
+  }
+
+  auto factorization = factorize(A);
+  const auto& ldlt = factorization->ldlt;
+
+  const size_type ncols = B->ncols();
+  X = boost::make_shared<DenseMatrix>(B->nrows(), ncols);
+  const int nproc = static_cast<int>(std::max<size_type>(1, std::min<size_type>(Parallel::NumCores(), ncols)));
+  const size_type blockSize = (ncols + nproc - 1) / nproc;
+
+  // the substitutions only read the factorization, so column blocks are independent
+  TaskPool::Instance().runTasks([&](int proc)
+  {
+    const size_type first = proc * blockSize;
+    const size_type count = std::min(blockSize, ncols - first);
+    if (count > 0)
+      X->middleCols(first, count) = ldlt.solve(B->middleCols(first, count));
+  }, nproc);
+
+  return true;
+}
+
 AlgorithmOutput SolveLinearSystemAlgo::run(const AlgorithmInput& input) const
 {
   auto lhs = input.get<SparseRowMatrix>(Variables::LHS);
+
+  if (getOption(Variables::Method) == "ldlt")
+  {
+    auto rhs = input.get<Matrix>(Variables::RHS);
+    ENSURE_ALGORITHM_INPUT_NOT_NULL(rhs, "No matrix B is given");
+    auto rhsDense = castMatrix::toDense(rhs);
+    if (!rhsDense)
+      rhsDense = convertMatrix::toDense(rhs);
+
+    DenseMatrixHandle solution;
+    run(lhs, rhsDense, solution);
+
+    AlgorithmOutput output;
+    output[Variables::Solution] = solution;
+    return output;
+  }
+
   auto rhs = input.get<DenseColumnMatrix>(Variables::RHS);
 
   DenseColumnMatrixHandle solution;
@@ -35,15 +35,25 @@
 
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/Math/ParallelAlgebra/LinearOperator.h>
 #include <Core/Algorithms/Math/share.h>
+#include <tuple>
 
 namespace SCIRun {
 namespace Core {
 namespace Algorithms {
 namespace Math {
 
+ALGORITHM_PARAMETER_DECL(SolverPrecision);
+
 // Solve a linear system in parallel using a standard iterative method
-// Method solves A*x = b, with x0 being the initializer for the solution
+// Method solves A*x = b, with x0 being the initializer for the solution.
+// "pipecg" is CG reorganized (Chronopoulos-Gear) to need one reduction per iteration.
+// The "ldlt" method instead factors a symmetric sparse A directly (fill-reducing
+// ordering) and keeps that factorization, so repeated solves against the same
+// matrix only cost the triangular substitutions.
+// With SolverPrecision "mixed", cg, pipecg and bicg iterate on a single precision copy of A
+// inside a double precision iterative refinement loop.
 
 class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
 {
@@ -61,7 +71,37 @@ class SCISHARE SolveLinearSystemAlgo : public AlgorithmBase
              Datatypes::DenseColumnMatrixHandle x0,
              Datatypes::DenseColumnMatrixHandle& x) const;
 
+    // Matrix-free version: A is only accessed through its product and diagonal
+    bool run(LinearOperatorHandle A,
+             Datatypes::DenseColumnMatrixHandle b,
+             Datatypes::DenseColumnMatrixHandle x0,
+             Datatypes::DenseColumnMatrixHandle& x) const;
+
+    // Direct version for several right-hand sides: every column of B is solved
+    // against the one (cached) factorization of A, column blocks in parallel
+    bool run(Datatypes::SparseRowMatrixHandle A,
+             Datatypes::DenseMatrixHandle B,
+             Datatypes::DenseMatrixHandle& X) const;
+
     AlgorithmOutput run(const AlgorithmInput& input) const override;
+
+  private:
+    template <class SystemMatrix>
+    bool solve(SystemMatrix A,
+               Datatypes::DenseColumnMatrixHandle b,
+               Datatypes::DenseColumnMatrixHandle x0,
+               Datatypes::DenseColumnMatrixHandle& x) const;
+
+    struct DirectFactorization;
+    SharedPointer<const DirectFactorization> factorize(Datatypes::SparseRowMatrixHandle A) const;
+
+    // factorization of the last matrix solved with "ldlt", keyed on its (id, rows, nonzeros).
+    // A matrix is treated as immutable once it has been solved: changing its values in
+    // place keeps the key, so the stale factorization would be reused. Pass a new
+    // matrix object instead.
+    typedef std::tuple<int, long long, long long> FactorizationKey;
+    mutable FactorizationKey factorizationKey_ {-1, -1, -1};
+    mutable SharedPointer<const DirectFactorization> factorization_;
 };
 
 
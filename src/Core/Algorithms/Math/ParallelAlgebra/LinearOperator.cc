@@ -0,0 +1,80 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Core/Algorithms/Math/ParallelAlgebra/LinearOperator.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Thread/Parallel.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  template <class Task>
+  void runOverRows(size_type size, int nproc, Task task)
+  {
+    if (nproc < 1)
+      nproc = Parallel::NumCores();
+    if (nproc > size)
+      nproc = std::max(static_cast<int>(size), 1);
+
+    const auto chunk = size / nproc;
+    Parallel::RunTasks([&](int proc)
+    {
+      const index_type begin = proc * chunk;
+      const index_type end = (proc == nproc - 1) ? size : (proc + 1) * chunk;
+      task(begin, end);
+    }, nproc);
+  }
+}
+
+void LinearOperator::multiply(const DenseColumnMatrix& x, DenseColumnMatrix& r, int nproc) const
+{
+  const auto size = nrows();
+  if (static_cast<size_type>(x.nrows()) != size)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Dimension mismatch"));
+  if (static_cast<size_type>(r.nrows()) != size)
+    r.resize(size);
+
+  const double* xdata = x.data();
+  double* rdata = r.data();
+  runOverRows(size, nproc, [this, xdata, rdata](index_type begin, index_type end) { apply(xdata, rdata, begin, end); });
+}
+
+DenseColumnMatrixHandle LinearOperator::buildDiagonal(int nproc) const
+{
+  const auto size = nrows();
+  auto diag = boost::make_shared<DenseColumnMatrix>(size);
+  double* ddata = diag->data();
+  runOverRows(size, nproc, [this, ddata](index_type begin, index_type end) { diagonal(ddata, begin, end); });
+  return diag;
+}
@@ -0,0 +1,75 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef CORE_ALGORITHMS_MATH_PARALLELALGEBRA_LINEAROPERATOR_H
+#define CORE_ALGORITHMS_MATH_PARALLELALGEBRA_LINEAROPERATOR_H
+
+#include <boost/noncopyable.hpp>
+#include <Core/Utils/SmartPointers.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+  /// Square operator that computes A*x on the fly instead of storing A.
+  /// The iterative solvers in SolveLinearSystemAlgo only need a product and
+  /// a diagonal, so any operator implementing these two can replace an
+  /// explicit SparseRowMatrix. Both calls work on a range of rows, which is
+  /// how ParallelLinearAlgebra splits the work over its threads: an
+  /// implementation must only write r[begin..end) and may read all of x.
+  class SCISHARE LinearOperator : boost::noncopyable
+  {
+  public:
+    virtual ~LinearOperator() {}
+
+    virtual size_type nrows() const = 0;
+    size_type ncols() const { return nrows(); }
+
+    /// r[begin..end) = (A*x)[begin..end)
+    virtual void apply(const double* x, double* r, index_type begin, index_type end) const = 0;
+    /// r[begin..end) = diag(A)[begin..end)
+    virtual void diagonal(double* r, index_type begin, index_type end) const = 0;
+
+    /// Only symmetric operators can be used with the transposed product (bicg)
+    virtual bool isSymmetric() const { return false; }
+
+    /// Convenience versions that split the rows over nproc threads.
+    /// With nproc < 1 the number of cores is used.
+    void multiply(const Datatypes::DenseColumnMatrix& x, Datatypes::DenseColumnMatrix& r, int nproc = -1) const;
+    Datatypes::DenseColumnMatrixHandle buildDiagonal(int nproc = -1) const;
+  };
+
+  typedef SharedPointer<LinearOperator> LinearOperatorHandle;
+
+}}}}
+
+#endif
@@ -33,6 +33,8 @@
 ///////////////////////////
 
 #include <cfloat>
+#include <climits>
+#include <cmath>
 
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
@@ -48,6 +50,30 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Thread;
 
+SinglePrecisionMatrix::SinglePrecisionMatrix(const SparseRowMatrix& A) :
+  rows_(A.nrows() + 1),
+  ncols_(A.ncols())
+{
+  if (A.ncols() > INT_MAX)
+    THROW_INVALID_ARGUMENT("Matrix has too many columns for 32-bit column indices");
+
+  values_.reserve(A.nonZeros());
+  columns_.reserve(A.nonZeros());
+  rows_[0] = 0;
+  for (index_type i = 0; i < A.nrows(); ++i)
+  {
+    for (SparseRowMatrix::InnerIterator it(A, i); it; ++it)
+    {
+      const float value = static_cast<float>(it.value());
+      if (!std::isfinite(value))
+        THROW_INVALID_ARGUMENT("Matrix entry is out of single precision range");
+      values_.push_back(value);
+      columns_.push_back(static_cast<int>(it.index()));
+    }
+    rows_[i + 1] = static_cast<index_type>(values_.size());
+  }
+}
+
 ParallelLinearAlgebraBase::ParallelLinearAlgebraBase()
 {}
 
@@ -140,10 +166,122 @@ bool ParallelLinearAlgebra::add_matrix(SparseRowMatrixHandle mat, ParallelMatrix
   M.m_ = mat->nrows();
   M.n_ = mat->ncols();
   M.nnz_ = mat->nonZeros();
+  M.op_ = nullptr;
+  M.fdata_ = nullptr;
+  M.fcolumns_ = nullptr;
+
+  return (true);
+}
+
+bool ParallelLinearAlgebra::add_matrix(LinearOperatorHandle op, ParallelMatrix& M)
+{
+  if (!op) return (false);
+  if (op->nrows() != static_cast<SCIRun::size_type>(size_)) return (false);
+
+  M.data_ = nullptr;
+  M.rows_ = nullptr;
+  M.columns_ = nullptr;
+
+  M.m_ = op->nrows();
+  M.n_ = op->ncols();
+  M.nnz_ = 0;
+  M.op_ = op.get();
+  M.fdata_ = nullptr;
+  M.fcolumns_ = nullptr;
+
+  return (true);
+}
+
+bool ParallelLinearAlgebra::add_matrix(SinglePrecisionMatrixHandle mat, ParallelMatrix& M)
+{
+  if (!mat) return (false);
+  if (mat->nrows() != static_cast<SCIRun::size_type>(size_)) return (false);
+
+  M.data_ = nullptr;
+  M.rows_ = mat->rows();
+  M.columns_ = nullptr;
+  M.fdata_ = mat->values();
+  M.fcolumns_ = mat->columns();
+
+  M.m_ = mat->nrows();
+  M.n_ = mat->ncols();
+  M.nnz_ = mat->nonZeros();
+  M.op_ = nullptr;
 
   return (true);
 }
 
+bool ParallelLinearAlgebra::add_matrix(const SolverInputs& inputs, ParallelMatrix& M)
+{
+  if (inputs.A)
+    return add_matrix(inputs.A, M);
+  if (inputs.Af)
+    return add_matrix(inputs.Af, M);
+  return add_matrix(inputs.Op, M);
+}
+
+namespace
+{
+  // CSR kernels shared by the double and the single precision matrices, sums stay in double
+
+  // rowDone(i) runs right after row i is written, so fused work finds it in cache
+  template <typename Value, typename Column, typename RowDone>
+  void multRows(const SCIRun::index_type* rows, const Column* columns, const Value* data,
+    const double* idata, double* odata, size_t start, size_t end, RowDone rowDone)
+  {
+    for(size_t i=start;i<end;i++)
+    {
+      double sum = 0.0;
+      SCIRun::index_type row_idx = rows[i];
+      SCIRun::index_type next_idx = rows[i+1];
+      for(SCIRun::index_type j=row_idx;j<next_idx;j++)
+      {
+        sum+=data[j]*idata[columns[j]];
+      }
+      odata[i]=sum;
+      rowDone(i);
+    }
+  }
+
+  const auto noRowWork = [](size_t) {};
+
+  template <typename Value, typename Column>
+  void multTransRows(const SCIRun::index_type* rows, const Column* columns, const Value* data, size_t m,
+    const double* idata, double* odata, size_t start, size_t end)
+  {
+    for (size_t i=start; i<end; i++) odata[i] = 0.0;
+    for (size_t j=0; j<m; j++)
+    {
+      if (idata[j] == 0.0) continue;
+      double xj = idata[j];
+      auto row_idx = rows[j];
+      auto next_idx = rows[j+1];
+      auto i=row_idx;
+      for (; i<next_idx && static_cast<size_t>(columns[i]) < start; i++);
+      for (; i<next_idx && static_cast<size_t>(columns[i]) < end; i++)
+        odata[columns[i]] += data[i]*xj;
+    }
+  }
+
+  template <typename Value, typename Column>
+  void diagRows(const SCIRun::index_type* rows, const Column* columns, const Value* data,
+    double* odata, size_t start, size_t end)
+  {
+    for(size_t i=start;i<end;i++)
+    {
+      double val = 0.0;
+      size_t row_idx=rows[i];
+      size_t next_idx=rows[i+1];
+
+      for(size_t j=row_idx;j<next_idx;j++)
+      {
+        if (static_cast<size_t>(columns[j]) == i) val = data[j];
+      }
+      odata[i]=val;
+    }
+  }
+}
+
 /// @todo: refactor duplication
 
 void ParallelLinearAlgebra::mult(const ParallelVector& a, const ParallelVector& b, ParallelVector& r)
@@ -630,95 +768,123 @@ void ParallelLinearAlgebra::mult(const ParallelMatrix& a, const ParallelVector&
 {
   wait();
 
-  double* idata = b.data_;
-  double* odata = r.data_;
+  if (a.op_)
+  {
+    a.op_->apply(b.data_, r.data_, start_, end_);
+    return;
+  }
 
-  double* data = a.data_;
-  auto rows = a.rows_;
-  auto columns = a.columns_;
+  if (a.fdata_)
+    multRows(a.rows_, a.fcolumns_, a.fdata_, b.data_, r.data_, start_, end_, noRowWork);
+  else
+    multRows(a.rows_, a.columns_, a.data_, b.data_, r.data_, start_, end_, noRowWork);
+}
 
-  for(size_t i=start_;i<end_;i++)
+void ParallelLinearAlgebra::mult_dots(const ParallelMatrix& a, const ParallelVector& u, ParallelVector& w,
+  const ParallelVector& r, double& wu, double& ru, double& rr)
+{
+  wait();
+
+  const double* udata = u.data_;
+  const double* wdata = w.data_;
+  const double* rdata = r.data_;
+  double sums[3] = { 0.0, 0.0, 0.0 };
+  auto dots = [&](size_t i)
   {
-    double sum = 0.0;
-    index_type row_idx = rows[i];
-    index_type next_idx = rows[i+1];
-    for(index_type j=row_idx;j<next_idx;j++)
-    {
-	    sum+=data[j]*idata[columns[j]];
-    }
-    odata[i]=sum;
+    sums[0] += wdata[i]*udata[i];
+    sums[1] += rdata[i]*udata[i];
+    sums[2] += rdata[i]*rdata[i];
+  };
+
+  if (a.op_)
+  {
+    a.op_->apply(u.data_, w.data_, start_, end_);
+    for (size_t i = start_; i < end_; i++)
+      dots(i);
   }
+  else if (a.fdata_)
+    multRows(a.rows_, a.fcolumns_, a.fdata_, u.data_, w.data_, start_, end_, dots);
+  else
+    multRows(a.rows_, a.columns_, a.data_, u.data_, w.data_, start_, end_, dots);
+
+  reduce_sum(sums, 3);
+  wu = sums[0];
+  ru = sums[1];
+  rr = sums[2];
 }
 
-void ParallelLinearAlgebra::mult_trans(ParallelMatrix& a, ParallelVector& b, ParallelVector& r)
+void ParallelLinearAlgebra::cg_update(double alpha, double beta, ParallelVector& u, const ParallelVector& w,
+  ParallelVector& p, ParallelVector& s, ParallelVector& x, ParallelVector& r, const ParallelVector& d)
 {
-  wait();
+  double* udata = u.data_;
+  const double* wdata = w.data_;
+  double* pdata = p.data_;
+  double* sdata = s.data_;
+  double* xdata = x.data_;
+  double* rdata = r.data_;
+  const double* ddata = d.data_;
 
-  double* idata = b.data_;
-  double* odata = r.data_;
+  for (size_t i = start_; i < end_; i++)
+  {
+    pdata[i] = udata[i] + beta*pdata[i];
+    sdata[i] = wdata[i] + beta*sdata[i];
+    xdata[i] += alpha*pdata[i];
+    rdata[i] -= alpha*sdata[i];
+    udata[i] = ddata[i]*rdata[i];
+  }
+}
 
-  double* data = a.data_;
-  auto rows = a.rows_;
-  auto columns = a.columns_;
-  size_t m = a.m_;
+void ParallelLinearAlgebra::mult_trans(ParallelMatrix& a, ParallelVector& b, ParallelVector& r)
+{
+  wait();
 
-  for (size_t i=start_; i<end_; i++) odata[i] = 0.0;
-  for (size_t j=0; j<m; j++)
+  if (a.op_)
   {
-    if (idata[j] == 0.0) continue;
-    double xj = idata[j];
-    auto row_idx = rows[j];
-    auto next_idx = rows[j+1];
-    auto i=row_idx;
-    for (; i<next_idx && columns[i] < start_; i++);
-    for (; i<next_idx && columns[i] < end_; i++)
-      odata[columns[i]] += data[i]*xj;
+    // SolveLinearSystemAlgo only accepts symmetric operators for bicg
+    a.op_->apply(b.data_, r.data_, start_, end_);
+    return;
   }
+
+  if (a.fdata_)
+    multTransRows(a.rows_, a.fcolumns_, a.fdata_, a.m_, b.data_, r.data_, start_, end_);
+  else
+    multTransRows(a.rows_, a.columns_, a.data_, a.m_, b.data_, r.data_, start_, end_);
 }
 
 void ParallelLinearAlgebra::diag(ParallelMatrix& a, ParallelVector& r)
 {
   double* odata = r.data_;
 
-  double* data = a.data_;
-  auto rows = a.rows_;
-  auto columns = a.columns_;
-
-  for(size_t i=start_;i<end_;i++)
+  if (a.op_)
   {
-    double val = 0.0;
-    size_t row_idx=rows[i];
-    size_t next_idx=rows[i+1];
-
-    for(size_t j=row_idx;j<next_idx;j++)
-    {
-      if (columns[j] == i) val = data[j];
-    }
-    odata[i]=val;
+    a.op_->diagonal(odata, start_, end_);
+    return;
   }
+
+  if (a.fdata_)
+    diagRows(a.rows_, a.fcolumns_, a.fdata_, odata, start_, end_);
+  else
+    diagRows(a.rows_, a.columns_, a.data_, odata, start_, end_);
 }
 
 void ParallelLinearAlgebra::absdiag(const ParallelMatrix& a, ParallelVector& r)
 {
   double* odata = r.data_;
 
-  double* data = a.data_;
-  auto rows = a.rows_;
-  auto columns = a.columns_;
-
-  for(size_t i=start_;i<end_;i++)
+  if (a.op_)
   {
-    double val = 0.0;
-    size_t row_idx=rows[i];
-    size_t next_idx=rows[i+1];
-
-    for(size_t j=row_idx;j<next_idx;j++)
-    {
-      if (columns[j] == i)
-        val = data[j];
-    }
-    odata[i]=std::abs(val);
+    a.op_->diagonal(odata, start_, end_);
+    for (size_t i = start_; i < end_; i++)
+      odata[i] = std::abs(odata[i]);
+    return;
   }
+
+  if (a.fdata_)
+    diagRows(a.rows_, a.fcolumns_, a.fdata_, odata, start_, end_);
+  else
+    diagRows(a.rows_, a.columns_, a.data_, odata, start_, end_);
+  for (size_t i = start_; i < end_; i++)
+    odata[i] = std::abs(odata[i]);
 }
 
 double ParallelLinearAlgebra::reduce_sum(double val)
@@ -735,6 +901,23 @@ double ParallelLinearAlgebra::reduce_sum(double val)
   return (ret);
 }
 
+void ParallelLinearAlgebra::reduce_sum(double* vals, int count)
+{
+  int buffer = reduce_buffer_;
+  for (int k=0; k<count; k++) reduce_[buffer][proc_*count+k] = vals[k];
+  if (reduce_buffer_)
+    reduce_buffer_ = 0;
+  else
+    reduce_buffer_ = 1;
+  wait();
+
+  for (int k=0; k<count; k++)
+  {
+    double ret = 0.0; for (int j=0; j<nproc_;j++) ret += reduce_[buffer][j*count+k];
+    vals[k] = ret;
+  }
+}
+
 /// @todo: std::max_element
 double ParallelLinearAlgebra::reduce_max(double val)
 {
@@ -767,9 +950,18 @@ double ParallelLinearAlgebra::reduce_min(double val)
 
 
 
+SCIRun::size_type SolverInputs::size() const
+{
+  if (A)
+    return A->nrows();
+  if (Af)
+    return Af->nrows();
+  return Op ? Op->nrows() : 0;
+}
+
 bool ParallelLinearAlgebraBase::start_parallel(SolverInputs& matrices, int nproc) const
 {
-  size_t size = matrices.A->nrows();
+  size_t size = matrices.size();
   if (matrices.b->nrows() != size
     || matrices.x->nrows() != size
     || matrices.x0->nrows() != size)
@@ -801,13 +993,13 @@ void ParallelLinearAlgebraBase::run_parallel(ParallelLinearAlgebraSharedData& da
 }
 
 ParallelLinearAlgebraSharedData::ParallelLinearAlgebraSharedData(const SolverInputs& inputs, int numProcs) :
-  size_(inputs.A->nrows()),
+  size_(inputs.size()),
   success_(numProcs),
   imatrices_(inputs),
   barrier_("Parallel Linear Algebra", numProcs),
   numProcs_(numProcs),
-  reduce1_(numProcs),
-  reduce2_(numProcs)
+  reduce1_(numProcs * MaxReduceValues),
+  reduce2_(numProcs * MaxReduceValues)
 {
   if (inputs.b->nrows() != size_
     || inputs.x->nrows() != size_
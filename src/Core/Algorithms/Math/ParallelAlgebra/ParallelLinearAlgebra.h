@@ -39,6 +39,7 @@
 #include <Core/Datatypes/MatrixFwd.h>
 #include <Core/Thread/Barrier.h>
 #include <Core/Datatypes/Legacy/Base/Types.h>
+#include <Core/Algorithms/Math/ParallelAlgebra/LinearOperator.h>
 #include <Core/Algorithms/Math/share.h>
 
 namespace SCIRun {
@@ -48,9 +49,37 @@ namespace Math {
 
   class ParallelLinearAlgebra;
 
+  // Single precision copy of a sparse matrix for the inner iterations of mixed-precision
+  // solves: float values and 32-bit column indices halve the bytes streamed per nonzero
+  class SCISHARE SinglePrecisionMatrix : boost::noncopyable
+  {
+  public:
+    explicit SinglePrecisionMatrix(const Datatypes::SparseRowMatrix& A);
+
+    size_type nrows() const { return static_cast<size_type>(rows_.size()) - 1; }
+    size_type ncols() const { return ncols_; }
+    size_t nonZeros() const { return values_.size(); }
+
+    index_type* rows() { return rows_.data(); }
+    const int* columns() const { return columns_.data(); }
+    const float* values() const { return values_.data(); }
+
+  private:
+    std::vector<index_type> rows_;
+    std::vector<int> columns_;
+    std::vector<float> values_;
+    size_type ncols_;
+  };
+
+  typedef SharedPointer<SinglePrecisionMatrix> SinglePrecisionMatrixHandle;
+
   struct SCISHARE SolverInputs
   {
     Datatypes::SparseRowMatrixHandle A;
+    // Matrix-free alternative to A, used when A is not set
+    LinearOperatorHandle Op;
+    // Single precision alternative to A, used when A is not set
+    SinglePrecisionMatrixHandle Af;
     Datatypes::DenseColumnMatrixHandle b;
     Datatypes::DenseColumnMatrixHandle x0;
     Datatypes::DenseColumnMatrixHandle x;
@@ -58,10 +87,14 @@ namespace Math {
     void clear()
     {
       A.reset();
+      Op.reset();
+      Af.reset();
       b.reset();
       x0.reset();
       x.reset();
     }
+
+    size_type size() const;
   };
 
   class SCISHARE ParallelLinearAlgebraSharedData : boost::noncopyable
@@ -96,6 +129,9 @@ namespace Math {
     double* reduceBuffer1() { return &reduce1_[0]; }
     double* reduceBuffer2() { return &reduce2_[0]; }
 
+    // Most values a single reduction can combine
+    static const int MaxReduceValues = 4;
+
   private:
     size_t size_;
     Datatypes::DenseColumnMatrixHandle current_matrix_;
@@ -145,6 +181,13 @@ public:
       size_t   m_;
       size_t   n_;
       size_t   nnz_;
+
+      // Set for matrix-free operators, the CSR arrays are unused then
+      const LinearOperator* op_ = nullptr;
+
+      // Set for single precision matrices, used instead of data_ and columns_
+      const float* fdata_ = nullptr;
+      const int* fcolumns_ = nullptr;
   };
 
   // Constructor
@@ -153,6 +196,10 @@ public:
   bool add_vector(Datatypes::DenseColumnMatrixHandle mat, ParallelVector& V);
   bool new_vector(ParallelVector& V);
   bool add_matrix(Datatypes::SparseRowMatrixHandle mat, ParallelMatrix& M);
+  bool add_matrix(LinearOperatorHandle op, ParallelMatrix& M);
+  bool add_matrix(SinglePrecisionMatrixHandle mat, ParallelMatrix& M);
+  // Links the system matrix: the sparse matrix A or else Af or the operator Op
+  bool add_matrix(const SolverInputs& inputs, ParallelMatrix& M);
 
   void mult(const ParallelVector& a, const ParallelVector& b, ParallelVector& r);
   void sub(const ParallelVector& a, const ParallelVector& b, ParallelVector& r);
@@ -187,6 +234,15 @@ public:
 
   void absdiag(const ParallelMatrix& a, ParallelVector& r);
 
+  // Fused kernels of the pipelined (Chronopoulos-Gear) CG: one pass over the vectors and
+  // one reduction per iteration.
+  // w = A*u, returning (w,u), (r,u) and (r,r) from a single reduction
+  void mult_dots(const ParallelMatrix& a, const ParallelVector& u, ParallelVector& w,
+    const ParallelVector& r, double& wu, double& ru, double& rr);
+  // p = u + beta*p; s = w + beta*s; x += alpha*p; r -= alpha*s; u = d.*r
+  void cg_update(double alpha, double beta, ParallelVector& u, const ParallelVector& w,
+    ParallelVector& p, ParallelVector& s, ParallelVector& x, ParallelVector& r, const ParallelVector& d);
+
   void ones(ParallelVector& r);
 
   int  proc() { return proc_; }
@@ -197,6 +253,8 @@ public:
 
 private:
   double reduce_sum(double val);
+  // sums count (at most MaxReduceValues) values at once
+  void reduce_sum(double* vals, int count);
   double reduce_min(double val);
   double reduce_max(double val);
 
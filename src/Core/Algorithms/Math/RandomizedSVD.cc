@@ -0,0 +1,204 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Algorithms/Math/RandomizedSVD.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Thread/Parallel.h>
+#include <Eigen/QR>
+#include <Eigen/SVD>
+#include <random>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Math;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+
+ALGORITHM_PARAMETER_DEF(Math, SVDMethod);
+ALGORITHM_PARAMETER_DEF(Math, TruncationRank);
+ALGORITHM_PARAMETER_DEF(Math, Oversampling);
+ALGORITHM_PARAMETER_DEF(Math, PowerIterations);
+ALGORITHM_PARAMETER_DEF(Math, ColumnBlockSize);
+
+RandomizedSVDParameters Math::randomizedSVDParameters(const AlgorithmParameterList& algo)
+{
+  RandomizedSVDParameters p;
+  p.rank = algo.get(Parameters::TruncationRank).toInt();
+  p.oversampling = algo.get(Parameters::Oversampling).toInt();
+  p.powerIterations = algo.get(Parameters::PowerIterations).toInt();
+  p.columnBlockSize = algo.get(Parameters::ColumnBlockSize).toInt();
+  return p;
+}
+
+MatrixColumnBlockSource::MatrixColumnBlockSource(MatrixHandle matrix)
+{
+  if (matrixIs::sparse(matrix))
+    sparse_ = castMatrix::toSparse(matrix);
+  else
+    dense_ = castMatrix::toDense(matrix);
+  if (!sparse_ && !dense_)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Unsupported matrix type for a column block source."));
+}
+
+size_type MatrixColumnBlockSource::nrows() const
+{
+  return dense_ ? dense_->nrows() : sparse_->nrows();
+}
+
+size_type MatrixColumnBlockSource::ncols() const
+{
+  return dense_ ? dense_->ncols() : sparse_->ncols();
+}
+
+void MatrixColumnBlockSource::block(index_type firstColumn, size_type numColumns, DenseMatrix& out) const
+{
+  if (dense_)
+    out = dense_->middleCols(firstColumn, numColumns);
+  else
+    out = sparse_->middleCols(firstColumn, numColumns).toDense();
+}
+
+void DenseColumnBlockSource::block(index_type firstColumn, size_type numColumns, DenseMatrix& out) const
+{
+  out = matrix_.middleCols(firstColumn, numColumns);
+}
+
+void CenteredColumnBlockSource::block(index_type firstColumn, size_type numColumns, DenseMatrix& out) const
+{
+  source_.block(firstColumn, numColumns, out);
+  out.rowwise() -= out.colwise().mean();
+}
+
+namespace
+{
+  typedef Eigen::MatrixXd Block;
+
+  /// Calls task(proc, firstColumn, numColumns, blockIndex) for every column block, blocks
+  /// dealt round-robin to the threads.
+  template <class Task>
+  void forEachBlock(size_type ncols, size_type blockSize, int nproc, Task task)
+  {
+    const size_type numBlocks = (ncols + blockSize - 1) / blockSize;
+    Parallel::RunTasks([&](int proc)
+    {
+      for (size_type b = proc; b < numBlocks; b += nproc)
+      {
+        const index_type first = b * blockSize;
+        task(proc, first, std::min(blockSize, ncols - first), b);
+      }
+    }, nproc);
+  }
+
+  Block orthonormalBasis(const Block& Y)
+  {
+    Eigen::HouseholderQR<Block> qr(Y);
+    return qr.householderQ() * Block::Identity(Y.rows(), Y.cols());
+  }
+}
+
+void RandomizedSVD::compute(const ColumnBlockSource& A, DenseMatrix& U, DenseColumnMatrix& S, DenseMatrix& V) const
+{
+  const size_type m = A.nrows();
+  const size_type n = A.ncols();
+  if (m == 0 || n == 0)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Input has a zero dimension."));
+  if (p_.rank < 1)
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Truncation rank must be positive."));
+
+  const size_type l = std::min<size_type>(p_.rank + std::max(p_.oversampling, 0), std::min(m, n));
+  const size_type k = std::min<size_type>(p_.rank, l);
+  const size_type blockSize = std::max(p_.columnBlockSize, 1);
+  const size_type numBlocks = (n + blockSize - 1) / blockSize;
+  const int nproc = static_cast<int>(std::max<size_type>(1,
+    std::min<size_type>(p_.numThreads < 1 ? Parallel::NumCores() : p_.numThreads, numBlocks)));
+
+  // Y = A * X, summed over column blocks; every thread keeps its own partial sum
+  auto multiply = [&](const std::function<void(index_type, size_type, size_type, Block&)>& rightRows)
+  {
+    std::vector<Block> partial(nproc, Block::Zero(m, l));
+    forEachBlock(n, blockSize, nproc, [&](int proc, index_type first, size_type count, size_type b)
+    {
+      DenseMatrix Ab;
+      Block Xb;
+      A.block(first, count, Ab);
+      rightRows(first, count, b, Xb);
+      partial[proc].noalias() += Ab * Xb;
+    });
+    for (int proc = 1; proc < nproc; ++proc)
+      partial[0] += partial[proc];
+    return partial[0];
+  };
+
+  // Z = A^T * Q; each block owns a disjoint row range of Z
+  auto multiplyTranspose = [&](const Block& Q)
+  {
+    Block Z(n, l);
+    forEachBlock(n, blockSize, nproc, [&](int, index_type first, size_type count, size_type)
+    {
+      DenseMatrix Ab;
+      A.block(first, count, Ab);
+      Z.middleRows(first, count).noalias() = Ab.transpose() * Q;
+    });
+    return Z;
+  };
+
+  // Gaussian test matrix, generated per block so the result does not depend on the thread count
+  Block Q = orthonormalBasis(multiply([this, l](index_type, size_type count, size_type b, Block& Xb)
+  {
+    std::mt19937 gen(p_.seed + static_cast<unsigned int>(b));
+    std::normal_distribution<double> normal;
+    Xb.resize(count, l);
+    for (index_type j = 0; j < static_cast<index_type>(l); ++j)
+      for (index_type i = 0; i < static_cast<index_type>(count); ++i)
+        Xb(i, j) = normal(gen);
+  }));
+
+  for (int q = 0; q < p_.powerIterations; ++q)
+  {
+    const Block Z = orthonormalBasis(multiplyTranspose(Q));
+    Q = orthonormalBasis(multiply([&Z](index_type first, size_type count, size_type, Block& Xb)
+    {
+      Xb = Z.middleRows(first, count);
+    }));
+  }
+
+  // B = Q^T A = Z^T with Z = A^T Q. Factor Z = Qz R, R = Ur S Vr^T, then
+  // A ~= Q B = (Q Vr) S (Qz Ur)^T.
+  const Block Z = multiplyTranspose(Q);
+  Eigen::HouseholderQR<Block> qrZ(Z);
+  const Block Qz = qrZ.householderQ() * Block::Identity(n, l);
+  const Block R = qrZ.matrixQR().topRows(l).triangularView<Eigen::Upper>();
+  Eigen::JacobiSVD<Block> svd(R, Eigen::ComputeFullU | Eigen::ComputeFullV);
+
+  S = svd.singularValues().head(k);
+  U = Q * svd.matrixV().leftCols(k);
+  V = Qz * svd.matrixU().leftCols(k);
+}
@@ -0,0 +1,130 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef ALGORITHMS_MATH_RANDOMIZEDSVD_H
+#define ALGORITHMS_MATH_RANDOMIZEDSVD_H
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/DenseColumnMatrix.h>
+#include <Core/Algorithms/Math/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace Math {
+
+  ALGORITHM_PARAMETER_DECL(SVDMethod);
+  ALGORITHM_PARAMETER_DECL(TruncationRank);
+  ALGORITHM_PARAMETER_DECL(Oversampling);
+  ALGORITHM_PARAMETER_DECL(PowerIterations);
+  ALGORITHM_PARAMETER_DECL(ColumnBlockSize);
+
+  /// Read-only access to a matrix one block of columns at a time, so the randomized
+  /// decomposition never needs the whole matrix in memory. block() is called concurrently
+  /// from several threads and must not modify shared state.
+  class SCISHARE ColumnBlockSource
+  {
+  public:
+    virtual ~ColumnBlockSource() {}
+    virtual size_type nrows() const = 0;
+    virtual size_type ncols() const = 0;
+    virtual void block(index_type firstColumn, size_type numColumns, Datatypes::DenseMatrix& out) const = 0;
+  };
+
+  /// Column blocks of an in-memory dense or sparse matrix.
+  class SCISHARE MatrixColumnBlockSource : public ColumnBlockSource
+  {
+  public:
+    explicit MatrixColumnBlockSource(Datatypes::MatrixHandle matrix);
+    size_type nrows() const override;
+    size_type ncols() const override;
+    void block(index_type firstColumn, size_type numColumns, Datatypes::DenseMatrix& out) const override;
+  private:
+    Datatypes::DenseMatrixHandle dense_;
+    Datatypes::SparseRowMatrixHandle sparse_;
+  };
+
+  /// Column blocks of a dense matrix owned by the caller, without copying it.
+  class SCISHARE DenseColumnBlockSource : public ColumnBlockSource
+  {
+  public:
+    explicit DenseColumnBlockSource(const Datatypes::DenseMatrix& matrix) : matrix_(matrix) {}
+    size_type nrows() const override { return matrix_.nrows(); }
+    size_type ncols() const override { return matrix_.ncols(); }
+    void block(index_type firstColumn, size_type numColumns, Datatypes::DenseMatrix& out) const override;
+  private:
+    const Datatypes::DenseMatrix& matrix_;
+  };
+
+  /// Column-wise mean removal on top of another source, as ComputePCA does with the full matrix.
+  /// The column means only depend on the column itself, so centering is done block by block.
+  class SCISHARE CenteredColumnBlockSource : public ColumnBlockSource
+  {
+  public:
+    explicit CenteredColumnBlockSource(const ColumnBlockSource& source) : source_(source) {}
+    size_type nrows() const override { return source_.nrows(); }
+    size_type ncols() const override { return source_.ncols(); }
+    void block(index_type firstColumn, size_type numColumns, Datatypes::DenseMatrix& out) const override;
+  private:
+    const ColumnBlockSource& source_;
+  };
+
+  struct SCISHARE RandomizedSVDParameters
+  {
+    int rank = 10;
+    int oversampling = 10;
+    int powerIterations = 2;
+    int columnBlockSize = 1024;
+    int numThreads = -1;
+    unsigned int seed = 1;
+  };
+
+  /// Reads the TruncationRank, Oversampling, PowerIterations and ColumnBlockSize parameters
+  /// of an algorithm that declares them.
+  SCISHARE RandomizedSVDParameters randomizedSVDParameters(const AlgorithmParameterList& algo);
+
+  /// Truncated SVD A ~= U diag(S) V^T of rank p.rank by a Gaussian range finder with
+  /// subspace (power) iterations (Halko, Martinsson and Tropp, SIAM Review 2011).
+  /// Every pass over A goes through the column blocks of the source in parallel, so the
+  /// working set is O((m + n) * (rank + oversampling)) plus one block per thread.
+  class SCISHARE RandomizedSVD
+  {
+  public:
+    explicit RandomizedSVD(const RandomizedSVDParameters& p) : p_(p) {}
+    void compute(const ColumnBlockSource& A, Datatypes::DenseMatrix& U,
+      Datatypes::DenseColumnMatrix& S, Datatypes::DenseMatrix& V) const;
+  private:
+    RandomizedSVDParameters p_;
+  };
+
+}}}}
+
+#endif
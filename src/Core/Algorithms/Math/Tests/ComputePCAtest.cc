@@ -160,3 +160,35 @@ TEST(ComputePCAtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m3,LeftPrinMat_U,PrinVals_S,RightPrinMat_V));
 
 }
+
+//Randomized mode centers block by block; the principal values must match the full PCA.
+TEST(ComputePCAtest, RandomizedMatchesFullPrincipalValues)
+{
+    ComputePCAAlgo algo;
+
+    DenseMatrixHandle m1(inputMatrix());
+    DenseMatrixHandle U_full, S_full, V_full;
+    algo.run(m1,U_full,S_full,V_full);
+
+    algo.setOption(SCIRun::Core::Algorithms::Math::Parameters::SVDMethod, "randomized");
+    algo.set(SCIRun::Core::Algorithms::Math::Parameters::TruncationRank, 2);
+    algo.set(SCIRun::Core::Algorithms::Math::Parameters::ColumnBlockSize, 1);
+
+    DenseMatrixHandle U, S, V;
+    algo.run(m1,U,S,V);
+
+    ASSERT_EQ(12,U->rows());
+    ASSERT_EQ(2,U->cols());
+    ASSERT_EQ(2,S->rows());
+    ASSERT_EQ(2,V->rows());
+
+    for (int i = 0; i < 2; ++i)
+        ASSERT_NEAR((*S_full)(i,0), (*S)(i,0), 1e-8);
+
+    DenseMatrix product = (*U) * S->col(0).asDiagonal() * V->transpose();
+    auto expected = *centeredInputMatrix();
+    for (int i = 0; i < product.rows(); ++i) {
+        for (int j = 0; j < product.cols(); ++j)
+            ASSERT_NEAR(expected(i,j), product(i,j), 1e-5);
+    }
+}
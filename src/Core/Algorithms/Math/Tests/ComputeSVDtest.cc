@@ -124,3 +124,40 @@ TEST(ComputeSVDtest, ThrowsForZeroDimensionInput)
     EXPECT_ANY_THROW(algo.run(m3,LeftSingularMatrix_U,SingularValues_S,RightSingularMatrix_V));
 
 }
+
+//Randomized mode on a low rank matrix: the leading singular values must match the full SVD,
+//and the block size must not change the result.
+TEST(ComputeSVDtest, RandomizedMatchesFullOnLowRankMatrix)
+{
+    Eigen::MatrixXd left = Eigen::MatrixXd::Random(60,5);
+    Eigen::MatrixXd right = Eigen::MatrixXd::Random(5,250);
+    DenseMatrixHandle m1(boost::make_shared<DenseMatrix>(left * right));
+
+    ComputeSVDAlgo algo;
+    DenseMatrixHandle U_full, S_full, V_full;
+    algo.run(m1,U_full,S_full,V_full);
+
+    algo.setOption(SCIRun::Core::Algorithms::Math::Parameters::SVDMethod, "randomized");
+    algo.set(SCIRun::Core::Algorithms::Math::Parameters::TruncationRank, 5);
+    algo.set(SCIRun::Core::Algorithms::Math::Parameters::ColumnBlockSize, 32);
+
+    DenseMatrixHandle U, S, V;
+    algo.run(m1,U,S,V);
+
+    ASSERT_EQ(60,U->rows());
+    ASSERT_EQ(5,U->cols());
+    ASSERT_EQ(5,S->rows());
+    ASSERT_EQ(250,V->rows());
+    ASSERT_EQ(5,V->cols());
+
+    for (int i = 0; i < 5; ++i)
+        EXPECT_NEAR((*S_full)(i,0), (*S)(i,0), 1e-8 * (*S_full)(0,0));
+
+    DenseMatrix product = (*U) * S->col(0).asDiagonal() * V->transpose();
+    EXPECT_NEAR(0.0, (product - *m1).norm() / m1->norm(), 1e-10);
+
+    algo.set(SCIRun::Core::Algorithms::Math::Parameters::ColumnBlockSize, 1000);
+    DenseMatrixHandle U2, S2, V2;
+    algo.run(m1,U2,S2,V2);
+    EXPECT_NEAR(0.0, (*S2 - *S).norm(), 1e-10 * (*S)(0,0));
+}
@@ -608,6 +608,95 @@ TEST(ParallelArithmeticTests, CanMultiplyMatrixByVectorMulti)
   EXPECT_EQ(2,vR.data_[size-1]);
 }
 
+TEST(ParallelArithmeticTests, CanMultiplySinglePrecisionMatrixByVector)
+{
+  ParallelLinearAlgebraSharedData data(getDummySystem(), 1);
+  ParallelLinearAlgebra pla(data, 0);
+
+  ParallelLinearAlgebra::ParallelVector v1, v2;
+  auto vec1 = vector1();
+  pla.add_vector(vec1, v1);
+  auto vec2 = vector2();
+  pla.add_vector(vec2, v2);
+
+  ParallelLinearAlgebra::ParallelMatrix m1;
+  auto mat1 = boost::make_shared<SinglePrecisionMatrix>(*matrix1());
+  EXPECT_EQ(3, mat1->nonZeros());
+  EXPECT_TRUE(pla.add_matrix(mat1, m1));
+
+  pla.mult(m1,v1,v2);
+
+  EXPECT_EQ(1,v2.data_[0]);
+  EXPECT_EQ(-4,v2.data_[1]);
+  EXPECT_EQ(0,v2.data_[2]);
+  EXPECT_EQ(-2,v2.data_[size-1]);
+
+  pla.diag(m1, v2);
+  EXPECT_EQ(1,v2.data_[0]);
+  EXPECT_EQ(0,v2.data_[1]);
+  EXPECT_EQ(2,v2.data_[size-1]);
+}
+
+TEST(ParallelArithmeticTests, CanMultiplyMatrixByVectorWithFusedDots)
+{
+  ParallelLinearAlgebraSharedData data(getDummySystem(), 1);
+  ParallelLinearAlgebra pla(data, 0);
+
+  ParallelLinearAlgebra::ParallelVector u, w, r;
+  auto vec1 = vector1();
+  pla.add_vector(vec1, u);
+  auto vec2 = vector2();
+  pla.add_vector(vec2, w);
+  auto vec3 = vector3();
+  pla.add_vector(vec3, r);
+
+  ParallelLinearAlgebra::ParallelMatrix m1;
+  auto mat1 = matrix1();
+  pla.add_matrix(mat1, m1);
+
+  double wu, ru, rr;
+  pla.mult_dots(m1, u, w, r, wu, ru, rr);
+
+  DenseColumnMatrix expectedW = *mat1 * *vec1;
+  EXPECT_EQ(expectedW[1], w.data_[1]);
+  EXPECT_EQ(expectedW.dot(*vec1), wu);
+  EXPECT_EQ(vec3->dot(*vec1), ru);
+  EXPECT_EQ(vec3->squaredNorm(), rr);
+}
+
+TEST(ParallelArithmeticTests, CanUpdateFusedCGVectors)
+{
+  ParallelLinearAlgebraSharedData data(getDummySystem(), 1);
+  ParallelLinearAlgebra pla(data, 0);
+
+  auto u0 = vector1(), w0 = vector2(), p0 = vector3(), s0 = vector1(), x0 = vector2(), r0 = vector3(), d0 = vector2();
+  auto u1 = boost::make_shared<DenseColumnMatrix>(*u0), p1 = boost::make_shared<DenseColumnMatrix>(*p0),
+    s1 = boost::make_shared<DenseColumnMatrix>(*s0), x1 = boost::make_shared<DenseColumnMatrix>(*x0),
+    r1 = boost::make_shared<DenseColumnMatrix>(*r0);
+  ParallelLinearAlgebra::ParallelVector u, w, p, s, x, r, d;
+  pla.add_vector(u1, u);
+  pla.add_vector(w0, w);
+  pla.add_vector(p1, p);
+  pla.add_vector(s1, s);
+  pla.add_vector(x1, x);
+  pla.add_vector(r1, r);
+  pla.add_vector(d0, d);
+
+  const double alpha = 0.5, beta = -2;
+  pla.cg_update(alpha, beta, u, w, p, s, x, r, d);
+
+  DenseColumnMatrix p2 = *u0 + beta * *p0;
+  DenseColumnMatrix s2 = *w0 + beta * *s0;
+  DenseColumnMatrix x2 = *x0 + alpha * p2;
+  DenseColumnMatrix r2 = *r0 - alpha * s2;
+  DenseColumnMatrix u2 = d0->cwiseProduct(r2);
+  EXPECT_EQ(p2, *p1);
+  EXPECT_EQ(s2, *s1);
+  EXPECT_EQ(x2, *x1);
+  EXPECT_EQ(r2, *r1);
+  EXPECT_EQ(u2, *u1);
+}
+
 TEST(ParallelArithmeticTests, CanSubtractVectors)
 {
   ParallelLinearAlgebraSharedData data(getDummySystem(),1);
@@ -29,6 +29,7 @@
 #include <Testing/Utils/SCIRunUnitTests.h>
 
 #include <fstream>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
 #include <Core/Algorithms/DataIO/ReadMatrix.h>
@@ -40,7 +41,9 @@
 #include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Core/Datatypes/MatrixIO.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
+#include <Core/Logging/LoggerInterface.h>
 
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Math;
@@ -147,3 +150,267 @@ TEST(SolveLinearSystemTests, DISABLED_CanSolveDarrell_MINRES)
   double solutionError = 2.4;
   CanSolveDarrellWithMethod("minres", solutionError);
 }
+
+namespace
+{
+  class RemarkLogger : public SCIRun::Core::Logging::LegacyLoggerInterface
+  {
+  public:
+    void error(const std::string&) const override {}
+    bool errorReported() const override { return false; }
+    void setErrorFlag(bool) override {}
+    void warning(const std::string&) const override {}
+    void remark(const std::string& msg) const override { remarks_.push_back(msg); }
+    void status(const std::string&) const override {}
+
+    int reuses() const
+    {
+      return static_cast<int>(std::count(remarks_.begin(), remarks_.end(), "Reusing factorization of the system matrix"));
+    }
+
+    mutable std::vector<std::string> remarks_;
+  };
+
+  // 5-point Laplacian on an n x n grid with Dirichlet boundary: symmetric positive definite
+  SparseRowMatrixHandle laplacian2D(int n)
+  {
+    std::vector<SparseRowMatrix::Triplet> entries;
+    auto id = [n](int i, int j) { return i + n * j; };
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+      {
+        entries.emplace_back(id(i, j), id(i, j), 4.0);
+        if (i > 0) entries.emplace_back(id(i, j), id(i - 1, j), -1.0);
+        if (i < n - 1) entries.emplace_back(id(i, j), id(i + 1, j), -1.0);
+        if (j > 0) entries.emplace_back(id(i, j), id(i, j - 1), -1.0);
+        if (j < n - 1) entries.emplace_back(id(i, j), id(i, j + 1), -1.0);
+      }
+    auto A(boost::make_shared<SparseRowMatrix>(n * n, n * n));
+    A->setFromTriplets(entries.begin(), entries.end());
+    return A;
+  }
+}
+
+TEST(SolveLinearSystemTests, LdltMatchesConjugateGradient)
+{
+  auto A = laplacian2D(20);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.set(Variables::TargetError, 1e-12);
+  algo.set(Variables::MaxIterations, 2000);
+  DenseColumnMatrixHandle xCG, xLDLT;
+  ASSERT_TRUE(algo.run(A, b, nullptr, xCG));
+  algo.setOption(Variables::Method, "ldlt");
+  ASSERT_TRUE(algo.run(A, b, nullptr, xLDLT));
+
+  EXPECT_TRUE(xLDLT->isApprox(*xCG, 1e-8));
+  EXPECT_LT((*A * *xLDLT - *b).norm(), 1e-10 * b->norm());
+}
+
+TEST(SolveLinearSystemTests, LdltReusesFactorizationOfSameMatrix)
+{
+  auto A = laplacian2D(10);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  auto logger = boost::make_shared<RemarkLogger>();
+  algo.setLogger(logger);
+  algo.setOption(Variables::Method, "ldlt");
+  DenseColumnMatrixHandle first, second, fresh;
+  ASSERT_TRUE(algo.run(A, b, nullptr, first));
+  EXPECT_EQ(0, logger->reuses());
+
+  // same matrix object: only the substitutions run
+  ASSERT_TRUE(algo.run(A, b, nullptr, second));
+  EXPECT_EQ(1, logger->reuses());
+  EXPECT_TRUE(second->isApprox(*first, 1e-12));
+
+  // a different matrix object is factored again
+  auto scaled = boost::make_shared<SparseRowMatrix>(*A);
+  *scaled *= 2.0;
+  ASSERT_TRUE(algo.run(scaled, b, nullptr, fresh));
+  EXPECT_EQ(1, logger->reuses());
+  EXPECT_TRUE(fresh->isApprox(0.5 * *first, 1e-10));
+}
+
+TEST(SolveLinearSystemTests, LdltSolvesSeveralRightHandSides)
+{
+  auto A = laplacian2D(12);
+  auto B(boost::make_shared<DenseMatrix>(DenseMatrix::Random(A->nrows(), 7)));
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, "ldlt");
+  DenseMatrixHandle X;
+  ASSERT_TRUE(algo.run(A, B, X));
+  ASSERT_EQ(B->nrows(), X->nrows());
+  ASSERT_EQ(B->ncols(), X->ncols());
+
+  for (int c = 0; c < B->ncols(); ++c)
+  {
+    auto b(boost::make_shared<DenseColumnMatrix>(B->col(c)));
+    DenseColumnMatrixHandle x;
+    ASSERT_TRUE(algo.run(A, b, nullptr, x));
+    EXPECT_TRUE(x->isApprox(X->col(c), 1e-12));
+  }
+}
+
+TEST(SolveLinearSystemTests, LdltThrowsForNonsymmetricMatrix)
+{
+  auto A = laplacian2D(4);
+  A->coeffRef(0, 1) = -2.0;
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Ones(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, "ldlt");
+  DenseColumnMatrixHandle x;
+  EXPECT_THROW(algo.run(A, b, nullptr, x), AlgorithmInputException);
+}
+
+TEST(SolveLinearSystemTests, SeveralRightHandSidesNeedLdlt)
+{
+  auto A = laplacian2D(4);
+  auto B(boost::make_shared<DenseMatrix>(DenseMatrix::Ones(A->nrows(), 2)));
+
+  SolveLinearSystemAlgo algo;
+  DenseMatrixHandle X;
+  EXPECT_THROW(algo.run(A, B, X), AlgorithmInputException);
+}
+
+class SolveLinearSystemMixedPrecisionTests : public ::testing::TestWithParam<const char*>
+{
+};
+
+TEST_P(SolveLinearSystemMixedPrecisionTests, ReachesDoublePrecisionTolerance)
+{
+  auto A = laplacian2D(40);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, GetParam());
+  algo.set(Variables::TargetError, 1e-11);
+  algo.set(Variables::MaxIterations, 2000);
+  DenseColumnMatrixHandle xDouble, xMixed;
+  ASSERT_TRUE(algo.run(A, b, nullptr, xDouble));
+  algo.setOption(Parameters::SolverPrecision, "mixed");
+  ASSERT_TRUE(algo.run(A, b, nullptr, xMixed));
+
+  // tighter than single precision alone could resolve
+  EXPECT_LT((*b - *A * *xMixed).norm(), 1e-11 * b->norm());
+  EXPECT_TRUE(xMixed->isApprox(*xDouble, 1e-9));
+}
+
+INSTANTIATE_TEST_CASE_P(
+  SolveLinearSystemMixedPrecisionTestsCgBicg,
+  SolveLinearSystemMixedPrecisionTests,
+  Values("cg", "pipecg", "bicg")
+  );
+
+class SolveLinearSystemPipelinedCGTests : public ::testing::TestWithParam<const char*>
+{
+};
+
+TEST_P(SolveLinearSystemPipelinedCGTests, MatchesConjugateGradient)
+{
+  auto A = laplacian2D(30);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Preconditioner, GetParam());
+  algo.set(Variables::TargetError, 1e-10);
+  algo.set(Variables::MaxIterations, 2000);
+  DenseColumnMatrixHandle xCG, xPipelined;
+  ASSERT_TRUE(algo.run(A, b, nullptr, xCG));
+  algo.setOption(Variables::Method, "pipecg");
+  ASSERT_TRUE(algo.run(A, b, nullptr, xPipelined));
+
+  EXPECT_LT((*b - *A * *xPipelined).norm(), 1e-9 * b->norm());
+  EXPECT_TRUE(xPipelined->isApprox(*xCG, 1e-8));
+}
+
+INSTANTIATE_TEST_CASE_P(
+  SolveLinearSystemPipelinedCGTestsPreconditioners,
+  SolveLinearSystemPipelinedCGTests,
+  Values("Jacobi", "None")
+  );
+
+TEST(SolveLinearSystemTests, MixedPrecisionNeedsKrylovMethod)
+{
+  auto A = laplacian2D(4);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Ones(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.setOption(Variables::Method, "minres");
+  algo.setOption(Parameters::SolverPrecision, "mixed");
+  DenseColumnMatrixHandle x;
+  EXPECT_THROW(algo.run(A, b, nullptr, x), AlgorithmInputException);
+}
+
+namespace
+{
+  // 7-point Laplacian on an n^3 grid
+  SparseRowMatrixHandle laplacian3D(int n)
+  {
+    std::vector<SparseRowMatrix::Triplet> entries;
+    auto id = [n](int i, int j, int k) { return i + n * (j + n * k); };
+    for (int k = 0; k < n; ++k)
+      for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i)
+        {
+          entries.emplace_back(id(i, j, k), id(i, j, k), 6.0);
+          if (i > 0) entries.emplace_back(id(i, j, k), id(i - 1, j, k), -1.0);
+          if (i < n - 1) entries.emplace_back(id(i, j, k), id(i + 1, j, k), -1.0);
+          if (j > 0) entries.emplace_back(id(i, j, k), id(i, j - 1, k), -1.0);
+          if (j < n - 1) entries.emplace_back(id(i, j, k), id(i, j + 1, k), -1.0);
+          if (k > 0) entries.emplace_back(id(i, j, k), id(i, j, k - 1), -1.0);
+          if (k < n - 1) entries.emplace_back(id(i, j, k), id(i, j, k + 1), -1.0);
+        }
+    auto A(boost::make_shared<SparseRowMatrix>(n * n * n, n * n * n));
+    A->setFromTriplets(entries.begin(), entries.end());
+    return A;
+  }
+}
+
+/// todo: switch these disabled timing tests to nightly mode. They are overly long for normal continuous builds.
+
+TEST(SolveLinearSystemTests, DISABLED_MixedPrecisionTimeToSolution)
+{
+  auto A = laplacian3D(64);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.set(Variables::TargetError, 1e-10);
+  algo.set(Variables::MaxIterations, 5000);
+  DenseColumnMatrixHandle xDouble, xMixed;
+  {
+    ScopedTimer t("double precision cg");
+    ASSERT_TRUE(algo.run(A, b, nullptr, xDouble));
+  }
+  algo.setOption(Parameters::SolverPrecision, "mixed");
+  {
+    ScopedTimer t("mixed precision cg");
+    ASSERT_TRUE(algo.run(A, b, nullptr, xMixed));
+  }
+  EXPECT_LT((*b - *A * *xMixed).norm(), 1e-10 * b->norm());
+}
+
+TEST(SolveLinearSystemTests, DISABLED_PipelinedCGTimeToSolution)
+{
+  auto A = laplacian3D(64);
+  auto b(boost::make_shared<DenseColumnMatrix>(DenseColumnMatrix::Random(A->nrows())));
+
+  SolveLinearSystemAlgo algo;
+  algo.set(Variables::TargetError, 1e-10);
+  algo.set(Variables::MaxIterations, 5000);
+  DenseColumnMatrixHandle xCG, xPipelined;
+  {
+    ScopedTimer t("cg");
+    ASSERT_TRUE(algo.run(A, b, nullptr, xCG));
+  }
+  algo.setOption(Variables::Method, "pipecg");
+  {
+    ScopedTimer t("pipelined cg");
+    ASSERT_TRUE(algo.run(A, b, nullptr, xPipelined));
+  }
+  EXPECT_LT((*b - *A * *xPipelined).norm(), 1e-9 * b->norm());
+}
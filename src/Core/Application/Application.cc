@@ -228,6 +228,20 @@ namespace
   }
 }
 
+namespace
+{
+  NetworkEditorControllerHandle makeController(ApplicationParametersHandle params, GlobalCommandFactoryHandle cmdFactory, NetworkEventCommandFactoryHandle eventCmdFactory)
+  {
+    /// @todo: these all get configured
+    ModuleFactoryHandle moduleFactory(new HardCodedModuleFactory);
+    ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
+    ExecutionStrategyFactoryHandle exe(new DesktopExecutionStrategyFactory(params->developerParameters()->threadMode()));
+    AlgorithmFactoryHandle algoFactory(new HardCodedAlgorithmFactory);
+    ReexecuteStrategyFactoryHandle reexFactory(new DynamicReexecutionStrategyFactory(params->developerParameters()->reexecuteMode()));
+    return boost::make_shared<NetworkEditorController>(moduleFactory, sf, exe, algoFactory, reexFactory, cmdFactory, eventCmdFactory);
+  }
+}
+
 NetworkEditorControllerHandle Application::controller()
 {
   ENSURE_NOT_NULL(private_, "Application internals are uninitialized!");
@@ -235,14 +249,7 @@ NetworkEditorControllerHandle Application::controller()
 
   if (!private_->controller_)
   {
-    /// @todo: these all get configured
-    ModuleFactoryHandle moduleFactory(new HardCodedModuleFactory);
-    ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
-    ExecutionStrategyFactoryHandle exe(new DesktopExecutionStrategyFactory(parameters()->developerParameters()->threadMode()));
-    AlgorithmFactoryHandle algoFactory(new HardCodedAlgorithmFactory);
-    ReexecuteStrategyFactoryHandle reexFactory(new DynamicReexecutionStrategyFactory(parameters()->developerParameters()->reexecuteMode()));
-    auto eventCmdFactory(makeNetworkEventCommandFactory());
-    private_->controller_.reset(new NetworkEditorController(moduleFactory, sf, exe, algoFactory, reexFactory, private_->cmdFactory_, eventCmdFactory));
+    private_->controller_ = makeController(parameters(), private_->cmdFactory_, makeNetworkEventCommandFactory());
 
     /// @todo: sloppy way to initialize this but similar to v4, oh well
     IEPluginManager::Initialize();
@@ -250,6 +257,15 @@ NetworkEditorControllerHandle Application::controller()
   return private_->controller_;
 }
 
+NetworkEditorControllerHandle Application::createWorkerController()
+{
+  ENSURE_NOT_NULL(private_, "Application internals are uninitialized!");
+  ENSURE_NOT_NULL(private_->cmdFactory_, "Application internals are uninitialized!");
+
+  IEPluginManager::Initialize();
+  return makeController(parameters(), private_->cmdFactory_, boost::make_shared<NullCommandFactory>());
+}
+
 void Application::executeCommandLineRequests()
 {
   ENSURE_NOT_NULL(private_, "Application internals are uninitialized!");
@@ -341,12 +357,13 @@ bool Application::get_user_name( std::string& user_name ) const
 std::string SaveFileCommandHelper::saveImpl(const std::string& filename)
 {
   auto fileNameWithExtension = filename;
-  if (!boost::algorithm::ends_with(fileNameWithExtension, ".srn5"))
+  if (!boost::algorithm::ends_with(fileNameWithExtension, ".srn5")
+    && !boost::algorithm::ends_with(fileNameWithExtension, BinaryNetworkFileExtension))
     fileNameWithExtension += ".srn5";
 
   auto file = Application::Instance().controller()->saveNetwork();
 
-  if (!XMLSerializer::save_xml(*file, fileNameWithExtension, "networkFile"))
+  if (!writeNetworkFile(*file, fileNameWithExtension))
     return "";
 
   return fileNameWithExtension;
@@ -68,6 +68,9 @@ public:
   void setCommandFactory(Commands::GlobalCommandFactoryHandle cmdFactory);
   CommandLine::ApplicationParametersHandle parameters() const;
   boost::shared_ptr<SCIRun::Dataflow::Engine::NetworkEditorController> controller();
+  /// Creates a separate controller set up like controller() but without network event commands,
+  /// so independent copies of a network can execute side by side (headless parameter sweeps).
+  boost::shared_ptr<SCIRun::Dataflow::Engine::NetworkEditorController> createWorkerController();
 
   void executeCommandLineRequests();
 
@@ -93,6 +93,7 @@ namespace SCIRun
         ExecuteCurrentNetwork,
         InteractiveMode,
         SetupQuitAfterExecute,
+        RunParameterSweep,
         QuitCommand
       };
 
@@ -70,6 +70,13 @@ using namespace SCIRun::Core::Algorithms;
       return q;
     }
 
+    if (params->parameterSweep())
+    {
+      q->enqueue(cmdFactory_->create(GlobalCommands::RunParameterSweep));
+      q->enqueue(cmdFactory_->create(GlobalCommands::QuitCommand));
+      return q;
+    }
+
     if (!params->disableSplash() && !params->disableGui())
       q->enqueue(cmdFactory_->create(GlobalCommands::ShowSplashScreen));
 
@@ -71,6 +71,10 @@ public:
       ("guiExpandFactor", po::value<double>(), "Expansion factor for high resolution displays")
       ("max-cores", po::value<unsigned int>(), "Limit the number of cores used by multithreaded algorithms")
       ("list-modules", "print list of available modules")
+      ("sweep", po::value<std::string>(), "Run the input network headless once per row of a CSV table of ModuleId::StateKey overrides")
+      ("sweep-collect", po::value<std::vector<std::string>>(), "Output port (ModuleId::PortName) saved for every sweep run")
+      ("sweep-output", po::value<std::string>(), "Directory receiving the per-run sweep output files")
+      ("sweep-jobs", po::value<unsigned int>(), "Number of sweep runs executed concurrently")
       ;
 
       positional_.add("input-file", -1);
@@ -192,11 +196,13 @@ public:
     const boost::optional<boost::filesystem::path>& pythonScriptFile,
     const boost::optional<boost::filesystem::path>& dataDirectory,
     const boost::optional<std::string>& networkToImport,
+    const boost::optional<ParameterSweepParameters>& parameterSweep,
     DeveloperParametersPtr devParams,
     const Flags& flags
    ) : entireCommandLine_(entireCommandLine),
     inputFiles_(inputFiles), pythonScriptFile_(pythonScriptFile), dataDirectory_(dataDirectory),
     networkToImport_(networkToImport),
+    parameterSweep_(parameterSweep),
     devParams_(devParams),
     flags_(flags)
   {}
@@ -296,12 +302,18 @@ public:
     return entireCommandLine_;
   }
 
+  boost::optional<ParameterSweepParameters> parameterSweep() const override
+  {
+    return parameterSweep_;
+  }
+
 private:
   std::string entireCommandLine_;
   std::vector<std::string> inputFiles_;
   boost::optional<boost::filesystem::path> pythonScriptFile_;
   boost::optional<boost::filesystem::path> dataDirectory_;
   boost::optional<std::string> networkToImport_;
+  boost::optional<ParameterSweepParameters> parameterSweep_;
   DeveloperParametersPtr devParams_;
   Flags flags_;
 };
@@ -352,6 +364,17 @@ ApplicationParametersHandle CommandLineParser::parse(int argc, const char* argv[
     {
       importNetworkFile = parsed["import"].as<std::string>();
     }
+    auto parameterSweep = boost::optional<ParameterSweepParameters>();
+    if (parsed.count("sweep") != 0 && !parsed["sweep"].empty() && !parsed["sweep"].defaulted())
+    {
+      ParameterSweepParameters sweep;
+      sweep.table = parsed["sweep"].as<std::string>();
+      sweep.outputDirectory = parsed.count("sweep-output") != 0 ? parsed["sweep-output"].as<std::string>() : "sweep_output";
+      if (parsed.count("sweep-collect") != 0)
+        sweep.collectedOutputs = parsed["sweep-collect"].as<std::vector<std::string>>();
+      sweep.jobs = parseOptionalArg<unsigned int>(parsed, "sweep-jobs");
+      parameterSweep = sweep;
+    }
 
     return boost::make_shared<ApplicationParametersImpl>
       (boost::algorithm::join(cmdline, " "),
@@ -359,6 +382,7 @@ ApplicationParametersHandle CommandLineParser::parse(int argc, const char* argv[
       pythonScriptFile,
       dataDirectory,
       importNetworkFile,
+      parameterSweep,
       boost::make_shared<DeveloperParametersImpl>(
         parseOptionalArg<std::string>(parsed, "threadMode"),
         parseOptionalArg<std::string>(parsed, "reexecuteMode"),
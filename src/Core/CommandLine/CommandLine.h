@@ -30,6 +30,7 @@
 #define CORE_COMMANDLINE_COMMANDLINESPEC_H
 
 #include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
@@ -43,6 +44,15 @@ namespace SCIRun {
       class DeveloperParameters;
       using DeveloperParametersPtr = boost::shared_ptr<DeveloperParameters>;
 
+      /// Options for running the input network headless over a table of module state overrides.
+      struct SCISHARE ParameterSweepParameters
+      {
+        boost::filesystem::path table;
+        boost::filesystem::path outputDirectory;
+        std::vector<std::string> collectedOutputs;
+        boost::optional<unsigned int> jobs;
+      };
+
       class SCISHARE ApplicationParameters : boost::noncopyable
       {
       public:
@@ -66,6 +76,7 @@ namespace SCIRun {
         virtual bool verboseMode() const = 0;
         virtual bool printModuleList() const = 0;
         virtual const std::string& entireCommandLine() const = 0;
+        virtual boost::optional<ParameterSweepParameters> parameterSweep() const = 0;
       };
 
       class SCISHARE DeveloperParameters : boost::noncopyable
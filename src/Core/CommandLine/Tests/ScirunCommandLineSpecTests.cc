@@ -59,7 +59,13 @@ TEST(ScirunCommandLineSpecTest, CanReadBasicOptions)
     "  --guiExpandFactor arg   Expansion factor for high resolution displays\n"
     "  --max-cores arg         Limit the number of cores used by multithreaded \n"
     "                          algorithms\n"
-    "  --list-modules          print list of available modules\n";
+    "  --list-modules          print list of available modules\n"
+    "  --sweep arg             Run the input network headless once per row of a CSV \n"
+    "                          table of ModuleId::StateKey overrides\n"
+    "  --sweep-collect arg     Output port (ModuleId::PortName) saved for every \n"
+    "                          sweep run\n"
+    "  --sweep-output arg      Directory receiving the per-run sweep output files\n"
+    "  --sweep-jobs arg        Number of sweep runs executed concurrently\n";
 
   EXPECT_EQ(expectedHelp, parser.describe());
 
@@ -199,4 +205,32 @@ TEST(ScirunCommandLineSpecTest, CanReadBasicOptions)
     EXPECT_TRUE(!!aph->importNetworkFile());
     EXPECT_EQ("oldnetwork.srn", *aph->importNetworkFile());
   }
+
+  {
+    const char* argv[] = { "scirun.exe", "net.srn5", "--sweep", "runs.csv", "--sweep-collect", "SolveLinearSystem:0::Solution",
+      "--sweep-collect", "MapFieldDataOntoNodes:0::OutputField", "--sweep-output", "results", "--sweep-jobs", "4" };
+    int argc = sizeof(argv) / sizeof(char*);
+
+    auto aph = parser.parse(argc, argv);
+
+    ASSERT_TRUE(!!aph->parameterSweep());
+    auto sweep = *aph->parameterSweep();
+    EXPECT_EQ("runs.csv", sweep.table);
+    EXPECT_EQ("results", sweep.outputDirectory);
+    ASSERT_EQ(2, sweep.collectedOutputs.size());
+    EXPECT_EQ("SolveLinearSystem:0::Solution", sweep.collectedOutputs[0]);
+    EXPECT_EQ("MapFieldDataOntoNodes:0::OutputField", sweep.collectedOutputs[1]);
+    ASSERT_TRUE(!!sweep.jobs);
+    EXPECT_EQ(4, *sweep.jobs);
+    EXPECT_EQ("net.srn5", aph->inputFiles()[0]);
+  }
+
+  {
+    const char* argv[] = { "scirun.exe", "net.srn5" };
+    int argc = sizeof(argv) / sizeof(char*);
+
+    auto aph = parser.parse(argc, argv);
+
+    EXPECT_FALSE(!!aph->parameterSweep());
+  }
 }
@@ -27,6 +27,7 @@
 
 
 #include <Core/ConsoleApplication/ConsoleCommands.h>
+#include <Core/ConsoleApplication/ParameterSweep.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Dataflow/Engine/Controller/NetworkEditorController.h>
 #include <Core/Application/Application.h>
@@ -84,7 +85,7 @@ bool LoadFileCommandConsole::execute()
   }
   try
   {
-    auto openedFile = XMLSerializer::load_xml<NetworkFile>(filename);
+    auto openedFile = readNetworkFile(filename);
 
     if (openedFile)
     {
@@ -241,6 +242,51 @@ bool RunPythonScriptCommandConsole::execute()
   return false;
 }
 
+bool RunParameterSweepCommandConsole::execute()
+{
+  quietModulesIfNotVerbose();
+
+  auto& app = Application::Instance();
+  auto sweep = app.parameters()->parameterSweep();
+  if (!sweep)
+    return false;
+
+  const auto& inputFiles = app.parameters()->inputFiles();
+  if (inputFiles.empty())
+  {
+    LOG_CONSOLE("Parameter sweep needs a network file.");
+    return false;
+  }
+
+  try
+  {
+    auto network = readNetworkFile(inputFiles[0]);
+    if (!network)
+    {
+      LOG_CONSOLE("File load failed: " << inputFiles[0]);
+      return false;
+    }
+    auto table = ParameterSweepTable::readFile(sweep->table);
+    LOG_CONSOLE("Running parameter sweep of " << inputFiles[0] << ": " << table.runs().size() << " runs from " << sweep->table);
+
+    ParameterSweepRunner runner(network, [&app]() { return app.createWorkerController(); }, sweep->jobs.value_or(0));
+    auto results = runner.run(table, sweep->collectedOutputs, sweep->outputDirectory);
+
+    auto failures = std::count_if(results.begin(), results.end(), [](const ParameterSweepResult& r) { return !r.succeeded; });
+    for (const auto& result : results)
+    {
+      LOG_CONSOLE("Run " << result.runId << (result.succeeded ? " finished" : " FAILED") << " in " << result.seconds << "s. " << result.message);
+    }
+    LOG_CONSOLE("Parameter sweep done: " << results.size() - failures << " of " << results.size() << " runs succeeded, outputs in " << sweep->outputDirectory);
+    return 0 == failures;
+  }
+  catch (std::exception& e)
+  {
+    LOG_CONSOLE("Parameter sweep failed: " << e.what());
+  }
+  return false;
+}
+
 bool SetupDataDirectoryCommand::execute()
 {
   auto dir = Application::Instance().parameters()->dataDirectory().get();
@@ -98,6 +98,12 @@ namespace Console {
 
   class SCISHARE PrintModulesCommand : public Core::Commands::ConsoleCommand
   {
+  public:
+    bool execute() override;
+  };
+
+  class SCISHARE RunParameterSweepCommandConsole : public Core::Commands::ConsoleCommand
+  {
   public:
     bool execute() override;
   };
@@ -0,0 +1,434 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/ConsoleApplication/ParameterSweep.h>
+#include <Dataflow/Engine/Controller/NetworkEditorController.h>
+#include <Dataflow/Engine/Scheduler/BoostGraphSerialScheduler.h>
+#include <Dataflow/Network/Module.h>
+#include <Dataflow/Network/NetworkInterface.h>
+#include <Dataflow/Network/SimpleSourceSink.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Matrix.h>
+#include <Core/Datatypes/String.h>
+#include <Core/Persistent/Persistent.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Utils/Exception.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <thread>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Console;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Dataflow::Engine;
+using namespace SCIRun::Dataflow::Networks;
+
+namespace
+{
+  const std::string addressSeparator("::");
+
+  std::pair<std::string, std::string> splitAddress(const std::string& address)
+  {
+    auto pos = address.rfind(addressSeparator);
+    if (pos == std::string::npos || pos == 0 || pos + addressSeparator.size() == address.size())
+      THROW_INVALID_ARGUMENT("Expected ModuleId" + addressSeparator + "Name, found: " + address);
+    return { boost::trim_copy(address.substr(0, pos)), boost::trim_copy(address.substr(pos + addressSeparator.size())) };
+  }
+
+  std::string defaultRunId(size_t index)
+  {
+    std::ostringstream ostr;
+    ostr << "run" << std::setw(4) << std::setfill('0') << index;
+    return ostr.str();
+  }
+}
+
+ParameterSweepTable ParameterSweepTable::read(std::istream& in)
+{
+  ParameterSweepTable table;
+  std::vector<std::pair<std::string, std::string>> columns;
+  std::set<std::string> ids;
+  bool headerRead = false, hasIdColumn = false;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line))
+  {
+    ++lineNumber;
+    boost::trim(line);
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::vector<std::string> cells;
+    boost::split(cells, line, boost::is_any_of(","));
+    for (auto& cell : cells)
+      boost::trim(cell);
+
+    if (!headerRead)
+    {
+      headerRead = true;
+      hasIdColumn = cells[0].find(addressSeparator) == std::string::npos;
+      for (size_t c = hasIdColumn ? 1 : 0; c < cells.size(); ++c)
+        columns.push_back(splitAddress(cells[c]));
+      if (columns.empty())
+        THROW_INVALID_ARGUMENT("Parameter sweep table has no ModuleId::StateKey columns.");
+      continue;
+    }
+
+    const size_t offset = hasIdColumn ? 1 : 0;
+    if (cells.size() != columns.size() + offset)
+    {
+      THROW_INVALID_ARGUMENT("Parameter sweep table line " + std::to_string(lineNumber) + " has "
+        + std::to_string(cells.size()) + " values, expected " + std::to_string(columns.size() + offset) + ".");
+    }
+
+    ParameterSweepRun run;
+    run.id = hasIdColumn && !cells[0].empty() ? cells[0] : defaultRunId(table.runs_.size());
+    if (!ids.insert(run.id).second)
+      THROW_INVALID_ARGUMENT("Duplicate parameter sweep run id: " + run.id);
+    for (size_t c = 0; c < columns.size(); ++c)
+      run.overrides.push_back({ columns[c].first, columns[c].second, cells[c + offset] });
+    table.runs_.push_back(run);
+  }
+  return table;
+}
+
+ParameterSweepTable ParameterSweepTable::readFile(const boost::filesystem::path& file)
+{
+  std::ifstream in(file.string());
+  if (!in)
+    THROW_INVALID_ARGUMENT("Could not open parameter sweep table: " + file.string());
+  return read(in);
+}
+
+Variable::Value SCIRun::Core::Console::convertOverride(const Variable& current, const StateOverride& change)
+{
+  const auto& value = current.value();
+  try
+  {
+    if (boost::get<int>(&value))
+      return boost::lexical_cast<int>(change.value);
+    if (boost::get<double>(&value))
+      return boost::lexical_cast<double>(change.value);
+    if (boost::get<std::string>(&value))
+      return change.value;
+    if (boost::get<bool>(&value))
+    {
+      auto lower = boost::to_lower_copy(change.value);
+      if (lower == "true" || lower == "1" || lower == "on" || lower == "yes")
+        return true;
+      if (lower == "false" || lower == "0" || lower == "off" || lower == "no")
+        return false;
+    }
+    else if (auto option = boost::get<AlgoOption>(&value))
+    {
+      if (option->options_.empty() || option->options_.count(change.value) != 0)
+        return AlgoOption(change.value, option->options_);
+    }
+  }
+  catch (boost::bad_lexical_cast&)
+  {
+  }
+  THROW_INVALID_ARGUMENT("Invalid value '" + change.value + "' for " + change.moduleId + addressSeparator + change.stateKey);
+}
+
+namespace
+{
+  boost::filesystem::path writeDatatype(const boost::filesystem::path& stem, DatatypeHandle data)
+  {
+    auto file = stem;
+    PiostreamPtr stream;
+    auto openStream = [&file, &stream](const std::string& extension)
+    {
+      file += extension;
+      stream = auto_ostream(file.string(), "Binary", nullptr);
+      if (stream->error())
+        THROW_INVALID_STATE("Could not open file for writing: " + file.string());
+    };
+
+    if (auto field = boost::dynamic_pointer_cast<Field>(data))
+    {
+      openStream(".fld");
+      Pio(*stream, field);
+    }
+    else if (auto matrix = boost::dynamic_pointer_cast<Matrix>(data))
+    {
+      openStream(".mat");
+      Pio(*stream, matrix);
+    }
+    else if (auto str = boost::dynamic_pointer_cast<String>(data))
+    {
+      file += ".txt";
+      std::ofstream out(file.string());
+      out << str->value();
+    }
+    else
+      THROW_INVALID_ARGUMENT("Cannot save sweep output of type " + data->dynamic_type_name());
+    return file;
+  }
+
+  /// Output data of a module that no sweep row touches, captured once and reused by every worker.
+  struct SharedSource
+  {
+    ModuleId module;
+    std::vector<std::pair<PortId, DatatypeHandle>> outputs;
+  };
+
+  struct CollectedOutput
+  {
+    std::string address;
+    std::string fileStem;
+    OutputPortHandle port;
+    boost::shared_ptr<SimpleSink> sink;
+  };
+
+  class SweepWorker
+  {
+  public:
+    SweepWorker(const ParameterSweepRunner::ControllerFactory& makeController, NetworkFileHandle file,
+      const std::vector<std::string>& collectedOutputs)
+    {
+      // Ports, sources and sinks register in process-wide sets, so workers are only ever built on the calling thread.
+      controller_ = makeController();
+      controller_->loadNetwork(file);
+      network_ = controller_->getNetwork();
+      order_ = BoostGraphSerialScheduler().schedule(*network_);
+
+      for (const auto& address : collectedOutputs)
+      {
+        auto modulePort = splitAddress(address);
+        auto ports = module(modulePort.first)->findOutputPortsWithName(modulePort.second);
+        if (ports.empty())
+          THROW_INVALID_ARGUMENT("Output port not found for sweep collection: " + address);
+        auto stem = modulePort.first + "_" + modulePort.second;
+        boost::replace_all(stem, ":", "");
+        outputs_.push_back({ address, stem, ports[0], boost::make_shared<SimpleSink>() });
+      }
+    }
+
+    ModuleHandle module(const std::string& id) const
+    {
+      auto m = network_->lookupModule(ModuleId(id));
+      if (!m)
+        THROW_INVALID_ARGUMENT("Module not found in sweep network: " + id);
+      return m;
+    }
+
+    void validate(const ParameterSweepTable& table) const
+    {
+      for (const auto& run : table.runs())
+      {
+        for (const auto& change : run.overrides)
+        {
+          auto state = module(change.moduleId)->get_state();
+          ModuleStateInterface::Name key(change.stateKey);
+          if (!state->containsKey(key))
+            THROW_INVALID_ARGUMENT("Unknown state key " + change.moduleId + addressSeparator + change.stateKey);
+          convertOverride(state->getValue(key), change);
+        }
+      }
+    }
+
+    std::vector<SharedSource> shareSources(const std::set<std::string>& overriddenModules) const
+    {
+      std::vector<SharedSource> shared;
+      auto sink = boost::make_shared<SimpleSink>();
+      for (size_t i = 0; i < network_->nmodules(); ++i)
+      {
+        auto m = network_->module(i);
+        if (overriddenModules.count(m->id().id_) != 0 || m->outputPorts().empty())
+          continue;
+        auto inputs = m->inputPorts();
+        if (std::any_of(inputs.begin(), inputs.end(), [](const InputPortHandle& p) { return p->nconnections() > 0; }))
+          continue;
+
+        SharedSource source{ m->id(), {} };
+        for (const auto& port : m->outputPorts())
+        {
+          port->source()->send(sink);
+          auto data = sink->receive();
+          if (!data || !*data)
+          {
+            source.outputs.clear();
+            break;
+          }
+          source.outputs.emplace_back(port->id(), *data);
+        }
+        if (!source.outputs.empty())
+          shared.push_back(source);
+      }
+      return shared;
+    }
+
+    void adopt(const std::vector<SharedSource>& shared)
+    {
+      for (const auto& source : shared)
+      {
+        auto m = network_->lookupModule(source.module);
+        for (const auto& output : source.outputs)
+          m->send_output_handle(output.first, output.second);
+        m->setExecutionDisabled(true);
+      }
+    }
+
+    ParameterSweepResult execute(const ParameterSweepRun& run, const boost::filesystem::path& outputDirectory)
+    {
+      ParameterSweepResult result;
+      result.runId = run.id;
+      auto start = std::chrono::steady_clock::now();
+      try
+      {
+        for (const auto& change : run.overrides)
+        {
+          auto state = module(change.moduleId)->get_state();
+          ModuleStateInterface::Name key(change.stateKey);
+          state->setValue(key, convertOverride(state->getValue(key), change));
+        }
+
+        // Modules within a run execute in order on this thread; concurrency comes from the other workers.
+        const auto errorsBefore = network_->errorCode();
+        network_->setModuleExecutionState(ModuleExecutionState::Value::Waiting, [](ModuleHandle) { return true; });
+        int failed = 0;
+        for (const auto& id : order_)
+        {
+          auto executable = network_->lookupExecutable(id);
+          if (executable && !executable->executeWithSignals())
+            ++failed;
+        }
+        result.moduleErrors = std::max(failed, network_->errorCode() - errorsBefore);
+
+        int missing = 0;
+        if (!outputs_.empty())
+        {
+          auto runDirectory = outputDirectory / run.id;
+          boost::filesystem::create_directories(runDirectory);
+          for (auto& output : outputs_)
+          {
+            output.port->source()->send(output.sink);
+            auto data = output.sink->receive();
+            if (!data || !*data)
+            {
+              result.message += "No data on " + output.address + ". ";
+              ++missing;
+              continue;
+            }
+            result.files.push_back(writeDatatype(runDirectory / output.fileStem, *data));
+          }
+        }
+        result.succeeded = 0 == result.moduleErrors && 0 == missing;
+      }
+      catch (const std::exception& e)
+      {
+        result.message += e.what();
+      }
+      result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      return result;
+    }
+
+  private:
+    NetworkEditorControllerHandle controller_;
+    NetworkHandle network_;
+    ModuleExecutionOrder order_;
+    std::vector<CollectedOutput> outputs_;
+  };
+
+  void writeSummary(const boost::filesystem::path& outputDirectory, const std::vector<ParameterSweepResult>& results)
+  {
+    std::ofstream summary((outputDirectory / "sweep_summary.csv").string());
+    summary << "run,succeeded,module_errors,seconds,message\n";
+    for (const auto& result : results)
+    {
+      summary << result.runId << ',' << result.succeeded << ',' << result.moduleErrors << ','
+        << result.seconds << ',' << boost::replace_all_copy(result.message, ",", ";") << '\n';
+    }
+  }
+}
+
+ParameterSweepRunner::ParameterSweepRunner(NetworkFileHandle network, ControllerFactory makeController, size_t jobs)
+  : network_(network), makeController_(makeController), jobs_(jobs)
+{
+  ENSURE_NOT_NULL(network_, "Parameter sweep network");
+  ENSURE_NOT_NULL(makeController_, "Parameter sweep controller factory");
+}
+
+std::vector<ParameterSweepResult> ParameterSweepRunner::run(const ParameterSweepTable& table,
+  const std::vector<std::string>& collectedOutputs,
+  const boost::filesystem::path& outputDirectory) const
+{
+  const auto& runs = table.runs();
+  std::vector<ParameterSweepResult> results(runs.size());
+  if (runs.empty())
+    return results;
+
+  boost::filesystem::create_directories(outputDirectory);
+
+  std::vector<std::unique_ptr<SweepWorker>> workers;
+  workers.emplace_back(new SweepWorker(makeController_, network_, collectedOutputs));
+  workers[0]->validate(table);
+
+  // The first run primes every module, including the readers that all later runs share.
+  results[0] = workers[0]->execute(runs[0], outputDirectory);
+
+  const auto jobs = std::min(jobs_ > 0 ? jobs_ : static_cast<size_t>(Core::Thread::Parallel::NumCores()), runs.size() - 1);
+  if (jobs > 1)
+  {
+    std::set<std::string> overriddenModules;
+    for (const auto& change : runs[0].overrides)
+      overriddenModules.insert(change.moduleId);
+    auto shared = workers[0]->shareSources(overriddenModules);
+    while (workers.size() < jobs)
+    {
+      workers.emplace_back(new SweepWorker(makeController_, network_, collectedOutputs));
+      workers.back()->adopt(shared);
+    }
+  }
+
+  std::atomic<size_t> next(1);
+  auto work = [&](SweepWorker& worker)
+  {
+    for (auto i = next++; i < runs.size(); i = next++)
+      results[i] = worker.execute(runs[i], outputDirectory);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t w = 1; w < workers.size(); ++w)
+    threads.emplace_back(work, std::ref(*workers[w]));
+  work(*workers[0]);
+  for (auto& t : threads)
+    t.join();
+
+  writeSummary(outputDirectory, results);
+  return results;
+}
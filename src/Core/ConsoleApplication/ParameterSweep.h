@@ -0,0 +1,119 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_CONSOLEAPPLICATION_PARAMETERSWEEP_H
+#define CORE_CONSOLEAPPLICATION_PARAMETERSWEEP_H
+
+#include <Dataflow/Network/NetworkFwd.h>
+#include <Core/Algorithms/Base/Variable.h>
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <Core/ConsoleApplication/share.h>
+
+namespace SCIRun {
+  namespace Dataflow {
+    namespace Engine {
+      class NetworkEditorController;
+    }}}
+
+namespace SCIRun {
+namespace Core {
+namespace Console {
+
+  /// One module state value replaced for a sweep run, addressed as ModuleId::StateKey.
+  struct SCISHARE StateOverride
+  {
+    std::string moduleId;
+    std::string stateKey;
+    std::string value;
+  };
+
+  /// The override's text as a value of the same type as the current state value: int, double, bool
+  /// (true/false, 1/0, on/off, yes/no), string, or one of an option's choices. Throws InvalidArgumentException otherwise.
+  SCISHARE Algorithms::Variable::Value convertOverride(const Algorithms::Variable& current, const StateOverride& change);
+
+  struct SCISHARE ParameterSweepRun
+  {
+    std::string id;
+    std::vector<StateOverride> overrides;
+  };
+
+  /// @class ParameterSweepTable
+  /// @brief Rows of state overrides read from CSV. The header names one ModuleId::StateKey per column;
+  /// an optional first column without "::" holds run labels. Blank lines and lines starting with # are skipped.
+  class SCISHARE ParameterSweepTable
+  {
+  public:
+    static ParameterSweepTable read(std::istream& in);
+    static ParameterSweepTable readFile(const boost::filesystem::path& file);
+
+    const std::vector<ParameterSweepRun>& runs() const { return runs_; }
+  private:
+    std::vector<ParameterSweepRun> runs_;
+  };
+
+  struct SCISHARE ParameterSweepResult
+  {
+    std::string runId;
+    bool succeeded = false;
+    int moduleErrors = 0;
+    double seconds = 0;
+    std::vector<boost::filesystem::path> files;
+    std::string message;
+  };
+
+  /// @class ParameterSweepRunner
+  /// @brief Executes one network for every row of a sweep table. Each worker owns a private copy of the
+  /// network, so runs proceed concurrently; the first run primes the source modules that no row overrides
+  /// (readers and other modules without connected inputs), and their outputs are handed read-only to every
+  /// other worker instead of being recomputed. Collected outputs, given as ModuleId::PortName, are written
+  /// to outputDirectory/<run id>/.
+  class SCISHARE ParameterSweepRunner : boost::noncopyable
+  {
+  public:
+    using ControllerFactory = std::function<boost::shared_ptr<Dataflow::Engine::NetworkEditorController>()>;
+
+    ParameterSweepRunner(Dataflow::Networks::NetworkFileHandle network, ControllerFactory makeController, size_t jobs);
+
+    std::vector<ParameterSweepResult> run(const ParameterSweepTable& table,
+      const std::vector<std::string>& collectedOutputs,
+      const boost::filesystem::path& outputDirectory) const;
+  private:
+    Dataflow::Networks::NetworkFileHandle network_;
+    ControllerFactory makeController_;
+    size_t jobs_;
+  };
+
+}}}
+
+#endif
@@ -0,0 +1,149 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/ConsoleApplication/ParameterSweep.h>
+#include <Core/Utils/Exception.h>
+#include <sstream>
+
+using namespace SCIRun::Core;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Console;
+
+namespace
+{
+  ParameterSweepTable readTable(const std::string& text)
+  {
+    std::istringstream in(text);
+    return ParameterSweepTable::read(in);
+  }
+
+  Variable::Value convert(const Variable::Value& current, const std::string& text)
+  {
+    return convertOverride(Variable(Name("Key"), current), { "Module:0", "Key", text });
+  }
+}
+
+TEST(ParameterSweepTableTests, ReadsIdColumnAndModuleStateColumns)
+{
+  auto table = readTable(
+    "id, CreateLatVol:0::XSize, SolveLinearSystem:1::TargetError\n"
+    "coarse, 8, 1e-4\n"
+    "fine,  64 , 1e-8\n");
+
+  ASSERT_EQ(2, table.runs().size());
+  const auto& run = table.runs()[1];
+  EXPECT_EQ("fine", run.id);
+  ASSERT_EQ(2, run.overrides.size());
+  EXPECT_EQ("CreateLatVol:0", run.overrides[0].moduleId);
+  EXPECT_EQ("XSize", run.overrides[0].stateKey);
+  EXPECT_EQ("64", run.overrides[0].value);
+  EXPECT_EQ("SolveLinearSystem:1", run.overrides[1].moduleId);
+  EXPECT_EQ("TargetError", run.overrides[1].stateKey);
+  EXPECT_EQ("1e-8", run.overrides[1].value);
+}
+
+TEST(ParameterSweepTableTests, NumbersRunsWithoutIdColumn)
+{
+  auto table = readTable(
+    "# resolution study\n"
+    "CreateLatVol:0::XSize\n"
+    "\n"
+    "8\n"
+    "16\n");
+
+  ASSERT_EQ(2, table.runs().size());
+  EXPECT_EQ("run0000", table.runs()[0].id);
+  EXPECT_EQ("run0001", table.runs()[1].id);
+  EXPECT_EQ("16", table.runs()[1].overrides[0].value);
+}
+
+TEST(ParameterSweepTableTests, FillsInEmptyIds)
+{
+  auto table = readTable("id, A:0::x\n, 1\nnamed, 2\n");
+  ASSERT_EQ(2, table.runs().size());
+  EXPECT_EQ("run0000", table.runs()[0].id);
+  EXPECT_EQ("named", table.runs()[1].id);
+}
+
+TEST(ParameterSweepTableTests, RejectsDuplicateIds)
+{
+  EXPECT_THROW(readTable("id, A:0::x\nsame, 1\nsame, 2\n"), InvalidArgumentException);
+}
+
+TEST(ParameterSweepTableTests, RejectsRowsWithWrongNumberOfValues)
+{
+  EXPECT_THROW(readTable("id, A:0::x, B:0::y\nfirst, 1\n"), InvalidArgumentException);
+  EXPECT_THROW(readTable("A:0::x, B:0::y\n1, 2, 3\n"), InvalidArgumentException);
+}
+
+TEST(ParameterSweepTableTests, EmptyInputHasNoRuns)
+{
+  EXPECT_TRUE(readTable("").runs().empty());
+  EXPECT_TRUE(readTable("# only a comment\n\n").runs().empty());
+  EXPECT_TRUE(readTable("id, A:0::x\n").runs().empty());
+}
+
+TEST(ParameterSweepTableTests, RejectsMalformedHeaders)
+{
+  EXPECT_THROW(readTable("id\nfirst\n"), InvalidArgumentException);
+  EXPECT_THROW(readTable("id, A:0:x\nfirst, 1\n"), InvalidArgumentException);
+  EXPECT_THROW(readTable("id, A:0::\nfirst, 1\n"), InvalidArgumentException);
+  EXPECT_THROW(readTable("id, ::x\nfirst, 1\n"), InvalidArgumentException);
+}
+
+TEST(ParameterSweepOverrideTests, KeepsTheTypeOfTheCurrentValue)
+{
+  // boost::get throws if the converted value changed type.
+  EXPECT_EQ(42, boost::get<int>(convert(7, "42")));
+  EXPECT_EQ(0.25, boost::get<double>(convert(1.0, "0.25")));
+  EXPECT_EQ("42", boost::get<std::string>(convert(std::string("old"), "42")));
+  EXPECT_TRUE(boost::get<bool>(convert(false, "true")));
+  EXPECT_TRUE(boost::get<bool>(convert(false, "Yes")));
+  EXPECT_FALSE(boost::get<bool>(convert(true, "0")));
+  EXPECT_FALSE(boost::get<bool>(convert(true, "OFF")));
+}
+
+TEST(ParameterSweepOverrideTests, AcceptsOnlyListedOptions)
+{
+  AlgoOption method("cg", { "cg", "bicg", "jacobi" });
+  auto converted = boost::get<AlgoOption>(convert(method, "bicg"));
+  EXPECT_EQ("bicg", converted.option_);
+  EXPECT_EQ(method.options_, converted.options_);
+  EXPECT_THROW(convert(method, "gmres"), InvalidArgumentException);
+}
+
+TEST(ParameterSweepOverrideTests, RejectsValuesThatDoNotParse)
+{
+  EXPECT_THROW(convert(7, "seven"), InvalidArgumentException);
+  EXPECT_THROW(convert(7, "7.5"), InvalidArgumentException);
+  EXPECT_THROW(convert(1.0, "1.0x"), InvalidArgumentException);
+  EXPECT_THROW(convert(1.0, ""), InvalidArgumentException);
+  EXPECT_THROW(convert(false, "maybe"), InvalidArgumentException);
+}
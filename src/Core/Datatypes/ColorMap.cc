@@ -31,6 +31,7 @@
 #include <Core/Math/MiscMath.h>
 #include <Core/Datatypes/ColorMap.h>
 #include <Core/Logging/Log.h>
+#include <Core/Thread/Parallel.h>
 #include <iostream>
 #include <boost/functional/factory.hpp>
 #include <boost/function.hpp>
@@ -41,6 +42,7 @@ using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 
 const static std::vector<ColorRGB> grayscaleData = {{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}};
 
@@ -159,7 +161,7 @@ ColorMap::ColorMap(const std::vector<ColorRGB>& colorData, const std::string& na
   invert_(invert), rescale_scale_(rescale_scale), rescale_shift_(rescale_shift),
   alphaLookup_(alphaPoints)
 {
-
+  buildLookup();
 }
 
 ColorMap* ColorMap::clone() const
@@ -172,21 +174,19 @@ inline static double clamp(double value, double min, double max)
   return std::min(std::max(value, min), max);
 }
 
-double ColorMap::getTransformedValue(double f) const
+size_t ColorMap::lookupIndex(double f) const
 {
   double v = clamp(static_cast<double>((f + rescale_shift_) * rescale_scale_), 0.0, 1.0);
-  double shift = shift_;
-
-  if (invert_) v = 1.0 - v, shift *= -1.0;
+  if (invert_) v = 1.0 - v;
+  if (std::isnan(v)) return 0;
 
   //apply the resolution
-  v = static_cast<double>((static_cast<int>(v * static_cast<double>(resolution_)))) /
-    static_cast<double>(resolution_ - 1);
+  return static_cast<size_t>(static_cast<int>(v * static_cast<double>(resolution_)));
+}
 
-  // the shift is a gamma. Make sure we don't hit divide by zero
-  double denom = std::tan(M_PI_2 * (0.5 - 0.5 * clamp(shift, -0.99, 0.99)));
-  denom = (std::isnan(denom) || denom < 0.001) ? 0.001 : denom;
-  return clamp(std::pow(v, 1.0 / denom), 0.0, 1.0);
+double ColorMap::getTransformedValue(double f) const
+{
+  return indexLookup_[lookupIndex(f)];
 }
 
 inline static double mix(double a, double b, double c)
@@ -253,11 +253,69 @@ ColorRGB ColorMap::applyAlpha(double transformed, ColorRGB colorWithoutAlpha) co
   return {colorWithoutAlpha.r(), colorWithoutAlpha.g(), colorWithoutAlpha.b(), a};
 }
 
+void ColorMap::buildLookup()
+{
+  double shift = invert_ ? -shift_ : shift_;
+
+  // the shift is a gamma. Make sure we don't hit divide by zero
+  double denom = std::tan(M_PI_2 * (0.5 - 0.5 * clamp(shift, -0.99, 0.99)));
+  denom = (std::isnan(denom) || denom < 0.001) ? 0.001 : denom;
+
+  indexLookup_.resize(resolution_ + 1);
+  for (size_t step = 0; step <= resolution_; ++step)
+  {
+    double v = static_cast<double>(static_cast<int>(step)) / static_cast<double>(resolution_ - 1);
+    indexLookup_[step] = clamp(std::pow(v, 1.0 / denom), 0.0, 1.0);
+  }
+
+  // A map without color data still gets full tables (default color) so every
+  // lookup below stays in range.
+  auto byte = [](double x) { return static_cast<uint32_t>(clamp(x, 0.0, 1.0) * 255.0 + 0.5); };
+  colorLookup_.resize(indexLookup_.size());
+  rgbaLookup_.resize(indexLookup_.size());
+  for (size_t step = 0; step < indexLookup_.size(); ++step)
+  {
+    double f = indexLookup_[step];
+    colorLookup_[step] = colorData_.empty() ? ColorRGB() : applyAlpha(f, readColorFromArray(colorData_, f));
+
+    const ColorRGB& c = colorLookup_[step];
+    rgbaLookup_[step] = byte(c.r()) | (byte(c.g()) << 8) | (byte(c.b()) << 16) | (byte(c.a()) << 24);
+  }
+}
+
 ColorRGB ColorMap::getColorMapVal(double v) const
 {
-  double f = getTransformedValue(v);
-  auto colorWithoutAlpha = readColorFromArray(colorData_, f);
-  return applyAlpha(f, colorWithoutAlpha);
+  return colorLookup_[lookupIndex(v)];
+}
+
+namespace
+{
+  // Tensors are colored by the length of their eigenvalue vector.
+  double magnitude(const Tensor& tensor)
+  {
+    Tensor t(tensor);
+    double eigen1, eigen2, eigen3;
+    t.get_eigenvalues(eigen1, eigen2, eigen3);
+    return Vector(eigen1, eigen2, eigen3).length();
+  }
+
+  // Splits [0, count) into one contiguous range per core once the batch is large
+  // enough to pay for the threads.
+  template <class RangeTask>
+  void forEachBlock(size_t count, const RangeTask& task)
+  {
+    const size_t minValuesPerTask = 1 << 15;
+    const size_t nproc = std::min<size_t>(Parallel::NumCores(), count / minValuesPerTask);
+    if (nproc <= 1)
+    {
+      task(0, count);
+      return;
+    }
+    Parallel::RunTasks([&](int proc)
+    {
+      task(count * proc / nproc, count * (proc + 1) / nproc);
+    }, static_cast<int>(nproc));
+  }
 }
 
 ColorRGB ColorMap::valueToColor(double scalar) const
@@ -272,10 +330,7 @@ ColorRGB ColorMap::valueToColor(const Vector &vector) const
 
 ColorRGB ColorMap::valueToColor(Tensor &tensor) const
 {
-  double eigen1, eigen2, eigen3;
-  tensor.get_eigenvalues(eigen1, eigen2, eigen3);
-  double magnitude = Vector(eigen1, eigen2, eigen3).length();
-  return getColorMapVal(magnitude);
+  return getColorMapVal(magnitude(tensor));
 }
 
 double ColorMap::valueToIndex(double scalar) const
@@ -290,10 +345,88 @@ double ColorMap::valueToIndex(const Vector &vector) const
 
 double ColorMap::valueToIndex(Tensor &tensor) const
 {
-  double eigen1, eigen2, eigen3;
-  tensor.get_eigenvalues(eigen1, eigen2, eigen3);
-  double magnitude = Vector(eigen1, eigen2, eigen3).length();
-  return getTransformedValue(magnitude);
+  return getTransformedValue(magnitude(tensor));
+}
+
+void ColorMap::valuesToColors(const double* values, size_t count, ColorRGB* colors) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      colors[i] = colorLookup_[lookupIndex(values[i])];
+  });
+}
+
+void ColorMap::valuesToColors(const Vector* values, size_t count, ColorRGB* colors) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      colors[i] = colorLookup_[lookupIndex(values[i].length())];
+  });
+}
+
+void ColorMap::valuesToColors(const Tensor* values, size_t count, ColorRGB* colors) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      colors[i] = colorLookup_[lookupIndex(magnitude(values[i]))];
+  });
+}
+
+void ColorMap::valuesToRGBA8(const double* values, size_t count, uint32_t* rgba) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      rgba[i] = rgbaLookup_[lookupIndex(values[i])];
+  });
+}
+
+void ColorMap::valuesToRGBA8(const Vector* values, size_t count, uint32_t* rgba) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      rgba[i] = rgbaLookup_[lookupIndex(values[i].length())];
+  });
+}
+
+void ColorMap::valuesToRGBA8(const Tensor* values, size_t count, uint32_t* rgba) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      rgba[i] = rgbaLookup_[lookupIndex(magnitude(values[i]))];
+  });
+}
+
+void ColorMap::valuesToIndices(const double* values, size_t count, double* indices) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      indices[i] = indexLookup_[lookupIndex(values[i])];
+  });
+}
+
+void ColorMap::valuesToIndices(const Vector* values, size_t count, double* indices) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      indices[i] = indexLookup_[lookupIndex(values[i].length())];
+  });
+}
+
+void ColorMap::valuesToIndices(const Tensor* values, size_t count, double* indices) const
+{
+  forEachBlock(count, [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      indices[i] = indexLookup_[lookupIndex(magnitude(values[i]))];
+  });
 }
 
 //TODO: heavily refactor
@@ -71,6 +71,21 @@ namespace Datatypes {
     double valueToIndex(Core::Geometry::Tensor &tensor) const;
     double valueToIndex(const Core::Geometry::Vector &vector) const;
 
+    // Batch versions of valueToColor/valueToIndex for coloring a whole field at once.
+    // Output arrays must hold count entries. Large batches are split across cores.
+    void valuesToColors(const double* values, size_t count, ColorRGB* colors) const;
+    void valuesToColors(const Core::Geometry::Vector* values, size_t count, ColorRGB* colors) const;
+    void valuesToColors(const Core::Geometry::Tensor* values, size_t count, ColorRGB* colors) const;
+
+    // Packed 8-bit RGBA, red in the lowest byte, ready for a GL_RGBA/GL_UNSIGNED_BYTE buffer.
+    void valuesToRGBA8(const double* values, size_t count, uint32_t* rgba) const;
+    void valuesToRGBA8(const Core::Geometry::Vector* values, size_t count, uint32_t* rgba) const;
+    void valuesToRGBA8(const Core::Geometry::Tensor* values, size_t count, uint32_t* rgba) const;
+
+    void valuesToIndices(const double* values, size_t count, double* indices) const;
+    void valuesToIndices(const Core::Geometry::Vector* values, size_t count, double* indices) const;
+    void valuesToIndices(const Core::Geometry::Tensor* values, size_t count, double* indices) const;
+
     std::string dynamic_type_name() const override { return "ColorMap"; }
 
   private:
@@ -79,6 +94,8 @@ namespace Datatypes {
     double getTransformedValue(double v) const;
     ColorRGB applyAlpha(double transformed, ColorRGB colorWithoutAlpha) const;
     double alpha(double transformedValue) const;
+    size_t lookupIndex(double v) const;
+    void buildLookup();
 
     std::vector<ColorRGB> colorData_;
     std::string nameInfo_; //The colormap's name.
@@ -88,6 +105,12 @@ namespace Datatypes {
     double rescale_scale_; //Rescaling scale (usually 1. / (data_max - data_min) ).
     double rescale_shift_; //Rescaling shift (usually -data_min). Shift happens before scale.
     std::vector<double> alphaLookup_;
+
+    // The transform quantizes values to resolution_ + 1 steps, so the transformed
+    // value and the color of every step are tabulated once at construction.
+    std::vector<double> indexLookup_;
+    std::vector<ColorRGB> colorLookup_;
+    std::vector<uint32_t> rgbaLookup_;
   };
 
   class SCISHARE StandardColorMapFactory : boost::noncopyable
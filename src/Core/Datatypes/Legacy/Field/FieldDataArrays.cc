@@ -0,0 +1,179 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
+#include <type_traits>
+#include <cmath>
+
+using namespace SCIRun;
+
+namespace
+{
+  using size_type = VMesh::size_type;
+
+  // The common strides are compile-time constants, so the unit-stride case
+  // becomes a plain streaming loop.
+  template <class Stride, class Op>
+  void applyToVectors(const VectorComponents& v, Stride stride, size_type size, double* result, Op op)
+  {
+    const double* x = v.x;
+    const double* y = v.y;
+    const double* z = v.z;
+    for (size_type i = 0; i < size; i++)
+    {
+      const size_type k = i * stride;
+      result[i] = op(x[k], y[k], z[k]);
+    }
+  }
+
+  template <class Op>
+  void applyToVectors(const VectorComponents& v, size_type size, double* result, Op op)
+  {
+    if (v.stride == 1)
+      applyToVectors(v, std::integral_constant<size_type, 1>(), size, result, op);
+    else if (v.stride == 3)
+      applyToVectors(v, std::integral_constant<size_type, 3>(), size, result, op);
+    else
+      applyToVectors(v, v.stride, size, result, op);
+  }
+
+  template <class Stride, class Op>
+  void applyToTensors(const SymmetricTensorComponents& t, Stride stride, size_type size, double* result, Op op)
+  {
+    const double* xx = t.xx;
+    const double* xy = t.xy;
+    const double* xz = t.xz;
+    const double* yy = t.yy;
+    const double* yz = t.yz;
+    const double* zz = t.zz;
+    for (size_type i = 0; i < size; i++)
+    {
+      const size_type k = i * stride;
+      result[i] = op(xx[k], xy[k], xz[k], yy[k], yz[k], zz[k]);
+    }
+  }
+
+  template <class Op>
+  void applyToTensors(const SymmetricTensorComponents& t, size_type size, double* result, Op op)
+  {
+    if (t.stride == 1)
+      applyToTensors(t, std::integral_constant<size_type, 1>(), size, result, op);
+    else if (t.stride == 6)
+      applyToTensors(t, std::integral_constant<size_type, 6>(), size, result, op);
+    else
+      applyToTensors(t, t.stride, size, result, op);
+  }
+
+  inline double squaredFrobeniusNorm(double xx, double xy, double xz, double yy, double yz, double zz)
+  {
+    return xx*xx + yy*yy + zz*zz + 2.0*(xy*xy + xz*xz + yz*yz);
+  }
+}
+
+VectorComponents VectorComponents::interleaved(const double* xyz)
+{
+  return { xyz, xyz + 1, xyz + 2, 3 };
+}
+
+SymmetricTensorComponents SymmetricTensorComponents::interleaved(const double* tensors)
+{
+  return { tensors, tensors + 1, tensors + 2, tensors + 3, tensors + 4, tensors + 5, 6 };
+}
+
+void VectorFieldArrays::resize(size_type size)
+{
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+}
+
+VectorComponents VectorFieldArrays::components() const
+{
+  return { x.data(), y.data(), z.data(), 1 };
+}
+
+void SymmetricTensorFieldArrays::resize(size_type size)
+{
+  xx.resize(size);
+  xy.resize(size);
+  xz.resize(size);
+  yy.resize(size);
+  yz.resize(size);
+  zz.resize(size);
+}
+
+SymmetricTensorComponents SymmetricTensorFieldArrays::components() const
+{
+  return { xx.data(), xy.data(), xz.data(), yy.data(), yz.data(), zz.data(), 1 };
+}
+
+void FieldDataKernels::vectorLengths(const VectorComponents& v, size_type size, double* result)
+{
+  applyToVectors(v, size, result, [](double x, double y, double z)
+  {
+    return std::sqrt(x*x + y*y + z*z);
+  });
+}
+
+void FieldDataKernels::tensorTraces(const SymmetricTensorComponents& t, size_type size, double* result)
+{
+  applyToTensors(t, size, result, [](double xx, double, double, double yy, double, double zz)
+  {
+    return xx + yy + zz;
+  });
+}
+
+void FieldDataKernels::tensorDeterminants(const SymmetricTensorComponents& t, size_type size, double* result)
+{
+  applyToTensors(t, size, result, [](double xx, double xy, double xz, double yy, double yz, double zz)
+  {
+    return xx*(yy*zz - yz*yz) - xy*(xy*zz - yz*xz) + xz*(xy*yz - yy*xz);
+  });
+}
+
+void FieldDataKernels::tensorSecondInvariants(const SymmetricTensorComponents& t, size_type size, double* result)
+{
+  applyToTensors(t, size, result, [](double xx, double xy, double xz, double yy, double yz, double zz)
+  {
+    return xx*yy + xx*zz + yy*zz - xy*xy - xz*xz - yz*yz;
+  });
+}
+
+void FieldDataKernels::tensorSquaredFrobeniusNorms(const SymmetricTensorComponents& t, size_type size, double* result)
+{
+  applyToTensors(t, size, result, squaredFrobeniusNorm);
+}
+
+void FieldDataKernels::tensorFrobeniusNorms(const SymmetricTensorComponents& t, size_type size, double* result)
+{
+  applyToTensors(t, size, result, [](double xx, double xy, double xz, double yy, double yz, double zz)
+  {
+    return std::sqrt(squaredFrobeniusNorm(xx, xy, xz, yy, yz, zz));
+  });
+}
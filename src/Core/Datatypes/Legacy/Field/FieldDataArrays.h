@@ -0,0 +1,121 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_DATATYPES_LEGACY_FIELD_FIELDDATAARRAYS_H
+#define CORE_DATATYPES_LEGACY_FIELD_FIELDDATAARRAYS_H 1
+
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <vector>
+
+#include <Core/Datatypes/Legacy/Field/share.h>
+
+namespace SCIRun {
+
+/// Read-only view of vector values given as three component pointers and a
+/// common stride. A stride of 1 addresses separate component arrays, a
+/// stride of 3 addresses interleaved x/y/z data such as an array of Vector.
+struct SCISHARE VectorComponents
+{
+  const double* x;
+  const double* y;
+  const double* z;
+  VMesh::size_type stride;
+
+  static VectorComponents interleaved(const double* xyz);
+};
+
+/// Read-only view of symmetric tensor values given as their six independent
+/// components (xx, xy, xz, yy, yz, zz) and a common stride.
+struct SCISHARE SymmetricTensorComponents
+{
+  const double* xx;
+  const double* xy;
+  const double* xz;
+  const double* yy;
+  const double* yz;
+  const double* zz;
+  VMesh::size_type stride;
+
+  static SymmetricTensorComponents interleaved(const double* tensors);
+};
+
+/// Structure-of-arrays copy of vector field data: one contiguous array per
+/// component. Obtained through VField::get_values and written back with
+/// VField::set_values, so the field itself keeps its usual storage.
+class SCISHARE VectorFieldArrays
+{
+public:
+  void resize(VMesh::size_type size);
+  VMesh::size_type size() const { return static_cast<VMesh::size_type>(x.size()); }
+  VectorComponents components() const;
+
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+};
+
+/// Structure-of-arrays copy of tensor field data. Only the six independent
+/// components of the symmetric tensor are kept, without the eigen
+/// decomposition that Tensor carries along.
+class SCISHARE SymmetricTensorFieldArrays
+{
+public:
+  void resize(VMesh::size_type size);
+  VMesh::size_type size() const { return static_cast<VMesh::size_type>(xx.size()); }
+  SymmetricTensorComponents components() const;
+
+  std::vector<double> xx;
+  std::vector<double> xy;
+  std::vector<double> xz;
+  std::vector<double> yy;
+  std::vector<double> yz;
+  std::vector<double> zz;
+};
+
+/// Per-value kernels over component views. The loops are written without
+/// branches or calls so that the compiler can vectorize them; the tensor
+/// invariants are evaluated in closed form instead of through an eigen
+/// decomposition.
+namespace FieldDataKernels {
+
+  SCISHARE void vectorLengths(const VectorComponents& v, VMesh::size_type size, double* result);
+
+  SCISHARE void tensorTraces(const SymmetricTensorComponents& t, VMesh::size_type size, double* result);
+  SCISHARE void tensorDeterminants(const SymmetricTensorComponents& t, VMesh::size_type size, double* result);
+  /// Sum of the principal 2x2 minors, i.e. l1*l2 + l1*l3 + l2*l3
+  SCISHARE void tensorSecondInvariants(const SymmetricTensorComponents& t, VMesh::size_type size, double* result);
+  /// Squared Frobenius norm, i.e. l1^2 + l2^2 + l3^2
+  SCISHARE void tensorSquaredFrobeniusNorms(const SymmetricTensorComponents& t, VMesh::size_type size, double* result);
+  SCISHARE void tensorFrobeniusNorms(const SymmetricTensorComponents& t, VMesh::size_type size, double* result);
+
+}
+
+}
+
+#endif
@@ -41,6 +41,7 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/GeometryPrimitives/Transform.h>
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/TaskPool.h>
 #include <sci_debug.h>
 
 using namespace SCIRun;
@@ -382,6 +383,12 @@ Mesh::basis_order()
   return (-1);
 }
 
+std::shared_future<bool>
+Mesh::synchronize_async(mask_type sync)
+{
+  return TaskPool::Instance().submit<bool>([this, sync]() { return synchronize(sync); });
+}
+
 const int MESHBASE_VERSION = 2;
 
 void Mesh::io(Piostream& stream)
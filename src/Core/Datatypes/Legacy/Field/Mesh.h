@@ -34,6 +34,7 @@
 #include <Core/Datatypes/Datatype.h>
 #include <Core/Datatypes/Mesh/MeshTraits.h>
 #include <Core/Datatypes/Legacy/Field/FieldFwd.h>
+#include <future>
 #include <Core/Datatypes/Legacy/Field/share.h>
 
 namespace SCIRun {
@@ -87,6 +88,11 @@ public:
   virtual bool synchronize(mask_type) { return false; }
   virtual bool unsynchronize(mask_type) { return false; }
 
+  /// Runs synchronize(sync) on the shared task pool and returns right away.
+  /// The mesh has to outlive the returned future. Do not wait on it from
+  /// inside a pool task, as the request may still be queued behind it.
+  std::shared_future<bool> synchronize_async(mask_type sync);
+
   virtual int basis_order();
 
   /// Persistent I/O.
@@ -0,0 +1,115 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_DATATYPES_LEGACY_FIELD_MESHDISPATCH_H
+#define CORE_DATATYPES_LEGACY_FIELD_MESHDISPATCH_H 1
+
+#include <Core/Basis/Constant.h>
+#include <Core/Basis/CrvLinearLgn.h>
+#include <Core/Basis/TriLinearLgn.h>
+#include <Core/Basis/QuadBilinearLgn.h>
+#include <Core/Basis/TetLinearLgn.h>
+#include <Core/Basis/PrismLinearLgn.h>
+#include <Core/Basis/HexTrilinearLgn.h>
+#include <Core/Datatypes/Legacy/Field/PointCloudMesh.h>
+#include <Core/Datatypes/Legacy/Field/CurveMesh.h>
+#include <Core/Datatypes/Legacy/Field/TriSurfMesh.h>
+#include <Core/Datatypes/Legacy/Field/QuadSurfMesh.h>
+#include <Core/Datatypes/Legacy/Field/TetVolMesh.h>
+#include <Core/Datatypes/Legacy/Field/PrismVolMesh.h>
+#include <Core/Datatypes/Legacy/Field/HexVolMesh.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+
+namespace SCIRun {
+
+/// The mesh classes that dispatch_unstructured_mesh() resolves to.
+typedef PointCloudMesh<Core::Basis::ConstantBasis<Core::Geometry::Point> >  PointCloudMeshLinear;
+typedef CurveMesh<Core::Basis::CrvLinearLgn<Core::Geometry::Point> >        CurveMeshLinear;
+typedef TriSurfMesh<Core::Basis::TriLinearLgn<Core::Geometry::Point> >      TriSurfMeshLinear;
+typedef QuadSurfMesh<Core::Basis::QuadBilinearLgn<Core::Geometry::Point> >  QuadSurfMeshLinear;
+typedef TetVolMesh<Core::Basis::TetLinearLgn<Core::Geometry::Point> >       TetVolMeshLinear;
+typedef PrismVolMesh<Core::Basis::PrismLinearLgn<Core::Geometry::Point> >   PrismVolMeshLinear;
+typedef HexVolMesh<Core::Basis::HexTrilinearLgn<Core::Geometry::Point> >    HexVolMeshLinear;
+
+/// Resolve a mesh to its concrete class once and call functor(mesh) with it.
+///
+/// Loops that go through VMesh pay a virtual call for every get_nodes(),
+/// get_center(), get_size() or get_point(), although the mesh type is fixed
+/// for the whole loop. FUNCTOR provides
+///
+///   template <class MESH> void operator()(MESH& mesh);
+///
+/// so that the loop is compiled against the inline accessors of each mesh
+/// class. The body should stick to the names VMesh shares with the mesh
+/// classes (the Node/Edge/Face/Cell/Elem/DElem types, get_nodes, get_elems,
+/// get_center, get_size, get_point), which lets the same operator() be
+/// called with a VMesh for every other mesh type.
+///
+/// Only the linear unstructured meshes are resolved; returns false for any
+/// other mesh without calling the functor. Synchronization is left to the
+/// caller and has to be requested through VMesh before dispatching.
+template <class FUNCTOR>
+bool dispatch_unstructured_mesh(Mesh* mesh, FUNCTOR& functor)
+{
+  if (!mesh)
+    return (false);
+
+  if (auto m = dynamic_cast<TetVolMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<HexVolMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<TriSurfMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<QuadSurfMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<PrismVolMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<CurveMeshLinear*>(mesh))
+    functor(*m);
+  else if (auto m = dynamic_cast<PointCloudMeshLinear*>(mesh))
+    functor(*m);
+  else
+    return (false);
+
+  return (true);
+}
+
+/// Call functor with the concrete mesh class of field when it is one of the
+/// linear unstructured meshes and with its VMesh otherwise.
+template <class FUNCTOR>
+void dispatch_mesh(const FieldHandle& field, FUNCTOR& functor)
+{
+  if (!dispatch_unstructured_mesh(field->mesh().get(), functor))
+    functor(*field->vmesh());
+}
+
+}
+
+#endif
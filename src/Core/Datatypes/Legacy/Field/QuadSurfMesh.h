@@ -54,6 +54,7 @@
 #include <Core/Datatypes/Mesh/VirtualMeshFacade.h>
 
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/TaskPool.h>
 #include <Core/Thread/ConditionVariable.h>
 #include <unordered_map>
 #include <Core/Persistent/PersistentSTL.h>
@@ -2347,6 +2348,23 @@ QuadSurfMesh<Basis>::QuadSurfMesh(const QuadSurfMesh &copy)
   points_ = copy.points_;
   faces_ = copy.faces_;
 
+  if (copy.synchronized_ & Mesh::EDGES_E)
+  {
+    edges_ = copy.edges_;
+    halfedge_to_edge_ = copy.halfedge_to_edge_;
+    synchronized_ |= Mesh::EDGES_E;
+  }
+  if (copy.synchronized_ & Mesh::NORMALS_E)
+  {
+    normals_ = copy.normals_;
+    synchronized_ |= Mesh::NORMALS_E;
+  }
+  if (copy.synchronized_ & Mesh::NODE_NEIGHBORS_E)
+  {
+    node_neighbors_ = copy.node_neighbors_;
+    synchronized_ |= Mesh::NODE_NEIGHBORS_E;
+  }
+
   /// Create a new virtual interface for this copy
   /// all pointers have changed hence create a new
   /// virtual interface class
@@ -2625,89 +2643,15 @@ QuadSurfMesh<Basis>::synchronize(mask_type sync)
     return (true);
   }
 
-  if (sync == Mesh::EDGES_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::EDGES_E)
-  {
-    mask_type tosync = Mesh::EDGES_E;
-    Synchronize syncclass(this,tosync);
-    SCIRun::Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NORMALS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NORMALS_E)
-  {
-    mask_type tosync = Mesh::NORMALS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_NEIGHBORS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_NEIGHBORS_E)
-  {
-    mask_type tosync = Mesh::NODE_NEIGHBORS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::BOUNDING_BOX_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::BOUNDING_BOX_E)
-  {
-    mask_type tosync = Mesh::BOUNDING_BOX_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_LOCATE_E)
+  std::vector<std::function<void()> > tasks;
+  for (mask_type table : { Mesh::EDGES_E, Mesh::NORMALS_E, Mesh::NODE_NEIGHBORS_E, Mesh::BOUNDING_BOX_E, Mesh::NODE_LOCATE_E, Mesh::ELEM_LOCATE_E })
   {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_LOCATE_E)
-  {
-    mask_type tosync = Mesh::NODE_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::ELEM_LOCATE_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::ELEM_LOCATE_E)
-  {
-    mask_type tosync = Mesh::ELEM_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
+    if (sync & table)
+      tasks.push_back([this, table]() { Synchronize(this, table).run(); });
   }
+  synchronize_lock_.unlock();
+  Core::Thread::TaskPool::Instance().runAll(tasks);
+  synchronize_lock_.lock();
 
   // Wait until threads are done
     while ((synchronized_ & sync) != sync)
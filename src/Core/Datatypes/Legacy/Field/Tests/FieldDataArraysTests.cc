@@ -0,0 +1,145 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+#include <vector>
+#include <cmath>
+
+using namespace SCIRun;
+using namespace SCIRun::TestUtils;
+using namespace SCIRun::Core::Geometry;
+
+TEST(FieldDataArraysTest, VectorFieldRoundTripsThroughComponentArrays)
+{
+  FieldHandle field = CreateEmptyLatVol(2, 2, 2, data_info_type::VECTOR_E);
+  VField* vfield = field->vfield();
+  for (VMesh::index_type i = 0; i < vfield->num_values(); ++i)
+    vfield->set_value(Vector(i, 2*i, 3*i), i);
+
+  VectorFieldArrays values;
+  ASSERT_TRUE(vfield->get_values(values));
+  ASSERT_EQ(8, values.size());
+  EXPECT_EQ(5, values.x[5]);
+  EXPECT_EQ(10, values.y[5]);
+  EXPECT_EQ(15, values.z[5]);
+
+  values.z[3] = -1;
+  ASSERT_TRUE(vfield->set_values(values));
+  Vector v;
+  vfield->get_value(v, 3);
+  EXPECT_EQ(Vector(3, 6, -1), v);
+}
+
+TEST(FieldDataArraysTest, TensorFieldRoundTripsThroughComponentArrays)
+{
+  FieldHandle field = CreateEmptyLatVol(2, 2, 2, data_info_type::TENSOR_E);
+  VField* vfield = field->vfield();
+  vfield->set_value(Tensor(1, 2, 3, 4, 5, 6), 1);
+
+  SymmetricTensorFieldArrays values;
+  ASSERT_TRUE(vfield->get_values(values));
+  ASSERT_EQ(8, values.size());
+  EXPECT_EQ(2, values.xy[1]);
+  EXPECT_EQ(5, values.yz[1]);
+  EXPECT_EQ(6, values.zz[1]);
+
+  values.xx[2] = 7;
+  ASSERT_TRUE(vfield->set_values(values));
+  Tensor t;
+  vfield->get_value(t, 2);
+  EXPECT_EQ(7, t.xx());
+  vfield->get_value(t, 1);
+  EXPECT_EQ(Tensor(1, 2, 3, 4, 5, 6), t);
+}
+
+TEST(FieldDataArraysTest, ScalarFieldHasNoComponentArrays)
+{
+  FieldHandle field = CreateEmptyLatVol(2, 2, 2, data_info_type::DOUBLE_E);
+  VectorFieldArrays vectors;
+  SymmetricTensorFieldArrays tensors;
+  EXPECT_FALSE(field->vfield()->get_values(vectors));
+  EXPECT_FALSE(field->vfield()->get_values(tensors));
+}
+
+TEST(FieldDataArraysTest, VectorLengthsAgreeForSeparateAndInterleavedData)
+{
+  VectorFieldArrays separate;
+  separate.resize(5);
+  std::vector<double> interleaved;
+  for (int i = 0; i < 5; ++i)
+  {
+    separate.x[i] = i; separate.y[i] = -2*i; separate.z[i] = 0.5;
+    interleaved.insert(interleaved.end(), { separate.x[i], separate.y[i], separate.z[i] });
+  }
+
+  std::vector<double> fromSeparate(5), fromInterleaved(5);
+  FieldDataKernels::vectorLengths(separate.components(), 5, fromSeparate.data());
+  FieldDataKernels::vectorLengths(VectorComponents::interleaved(interleaved.data()), 5, fromInterleaved.data());
+
+  for (int i = 0; i < 5; ++i)
+  {
+    Vector v(separate.x[i], separate.y[i], separate.z[i]);
+    EXPECT_DOUBLE_EQ(v.length(), fromSeparate[i]);
+    EXPECT_DOUBLE_EQ(v.length(), fromInterleaved[i]);
+  }
+}
+
+TEST(FieldDataArraysTest, TensorInvariantsMatchEigenvalues)
+{
+  // the first tensor has eigenvalues 1, 2 and 3
+  std::vector<double> data = { 1.5, 0.5, 0, 1.5, 0, 3,   1, 2, 3, 4, 5, 6 };
+  auto tensors = SymmetricTensorComponents::interleaved(data.data());
+
+  std::vector<double> result(2);
+  FieldDataKernels::tensorTraces(tensors, 2, result.data());
+  EXPECT_NEAR(6, result[0], 1e-12);
+  EXPECT_NEAR(11, result[1], 1e-12);
+
+  FieldDataKernels::tensorDeterminants(tensors, 2, result.data());
+  EXPECT_NEAR(6, result[0], 1e-12);
+  EXPECT_NEAR(-1, result[1], 1e-12);
+
+  FieldDataKernels::tensorSecondInvariants(tensors, 2, result.data());
+  EXPECT_NEAR(11, result[0], 1e-12);
+  EXPECT_NEAR(-4, result[1], 1e-12);
+
+  FieldDataKernels::tensorSquaredFrobeniusNorms(tensors, 2, result.data());
+  EXPECT_NEAR(14, result[0], 1e-12);
+  EXPECT_NEAR(129, result[1], 1e-12);
+
+  FieldDataKernels::tensorFrobeniusNorms(tensors, 2, result.data());
+  EXPECT_NEAR(std::sqrt(14.0), result[0], 1e-12);
+  EXPECT_NEAR(std::sqrt(129.0), result[1], 1e-12);
+}
@@ -0,0 +1,121 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Testing/Utils/SCIRunFieldSamples.h>
+
+#include <Core/Datatypes/Legacy/Field/MeshDispatch.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // Sums the element centers weighted by element size, the inner loop of
+  // CalculateMeshCenter.
+  class WeightedElemCenter
+  {
+  public:
+    WeightedElemCenter() : size(0.0), typed(false) {}
+
+    template <class MESH>
+    void operator()(const MESH& mesh)
+    {
+      typed = !std::is_same<MESH, VMesh>::value;
+      typename MESH::Elem::size_type num_elems;
+      mesh.size(num_elems);
+      VMesh::size_type num = num_elems;
+      for (VMesh::index_type idx = 0; idx < num; ++idx)
+      {
+        Point p;
+        typename MESH::Elem::index_type elem(idx);
+        mesh.get_center(p, elem);
+        double weight = std::fabs(mesh.get_size(elem));
+        center += weight*Vector(p);
+        size += weight;
+      }
+    }
+
+    Vector center;
+    double size;
+    bool typed;
+  };
+}
+
+TEST(MeshDispatchTests, ResolvesTetVolToItsMeshClass)
+{
+  auto field = CubeTetVolLinearBasis(data_info_type::DOUBLE_E);
+  WeightedElemCenter functor;
+  EXPECT_TRUE(dispatch_unstructured_mesh(field->mesh().get(), functor));
+  EXPECT_TRUE(functor.typed);
+}
+
+TEST(MeshDispatchTests, ResolvesTriSurfToItsMeshClass)
+{
+  auto field = CubeTriSurfLinearBasis(data_info_type::DOUBLE_E);
+  WeightedElemCenter functor;
+  dispatch_mesh(field, functor);
+  EXPECT_TRUE(functor.typed);
+}
+
+TEST(MeshDispatchTests, FallsBackToVMeshForStructuredMeshes)
+{
+  auto field = CreateEmptyLatVol(3, 3, 3);
+  WeightedElemCenter functor;
+  EXPECT_FALSE(dispatch_unstructured_mesh(field->mesh().get(), functor));
+  EXPECT_FALSE(functor.typed);
+
+  dispatch_mesh(field, functor);
+  EXPECT_FALSE(functor.typed);
+  EXPECT_NEAR(8.0, functor.size, 1e-12);
+  EXPECT_NEAR(0.0, functor.center.length(), 1e-12);
+}
+
+TEST(MeshDispatchTests, TypedLoopMatchesVMeshLoop)
+{
+  auto field = CubeGrid(4, FieldInformation(mesh_info_type::TETVOLMESH_E, databasis_info_type::NODATA_E, data_info_type::DOUBLE_E));
+  WeightedElemCenter typed, virt;
+  dispatch_mesh(field, typed);
+  virt(*field->vmesh());
+
+  EXPECT_TRUE(typed.typed);
+  EXPECT_FALSE(virt.typed);
+  EXPECT_NEAR(64.0, typed.size, 1e-9);
+  EXPECT_NEAR(virt.size, typed.size, 1e-9);
+  EXPECT_NEAR(0.0, (virt.center - typed.center).length(), 1e-9);
+  EXPECT_NEAR(0.0, (typed.center*(1.0/typed.size) - Vector(2, 2, 2)).length(), 1e-9);
+}
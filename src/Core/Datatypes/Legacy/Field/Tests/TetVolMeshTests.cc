@@ -68,3 +68,47 @@ TEST(TetVolMeshTest, CheckMeshIteratorTetVolMesh)
   ASSERT_EQ(c, 6);
 
 }
+
+TEST(TetVolMeshTest, SynchronizeBuildsAllRequestedTables)
+{
+  auto tetmesh = CubeTetVolLinearBasis(data_info_type::NONE_E);
+  auto mesh = tetmesh->vmesh();
+
+  mesh->synchronize(Mesh::EDGES_E | Mesh::FACES_E | Mesh::NODE_NEIGHBORS_E |
+    Mesh::NODE_LOCATE_E | Mesh::ELEM_LOCATE_E);
+
+  EXPECT_EQ(19, mesh->num_edges());
+  EXPECT_EQ(18, mesh->num_faces());
+
+  VMesh::Elem::index_type elem;
+  EXPECT_TRUE(mesh->locate(elem, Point(0.1, 0.1, 0.1)));
+  VMesh::Node::array_type nodes;
+  mesh->get_nodes(nodes, elem);
+  VMesh::Elem::array_type neighbors;
+  mesh->get_elems(neighbors, nodes[0]);
+  EXPECT_FALSE(neighbors.empty());
+}
+
+TEST(TetVolMeshTest, SynchronizeAsyncBuildsTablesInBackground)
+{
+  auto tetmesh = CubeTetVolLinearBasis(data_info_type::NONE_E);
+  auto done = tetmesh->mesh()->synchronize_async(Mesh::EDGES_E | Mesh::FACES_E);
+  EXPECT_TRUE(done.get());
+
+  auto mesh = tetmesh->vmesh();
+  EXPECT_EQ(19, mesh->num_edges());
+  EXPECT_EQ(18, mesh->num_faces());
+}
+
+TEST(TetVolMeshTest, CloneKeepsTopologyTables)
+{
+  auto tetmesh = CubeTetVolLinearBasis(data_info_type::NONE_E);
+  tetmesh->vmesh()->synchronize(Mesh::EDGES_E | Mesh::FACES_E);
+
+  MeshHandle copy(tetmesh->mesh()->clone());
+  auto mesh = copy->vmesh();
+
+  // no synchronize call on the copy
+  EXPECT_EQ(19, mesh->num_edges());
+  EXPECT_EQ(18, mesh->num_faces());
+}
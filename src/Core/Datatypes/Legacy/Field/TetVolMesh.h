@@ -59,6 +59,7 @@
 
 #include <unordered_map>
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/TaskPool.h>
 #include <Core/Thread/ConditionVariable.h>
 
 #include <set>
@@ -2709,6 +2710,25 @@ TetVolMesh<Basis>::TetVolMesh(const TetVolMesh &copy) :
   epsilon2_ = copy.epsilon2_;
   epsilon3_ = copy.epsilon3_;
 
+  if (copy.synchronized_ & Mesh::EDGES_E)
+  {
+    edges_ = copy.edges_;
+    edge_table_ = copy.edge_table_;
+    synchronized_ |= Mesh::EDGES_E;
+  }
+  if (copy.synchronized_ & Mesh::FACES_E)
+  {
+    faces_ = copy.faces_;
+    face_table_ = copy.face_table_;
+    boundary_faces_ = copy.boundary_faces_;
+    synchronized_ |= Mesh::FACES_E;
+  }
+  if (copy.synchronized_ & Mesh::NODE_NEIGHBORS_E)
+  {
+    node_neighbors_ = copy.node_neighbors_;
+    synchronized_ |= Mesh::NODE_NEIGHBORS_E;
+  }
+
   copy.synchronize_lock_.unlock();
 
   /// Create a new virtual interface for this copy
@@ -3194,89 +3214,15 @@ TetVolMesh<Basis>::synchronize(mask_type sync)
   // Only sync was hasn't been synched
   sync &= (~synchronized_);
 
-  if (sync == Mesh::EDGES_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::EDGES_E)
-  {
-    mask_type tosync = Mesh::EDGES_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::FACES_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::FACES_E)
-  {
-    mask_type tosync = Mesh::FACES_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_NEIGHBORS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_NEIGHBORS_E)
-  {
-    mask_type tosync = Mesh::NODE_NEIGHBORS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::BOUNDING_BOX_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::BOUNDING_BOX_E)
-  {
-    mask_type tosync = Mesh::BOUNDING_BOX_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_LOCATE_E)
+  std::vector<std::function<void()> > tasks;
+  for (mask_type table : { Mesh::EDGES_E, Mesh::FACES_E, Mesh::NODE_NEIGHBORS_E, Mesh::BOUNDING_BOX_E, Mesh::NODE_LOCATE_E, Mesh::ELEM_LOCATE_E })
   {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_LOCATE_E)
-  {
-    mask_type tosync = Mesh::NODE_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::ELEM_LOCATE_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::ELEM_LOCATE_E)
-  {
-    mask_type tosync = Mesh::ELEM_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
+    if (sync & table)
+      tasks.push_back([this, table]() { Synchronize(this, table).run(); });
   }
+  synchronize_lock_.unlock();
+  Core::Thread::TaskPool::Instance().runAll(tasks);
+  synchronize_lock_.lock();
 
   // Wait until threads are done
   while ((synchronized_ & sync) != sync)
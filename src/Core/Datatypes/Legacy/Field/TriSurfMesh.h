@@ -55,6 +55,7 @@
 #include <Core/Datatypes/Legacy/Base/Types.h>
 
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/TaskPool.h>
 #include <Core/Thread/ConditionVariable.h>
 #include <unordered_map>
 
@@ -2439,103 +2440,15 @@ TriSurfMesh<Basis>::synchronize(mask_type sync)
   // Only sync was hasn't been synched
   sync &= (~synchronized_);
 
-  if (sync == Mesh::EDGES_E)
+  std::vector<std::function<void()> > tasks;
+  for (mask_type table : { Mesh::EDGES_E, Mesh::NORMALS_E, Mesh::NODE_NEIGHBORS_E, Mesh::ELEM_NEIGHBORS_E, Mesh::BOUNDING_BOX_E, Mesh::NODE_LOCATE_E, Mesh::ELEM_LOCATE_E })
   {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::EDGES_E)
-  {
-    mask_type tosync = Mesh::EDGES_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NORMALS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NORMALS_E)
-  {
-    mask_type tosync = Mesh::NORMALS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_NEIGHBORS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_NEIGHBORS_E)
-  {
-    mask_type tosync = Mesh::NODE_NEIGHBORS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::ELEM_NEIGHBORS_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::ELEM_NEIGHBORS_E)
-  {
-    mask_type tosync = Mesh::ELEM_NEIGHBORS_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::BOUNDING_BOX_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::BOUNDING_BOX_E)
-  {
-    mask_type tosync = Mesh::BOUNDING_BOX_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::NODE_LOCATE_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::NODE_LOCATE_E)
-  {
-    mask_type tosync = Mesh::NODE_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
-  }
-
-  if (sync == Mesh::ELEM_LOCATE_E)
-  {
-    Synchronize Synchronize(this,sync);
-    synchronize_lock_.unlock();
-    Synchronize.run();
-    synchronize_lock_.lock();
-  }
-  else if (sync & Mesh::ELEM_LOCATE_E)
-  {
-    mask_type tosync = Mesh::ELEM_LOCATE_E;
-    Synchronize syncclass(this,tosync);
-    Core::Thread::Util::launchAsyncThread(syncclass);
+    if (sync & table)
+      tasks.push_back([this, table]() { Synchronize(this, table).run(); });
   }
+  synchronize_lock_.unlock();
+  Core::Thread::TaskPool::Instance().runAll(tasks);
+  synchronize_lock_.lock();
 
   // Wait until threads are done
   while ((synchronized_ & sync) != sync)
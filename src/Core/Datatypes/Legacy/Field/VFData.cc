@@ -206,6 +206,30 @@ VFData::copy_evalues(VFData*)
   ASSERTFAIL("VFData interface has no virtual function implementation for copy_evalues");
 }
 
+bool
+VFData::get_component_values(VectorFieldArrays&) const
+{
+  return (false);
+}
+
+bool
+VFData::set_component_values(const VectorFieldArrays&)
+{
+  return (false);
+}
+
+bool
+VFData::get_component_values(SymmetricTensorFieldArrays&) const
+{
+  return (false);
+}
+
+bool
+VFData::set_component_values(const SymmetricTensorFieldArrays&)
+{
+  return (false);
+}
+
 VMesh::size_type
 VFData::size()
 {
@@ -36,6 +36,7 @@
 #include <Core/Datatypes/Legacy/Field/Mesh.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/CastFData.h>
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
 #include <string>
 #include <vector>
 #include <complex>
@@ -124,6 +125,13 @@ public:
   VFDATA_ACCESS_DECLARATION2_V(Core::Geometry::Tensor)
 
 
+  /// Copy vector or tensor data into/out of separate component arrays.
+  /// These return false if the data is not of the matching type.
+  virtual bool get_component_values(VectorFieldArrays& values) const;
+  virtual bool set_component_values(const VectorFieldArrays& values);
+  virtual bool get_component_values(SymmetricTensorFieldArrays& values) const;
+  virtual bool set_component_values(const SymmetricTensorFieldArrays& values);
+
   /// Copy a value without needing to know the type
   virtual void copy_value(VFData* fdata,
                           VMesh::index_type vidx,
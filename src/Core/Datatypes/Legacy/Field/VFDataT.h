@@ -923,6 +923,27 @@ public:
     max = CastFData<double>(tval2);
     return (true);
   }
+
+  bool get_component_values(VectorFieldArrays& values) const override
+  {
+    size_type sz = static_cast<size_type>(this->fdata_.size());
+    values.resize(sz);
+    for (size_type p=0; p<sz; p++)
+    {
+      const Core::Geometry::Vector& v = this->fdata_[p];
+      values.x[p] = v.x(); values.y[p] = v.y(); values.z[p] = v.z();
+    }
+    return (true);
+  }
+
+  bool set_component_values(const VectorFieldArrays& values) override
+  {
+    size_type sz = static_cast<size_type>(this->fdata_.size());
+    if (values.size() < sz) sz = values.size();
+    for (size_type p=0; p<sz; p++)
+      this->fdata_[p] = Core::Geometry::Vector(values.x[p], values.y[p], values.z[p]);
+    return (true);
+  }
 };
 
 
@@ -987,6 +1008,29 @@ public:
     max = CastFData<double>(tval2);
     return (true);
   }
+
+  bool get_component_values(SymmetricTensorFieldArrays& values) const override
+  {
+    size_type sz = static_cast<size_type>(this->fdata_.size());
+    values.resize(sz);
+    for (size_type p=0; p<sz; p++)
+    {
+      const Core::Geometry::Tensor& t = this->fdata_[p];
+      values.xx[p] = t.xx(); values.xy[p] = t.xy(); values.xz[p] = t.xz();
+      values.yy[p] = t.yy(); values.yz[p] = t.yz(); values.zz[p] = t.zz();
+    }
+    return (true);
+  }
+
+  bool set_component_values(const SymmetricTensorFieldArrays& values) override
+  {
+    size_type sz = static_cast<size_type>(this->fdata_.size());
+    if (values.size() < sz) sz = values.size();
+    for (size_type p=0; p<sz; p++)
+      this->fdata_[p] = Core::Geometry::Tensor(values.xx[p], values.xy[p], values.xz[p],
+                                               values.yy[p], values.yz[p], values.zz[p]);
+    return (true);
+  }
 };
 
 
@@ -276,6 +276,17 @@ public:
   template<class T,class ARRAY> inline void get_values(T* values, ARRAY& idx) const
   { vfdata_->get_values(values,&(idx[0]),idx.size()); }
 
+  /// Get/Set vector or tensor values as separate component arrays, returns
+  /// false if the field does not hold data of that type
+  inline bool get_values(VectorFieldArrays& values) const
+  { return (vfdata_->get_component_values(values)); }
+  inline bool set_values(const VectorFieldArrays& values)
+  { return (vfdata_->set_component_values(values)); }
+  inline bool get_values(SymmetricTensorFieldArrays& values) const
+  { return (vfdata_->get_component_values(values)); }
+  inline bool set_values(const SymmetricTensorFieldArrays& values)
+  { return (vfdata_->set_component_values(values)); }
+
   /// Set all values to a specific value
   template<class T> inline void set_all_values(const T& val)
   { vfdata_->set_all_values(val); }
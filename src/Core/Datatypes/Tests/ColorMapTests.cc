@@ -0,0 +1,168 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Core/Datatypes/ColorMap.h>
+#include <random>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  // The transform ColorMap documents: rescale, clamp, invert, quantize, then gamma by shift.
+  double referenceIndex(double f, size_t resolution, double shift, bool invert, double scale, double offset)
+  {
+    double v = std::min(std::max((f + offset) * scale, 0.0), 1.0);
+    if (invert) v = 1.0 - v, shift *= -1.0;
+    v = static_cast<double>(static_cast<int>(v * resolution)) / static_cast<double>(resolution - 1);
+    double denom = std::tan(M_PI_2 * (0.5 - 0.5 * std::min(std::max(shift, -0.99), 0.99)));
+    denom = (std::isnan(denom) || denom < 0.001) ? 0.001 : denom;
+    return std::min(std::max(std::pow(v, 1.0 / denom), 0.0), 1.0);
+  }
+
+  std::vector<double> randomValues(size_t n)
+  {
+    std::mt19937 gen(12);
+    std::uniform_real_distribution<double> dist(-1.5, 1.5);
+    std::vector<double> values(n);
+    for (auto& v : values)
+      v = dist(gen);
+    return values;
+  }
+
+  std::vector<ColorMapHandle> testMaps()
+  {
+    return {
+      StandardColorMapFactory::create(),
+      StandardColorMapFactory::create("Rainbow", 100, 0.4, true, 0.5, 1.0, {0.05, 0.2, 0.5, 0.9, 0.95, 0.1}),
+      StandardColorMapFactory::create("Blackbody", 17, -0.7, false, 0.25, 0.3),
+      StandardColorMapFactory::create("Grayscale", 256, 0, false, 1.0, 0.0)
+    };
+  }
+}
+
+TEST(ColorMapTests, ValueToIndexMatchesTransform)
+{
+  auto values = randomValues(1000);
+  for (bool invert : {false, true})
+  {
+    for (double shift : {-0.5, 0.0, 0.3})
+    {
+      auto cm = StandardColorMapFactory::create("Rainbow", 64, shift, invert, 0.5, 1.0);
+      for (double v : values)
+        EXPECT_DOUBLE_EQ(referenceIndex(v, 64, shift, invert, 0.5, 1.0), cm->valueToIndex(v));
+    }
+  }
+}
+
+TEST(ColorMapTests, BatchScalarsMatchPerValue)
+{
+  auto values = randomValues(5000);
+  for (const auto& cm : testMaps())
+  {
+    std::vector<ColorRGB> colors(values.size());
+    std::vector<double> indices(values.size());
+    std::vector<uint32_t> rgba(values.size());
+    cm->valuesToColors(values.data(), values.size(), colors.data());
+    cm->valuesToIndices(values.data(), values.size(), indices.data());
+    cm->valuesToRGBA8(values.data(), values.size(), rgba.data());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      auto c = cm->valueToColor(values[i]);
+      ASSERT_EQ(c, colors[i]);
+      ASSERT_EQ(cm->valueToIndex(values[i]), indices[i]);
+      ASSERT_EQ(static_cast<uint32_t>(c.r() * 255.0 + 0.5), rgba[i] & 0xff);
+      ASSERT_EQ(static_cast<uint32_t>(c.g() * 255.0 + 0.5), (rgba[i] >> 8) & 0xff);
+      ASSERT_EQ(static_cast<uint32_t>(c.b() * 255.0 + 0.5), (rgba[i] >> 16) & 0xff);
+      ASSERT_EQ(static_cast<uint32_t>(c.a() * 255.0 + 0.5), rgba[i] >> 24);
+    }
+  }
+}
+
+TEST(ColorMapTests, BatchVectorsAndTensorsMatchPerValue)
+{
+  auto values = randomValues(3000);
+  std::vector<Vector> vectors;
+  std::vector<Tensor> tensors;
+  for (size_t i = 0; i + 2 < values.size(); i += 3)
+  {
+    vectors.emplace_back(values[i], values[i + 1], values[i + 2]);
+    tensors.emplace_back(values[i], 0.1 * values[i + 1], 0.0, values[i + 1], 0.2 * values[i + 2], values[i + 2]);
+  }
+
+  for (const auto& cm : testMaps())
+  {
+    std::vector<ColorRGB> colors(vectors.size());
+    std::vector<double> indices(vectors.size());
+    cm->valuesToColors(vectors.data(), vectors.size(), colors.data());
+    cm->valuesToIndices(vectors.data(), vectors.size(), indices.data());
+    for (size_t i = 0; i < vectors.size(); ++i)
+    {
+      ASSERT_EQ(cm->valueToColor(vectors[i]), colors[i]);
+      ASSERT_EQ(cm->valueToIndex(vectors[i]), indices[i]);
+    }
+
+    cm->valuesToColors(tensors.data(), tensors.size(), colors.data());
+    cm->valuesToIndices(tensors.data(), tensors.size(), indices.data());
+    for (size_t i = 0; i < tensors.size(); ++i)
+    {
+      Tensor t(tensors[i]);
+      ASSERT_EQ(cm->valueToColor(t), colors[i]);
+      ASSERT_EQ(cm->valueToIndex(t), indices[i]);
+    }
+  }
+}
+
+TEST(ColorMapTests, LargeBatchMatchesPerValue)
+{
+  auto values = randomValues(1 << 20);
+  values[7] = std::numeric_limits<double>::quiet_NaN();
+  auto cm = testMaps()[1];
+
+  std::vector<ColorRGB> colors(values.size());
+  cm->valuesToColors(values.data(), values.size(), colors.data());
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(cm->valueToColor(values[i]), colors[i]);
+}
+
+TEST(ColorMapTests, MapWithoutColorDataReturnsDefaultColor)
+{
+  ColorMap cm(std::vector<ColorRGB>(), "Empty", 16);
+  auto values = randomValues(100);
+
+  std::vector<ColorRGB> colors(values.size());
+  cm.valuesToColors(values.data(), values.size(), colors.data());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_EQ(ColorRGB(), cm.valueToColor(values[i]));
+    EXPECT_EQ(ColorRGB(), colors[i]);
+  }
+}
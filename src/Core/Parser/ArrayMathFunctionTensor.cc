@@ -32,8 +32,10 @@
 
 #include <Core/Parser/ArrayMathFunctionCatalog.h>
 #include <Core/Math/MiscMath.h>
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
 
 #include <cmath>
+#include <vector>
 
 namespace ArrayMathFunctions {
 
@@ -452,54 +454,20 @@ bool eigval3_t(SCIRun::ArrayMathProgramCode& pc)
 
 bool trace_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = eval[0]+eval[1]+eval[2];
-
-    data0 ++; data1 +=6;
-  }
+  FieldDataKernels::tensorTraces(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
 
 bool det_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = eval[0]*eval[1]*eval[2];
-
-    data0 ++; data1 +=6;
-  }
+  FieldDataKernels::tensorDeterminants(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
@@ -507,131 +475,57 @@ bool det_t(SCIRun::ArrayMathProgramCode& pc)
 
 bool B_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = eval[0]*eval[1]+eval[0]*eval[2]+eval[2]*eval[1];
-
-    data0 ++; data1 +=6;
-  }
+  FieldDataKernels::tensorSecondInvariants(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
 
 bool S_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = eval[0]*eval[0]+eval[1]*eval[1]+eval[2]*eval[2];
-
-    data0 ++; data1 +=6;
-  }
+  FieldDataKernels::tensorSquaredFrobeniusNorms(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
 
 bool quality_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
+  // (S - B)/9 with S = sum of squared eigenvalues and B = sum of their pairwise products
+  SymmetricTensorComponents tensors = SymmetricTensorComponents::interleaved(data1);
+  std::vector<double> second(pc.get_size());
+  FieldDataKernels::tensorSquaredFrobeniusNorms(tensors, pc.get_size(), data0);
+  FieldDataKernels::tensorSecondInvariants(tensors, pc.get_size(), &second[0]);
 
-    data0[0] = ((eval[0]*eval[0]+eval[1]*eval[1]+eval[2]*eval[2]) -
-      (eval[0]*eval[1]+eval[0]*eval[2]+eval[2]*eval[1]))/9.0;
-
-    data0 ++; data1 +=6;
-  }
+  for (size_t i = 0; i < second.size(); i++)
+    data0[i] = (data0[i] - second[i])/9.0;
 
   return (true);
 }
 
 bool frobenius_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = ::sqrt(eval[0]*eval[0]+eval[1]*eval[1]+eval[2]*eval[2]);
-
-    data0 ++; data1 +=6;
-  }
+  FieldDataKernels::tensorFrobeniusNorms(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
 
 bool frobenius2_t(SCIRun::ArrayMathProgramCode& pc)
 {
-  double ten[7]; double eval[3] = {0}; double evec[9];
-
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
 
-  double* data1_end = data1 + 6*pc.get_size();
-
-  while (data1 != data1_end)
-  {
-    ten[0] = 1.0; ten[1] = data1[0]; ten[2] = data1[1];
-    ten[3] = data1[2]; ten[4] = data1[3];
-    ten[5] = data1[4]; ten[6] = data1[5];
-
-    tenEigensolve_d(eval, evec, ten);
-
-
-    data0[0] = eval[0]*eval[0]+eval[1]*eval[1]+eval[2]*eval[2];
-
-    data0++; data1 +=6;
-  }
+  FieldDataKernels::tensorSquaredFrobeniusNorms(SymmetricTensorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
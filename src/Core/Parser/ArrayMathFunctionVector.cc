@@ -28,6 +28,7 @@
 
 #include <Core/Parser/ArrayMathFunctionCatalog.h>
 #include <Core/Math/MiscMath.h>
+#include <Core/Datatypes/Legacy/Field/FieldDataArrays.h>
 
 #include <math.h>
 
@@ -223,13 +224,8 @@ bool norm_v(SCIRun::ArrayMathProgramCode& pc)
 {
   double* data0 = pc.get_variable(0);
   double* data1 = pc.get_variable(1);
-  double* data0_end = data0 + pc.get_size();
 
-  while (data0 != data0_end)
-  {
-    data0[0] = ::sqrt(data1[0]*data1[0]+data1[1]*data1[1]+data1[2]*data1[2]);
-    data0++; data1+=3;
-  }
+  FieldDataKernels::vectorLengths(VectorComponents::interleaved(data1), pc.get_size(), data0);
 
   return (true);
 }
@@ -44,6 +44,8 @@
 #include <Core/Python/PythonDatatypeConverter.h>
 #include <Core/Algorithms/Base/VariableHelper.h>
 #include <boost/variant/apply_visitor.hpp>
+#include <cstring>
+#include <type_traits>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Algorithms;
@@ -221,6 +223,329 @@ py::dict toPythonListSparse(const SparseRowMatrixGeneric<T>& sparse)
   list["values"] = values;
   return list;
 }
+
+// Matrices and field arrays are handed to Python through the buffer protocol.
+// A SharedBuffer exposes memory owned by a SCIRun object without copying it,
+// and keeps that object alive for as long as any NumPy array made from it
+// exists. The memory is exported read-only since the datatypes flowing through
+// a network are shared between modules; scripts copy an array to modify it.
+struct SharedBufferContents
+{
+  boost::shared_ptr<const void> owner;
+  DatatypeHandle source;
+  const void* data;
+  std::string format;
+  Py_ssize_t itemsize;
+  std::vector<Py_ssize_t> shape;
+  std::vector<Py_ssize_t> strides;
+};
+
+struct SharedBuffer
+{
+  PyObject_HEAD
+  SharedBufferContents* contents;
+};
+
+void sharedBufferDealloc(PyObject* self)
+{
+  delete reinterpret_cast<SharedBuffer*>(self)->contents;
+  Py_TYPE(self)->tp_free(self);
+}
+
+int sharedBufferGetBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+  if (flags & PyBUF_WRITABLE)
+  {
+    PyErr_SetString(PyExc_BufferError, "SCIRun data is shared read-only; copy the array to modify it.");
+    view->obj = nullptr;
+    return -1;
+  }
+  const auto& contents = *reinterpret_cast<SharedBuffer*>(self)->contents;
+  Py_ssize_t count = 1;
+  for (auto extent : contents.shape)
+    count *= extent;
+
+  view->buf = const_cast<void*>(contents.data);
+  view->obj = self;
+  Py_INCREF(self);
+  view->len = count * contents.itemsize;
+  view->itemsize = contents.itemsize;
+  view->readonly = 1;
+  view->ndim = static_cast<int>(contents.shape.size());
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(contents.format.c_str()) : nullptr;
+  view->shape = (flags & PyBUF_ND) ? const_cast<Py_ssize_t*>(contents.shape.data()) : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? const_cast<Py_ssize_t*>(contents.strides.data()) : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+PyTypeObject* sharedBufferType()
+{
+  static PyBufferProcs bufferProcs = { sharedBufferGetBuffer, nullptr };
+  static PyTypeObject type = { PyVarObject_HEAD_INIT(nullptr, 0) };
+  static bool ready = false;
+  if (!ready)
+  {
+    type.tp_name = "SCIRun.SharedBuffer";
+    type.tp_doc = "Read-only view of memory owned by a SCIRun datatype";
+    type.tp_basicsize = sizeof(SharedBuffer);
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_dealloc = sharedBufferDealloc;
+    type.tp_as_buffer = &bufferProcs;
+    if (PyType_Ready(&type) < 0)
+      py::throw_error_already_set();
+    ready = true;
+  }
+  return &type;
+}
+
+template <class T> const char* bufferFormat();
+template <> const char* bufferFormat<double>() { return "d"; }
+template <> const char* bufferFormat<float>() { return "f"; }
+template <> const char* bufferFormat<int>() { return "i"; }
+template <> const char* bufferFormat<unsigned int>() { return "I"; }
+template <> const char* bufferFormat<long long>() { return "q"; }
+
+py::object importNumpy()
+{
+  try
+  {
+    return py::import("numpy");
+  }
+  catch (const py::error_already_set&)
+  {
+    PyErr_Clear();
+    return {};
+  }
+}
+
+// Returns a NumPy array sharing the given memory, or None when NumPy is not
+// installed, in which case callers fall back to building Python lists.
+template <class T>
+py::object shareWithNumpy(boost::shared_ptr<const void> owner, const T* data,
+  const std::vector<Py_ssize_t>& shape, DatatypeHandle source = nullptr)
+{
+  if (!data)
+    return {};
+  auto numpy = importNumpy();
+  if (numpy.is_none())
+    return {};
+
+  auto type = sharedBufferType();
+  auto buffer = reinterpret_cast<SharedBuffer*>(type->tp_alloc(type, 0));
+  if (!buffer)
+    py::throw_error_already_set();
+  // Exports are always C-contiguous.
+  std::vector<Py_ssize_t> strides(shape.size(), sizeof(T));
+  for (auto dim = static_cast<int>(shape.size()) - 2; dim >= 0; --dim)
+    strides[dim] = strides[dim + 1] * shape[dim + 1];
+  buffer->contents = new SharedBufferContents { owner, source, data, bufferFormat<T>(), sizeof(T), shape, strides };
+  py::object holder { py::handle<>(reinterpret_cast<PyObject*>(buffer)) };
+  return numpy.attr("asarray")(holder);
+}
+
+// Reads any object exporting the buffer protocol (NumPy arrays, memoryviews,
+// array.array) with a numeric element type, honouring its strides.
+class BufferReader
+{
+public:
+  explicit BufferReader(const py::object& object)
+  {
+    auto ptr = object.ptr();
+    if (!PyObject_CheckBuffer(ptr) || PyBytes_Check(ptr) || PyByteArray_Check(ptr))
+      return;
+    if (PyObject_GetBuffer(ptr, &view_, PyBUF_RECORDS_RO) != 0)
+    {
+      PyErr_Clear();
+      return;
+    }
+    acquired_ = true;
+    code_ = typeCode(view_.format ? view_.format : "B");
+  }
+
+  ~BufferReader()
+  {
+    if (acquired_)
+      PyBuffer_Release(&view_);
+  }
+
+  BufferReader(const BufferReader&) = delete;
+  BufferReader& operator=(const BufferReader&) = delete;
+
+  bool numeric() const { return acquired_ && code_ != 0 && view_.ndim <= 2; }
+  int ndim() const { return view_.ndim; }
+  Py_ssize_t extent(int dim) const { return dim < view_.ndim ? view_.shape[dim] : 1; }
+  Py_ssize_t size() const { return extent(0) * extent(1); }
+  const void* data() const { return view_.buf; }
+  char typeCode() const { return code_; }
+
+  bool cContiguous() const { return PyBuffer_IsContiguous(&view_, 'C') != 0; }
+
+  /// Copies the elements in row-major order, converting them to T.
+  template <class T>
+  void copyTo(T* out) const
+  {
+    switch (code_)
+    {
+    case '?': copyAs<bool>(out); break;
+    case 'b': copyAs<signed char>(out); break;
+    case 'B': copyAs<unsigned char>(out); break;
+    case 'h': copyAs<short>(out); break;
+    case 'H': copyAs<unsigned short>(out); break;
+    case 'i': copyAs<int>(out); break;
+    case 'I': copyAs<unsigned int>(out); break;
+    case 'l': copyAs<long>(out); break;
+    case 'L': copyAs<unsigned long>(out); break;
+    case 'q': copyAs<long long>(out); break;
+    case 'Q': copyAs<unsigned long long>(out); break;
+    case 'f': copyAs<float>(out); break;
+    case 'd': copyAs<double>(out); break;
+    default: break;
+    }
+  }
+
+  template <class T>
+  std::vector<T> toVector() const
+  {
+    std::vector<T> values(size());
+    copyTo(values.data());
+    return values;
+  }
+
+private:
+  static char typeCode(const char* format)
+  {
+    // Only native byte order is read; NumPy reports it without a prefix or with '='.
+    const uint16_t probe = 1;
+    const char native = *reinterpret_cast<const char*>(&probe) ? '<' : '>';
+    if (*format == '@' || *format == '=' || *format == native)
+      ++format;
+    if (std::strlen(format) != 1 || !std::strchr("?bBhHiIlLqQfd", *format))
+      return 0;
+    return *format;
+  }
+
+  template <class S, class T>
+  void copyAs(T* out) const
+  {
+    if (std::is_same<S, T>::value && cContiguous())
+    {
+      std::memcpy(out, view_.buf, size() * sizeof(T));
+      return;
+    }
+    const auto rows = extent(0);
+    const auto cols = extent(1);
+    const auto rowStride = view_.ndim > 0 ? view_.strides[0] : 0;
+    const auto colStride = view_.ndim > 1 ? view_.strides[1] : 0;
+    const auto base = static_cast<const char*>(view_.buf);
+    for (Py_ssize_t i = 0; i < rows; ++i)
+    {
+      for (Py_ssize_t j = 0; j < cols; ++j)
+      {
+        S value;
+        std::memcpy(&value, base + i * rowStride + j * colStride, sizeof(S));
+        *out++ = static_cast<T>(value);
+      }
+    }
+  }
+
+  Py_buffer view_ {};
+  bool acquired_ {false};
+  char code_ {0};
+};
+
+bool isNumericBuffer(const py::object& object, int maxDims)
+{
+  BufferReader buffer(object);
+  return buffer.numeric() && buffer.ndim() <= maxDims;
+}
+
+// If the object is an unmodified NumPy view made by shareWithNumpy, returns the
+// datatype it was made from so that passing data straight through a script
+// costs no copy in either direction.
+DatatypeHandle sharedSource(const py::object& object, const BufferReader& buffer)
+{
+  auto current = object;
+  for (int depth = 0; depth < 8; ++depth)
+  {
+    if (Py_TYPE(current.ptr()) == sharedBufferType())
+    {
+      const auto& contents = *reinterpret_cast<SharedBuffer*>(current.ptr())->contents;
+      const bool sameView = contents.data == buffer.data() && buffer.cContiguous()
+        && static_cast<int>(contents.shape.size()) == buffer.ndim()
+        && contents.shape[0] == buffer.extent(0) && buffer.extent(1) == (contents.shape.size() > 1 ? contents.shape[1] : 1)
+        && contents.format[0] == buffer.typeCode();
+      return sameView ? contents.source : nullptr;
+    }
+    // NumPy arrays refer to their owner through base; memoryviews through obj.
+    if (PyMemoryView_Check(current.ptr()))
+      current = current.attr("obj");
+    else if (PyObject_HasAttrString(current.ptr(), "base"))
+      current = current.attr("base");
+    else
+      return nullptr;
+    if (current.is_none())
+      return nullptr;
+  }
+  return nullptr;
+}
+
+template <class T>
+std::vector<T> toStdVectorFromSequence(const py::object& object)
+{
+  BufferReader buffer(object);
+  if (buffer.numeric())
+    return buffer.toVector<T>();
+  return to_std_vector<T>(object);
+}
+
+template <class T>
+py::object toPythonArray(const DenseMatrixGeneric<T>& dense, boost::shared_ptr<const DenseMatrixGeneric<T>> owner)
+{
+  auto array = shareWithNumpy<T>(owner, dense.data(), { static_cast<Py_ssize_t>(dense.nrows()), static_cast<Py_ssize_t>(dense.ncols()) }, boost::const_pointer_cast<DenseMatrixGeneric<T>>(owner));
+  if (!array.is_none())
+    return array;
+  return toPythonListDense(dense);
+}
+
+py::dict toPythonArraysSparse(SparseRowMatrixHandle sparse)
+{
+  if (!sparse->isCompressed())
+  {
+    sparse = boost::make_shared<SparseRowMatrix>(*sparse);
+    sparse->makeCompressed();
+  }
+  const auto nnz = static_cast<Py_ssize_t>(sparse->nonZeros());
+  auto values = shareWithNumpy(sparse, sparse->valuePtr(), { nnz }, sparse);
+  if (values.is_none() || 0 == nnz)
+    return toPythonListSparse(*sparse);
+
+  py::dict dict;
+  dict["nrows"] = sparse->nrows();
+  dict["ncols"] = sparse->ncols();
+  dict["rows"] = shareWithNumpy(sparse, sparse->outerIndexPtr(), { static_cast<Py_ssize_t>(sparse->outerSize() + 1) }, sparse);
+  dict["columns"] = shareWithNumpy(sparse, sparse->innerIndexPtr(), { nnz }, sparse);
+  dict["values"] = values;
+  return dict;
+}
+
+template <class T>
+py::object toPythonFieldArray(std::vector<T>& values, int dim1, int dim2, bool isMatrix)
+{
+  auto owned = boost::make_shared<std::vector<T>>(std::move(values));
+  std::vector<Py_ssize_t> shape;
+  if (isMatrix)
+    shape = { dim1, dim2 };
+  else
+    shape = { static_cast<Py_ssize_t>(owned->size()) };
+  auto array = shareWithNumpy<T>(owned, owned->data(), shape);
+  if (!array.is_none())
+    return array;
+  if (isMatrix)
+    return toPythonListOfLists(*owned, dim1, dim2);
+  return toPythonList(*owned);
+}
 }
 
 py::dict SCIRun::Core::Python::wrapDatatypesInMap(
@@ -267,10 +592,8 @@ py::dict SCIRun::Core::Python::convertFieldToPython(FieldHandle field)
     {
       std::vector<unsigned int> v;
       subField.getnumericarray(v);
-      if (1 != subField.getm() && 1 != subField.getn())
-        matlabStructure[fieldName] = toPythonListOfLists(v, subField.getn(), subField.getm());
-      else
-        matlabStructure[fieldName] = toPythonList(v);
+      matlabStructure[fieldName] = toPythonFieldArray(v, subField.getn(), subField.getm(),
+        1 != subField.getm() && 1 != subField.getn());
       break;
     }
     case matfilebase::miDOUBLE:
@@ -280,10 +603,8 @@ py::dict SCIRun::Core::Python::convertFieldToPython(FieldHandle field)
       // std::cout << "miDOUBLE " << subField.getm() << "x" << subField.getn() << "\n";
       // std::copy(v.begin(), v.end(), std::ostream_iterator<double>(std::cout, " "));
       // std::cout << "\n...\n";
-      if (1 != subField.getm() && 1 != subField.getn())
-        matlabStructure[fieldName] = toPythonListOfLists(v, subField.getn(), subField.getm());
-      else
-        matlabStructure[fieldName] = toPythonList(v);
+      matlabStructure[fieldName] = toPythonFieldArray(v, subField.getn(), subField.getm(),
+        1 != subField.getm() && 1 != subField.getn());
       break;
     }
     default:
@@ -295,15 +616,15 @@ py::dict SCIRun::Core::Python::convertFieldToPython(FieldHandle field)
   return matlabStructure;
 }
 
-py::list SCIRun::Core::Python::convertMatrixToPython(DenseMatrixHandle matrix)
+py::object SCIRun::Core::Python::convertMatrixToPython(DenseMatrixHandle matrix)
 {
-  if (matrix) return ::toPythonListDense(*matrix);
+  if (matrix) return ::toPythonArray<double>(*matrix, matrix);
   return {};
 }
 
 py::dict SCIRun::Core::Python::convertMatrixToPython(SparseRowMatrixHandle matrix)
 {
-  if (matrix) return ::toPythonListSparse(*matrix);
+  if (matrix) return ::toPythonArraysSparse(matrix);
   return {};
 }
 
@@ -319,6 +640,12 @@ py::object SCIRun::Core::Python::convertStringToPython(StringHandle str)
 
 bool DenseMatrixExtractor::check() const
 {
+  {
+    BufferReader buffer(object_);
+    if (buffer.numeric())
+      return 2 == buffer.ndim();
+  }
+
   py::extract<py::list> e(object_);
   if (!e.check()) return false;
 
@@ -335,6 +662,19 @@ bool DenseMatrixExtractor::check() const
 DatatypeHandle DenseMatrixExtractor::operator()() const
 {
   DenseMatrixHandle dense;
+  {
+    BufferReader buffer(object_);
+    if (buffer.numeric() && 2 == buffer.ndim())
+    {
+      auto source = sharedSource(object_, buffer);
+      if (boost::dynamic_pointer_cast<DenseMatrix>(source))
+        return source;
+      dense = boost::make_shared<DenseMatrix>(buffer.extent(0), buffer.extent(1));
+      buffer.copyTo(dense->data());
+      return dense;
+    }
+  }
+
   py::extract<py::list> e(object_);
   if (e.check())
   {
@@ -401,7 +741,7 @@ bool SparseRowMatrixExtractor::check() const
 
     py::extract<py::list> value_i_list(values[i]);
     py::extract<size_t> value_i_int(values[i]);
-    if (!value_i_int.check() && !value_i_list.check()) return false;
+    if (!value_i_int.check() && !value_i_list.check() && !isNumericBuffer(values[i], 1)) return false;
   }
 
   return true;
@@ -421,17 +761,24 @@ DatatypeHandle SparseRowMatrixExtractor::operator()() const
   auto keys = pyMatlabDict.keys();
   auto values = pyMatlabDict.values();
   size_t nrows, ncols;
+  std::set<DatatypeHandle> sources;
 
   for (int i = 0; i < length; ++i)
   {
     py::extract<std::string> key_i(keys[i]);
 
-    py::extract<py::list> value_i_list(values[i]);
+    py::object value_i = values[i];
     auto fieldName = key_i();
-    if (fieldName == "rows") { rows = to_std_vector<index_type>(value_i_list()); }
+    if (fieldName == "rows" || fieldName == "columns" || fieldName == "values")
+    {
+      BufferReader buffer(value_i);
+      sources.insert(buffer.numeric() ? sharedSource(value_i, buffer) : nullptr);
+    }
+
+    if (fieldName == "rows") { rows = toStdVectorFromSequence<index_type>(value_i); }
     else if (fieldName == "columns")
     {
-      columns = to_std_vector<index_type>(value_i_list());
+      columns = toStdVectorFromSequence<index_type>(value_i);
     }
     else if (fieldName == "nrows")
     {
@@ -445,10 +792,18 @@ DatatypeHandle SparseRowMatrixExtractor::operator()() const
     }
     else if (fieldName == "values")
     {
-      matrixValues = to_std_vector<double>(value_i_list());
+      matrixValues = toStdVectorFromSequence<double>(value_i);
     }
   }
 
+  // All three arrays still view the matrix that was sent to Python.
+  if (1 == sources.size())
+  {
+    auto source = boost::dynamic_pointer_cast<SparseRowMatrix>(*sources.begin());
+    if (source && source->nrows() == nrows && source->ncols() == ncols)
+      return source;
+  }
+
   if (!rows.empty() && !columns.empty() && !matrixValues.empty())
   {
     auto nnz = matrixValues.size();
@@ -478,18 +833,33 @@ bool FieldExtractor::check() const
 
     py::extract<std::string> value_i_string(values[i]);
     py::extract<py::list> value_i_list(values[i]);
-    if (!value_i_string.check() && !value_i_list.check()) return false;
+    if (!value_i_string.check() && !value_i_list.check() && !isNumericBuffer(values[i], 2)) return false;
   }
 
   return true;
 }
 
 namespace {
-matlabarray getPythonFieldDictionaryValue(
-    const py::extract<std::string>& strExtract, const py::extract<py::list>& listExtract)
+matlabarray getPythonFieldDictionaryValue(const py::object& object)
 {
+  const py::extract<std::string> strExtract(object);
+  const py::extract<py::list> listExtract(object);
   matlabarray value;
-  if (strExtract.check())
+  BufferReader buffer(object);
+  if (buffer.numeric())
+  {
+    auto values = buffer.toVector<double>();
+    if (1 == values.size())
+      value.createdoublescalar(values[0]);
+    else if (2 == buffer.ndim())
+    {
+      std::vector<int> dims = {static_cast<int>(buffer.extent(1)), static_cast<int>(buffer.extent(0))};
+      value.createdoublematrix(values, dims);
+    }
+    else
+      value.createdoublevector(values);
+  }
+  else if (strExtract.check())
   {
     value.createstringarray();
     auto strData = strExtract();
@@ -551,11 +921,9 @@ DatatypeHandle FieldExtractor::operator()() const
   {
     py::extract<std::string> key_i(keys[i]);
 
-    py::extract<std::string> value_i_string(values[i]);
-    py::extract<py::list> value_i_list(values[i]);
     auto fieldName = key_i();
     // std::cout << "setting field " << fieldName << std::endl;
-    ma.setfield(0, fieldName, getPythonFieldDictionaryValue(value_i_string, value_i_list));
+    ma.setfield(0, fieldName, getPythonFieldDictionaryValue(values[i]));
   }
 
   FieldHandle field;
@@ -578,6 +946,12 @@ const std::string SCIRun::Core::Python::getClassName(const py::object& object)
 
 Variable SCIRun::Core::Python::convertPythonObjectToVariable(const py::object& object)
 {
+  if (isNumericBuffer(object, 2))
+  {
+    DenseMatrixExtractor e(object);
+    if (e.check())
+      return makeDatatypeVariable(e);
+  }
   {
     py::extract<int> e(object);
     if (e.check())
@@ -88,7 +88,9 @@ namespace SCIRun
       }
 
       SCISHARE boost::python::dict convertFieldToPython(FieldHandle field);
-      SCISHARE boost::python::list convertMatrixToPython(Datatypes::DenseMatrixHandle matrix);
+      /// Matrices and numeric field arrays are returned as read-only NumPy arrays
+      /// sharing the SCIRun memory when NumPy is installed, and as lists otherwise.
+      SCISHARE boost::python::object convertMatrixToPython(Datatypes::DenseMatrixHandle matrix);
       SCISHARE boost::python::dict convertMatrixToPython(Datatypes::SparseRowMatrixHandle matrix);
       SCISHARE boost::python::object convertStringToPython(Datatypes::StringHandle str);
       SCISHARE boost::python::dict wrapDatatypesInMap(
@@ -38,6 +38,9 @@
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
 #include <Testing/Utils/SCIRunFieldSamples.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/SparseRowMatrixFromMap.h>
 #ifdef WIN32
 #ifndef DEBUG
 #include <Core/Python/PythonInterpreter.h>
@@ -47,6 +50,7 @@
 using namespace SCIRun;
 using namespace SCIRun::Core;
 using namespace Core::Python;
+using namespace Core::Datatypes;
 using namespace Testing;
 using namespace TestUtils;
 
@@ -430,3 +434,95 @@ TEST_F(FieldConversionTests, RejectsIncompatibleDictionary)
 
   ASSERT_FALSE(converter.check());
 }
+
+class MatrixConversionTests : public FieldConversionTests
+{
+protected:
+  static bool numpyAvailable()
+  {
+    try
+    {
+      boost::python::import("numpy");
+      return true;
+    }
+    catch (const boost::python::error_already_set&)
+    {
+      PyErr_Clear();
+      return false;
+    }
+  }
+};
+
+TEST_F(MatrixConversionTests, RoundTripDenseMatrix)
+{
+  auto expected = boost::make_shared<DenseMatrix>(3, 4);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j)
+      (*expected)(i, j) = 10 * i + j;
+
+  auto pyMatrix = convertMatrixToPython(expected);
+  DenseMatrixExtractor converter(pyMatrix);
+  ASSERT_TRUE(converter.check());
+
+  auto actual = boost::dynamic_pointer_cast<DenseMatrix>(converter());
+  ASSERT_TRUE(actual != nullptr);
+  EXPECT_EQ(*expected, *actual);
+  if (numpyAvailable())
+  {
+    // An unmodified NumPy view converts back to the matrix it shares memory with.
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST_F(MatrixConversionTests, RoundTripSparseMatrix)
+{
+  SparseRowMatrixFromMap::Values values;
+  values[0][1] = 2;
+  values[1][0] = -1;
+  values[2][3] = 5;
+  auto expected = SparseRowMatrixFromMap::make(3, 4, values);
+
+  auto pyMatrix = convertMatrixToPython(expected);
+  SparseRowMatrixExtractor converter(pyMatrix);
+  ASSERT_TRUE(converter.check());
+
+  auto actual = boost::dynamic_pointer_cast<SparseRowMatrix>(converter());
+  ASSERT_TRUE(actual != nullptr);
+  EXPECT_EQ(expected->nonZeros(), actual->nonZeros());
+  EXPECT_EQ(2, actual->coeff(0, 1));
+  EXPECT_EQ(-1, actual->coeff(1, 0));
+  EXPECT_EQ(5, actual->coeff(2, 3));
+}
+
+TEST_F(MatrixConversionTests, NumpyViewsAreReadOnlyAndKeepMatrixAlive)
+{
+  if (!numpyAvailable())
+    return;
+
+  auto matrix = boost::make_shared<DenseMatrix>(2, 3);
+  *matrix << 1, 2, 3,
+             4, 5, 6;
+  boost::weak_ptr<DenseMatrix> weak(matrix);
+
+  boost::python::dict scope;
+  scope["m"] = convertMatrixToPython(matrix);
+  matrix.reset();
+  EXPECT_FALSE(weak.expired());
+
+  boost::python::exec("writeable = m.flags.writeable\nt = m.T\ntotal = float(m.sum())\n", scope, scope);
+  EXPECT_FALSE(boost::python::extract<bool>(scope["writeable"])());
+  EXPECT_EQ(21.0, boost::python::extract<double>(scope["total"])());
+
+  boost::python::object pyTransposed = scope["t"];
+  DenseMatrixExtractor converter(pyTransposed);
+  ASSERT_TRUE(converter.check());
+  auto transposed = boost::dynamic_pointer_cast<DenseMatrix>(converter());
+  ASSERT_TRUE(transposed != nullptr);
+  ASSERT_EQ(3, transposed->nrows());
+  EXPECT_EQ(4, (*transposed)(0, 1));
+  EXPECT_EQ(3, (*transposed)(2, 0));
+
+  pyTransposed = boost::python::object();
+  scope.clear();
+  EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,194 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Core/Thread/TaskPool.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Logging/Log.h>
+#include <algorithm>
+
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Logging;
+
+TaskPool::TaskPool(size_t maxThreads) : maxThreads_(std::max<size_t>(maxThreads, 1)), idleThreads_(0), stopping_(false)
+{
+}
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    tasks_.clear();
+  }
+  taskAvailable_.notify_all();
+  for (auto& t : threads_)
+    t.join();
+}
+
+TaskPool& TaskPool::Instance()
+{
+  static TaskPool pool(Parallel::NumCores());
+  return pool;
+}
+
+void TaskPool::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (idleThreads_ < tasks_.size() && threads_.size() < maxThreads_)
+      threads_.emplace_back([this]() { workLoop(); });
+  }
+  taskAvailable_.notify_one();
+}
+
+namespace
+{
+  // Bookkeeping for one runAll call. Queued copies of the tasks keep this alive, so a task a
+  // worker dequeues after runAll returned finds itself claimed and does nothing.
+  struct TaskBatch
+  {
+    explicit TaskBatch(size_t size) : claimed(size, false), running(0) {}
+
+    bool claim(size_t i, bool countAsRunning)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (claimed[i])
+        return false;
+      claimed[i] = true;
+      if (countAsRunning)
+        ++running;
+      return true;
+    }
+
+    void run(const std::function<void()>& task)
+    {
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+
+    void finished()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        --running;
+      }
+      done.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<bool> claimed;
+    size_t running;
+    std::exception_ptr error;
+  };
+}
+
+void TaskPool::runAll(const std::vector<std::function<void()>>& tasks)
+{
+  if (tasks.empty())
+    return;
+  if (tasks.size() == 1)
+  {
+    tasks[0]();
+    return;
+  }
+
+  auto batch = std::make_shared<TaskBatch>(tasks.size());
+  for (size_t i = 1; i < tasks.size(); ++i)
+  {
+    auto task = tasks[i];
+    enqueue([batch, i, task]()
+    {
+      if (batch->claim(i, true))
+      {
+        batch->run(task);
+        batch->finished();
+      }
+    });
+  }
+
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    if (batch->claim(i, false))
+      batch->run(tasks[i]);
+  }
+
+  std::unique_lock<std::mutex> lock(batch->mutex);
+  batch->done.wait(lock, [&batch]() { return batch->running == 0; });
+  if (batch->error)
+    std::rethrow_exception(batch->error);
+}
+
+void TaskPool::runTasks(const std::function<void(int)>& task, int numTasks)
+{
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(std::max(numTasks, 0));
+  for (int i = 0; i < numTasks; ++i)
+    tasks.push_back([&task, i]() { task(i); });
+  runAll(tasks);
+}
+
+void TaskPool::workLoop()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    ++idleThreads_;
+    taskAvailable_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+    --idleThreads_;
+    if (stopping_)
+      return;
+
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    try
+    {
+      task();
+    }
+    catch (const std::exception& e)
+    {
+      logError("Thread pool task failed: {}", e.what());
+    }
+    catch (...)
+    {
+      logError("Thread pool task failed with an unknown exception");
+    }
+    lock.lock();
+  }
+}
@@ -0,0 +1,98 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_THREAD_TASKPOOL_H
+#define CORE_THREAD_TASKPOOL_H
+
+#include <boost/noncopyable.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Core/Thread/share.h>
+
+namespace SCIRun
+{
+namespace Core
+{
+namespace Thread
+{
+  /// @class TaskPool
+  /// @brief Worker threads shared by short computational tasks. At most maxThreads() tasks run
+  /// at once; threads are started on demand.
+  class SCISHARE TaskPool : public boost::noncopyable
+  {
+  public:
+    explicit TaskPool(size_t maxThreads);
+    /// Waits for running tasks; queued tasks that have not started are dropped.
+    virtual ~TaskPool();
+
+    /// Shared pool with one thread per core, see Parallel::NumCores().
+    static TaskPool& Instance();
+
+    size_t maxThreads() const { return maxThreads_; }
+    void enqueue(std::function<void()> task);
+
+    template <class Result>
+    std::shared_future<Result> submit(std::function<Result()> work)
+    {
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::move(work));
+      auto result = task->get_future().share();
+      enqueue([task]() { (*task)(); });
+      return result;
+    }
+
+    /// Runs the tasks concurrently and returns once all of them finished. The calling thread
+    /// executes every task no worker has picked up yet, so this never waits on a busy pool and
+    /// is safe to call from inside a pool task. The first exception thrown is rethrown here.
+    void runAll(const std::vector<std::function<void()>>& tasks);
+
+    /// Runs task(0), ..., task(numTasks - 1) through runAll; the pool counterpart of
+    /// Parallel::RunTasks for data parallel passes.
+    void runTasks(const std::function<void(int)>& task, int numTasks);
+
+  private:
+    void workLoop();
+
+    const size_t maxThreads_;
+    std::mutex mutex_;
+    std::condition_variable taskAvailable_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    size_t idleThreads_;
+    bool stopping_;
+  };
+
+}}}
+
+#endif
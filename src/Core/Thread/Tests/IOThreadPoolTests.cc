@@ -0,0 +1,80 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+
+#include <Core/Thread/IOThreadPool.h>
+
+using namespace SCIRun::Core::Thread;
+
+TEST(IOThreadPoolTests, SubmittedWorkReturnsResults)
+{
+  IOThreadPool pool(2);
+  std::vector<std::shared_future<int>> results;
+  for (int i = 0; i < 10; ++i)
+    results.push_back(pool.submit<int>([i]() { return i * i; }));
+
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i * i, results[i].get());
+}
+
+TEST(IOThreadPoolTests, NeverRunsMoreThanMaxThreadsAtOnce)
+{
+  const size_t maxThreads = 3;
+  IOThreadPool pool(maxThreads);
+  std::atomic<int> running(0), peak(0);
+  std::vector<std::shared_future<bool>> results;
+  for (int i = 0; i < 12; ++i)
+  {
+    results.push_back(pool.submit<bool>([&]()
+    {
+      auto now = ++running;
+      auto seen = peak.load();
+      while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      --running;
+      return true;
+    }));
+  }
+  for (auto& r : results)
+    EXPECT_TRUE(r.get());
+  EXPECT_LE(peak.load(), static_cast<int>(maxThreads));
+  EXPECT_GE(peak.load(), 1);
+}
+
+TEST(IOThreadPoolTests, ExceptionsAreDeliveredThroughTheFuture)
+{
+  IOThreadPool pool(1);
+  auto failed = pool.submit<int>([]() -> int { throw std::runtime_error("unreadable"); });
+  auto fine = pool.submit<int>([]() { return 7; });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  EXPECT_EQ(7, fine.get());
+}
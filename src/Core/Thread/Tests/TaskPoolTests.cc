@@ -0,0 +1,94 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+
+#include <Core/Thread/TaskPool.h>
+
+using namespace SCIRun::Core::Thread;
+
+TEST(TaskPoolTests, RunAllExecutesEveryTaskOnce)
+{
+  TaskPool pool(3);
+  std::vector<std::atomic<int>> counts(20);
+  std::vector<std::function<void()>> tasks;
+  for (size_t i = 0; i < counts.size(); ++i)
+    tasks.push_back([&counts, i]() { ++counts[i]; });
+
+  pool.runAll(tasks);
+
+  for (const auto& c : counts)
+    EXPECT_EQ(1, c.load());
+}
+
+TEST(TaskPoolTests, RunAllFinishesWhileEveryWorkerIsBusy)
+{
+  TaskPool pool(1);
+  std::atomic<bool> release(false);
+  auto blocker = pool.submit<bool>([&release]()
+  {
+    while (!release)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return true;
+  });
+
+  std::atomic<int> done(0);
+  std::vector<std::function<void()>> tasks(4, [&done]() { ++done; });
+  pool.runAll(tasks);
+  EXPECT_EQ(4, done.load());
+
+  release = true;
+  EXPECT_TRUE(blocker.get());
+}
+
+TEST(TaskPoolTests, RunAllRethrowsTaskExceptions)
+{
+  TaskPool pool(2);
+  std::atomic<int> done(0);
+  std::vector<std::function<void()>> tasks =
+  {
+    [&done]() { ++done; },
+    []() { throw std::runtime_error("bad table"); },
+    [&done]() { ++done; }
+  };
+  EXPECT_THROW(pool.runAll(tasks), std::runtime_error);
+  EXPECT_EQ(2, done.load());
+}
+
+TEST(TaskPoolTests, RunTasksPassesEveryIndexOnce)
+{
+  TaskPool pool(3);
+  std::vector<std::atomic<int>> counts(8);
+  pool.runTasks([&counts](int i) { ++counts[i]; }, static_cast<int>(counts.size()));
+
+  for (const auto& c : counts)
+    EXPECT_EQ(1, c.load());
+}
@@ -50,6 +50,23 @@ namespace Engine {
 
   typedef boost::shared_ptr<NetworkIOInterface<Networks::NetworkFileHandle>> NetworkIOHandle;
 
+  /// Fine-grained network edits used by provenance items to apply a change in place,
+  /// rather than clearing and reloading a whole-network snapshot. Each operation returns
+  /// false when it cannot be applied, so the caller can fall back to a snapshot.
+  class SCISHARE NetworkDeltaInterface
+  {
+  public:
+    virtual ~NetworkDeltaInterface() {}
+    /// Modules only (lookup info, state, position)--connections are recorded separately.
+    virtual Networks::NetworkFileHandle saveModuleFragment(const Networks::ModuleId& id) const = 0;
+    /// Re-adds the fragment's modules under their original ids.
+    virtual bool insertModules(const Networks::NetworkFileHandle& fragment) = 0;
+    virtual bool eraseModule(const Networks::ModuleId& id) = 0;
+    virtual bool insertConnection(const Networks::ConnectionDescription& desc) = 0;
+    virtual bool eraseConnection(const Networks::ConnectionId& id) = 0;
+    virtual bool moveModule(const Networks::ModuleId& id, double x, double y) = 0;
+  };
+
   template <class Memento>
   class ProvenanceItem;
 
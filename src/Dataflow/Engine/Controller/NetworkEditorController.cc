@@ -655,6 +655,88 @@ void NetworkEditorController::appendToNetwork(const NetworkFileHandle& xml)
   }
 }
 
+NetworkFileHandle NetworkEditorController::saveModuleFragment(const ModuleId& id) const
+{
+  if (!theNetwork_->lookupModule(id))
+    return nullptr;
+  return serializeNetworkFragment([&id](ModuleHandle mod) { return mod->id() == id; },
+    [](const ConnectionDescription&) { return false; });
+}
+
+bool NetworkEditorController::insertModules(const NetworkFileHandle& fragment)
+{
+  if (!fragment)
+    return false;
+  for (const auto& mod : fragment->network.modules)
+  {
+    if (theNetwork_->lookupModule(ModuleId(mod.first)))
+      return false;
+  }
+
+  // ids are all free, so unlike appendToNetwork nothing is renamed or shifted
+  NetworkXMLConverter conv(moduleFactory_, stateFactory_, algoFactory_, reexFactory_, this);
+  auto info = conv.appendXmlData(fragment->network);
+  ModuleCounter modulesDone;
+  for (size_t i = info.newModuleStartIndex; i < theNetwork_->nmodules(); ++i)
+  {
+    auto module = theNetwork_->module(i);
+    moduleAdded_(module->name(), module, modulesDone);
+  }
+
+  if (serializationManager_)
+  {
+    serializationManager_->updateModulePositions(fragment->modulePositions, false);
+    serializationManager_->updateModuleNotes(fragment->moduleNotes);
+    serializationManager_->updateModuleTags(fragment->moduleTags);
+  }
+  return true;
+}
+
+bool NetworkEditorController::eraseModule(const ModuleId& id)
+{
+  if (!theNetwork_->lookupModule(id))
+    return false;
+  for (const auto& cd : theNetwork_->connections(true))
+  {
+    if (cd.out_.moduleId_ == id || cd.in_.moduleId_ == id)
+      removeConnection(ConnectionId::create(cd));
+  }
+  removeModule(id);
+  return true;
+}
+
+bool NetworkEditorController::insertConnection(const ConnectionDescription& desc)
+{
+  auto from = theNetwork_->lookupModule(desc.out_.moduleId_);
+  auto to = theNetwork_->lookupModule(desc.in_.moduleId_);
+  if (!from || !to || !from->hasOutputPort(desc.out_.portId_) || !to->hasInputPort(desc.in_.portId_))
+    return false;
+  auto id = requestConnection(from->getOutputPort(desc.out_.portId_).get(), to->getInputPort(desc.in_.portId_).get());
+  return id && !id->id_.empty();
+}
+
+bool NetworkEditorController::eraseConnection(const ConnectionId& id)
+{
+  if (!theNetwork_->disconnect(id))
+    return false;
+  connectionRemoved_(id);
+  printNetwork();
+  return true;
+}
+
+bool NetworkEditorController::moveModule(const ModuleId& id, double x, double y)
+{
+  if (!theNetwork_->lookupModule(id))
+    return false;
+  if (serializationManager_)
+  {
+    ModulePositions positions;
+    positions.modulePositions[id.id_] = { x, y };
+    serializationManager_->updateModulePositions(positions, false);
+  }
+  return true;
+}
+
 void NetworkEditorController::clear()
 {
   LOG_DEBUG("NetworkEditorController::clear()");
@@ -83,7 +83,7 @@ namespace Engine {
   //   Service object will hold the Domain objects (network, factories), while Controller will manage the signal forwarding and the service's thread
   //   This will be done in issue #231
 
-  class SCISHARE NetworkEditorController : public NetworkIOInterface<Networks::NetworkFileHandle>, public Networks::NetworkEditorControllerInterface
+  class SCISHARE NetworkEditorController : public NetworkIOInterface<Networks::NetworkFileHandle>, public NetworkDeltaInterface, public Networks::NetworkEditorControllerInterface
   {
   public:
     NetworkEditorController(Networks::ModuleFactoryHandle mf,
@@ -119,6 +119,13 @@ namespace Engine {
 
     Networks::NetworkFileHandle serializeNetworkFragment(Networks::ModuleFilter modFilter, Networks::ConnectionFilter connFilter) const;
     void appendToNetwork(const Networks::NetworkFileHandle& xml);
+
+    Networks::NetworkFileHandle saveModuleFragment(const Networks::ModuleId& id) const override;
+    bool insertModules(const Networks::NetworkFileHandle& fragment) override;
+    bool eraseModule(const Networks::ModuleId& id) override;
+    bool insertConnection(const Networks::ConnectionDescription& desc) override;
+    bool eraseConnection(const Networks::ConnectionId& id) override;
+    bool moveModule(const Networks::ModuleId& id, double x, double y) override;
 //////////////////////End: To be Pythonized///////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 
@@ -33,6 +33,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <Dataflow/Network/NetworkFwd.h>
+#include <Dataflow/Engine/Controller/ControllerInterfaces.h>
 #include <Dataflow/Engine/Controller/share.h>
 
 namespace SCIRun {
@@ -47,6 +48,11 @@ namespace Engine {
     virtual ~ProvenanceItem() {}
     virtual Memento memento() const = 0;
     virtual std::string name() const = 0;
+    /// False for items that only record a delta; the manager then restores from a checkpoint.
+    virtual bool hasMemento() const { return true; }
+    /// Redo/undo this item's change in place. Snapshot-only items return false.
+    virtual bool applyForward(NetworkDeltaInterface&) const { return false; }
+    virtual bool applyInverse(NetworkDeltaInterface&) const { return false; }
   };
 
 }
@@ -31,10 +31,14 @@
 #include <string>
 #include <sstream>
 #include <Dataflow/Engine/Controller/ProvenanceItemImpl.h>
+#include <Dataflow/Network/ModuleInterface.h>
+#include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
+#include <Dataflow/Serialization/Network/StateSerialization.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Dataflow::Engine;
 using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Dataflow::State;
 
 ProvenanceItemBase::ProvenanceItemBase(NetworkFileHandle state) : state_(state)
 {
@@ -45,48 +49,132 @@ NetworkFileHandle ProvenanceItemBase::memento() const
   return state_;
 }
 
+bool ProvenanceItemBase::hasMemento() const
+{
+  return state_ != nullptr;
+}
+
 ModuleAddedProvenanceItem::ModuleAddedProvenanceItem(const std::string& moduleName, NetworkFileHandle state)
   : ProvenanceItemBase(state), moduleName_(moduleName)
 {
 }
 
+ModuleAddedProvenanceItem::ModuleAddedProvenanceItem(const std::string& moduleName, const ModuleId& moduleId, NetworkFileHandle moduleFragment)
+  : ProvenanceItemBase(nullptr), moduleName_(moduleName), moduleId_(moduleId.id_), fragment_(moduleFragment)
+{
+}
+
 std::string ModuleAddedProvenanceItem::name() const
 {
   return "Module Added: " + moduleName_;
 }
 
+bool ModuleAddedProvenanceItem::applyForward(NetworkDeltaInterface& network) const
+{
+  return fragment_ && network.insertModules(fragment_);
+}
+
+bool ModuleAddedProvenanceItem::applyInverse(NetworkDeltaInterface& network) const
+{
+  if (moduleId_.empty())
+    return false;
+  auto current = network.saveModuleFragment(ModuleId(moduleId_));
+  if (!current || !network.eraseModule(ModuleId(moduleId_)))
+    return false;
+  fragment_ = current;
+  return true;
+}
+
 ModuleRemovedProvenanceItem::ModuleRemovedProvenanceItem(const ModuleId& moduleId, NetworkFileHandle state)
   : ProvenanceItemBase(state), moduleId_(moduleId)
 {
 }
 
+boost::shared_ptr<ModuleRemovedProvenanceItem> ModuleRemovedProvenanceItem::fromFragment(const ModuleId& moduleId, NetworkFileHandle moduleFragment)
+{
+  auto item = boost::make_shared<ModuleRemovedProvenanceItem>(moduleId, nullptr);
+  item->fragment_ = moduleFragment;
+  return item;
+}
+
 std::string ModuleRemovedProvenanceItem::name() const
 {
   return "Module Removed: " + moduleId_.id_;
 }
 
+bool ModuleRemovedProvenanceItem::applyForward(NetworkDeltaInterface& network) const
+{
+  if (!fragment_)
+    return false;
+  auto current = network.saveModuleFragment(moduleId_);
+  if (!current || !network.eraseModule(moduleId_))
+    return false;
+  fragment_ = current;
+  return true;
+}
+
+bool ModuleRemovedProvenanceItem::applyInverse(NetworkDeltaInterface& network) const
+{
+  return fragment_ && network.insertModules(fragment_);
+}
+
 ConnectionAddedProvenanceItem::ConnectionAddedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionDescription& cd, NetworkFileHandle state)
   : ProvenanceItemBase(state), desc_(cd)
 {
 }
 
+ConnectionAddedProvenanceItem::ConnectionAddedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionDescription& cd)
+  : ProvenanceItemBase(nullptr), desc_(cd)
+{
+}
+
 std::string ConnectionAddedProvenanceItem::name() const
 {
   return "Connection added: " + ConnectionId::create(desc_).id_;
 }
 
+bool ConnectionAddedProvenanceItem::applyForward(NetworkDeltaInterface& network) const
+{
+  return network.insertConnection(desc_);
+}
+
+bool ConnectionAddedProvenanceItem::applyInverse(NetworkDeltaInterface& network) const
+{
+  return network.eraseConnection(ConnectionId::create(desc_));
+}
+
 ConnectionRemovedProvenanceItem::ConnectionRemovedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionId& id, NetworkFileHandle state)
   : ProvenanceItemBase(state), id_(id)
 {
 }
 
+ConnectionRemovedProvenanceItem::ConnectionRemovedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionId& id)
+  : ProvenanceItemBase(nullptr), id_(id)
+{
+}
+
 std::string ConnectionRemovedProvenanceItem::name() const
 {
   return "Connection Removed: " + id_.id_;
 }
 
+bool ConnectionRemovedProvenanceItem::applyForward(NetworkDeltaInterface& network) const
+{
+  return network.eraseConnection(id_);
+}
+
+bool ConnectionRemovedProvenanceItem::applyInverse(NetworkDeltaInterface& network) const
+{
+  return network.insertConnection(id_.describe());
+}
+
 ModuleMovedProvenanceItem::ModuleMovedProvenanceItem(const SCIRun::Dataflow::Networks::ModuleId& moduleId, double newX, double newY, NetworkFileHandle state)
-  : ProvenanceItemBase(state), moduleId_(moduleId), newX_(newX), newY_(newY)
+  : ProvenanceItemBase(state), moduleId_(moduleId), oldX_(0), oldY_(0), newX_(newX), newY_(newY), hasOldPosition_(false)
+{
+}
+
+ModuleMovedProvenanceItem::ModuleMovedProvenanceItem(const SCIRun::Dataflow::Networks::ModuleId& moduleId, double oldX, double oldY, double newX, double newY)
+  : ProvenanceItemBase(nullptr), moduleId_(moduleId), oldX_(oldX), oldY_(oldY), newX_(newX), newY_(newY), hasOldPosition_(true)
 {
 }
 
@@ -96,3 +184,22 @@ std::string ModuleMovedProvenanceItem::name() const
   ostr << "Module " << moduleId_.id_ << " moved to (" << newX_ << "," << newY_ << ")";
   return ostr.str();
 }
+
+bool ModuleMovedProvenanceItem::applyForward(NetworkDeltaInterface& network) const
+{
+  return hasOldPosition_ && network.moveModule(moduleId_, newX_, newY_);
+}
+
+bool ModuleMovedProvenanceItem::applyInverse(NetworkDeltaInterface& network) const
+{
+  return hasOldPosition_ && network.moveModule(moduleId_, oldX_, oldY_);
+}
+
+NetworkFileHandle SCIRun::Dataflow::Engine::makeModuleFragment(const ModuleHandle& module, double x, double y)
+{
+  auto fragment(boost::make_shared<NetworkFile>());
+  auto state = make_state_xml(module->get_state());
+  fragment->network.modules[module->id()] = ModuleWithState(module->info(), state ? *state : SimpleMapModuleStateXML());
+  fragment->modulePositions.modulePositions[module->id()] = { x, y };
+  return fragment;
+}
@@ -40,11 +40,14 @@ namespace SCIRun {
 namespace Dataflow {
 namespace Engine {
 
+  /// Items constructed with a network snapshot restore by reloading it; the delta
+  /// constructors record only what changed, and are applied in place.
   class SCISHARE ProvenanceItemBase : public ProvenanceItem<Networks::NetworkFileHandle>
   {
   public:
     explicit ProvenanceItemBase(Networks::NetworkFileHandle state);
     Networks::NetworkFileHandle memento() const override;
+    bool hasMemento() const override;
   protected:
     Networks::NetworkFileHandle state_;
   };
@@ -53,25 +56,38 @@ namespace Engine {
   {
   public:
     ModuleAddedProvenanceItem(const std::string& moduleName, Networks::NetworkFileHandle state);
+    ModuleAddedProvenanceItem(const std::string& moduleName, const Networks::ModuleId& moduleId, Networks::NetworkFileHandle moduleFragment);
     std::string name() const override;
+    bool applyForward(NetworkDeltaInterface& network) const override;
+    bool applyInverse(NetworkDeltaInterface& network) const override;
   private:
     std::string moduleName_;
+    std::string moduleId_;
+    // refreshed on undo so redo brings the module back as it was
+    mutable Networks::NetworkFileHandle fragment_;
   };
 
   class SCISHARE ModuleRemovedProvenanceItem : public ProvenanceItemBase
   {
   public:
     ModuleRemovedProvenanceItem(const SCIRun::Dataflow::Networks::ModuleId& moduleId, Networks::NetworkFileHandle state);
+    static boost::shared_ptr<ModuleRemovedProvenanceItem> fromFragment(const SCIRun::Dataflow::Networks::ModuleId& moduleId, Networks::NetworkFileHandle moduleFragment);
     std::string name() const override;
+    bool applyForward(NetworkDeltaInterface& network) const override;
+    bool applyInverse(NetworkDeltaInterface& network) const override;
   private:
     SCIRun::Dataflow::Networks::ModuleId moduleId_;
+    mutable Networks::NetworkFileHandle fragment_;
   };
 
   class SCISHARE ConnectionAddedProvenanceItem : public ProvenanceItemBase
   {
   public:
     ConnectionAddedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionDescription& cd, Networks::NetworkFileHandle state);
+    explicit ConnectionAddedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionDescription& cd);
     std::string name() const override;
+    bool applyForward(NetworkDeltaInterface& network) const override;
+    bool applyInverse(NetworkDeltaInterface& network) const override;
   private:
     SCIRun::Dataflow::Networks::ConnectionDescription desc_;
   };
@@ -80,7 +96,10 @@ namespace Engine {
   {
   public:
     ConnectionRemovedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionId& id, Networks::NetworkFileHandle state);
+    explicit ConnectionRemovedProvenanceItem(const SCIRun::Dataflow::Networks::ConnectionId& id);
     std::string name() const override;
+    bool applyForward(NetworkDeltaInterface& network) const override;
+    bool applyInverse(NetworkDeltaInterface& network) const override;
   private:
     SCIRun::Dataflow::Networks::ConnectionId id_;
   };
@@ -89,11 +108,19 @@ namespace Engine {
   {
   public:
     ModuleMovedProvenanceItem(const SCIRun::Dataflow::Networks::ModuleId& moduleId, double newX, double newY, Networks::NetworkFileHandle state);
+    ModuleMovedProvenanceItem(const SCIRun::Dataflow::Networks::ModuleId& moduleId, double oldX, double oldY, double newX, double newY);
     std::string name() const override;
+    bool applyForward(NetworkDeltaInterface& network) const override;
+    bool applyInverse(NetworkDeltaInterface& network) const override;
   private:
     SCIRun::Dataflow::Networks::ModuleId moduleId_;
-    double newX_, newY_;
+    double oldX_, oldY_, newX_, newY_;
+    bool hasOldPosition_;
   };
+
+  /// Lookup info, state and position of a single module, for delta items created
+  /// after the module has left the network.
+  SCISHARE Networks::NetworkFileHandle makeModuleFragment(const Networks::ModuleHandle& module, double x, double y);
 }
 }
 }
@@ -31,8 +31,10 @@
 #ifndef ENGINE_NETWORK_PROVENANCEMANAGER_H
 #define ENGINE_NETWORK_PROVENANCEMANAGER_H
 
-#include <stack>
+#include <deque>
+#include <limits>
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Engine/Controller/NetworkEditorController.h>
 #include <Dataflow/Engine/Controller/share.h>
@@ -41,17 +43,21 @@ namespace SCIRun {
 namespace Dataflow {
 namespace Engine {
 
+  /// Undo/redo history. Items that carry a delta are applied in place through the
+  /// NetworkDeltaInterface, so a step costs O(change) instead of a full reload. A full
+  /// checkpoint is saved every checkpointInterval() delta items; when an item cannot be
+  /// applied in place, the network is reloaded from the nearest earlier snapshot and the
+  /// deltas after it are replayed. The history holds at most maxItems() items.
   template <class Memento>
   class ProvenanceManager : boost::noncopyable
   {
   public:
     using Item = ProvenanceItem<Memento>;
     using ItemHandle = typename Item::Handle;
-    using Stack = std::stack<ItemHandle>;
-    using List = typename Stack::container_type;
+    using List = std::deque<ItemHandle>;
     using IOType = Engine::NetworkIOInterface<Memento>;
 
-    explicit ProvenanceManager(IOType* networkIO);
+    explicit ProvenanceManager(IOType* networkIO, NetworkDeltaInterface* deltaIO = nullptr);
     void setInitialState(const Memento& initialState);
     void addItem(ItemHandle item);
     ItemHandle undo();
@@ -65,25 +71,50 @@ namespace Engine {
     size_t undoSize() const;
     size_t redoSize() const;
 
+    void setMaxItems(size_t maxItems);
+    size_t maxItems() const;
+    void setCheckpointInterval(size_t interval);
+    size_t checkpointInterval() const;
+
     const IOType* networkIO() const;
 
   private:
+    struct Entry
+    {
+      ItemHandle item;
+      boost::optional<Memento> checkpoint;
+    };
+    using History = std::deque<Entry>;
+
     ItemHandle undo(bool restore);
     ItemHandle redo(bool restore);
+    static bool hasSnapshot(const Entry& entry);
+    static Memento snapshot(const Entry& entry);
+    size_t stepsSinceSnapshot() const;
+    void restoreState(size_t numApplied);
+    void replay(const ItemHandle& item);
+    void trim();
+
     IOType* networkIO_;
-    Stack undo_, redo_;
+    NetworkDeltaInterface* deltaIO_;
+    History undo_, redo_;
+    // delta items trimmed off the front since initialState_ was last known
+    List trimmed_;
     boost::optional<Memento> initialState_;
+    size_t maxItems_, checkpointInterval_;
   };
 
 
 
   template <class Memento>
-  ProvenanceManager<Memento>::ProvenanceManager(IOType* networkIO) : networkIO_(networkIO) {}
+  ProvenanceManager<Memento>::ProvenanceManager(IOType* networkIO, NetworkDeltaInterface* deltaIO)
+    : networkIO_(networkIO), deltaIO_(deltaIO), maxItems_(std::numeric_limits<size_t>::max()), checkpointInterval_(8) {}
 
   template <class Memento>
   void ProvenanceManager<Memento>::setInitialState(const Memento& initialState)
   {
     initialState_ = initialState;
+    trimmed_.clear();
   }
 
   template <class Memento>
@@ -98,18 +129,50 @@ namespace Engine {
     return redo_.size();
   }
 
+  template <class Memento>
+  void ProvenanceManager<Memento>::setMaxItems(size_t maxItems)
+  {
+    maxItems_ = maxItems;
+    trim();
+  }
+
+  template <class Memento>
+  size_t ProvenanceManager<Memento>::maxItems() const
+  {
+    return maxItems_;
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::setCheckpointInterval(size_t interval)
+  {
+    checkpointInterval_ = interval > 0 ? interval : 1;
+  }
+
+  template <class Memento>
+  size_t ProvenanceManager<Memento>::checkpointInterval() const
+  {
+    return checkpointInterval_;
+  }
+
   template <class Memento>
   void ProvenanceManager<Memento>::addItem(typename ProvenanceManager<Memento>::ItemHandle item)
   {
-    undo_.push(item);
-    Stack().swap(redo_);
+    undo_.push_back({ item, boost::none });
+    redo_.clear();
+
+    // without a delta target every item must be restorable from a snapshot
+    if (!item->hasMemento() && (!deltaIO_ || stepsSinceSnapshot() >= checkpointInterval_))
+      undo_.back().checkpoint = networkIO_->saveNetwork();
+
+    trim();
   }
 
   template <class Memento>
   void ProvenanceManager<Memento>::clearAll()
   {
-    Stack().swap(undo_);
-    Stack().swap(redo_);
+    undo_.clear();
+    redo_.clear();
+    trimmed_.clear();
   }
 
   template <class Memento>
@@ -123,21 +186,14 @@ namespace Engine {
   {
     if (!undo_.empty())
     {
-      auto undone = undo_.top();
-      undo_.pop();
-      redo_.push(undone);
+      auto undone = undo_.back();
+      undo_.pop_back();
+      redo_.push_back(undone);
 
-      //clear and load previous memento
-      if (restore)
-      {
-        networkIO_->clear();
-        if (!undo_.empty())
-          networkIO_->loadNetwork(undo_.top()->memento());
-        else if (initialState_)
-          networkIO_->loadNetwork(initialState_.get());
-      }
+      if (restore && !(deltaIO_ && undone.item->applyInverse(*deltaIO_)))
+        restoreState(undo_.size());
 
-      return undone;
+      return undone.item;
     }
     return ItemHandle();
   }
@@ -153,18 +209,14 @@ namespace Engine {
   {
     if (!redo_.empty())
     {
-      auto redone = redo_.top();
-      redo_.pop();
-      undo_.push(redone);
+      auto redone = redo_.back();
+      redo_.pop_back();
+      undo_.push_back(redone);
 
-      //clear and load redone memento
-      if (restore)
-      {
-        networkIO_->clear();
-        networkIO_->loadNetwork(redone->memento());
-      }
+      if (restore && !(deltaIO_ && redone.item->applyForward(*deltaIO_)))
+        restoreState(undo_.size());
 
-      return redone;
+      return redone.item;
     }
     return ItemHandle();
   }
@@ -175,9 +227,7 @@ namespace Engine {
     List undone;
     while (0 != undoSize())
       undone.push_back(undo(false));
-    networkIO_->clear();
-    if (initialState_)
-      networkIO_->loadNetwork(initialState_.get());
+    restoreState(0);
     return undone;
   }
 
@@ -187,11 +237,81 @@ namespace Engine {
     List redone;
     while (0 != redoSize())
       redone.push_back(redo(false));
-    networkIO_->clear();
-    networkIO_->loadNetwork(undo_.top()->memento());
+    restoreState(undo_.size());
     return redone;
   }
 
+  template <class Memento>
+  bool ProvenanceManager<Memento>::hasSnapshot(const Entry& entry)
+  {
+    return entry.checkpoint || entry.item->hasMemento();
+  }
+
+  template <class Memento>
+  Memento ProvenanceManager<Memento>::snapshot(const Entry& entry)
+  {
+    return entry.checkpoint ? entry.checkpoint.get() : entry.item->memento();
+  }
+
+  template <class Memento>
+  size_t ProvenanceManager<Memento>::stepsSinceSnapshot() const
+  {
+    size_t steps = 0;
+    for (auto e = undo_.rbegin(); e != undo_.rend(); ++e, ++steps)
+    {
+      if (hasSnapshot(*e))
+        return steps;
+    }
+    return steps + trimmed_.size();
+  }
+
+  //clear and load the state after the first numApplied undo items: nearest snapshot, then deltas
+  template <class Memento>
+  void ProvenanceManager<Memento>::restoreState(size_t numApplied)
+  {
+    auto start = numApplied;
+    while (start > 0 && !hasSnapshot(undo_[start - 1]))
+      --start;
+
+    networkIO_->clear();
+    if (start > 0)
+      networkIO_->loadNetwork(snapshot(undo_[start - 1]));
+    else
+    {
+      if (initialState_)
+        networkIO_->loadNetwork(initialState_.get());
+      for (const auto& item : trimmed_)
+        replay(item);
+    }
+
+    for (auto i = start; i < numApplied; ++i)
+      replay(undo_[i].item);
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::replay(const ItemHandle& item)
+  {
+    if (deltaIO_)
+      item->applyForward(*deltaIO_);
+  }
+
+  template <class Memento>
+  void ProvenanceManager<Memento>::trim()
+  {
+    while (!undo_.empty() && undo_.size() + redo_.size() > maxItems_)
+    {
+      const auto oldest = undo_.front();
+      undo_.pop_front();
+      if (hasSnapshot(oldest))
+      {
+        initialState_ = snapshot(oldest);
+        trimmed_.clear();
+      }
+      else
+        trimmed_.push_back(oldest.item);
+    }
+  }
+
   template <class Memento>
   const typename ProvenanceManager<Memento>::IOType* ProvenanceManager<Memento>::networkIO() const
   {
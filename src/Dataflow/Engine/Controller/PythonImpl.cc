@@ -107,7 +107,7 @@ namespace
 
   private:
     DenseMatrixHandle underlying_;
-    py::list pyMat_;
+    py::object pyMat_;
   };
 
   class PyDatatypeSparseRowMatrix : public PyDatatype
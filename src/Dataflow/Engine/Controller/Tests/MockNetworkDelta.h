@@ -0,0 +1,57 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#ifndef ENGINE_CONTROLLER_TESTS_MOCKNETWORKDELTA_H
+#define ENGINE_CONTROLLER_TESTS_MOCKNETWORKDELTA_H
+
+#include <Dataflow/Engine/Controller/ControllerInterfaces.h>
+#include <Dataflow/Network/ConnectionId.h>
+#include <Dataflow/Network/ModuleDescription.h>
+#include <gmock/gmock.h>
+
+namespace SCIRun {
+  namespace Dataflow {
+    namespace Engine {
+      namespace Mocks
+      {
+        class MockNetworkDelta : public NetworkDeltaInterface
+        {
+        public:
+          MOCK_CONST_METHOD1(saveModuleFragment, Networks::NetworkFileHandle(const Networks::ModuleId&));
+          MOCK_METHOD1(insertModules, bool(const Networks::NetworkFileHandle&));
+          MOCK_METHOD1(eraseModule, bool(const Networks::ModuleId&));
+          MOCK_METHOD1(insertConnection, bool(const Networks::ConnectionDescription&));
+          MOCK_METHOD1(eraseConnection, bool(const Networks::ConnectionId&));
+          MOCK_METHOD3(moveModule, bool(const Networks::ModuleId&, double, double));
+        };
+      }
+    }
+  }
+}
+
+#endif
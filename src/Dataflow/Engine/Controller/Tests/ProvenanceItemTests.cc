@@ -34,11 +34,14 @@
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Engine/Controller/ProvenanceItemFactory.h>
 #include <Dataflow/Engine/Controller/ProvenanceItemImpl.h>
+#include <Dataflow/Engine/Controller/Tests/MockNetworkDelta.h>
+#include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Dataflow::Engine;
 using namespace SCIRun::Dataflow::Networks;
 using namespace SCIRun::Dataflow::Networks::Mocks;
+using namespace SCIRun::Dataflow::Engine::Mocks;
 using ::testing::_;
 using ::testing::Eq;
 using ::testing::NiceMock;
@@ -74,3 +77,74 @@ TEST_F(ProvenanceItemTests, CanCreateRemoveModule)
 
   EXPECT_EQ("Module Removed: " + id, item.name());
 }
+
+TEST_F(ProvenanceItemTests, SnapshotItemsDoNotApplyInPlace)
+{
+  NiceMock<MockNetworkDelta> network;
+  ModuleAddedProvenanceItem item("ComputeSVD", boost::make_shared<NetworkFile>());
+
+  EXPECT_TRUE(item.hasMemento());
+  EXPECT_CALL(network, eraseModule(_)).Times(0);
+  EXPECT_FALSE(item.applyInverse(network));
+}
+
+TEST_F(ProvenanceItemTests, ModuleAddedUndoCapturesModuleForRedo)
+{
+  NiceMock<MockNetworkDelta> network;
+  const ModuleId id("ComputeSVD:0");
+  auto added = boost::make_shared<NetworkFile>();
+  auto edited = boost::make_shared<NetworkFile>();
+  ModuleAddedProvenanceItem item("ComputeSVD", id, added);
+
+  EXPECT_FALSE(item.hasMemento());
+  EXPECT_CALL(network, saveModuleFragment(id)).WillOnce(Return(edited));
+  EXPECT_CALL(network, eraseModule(id)).WillOnce(Return(true));
+  EXPECT_TRUE(item.applyInverse(network));
+
+  EXPECT_CALL(network, insertModules(NetworkFileHandle(edited))).WillOnce(Return(true));
+  EXPECT_TRUE(item.applyForward(network));
+}
+
+TEST_F(ProvenanceItemTests, ModuleRemovedUndoReinsertsFragment)
+{
+  NiceMock<MockNetworkDelta> network;
+  const ModuleId id("ComputeSVD:0");
+  auto fragment = boost::make_shared<NetworkFile>();
+  auto item = ModuleRemovedProvenanceItem::fromFragment(id, fragment);
+
+  EXPECT_EQ("Module Removed: ComputeSVD:0", item->name());
+  EXPECT_CALL(network, insertModules(NetworkFileHandle(fragment))).WillOnce(Return(true));
+  EXPECT_TRUE(item->applyInverse(network));
+
+  EXPECT_CALL(network, saveModuleFragment(id)).WillOnce(Return(fragment));
+  EXPECT_CALL(network, eraseModule(id)).WillOnce(Return(true));
+  EXPECT_TRUE(item->applyForward(network));
+}
+
+TEST_F(ProvenanceItemTests, ConnectionItemsAreInverses)
+{
+  NiceMock<MockNetworkDelta> network;
+  const ConnectionDescription desc(OutgoingConnectionDescription(ModuleId("CreateMatrix:0"), PortId(0, "OutputMatrix")),
+    IncomingConnectionDescription(ModuleId("ComputeSVD:0"), PortId(0, "InputMatrix")));
+  const auto id = ConnectionId::create(desc);
+
+  ConnectionAddedProvenanceItem added(desc);
+  EXPECT_CALL(network, eraseConnection(id)).WillOnce(Return(true));
+  EXPECT_TRUE(added.applyInverse(network));
+
+  ConnectionRemovedProvenanceItem removed(id);
+  EXPECT_CALL(network, insertConnection(desc)).WillOnce(Return(true));
+  EXPECT_TRUE(removed.applyInverse(network));
+}
+
+TEST_F(ProvenanceItemTests, ModuleMovedRestoresOldPosition)
+{
+  NiceMock<MockNetworkDelta> network;
+  const ModuleId id("ComputeSVD:0");
+  ModuleMovedProvenanceItem item(id, 10, 20, 30, 40);
+
+  EXPECT_CALL(network, moveModule(id, 10, 20)).WillOnce(Return(true));
+  EXPECT_TRUE(item.applyInverse(network));
+  EXPECT_CALL(network, moveModule(id, 30, 40)).WillOnce(Return(true));
+  EXPECT_TRUE(item.applyForward(network));
+}
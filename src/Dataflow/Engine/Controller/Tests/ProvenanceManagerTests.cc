@@ -30,10 +30,12 @@
 #include <gmock/gmock.h>
 #include <Dataflow/Engine/Controller/ProvenanceItem.h>
 #include <Dataflow/Engine/Controller/ProvenanceManager.h>
+#include <Dataflow/Engine/Controller/Tests/MockNetworkDelta.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Dataflow::Engine;
 using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Dataflow::Engine::Mocks;
 using ::testing::_;
 using ::testing::Eq;
 using ::testing::NiceMock;
@@ -269,3 +271,131 @@ TEST_F(ProvenanceManagerTests, LoadFileSetsInitialState)
   EXPECT_CALL(*controller_, loadNetwork("initial")).Times(1);
   manager.undo();
 }
+
+class DeltaProvenanceManagerTests : public ProvenanceManagerTests
+{
+protected:
+  // moves a module to (1,1) and back to (0,0); no network snapshot
+  class DeltaItem : public ProvenanceItem<std::string>
+  {
+  public:
+    DeltaItem(const std::string& name, bool canUndo) : name_(name), canUndo_(canUndo) {}
+    std::string name() const override { return name_; }
+    std::string memento() const override { return ""; }
+    bool hasMemento() const override { return false; }
+    bool applyForward(NetworkDeltaInterface& network) const override { return network.moveModule(ModuleId(name_), 1, 1); }
+    bool applyInverse(NetworkDeltaInterface& network) const override { return canUndo_ && network.moveModule(ModuleId(name_), 0, 0); }
+  private:
+    std::string name_;
+    bool canUndo_;
+  };
+
+  ProvenanceItem<std::string>::Handle delta(const std::string& name, bool canUndo = true)
+  {
+    return ProvenanceItem<std::string>::Handle(new DeltaItem(name, canUndo));
+  }
+
+  NiceMock<MockNetworkDelta> delta_;
+};
+
+TEST_F(DeltaProvenanceManagerTests, DeltaItemsAreAppliedInPlace)
+{
+  ProvenanceManager<std::string> manager(controller_.get(), &delta_);
+
+  manager.addItem(delta("m1"));
+  manager.addItem(delta("m2"));
+
+  EXPECT_CALL(*controller_, clear()).Times(0);
+  EXPECT_CALL(*controller_, loadNetwork(_)).Times(0);
+  EXPECT_CALL(delta_, moveModule(ModuleId("m2"), 0, 0)).WillOnce(Return(true));
+  auto undone = manager.undo();
+  EXPECT_EQ("m2", undone->name());
+
+  EXPECT_CALL(delta_, moveModule(ModuleId("m2"), 1, 1)).WillOnce(Return(true));
+  auto redone = manager.redo();
+  EXPECT_EQ("m2", redone->name());
+  EXPECT_EQ(2, manager.undoSize());
+  EXPECT_EQ(0, manager.redoSize());
+}
+
+TEST_F(DeltaProvenanceManagerTests, SavesCheckpointEveryIntervalDeltaItems)
+{
+  ProvenanceManager<std::string> manager(controller_.get(), &delta_);
+  manager.setCheckpointInterval(2);
+
+  EXPECT_CALL(*controller_, saveNetwork()).WillOnce(Return("after m2"));
+  manager.addItem(delta("m1"));
+  manager.addItem(delta("m2"));
+  manager.addItem(delta("m3", false));
+
+  // m3 cannot be undone in place: reload the checkpoint taken after m2, nothing to replay
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("after m2")).Times(1);
+  EXPECT_CALL(delta_, moveModule(_, _, _)).Times(0);
+  manager.undo();
+}
+
+TEST_F(DeltaProvenanceManagerTests, FallbackReplaysDeltasAfterNearestSnapshot)
+{
+  ProvenanceManager<std::string> manager(controller_.get(), &delta_);
+  manager.setInitialState("initial");
+
+  manager.addItem(delta("m1"));
+  manager.addItem(delta("m2", false));
+
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("initial")).Times(1);
+  EXPECT_CALL(delta_, moveModule(ModuleId("m1"), 1, 1)).WillOnce(Return(true));
+  manager.undo();
+}
+
+TEST_F(DeltaProvenanceManagerTests, WithoutDeltaTargetEveryDeltaItemIsCheckpointed)
+{
+  ProvenanceManager<std::string> manager(controller_.get());
+
+  EXPECT_CALL(*controller_, saveNetwork()).WillOnce(Return("after m1")).WillOnce(Return("after m2"));
+  manager.addItem(delta("m1"));
+  manager.addItem(delta("m2"));
+
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("after m1")).Times(1);
+  manager.undo();
+}
+
+TEST_F(DeltaProvenanceManagerTests, HistoryIsBoundedByMaxItems)
+{
+  ProvenanceManager<std::string> manager(controller_.get(), &delta_);
+  manager.setInitialState("initial");
+  manager.setMaxItems(2);
+
+  manager.addItem(delta("m1"));
+  manager.addItem(delta("m2"));
+  manager.addItem(delta("m3"));
+
+  EXPECT_EQ(2, manager.undoSize());
+
+  // m1 fell off the front, but its delta is still replayed on top of the initial state
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("initial")).Times(1);
+  EXPECT_CALL(delta_, moveModule(ModuleId("m1"), 1, 1)).WillOnce(Return(true));
+  auto undone = manager.undoAll();
+  EXPECT_EQ(2, undone.size());
+  EXPECT_EQ(2, manager.redoSize());
+}
+
+TEST_F(DeltaProvenanceManagerTests, TrimmingPastSnapshotMovesInitialState)
+{
+  ProvenanceManager<std::string> manager(controller_.get(), &delta_);
+  manager.setInitialState("initial");
+  manager.setMaxItems(1);
+
+  manager.addItem(item("1"));
+  manager.addItem(delta("m2"));
+
+  EXPECT_EQ(1, manager.undoSize());
+
+  EXPECT_CALL(*controller_, clear()).Times(1);
+  EXPECT_CALL(*controller_, loadNetwork("1")).Times(1);
+  EXPECT_CALL(delta_, moveModule(_, _, _)).Times(0);
+  manager.undoAll();
+}
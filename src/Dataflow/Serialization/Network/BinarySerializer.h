@@ -0,0 +1,115 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef CORE_SERIALIZATION_NETWORK_BINARY_SERIALIZER_H
+#define CORE_SERIALIZATION_NETWORK_BINARY_SERIALIZER_H
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+#include <Dataflow/Serialization/Network/share.h>
+
+namespace SCIRun {
+namespace Dataflow {
+namespace Networks {
+
+  /// Compact counterpart of XMLSerializer. It runs the same serialize() functions through
+  /// a boost binary archive, so class versions (e.g. NetworkFile) are shared with the XML
+  /// format. Snapshots are meant for fast reloading on the machine that wrote them; the
+  /// archive is not portable across platforms with different endianness or type sizes.
+  namespace BinarySerializer
+  {
+    constexpr char magic[] = "SCIRunBinaryNetwork";
+    constexpr uint32_t formatVersion = 1;
+
+    /// True if the stream starts with a binary snapshot header. The read position is restored.
+    inline bool is_binary(std::istream& istr)
+    {
+      if (!istr.good())
+        return false;
+      const auto start = istr.tellg();
+      char header[sizeof(magic)] = {};
+      istr.read(header, sizeof(header));
+      const bool match = istr.gcount() == sizeof(header) && std::equal(header, header + sizeof(header), magic);
+      istr.clear();
+      istr.seekg(start);
+      return match;
+    }
+
+    template <class Serializable>
+    bool save_binary(const Serializable& data, std::ostream& ostr)
+    {
+      if (!ostr.good())
+        return false;
+      ostr.write(magic, sizeof(magic));
+      ostr.write(reinterpret_cast<const char*>(&formatVersion), sizeof(formatVersion));
+      boost::archive::binary_oarchive oa(ostr);
+      oa << data;
+      return ostr.good();
+    }
+
+    template <class Serializable>
+    bool save_binary(const Serializable& data, const std::string& filename)
+    {
+      std::ofstream ofs(filename.c_str(), std::ios::binary);
+      if (!ofs)
+        return false;
+      return save_binary(data, ofs);
+    }
+
+    template <class Serializable>
+    boost::shared_ptr<Serializable> load_binary(std::istream& istr)
+    {
+      if (!is_binary(istr))
+        return nullptr;
+      istr.seekg(sizeof(magic), std::ios::cur);
+      uint32_t version = 0;
+      istr.read(reinterpret_cast<char*>(&version), sizeof(version));
+      if (!istr.good() || version > formatVersion)
+        return nullptr;
+      boost::archive::binary_iarchive ia(istr);
+      auto nh = boost::make_shared<Serializable>();
+      ia >> *nh;
+      return nh;
+    }
+
+    template <class Serializable>
+    boost::shared_ptr<Serializable> load_binary(const std::string& filename)
+    {
+      std::ifstream ifs(filename.c_str(), std::ios::binary);
+      return load_binary<Serializable>(ifs);
+    }
+  }
+}}}
+
+#endif
@@ -28,7 +28,9 @@
 
 #include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 #include <Dataflow/Serialization/Network/XMLSerializer.h>
+#include <Dataflow/Serialization/Network/BinarySerializer.h>
 #include <boost/filesystem/operations.hpp>
+#include <boost/algorithm/string/predicate.hpp>
 
 using namespace SCIRun::Dataflow::Networks;
 
@@ -88,3 +90,22 @@ ToolkitFile SCIRun::Dataflow::Networks::makeToolkitFromDirectory(const boost::fi
   }
   return toolkit;
 }
+
+const char* const SCIRun::Dataflow::Networks::BinaryNetworkFileExtension = ".srn5b";
+
+NetworkFileHandle SCIRun::Dataflow::Networks::readNetworkFile(const std::string& filename)
+{
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    if (BinarySerializer::is_binary(ifs))
+      return BinarySerializer::load_binary<NetworkFile>(ifs);
+  }
+  return XMLSerializer::load_xml<NetworkFile>(filename);
+}
+
+bool SCIRun::Dataflow::Networks::writeNetworkFile(const NetworkFile& file, const std::string& filename)
+{
+  if (boost::algorithm::ends_with(filename, BinaryNetworkFileExtension))
+    return BinarySerializer::save_binary(file, filename);
+  return XMLSerializer::save_xml(file, filename, "networkFile");
+}
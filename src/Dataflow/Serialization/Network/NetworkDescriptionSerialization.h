@@ -187,6 +187,15 @@ namespace Networks {
 
   SCISHARE ToolkitFile makeToolkitFromDirectory(const boost::filesystem::path& toolkitPath);
 
+  /// Extension that selects the binary snapshot format when saving a network.
+  SCISHARE extern const char* const BinaryNetworkFileExtension;
+
+  /// Loads a network file in either format: binary snapshots are detected by their header,
+  /// anything else is read as XML.
+  SCISHARE NetworkFileHandle readNetworkFile(const std::string& filename);
+  /// Saves as a binary snapshot if filename ends with BinaryNetworkFileExtension, otherwise as XML.
+  SCISHARE bool writeNetworkFile(const NetworkFile& file, const std::string& filename);
+
   template <class Value>
   std::map<std::string, Value> remapIdBasedContainer(const std::map<std::string, Value>& keyedByOriginalId, const std::map<std::string, std::string>& idMapping)
   {
@@ -42,13 +42,16 @@
 #include <Dataflow/State/SimpleMapModuleState.h>
 #include <Dataflow/Engine/Controller/NetworkEditorController.h>
 #include <Dataflow/Serialization/Network/XMLSerializer.h>
+#include <Dataflow/Serialization/Network/BinarySerializer.h>
 #include <Dataflow/Engine/Scheduler/DesktopExecutionStrategyFactory.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Base/VariableHelper.h>
 #include <Core/Datatypes/Tests/MatrixTestCases.h>
 #include <Modules/Math/CreateMatrix.h>
 #include <Core/ConsoleApplication/ConsoleCommands.h>
 #include <Core/ConsoleApplication/ConsoleCommandFactory.h>
 #include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/MatrixTestUtilities.h>
 #include <Dataflow/Network/Network.h>
 
 using namespace SCIRun;
@@ -63,6 +66,7 @@ using namespace SCIRun::Dataflow::State;
 using namespace SCIRun::Core::Algorithms;
 
 #include <boost/assign.hpp>
+#include <boost/filesystem/operations.hpp>
 
 using namespace SCIRun::Dataflow::Networks;
 using namespace boost::assign;
@@ -350,6 +354,142 @@ TEST(SerializeNetworkTest, FullTestWithDynamicPorts)
   EXPECT_NE(net.get(), deserialized.get());
 }
 
+namespace
+{
+  // Builds a network file with every section filled in, module state of all value types,
+  // and a chain of connections, to stand in for large generated networks.
+  NetworkFile generatedNetworkFile(int numModules, int stateEntriesPerModule)
+  {
+    NetworkFile file;
+    for (int i = 0; i < numModules; ++i)
+    {
+      const std::string id = "CreateMatrix:" + std::to_string(i);
+      ModuleLookupInfoXML info;
+      info.module_name_ = "CreateMatrix";
+      info.category_name_ = "Math";
+      info.package_name_ = "SCIRun";
+
+      SimpleMapModuleStateXML state;
+      for (int s = 0; s < stateEntriesPerModule; ++s)
+      {
+        const std::string key = "Parameter" + std::to_string(s);
+        switch (s % 6)
+        {
+          case 0: state.setValue(AlgorithmParameterName(key), i * s); break;
+          case 1: state.setValue(AlgorithmParameterName(key), 0.1 * i + s); break;
+          case 2: state.setValue(AlgorithmParameterName(key), std::string(64, static_cast<char>('a' + s % 26))); break;
+          case 3: state.setValue(AlgorithmParameterName(key), (i + s) % 2 == 0); break;
+          case 4: state.setValue(AlgorithmParameterName(key), AlgoOption("first", { "first", "second" })); break;
+          case 5: state.setValue(AlgorithmParameterName(key), Variable::List{ makeVariable("x", 1.5), makeVariable("y", std::string("list")) }); break;
+        }
+      }
+      file.network.modules[id] = ModuleWithState(info, state);
+      file.modulePositions.modulePositions[id] = std::make_pair(10.0 * i, -2.5 * i);
+      file.moduleTags.tags[id] = i % 10;
+      if (i % 7 == 0)
+        file.moduleNotes.notes[id] = NoteXML("<p>note " + std::to_string(i) + "</p>", i % 4, "note", 14);
+
+      if (i > 0)
+      {
+        ConnectionDescriptionXML conn;
+        conn.out_.moduleId_ = ModuleId("CreateMatrix", i - 1);
+        conn.in_.moduleId_ = ModuleId("CreateMatrix", i);
+        conn.out_.portId_ = PortId(0, "EntireMatrix");
+        conn.in_.portId_ = PortId(0, "InputMatrix");
+        file.network.connections.push_back(conn);
+      }
+    }
+    file.moduleTags.labels[3] = "three";
+    file.moduleTags.showTagGroupsOnLoad = true;
+    file.disabledComponents.disabledModules.push_back("CreateMatrix:1");
+    file.subnetworks.subnets["Subnet:0"] = { "CreateMatrix:0", "CreateMatrix:1" };
+    return file;
+  }
+
+  std::string toXml(const NetworkFile& file)
+  {
+    std::ostringstream ostr;
+    XMLSerializer::save_xml(file, ostr, "networkFile");
+    return ostr.str();
+  }
+}
+
+TEST(SerializeNetworkTest, BinaryRoundTripMatchesXml)
+{
+  auto file = generatedNetworkFile(20, 12);
+
+  std::stringstream binary;
+  ASSERT_TRUE(BinarySerializer::save_binary(file, binary));
+  EXPECT_TRUE(BinarySerializer::is_binary(binary));
+
+  auto readIn = BinarySerializer::load_binary<NetworkFile>(binary);
+  ASSERT_TRUE(readIn.get() != nullptr);
+  EXPECT_EQ(toXml(file), toXml(*readIn));
+
+  std::istringstream xml(toXml(file));
+  EXPECT_FALSE(BinarySerializer::is_binary(xml));
+  EXPECT_TRUE(BinarySerializer::load_binary<NetworkFile>(xml) == nullptr);
+}
+
+TEST(SerializeNetworkTest, ReadNetworkFileDetectsFormat)
+{
+  auto file = generatedNetworkFile(5, 6);
+  const auto dir = boost::filesystem::temp_directory_path();
+  const auto xmlFile = (dir / "binaryRoundTrip.srn5").string();
+  const auto binaryFile = (dir / ("binaryRoundTrip" + std::string(BinaryNetworkFileExtension))).string();
+
+  const bool wroteXml = writeNetworkFile(file, xmlFile);
+  const bool wroteBinary = writeNetworkFile(file, binaryFile);
+  bool detectedBinary;
+  {
+    std::ifstream written(binaryFile, std::ios::binary);
+    detectedBinary = BinarySerializer::is_binary(written);
+  }
+  auto fromXml = readNetworkFile(xmlFile);
+  auto fromBinary = readNetworkFile(binaryFile);
+  boost::filesystem::remove(xmlFile);
+  boost::filesystem::remove(binaryFile);
+
+  ASSERT_TRUE(wroteXml);
+  ASSERT_TRUE(wroteBinary);
+  EXPECT_TRUE(detectedBinary);
+  ASSERT_TRUE(fromXml.get() != nullptr);
+  ASSERT_TRUE(fromBinary.get() != nullptr);
+  EXPECT_EQ(toXml(file), toXml(*fromXml));
+  EXPECT_EQ(toXml(file), toXml(*fromBinary));
+}
+
+/// todo: switch this disabled test to nightly mode. It times saving and loading a
+/// 1000 module network as xml versus binary.
+TEST(SerializeNetworkTest, DISABLED_BinaryVersusXmlTimingOnLargeNetwork)
+{
+  auto file = generatedNetworkFile(1000, 30);
+
+  std::stringstream xml, binary;
+  NetworkFileHandle fromXml, fromBinary;
+  {
+    TestUtils::ScopedTimer t("save xml");
+    XMLSerializer::save_xml(file, xml, "networkFile");
+  }
+  {
+    TestUtils::ScopedTimer t("load xml");
+    fromXml = XMLSerializer::load_xml<NetworkFile>(xml);
+  }
+  {
+    TestUtils::ScopedTimer t("save binary");
+    BinarySerializer::save_binary(file, binary);
+  }
+  {
+    TestUtils::ScopedTimer t("load binary");
+    fromBinary = BinarySerializer::load_binary<NetworkFile>(binary);
+  }
+
+  EXPECT_LT(binary.str().size(), xml.str().size());
+  ASSERT_TRUE(fromXml.get() != nullptr);
+  ASSERT_TRUE(fromBinary.get() != nullptr);
+  EXPECT_EQ(toXml(*fromXml), toXml(*fromBinary));
+}
+
 TEST(ToolkitSerializationTest, Experimenting)
 {
   ToolkitFile toolkit;
@@ -273,7 +273,7 @@ FileOpenCommand::FileOpenCommand()
 
 NetworkFileHandle FileOpenCommand::processXmlFile(const std::string& filename)
 {
-  return XMLSerializer::load_xml<NetworkFile>(filename);
+  return readNetworkFile(filename);
 }
 
 FileImportCommand::FileImportCommand()
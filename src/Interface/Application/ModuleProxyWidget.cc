@@ -459,7 +459,7 @@ void ModuleProxyWidget::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
     if (position_ != pos())
     {
       snapToGrid();
-      Q_EMIT widgetMoved(ModuleId(module_->getModuleId()), pos().x(), pos().y());
+      Q_EMIT widgetMoved(ModuleId(module_->getModuleId()), position_.x(), position_.y(), pos().x(), pos().y());
     }
     QGraphicsItem::mouseReleaseEvent(event);
   }
@@ -100,7 +100,7 @@ NetworkEditor::NetworkEditor(const NetworkEditorParameters& params, QWidget* par
   NetworkEditorPythonAPI::setExecutionContext(this);
 #endif
 
-  connect(this, SIGNAL(moduleMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double)), this, SLOT(redrawTagGroups()));
+  connect(this, SIGNAL(moduleMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double, double, double)), this, SLOT(redrawTagGroups()));
 
   setObjectName(QString::fromUtf8("networkEditor_"));
   setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
@@ -495,8 +495,8 @@ ModuleProxyWidget* NetworkEditor::setupModuleWidget(ModuleWidget* module)
 
   connect(scene_, SIGNAL(selectionChanged()), proxy, SLOT(highlightIfSelected()));
   connect(proxy, SIGNAL(selected()), this, SLOT(bringToFront()));
-  connect(proxy, SIGNAL(widgetMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double)), this, SIGNAL(modified()));
-  connect(proxy, SIGNAL(widgetMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double)), this, SIGNAL(moduleMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double)));
+  connect(proxy, SIGNAL(widgetMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double, double, double)), this, SIGNAL(modified()));
+  connect(proxy, SIGNAL(widgetMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double, double, double)), this, SIGNAL(moduleMoved(const SCIRun::Dataflow::Networks::ModuleId&, double, double, double, double)));
   connect(this, SIGNAL(snapToModules()), proxy, SLOT(snapToGrid()));
   connect(this, SIGNAL(highlightPorts(int)), proxy, SLOT(highlightPorts(int)));
   connect(this, SIGNAL(resetModulesDueToCycle()), module, SLOT(changeExecuteButtonToPlay()));
@@ -890,7 +890,7 @@ void NetworkEditor::dropEvent(QDropEvent* event)
     {
       auto file = urls[0].toLocalFile();
       QFileInfo check_file(file);
-      if (check_file.exists() && check_file.isFile() && file.endsWith("srn5"))
+      if (check_file.exists() && check_file.isFile() && (file.endsWith("srn5") || file.endsWith("srn5b")))
       {
         Q_EMIT requestLoadNetwork(file);
         return;
@@ -1693,6 +1693,72 @@ void NetworkEditor::appendToNetwork(const NetworkFileHandle& xml)
   setSceneRect(QRectF());
 }
 
+NetworkFileHandle NetworkEditor::saveModuleFragment(const ModuleId& id) const
+{
+  if (!findById(scene_->items(), id.id_))
+    return nullptr;
+  return controller_->serializeNetworkFragment([&id](ModuleHandle mod) { return mod->id() == id; },
+    [](const ConnectionDescription&) { return false; });
+}
+
+bool NetworkEditor::insertModules(const NetworkFileHandle& fragment)
+{
+  auto originalItems = scene_->items();
+  fileLoading_ = true;
+  auto inserted = controller_->insertModules(fragment);
+  fileLoading_ = false;
+
+  Q_FOREACH(QGraphicsItem* item, scene_->items())
+  {
+    if (!originalItems.contains(item))
+    {
+      if (auto w = dynamic_cast<ModuleProxyWidget*>(item))
+        w->getModuleWidget()->postLoadAction();
+    }
+  }
+  return inserted;
+}
+
+bool NetworkEditor::eraseModule(const ModuleId& id)
+{
+  if (!findById(scene_->items(), id.id_))
+    return false;
+  controller_->removeModule(id);
+  return true;
+}
+
+bool NetworkEditor::insertConnection(const ConnectionDescription& desc)
+{
+  return controller_->insertConnection(desc);
+}
+
+bool NetworkEditor::eraseConnection(const ConnectionId& id)
+{
+  Q_FOREACH(QGraphicsItem* item, scene_->items())
+  {
+    if (auto conn = dynamic_cast<ConnectionLine*>(item))
+    {
+      if (conn->id() == id)
+      {
+        scene_->removeItem(conn);
+        delete conn;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool NetworkEditor::moveModule(const ModuleId& id, double x, double y)
+{
+  auto widget = findById(scene_->items(), id.id_);
+  if (!widget)
+    return false;
+  widget->setPos(x, y);
+  ensureVisible(widget);
+  return true;
+}
+
 void NetworkEditor::disableViewScenes()
 {
   Q_FOREACH(QGraphicsItem* item, scene_->items())
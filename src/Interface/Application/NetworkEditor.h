@@ -207,6 +207,7 @@ namespace Gui {
     public Dataflow::Networks::ExecutableLookup,
     public Dataflow::Networks::NetworkEditorSerializationManager,
     public Dataflow::Engine::NetworkIOInterface<Dataflow::Networks::NetworkFileHandle>,
+    public Dataflow::Engine::NetworkDeltaInterface,
     public Dataflow::Networks::ConnectionMakerService,
     public ModuleErrorDisplayer
   {
@@ -226,6 +227,13 @@ namespace Gui {
     void loadNetwork(const Dataflow::Networks::NetworkFileHandle& file) override;
     void appendToNetwork(const Dataflow::Networks::NetworkFileHandle& xml);
 
+    Dataflow::Networks::NetworkFileHandle saveModuleFragment(const Dataflow::Networks::ModuleId& id) const override;
+    bool insertModules(const Dataflow::Networks::NetworkFileHandle& fragment) override;
+    bool eraseModule(const Dataflow::Networks::ModuleId& id) override;
+    bool insertConnection(const Dataflow::Networks::ConnectionDescription& desc) override;
+    bool eraseConnection(const Dataflow::Networks::ConnectionId& id) override;
+    bool moveModule(const Dataflow::Networks::ModuleId& id, double x, double y) override;
+
     Dataflow::Networks::ModulePositionsHandle dumpModulePositions(Dataflow::Networks::ModuleFilter filter) const override;
     void updateModulePositions(const Dataflow::Networks::ModulePositions& modulePositions, bool selectAll) override;
 
@@ -382,7 +390,7 @@ namespace Gui {
     void networkExecutionFinished();
     void networkEditorMouseButtonPressed();
     void middleMouseClicked();
-    void moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double newX, double newY);
+    void moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double oldX, double oldY, double newX, double newY);
     void defaultNotePositionChanged(NotePosition position);
     void defaultNoteSizeChanged(int size);
     void snapToModules();
@@ -119,6 +119,16 @@ void NetworkEditorControllerGuiProxy::appendToNetwork(const NetworkFileHandle& x
   controller_->appendToNetwork(xml);
 }
 
+bool NetworkEditorControllerGuiProxy::insertModules(const NetworkFileHandle& fragment)
+{
+  return controller_->insertModules(fragment);
+}
+
+bool NetworkEditorControllerGuiProxy::insertConnection(const ConnectionDescription& desc)
+{
+  return controller_->insertConnection(desc);
+}
+
 void NetworkEditorControllerGuiProxy::executeAll(const ExecutableLookup& lookup)
 {
   controller_->executeAll(&lookup);
@@ -62,6 +62,8 @@ namespace Gui {
     SCIRun::Dataflow::Networks::NetworkFileHandle serializeNetworkFragment(SCIRun::Dataflow::Networks::ModuleFilter modFilter, SCIRun::Dataflow::Networks::ConnectionFilter connFilter) const;
     void loadNetwork(const SCIRun::Dataflow::Networks::NetworkFileHandle& xml);
     void appendToNetwork(const SCIRun::Dataflow::Networks::NetworkFileHandle& xml);
+    bool insertModules(const SCIRun::Dataflow::Networks::NetworkFileHandle& fragment);
+    bool insertConnection(const SCIRun::Dataflow::Networks::ConnectionDescription& desc);
     void executeAll(const SCIRun::Dataflow::Networks::ExecutableLookup& lookup);
     void executeModule(const SCIRun::Dataflow::Networks::ModuleHandle& module, const SCIRun::Dataflow::Networks::ExecutableLookup& lookup, bool executeUpstream);
     size_t numModules() const;
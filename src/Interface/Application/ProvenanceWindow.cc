@@ -31,6 +31,7 @@
 #include <Dataflow/Engine/Controller/ProvenanceManager.h>
 #include <Interface/Application/ProvenanceWindow.h>
 #include <Interface/Application/NetworkEditor.h>
+#include <Dataflow/Network/ModuleInterface.h>
 #include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 #include <Dataflow/Serialization/Network/XMLSerializer.h>
 
@@ -58,7 +59,8 @@ ProvenanceWindow::ProvenanceWindow(ProvenanceManagerHandle provenanceManager, QW
   connect(redoAllButton_, SIGNAL(clicked()), this, SLOT(redoAll()));
   connect(clearButton_, SIGNAL(clicked()), this, SLOT(clear()));
   connect(itemMaxSpinBox_, SIGNAL(valueChanged(int)), this, SLOT(setMaxItems(int)));
-  setMaxItems(10);
+  itemMaxSpinBox_->setValue(maxItems_);
+  provenanceManager_->setMaxItems(static_cast<size_t>(maxItems_));
   setUndoEnabled(false);
   setRedoEnabled(false);
 }
@@ -161,6 +163,7 @@ void ProvenanceWindow::clear()
   setRedoEnabled(false);
 
   networkXMLTextEdit_->clear();
+  Q_EMIT historyCleared();
 }
 
 void ProvenanceWindow::setMaxItems(int max)
@@ -170,10 +173,15 @@ void ProvenanceWindow::setMaxItems(int max)
 
   maxItems_ = max;
   itemMaxSpinBox_->setValue(max);
-  for (int i = 0; i < provenanceListWidget_->count() - max; ++i)
+  // the manager trims the same oldest undo items
+  while (provenanceListWidget_->count() > max && lastUndoRow_ >= 0)
   {
     delete provenanceListWidget_->takeItem(0);
+    lastUndoRow_--;
   }
+  provenanceManager_->setMaxItems(static_cast<size_t>(max));
+  if (lastUndoRow_ == -1)
+    setUndoEnabled(false);
 }
 
 void ProvenanceWindow::setUndoEnabled(bool enable)
@@ -288,29 +296,43 @@ GuiActionProvenanceConverter::GuiActionProvenanceConverter(NetworkEditor* editor
   provenanceManagerModifyingNetwork_(false)
 {}
 
-void GuiActionProvenanceConverter::moduleAdded(const std::string& name, SCIRun::Dataflow::Networks::ModuleHandle)
+void GuiActionProvenanceConverter::moduleAdded(const std::string& name, SCIRun::Dataflow::Networks::ModuleHandle module)
 {
+  const ModuleId id(module->id());
+  modules_[id.id_] = module;
   if (!provenanceManagerModifyingNetwork_)
   {
-    ProvenanceItemHandle item(boost::make_shared<ModuleAddedProvenanceItem>(name, editor_->saveNetwork()));
+    refreshModulePositions();
+    ProvenanceItemHandle item(boost::make_shared<ModuleAddedProvenanceItem>(name, id, editor_->saveModuleFragment(id)));
     Q_EMIT provenanceItemCreated(item);
   }
 }
 
 void GuiActionProvenanceConverter::moduleRemoved(const ModuleId& id)
 {
+  auto module = modules_.find(id.id_);
+  auto position = positions_.find(id.id_);
   if (!provenanceManagerModifyingNetwork_)
   {
-    ProvenanceItemHandle item(boost::make_shared<ModuleRemovedProvenanceItem>(id, editor_->saveNetwork()));
+    ProvenanceItemHandle item;
+    if (module != modules_.end() && position != positions_.end())
+      item = ModuleRemovedProvenanceItem::fromFragment(id, makeModuleFragment(module->second, position->second.first, position->second.second));
+    else
+      item = boost::make_shared<ModuleRemovedProvenanceItem>(id, editor_->saveNetwork());
     Q_EMIT provenanceItemCreated(item);
   }
+  if (module != modules_.end())
+    modules_.erase(module);
+  if (position != positions_.end())
+    positions_.erase(position);
 }
 
 void GuiActionProvenanceConverter::connectionAdded(const SCIRun::Dataflow::Networks::ConnectionDescription& cd)
 {
   if (!provenanceManagerModifyingNetwork_)
   {
-    ProvenanceItemHandle item(boost::make_shared<ConnectionAddedProvenanceItem>(cd, editor_->saveNetwork()));
+    refreshModulePositions();
+    ProvenanceItemHandle item(boost::make_shared<ConnectionAddedProvenanceItem>(cd));
     Q_EMIT provenanceItemCreated(item);
   }
 }
@@ -319,16 +341,18 @@ void GuiActionProvenanceConverter::connectionRemoved(const SCIRun::Dataflow::Net
 {
   if (!provenanceManagerModifyingNetwork_)
   {
-    ProvenanceItemHandle item(boost::make_shared<ConnectionRemovedProvenanceItem>(id, editor_->saveNetwork()));
+    refreshModulePositions();
+    ProvenanceItemHandle item(boost::make_shared<ConnectionRemovedProvenanceItem>(id));
     Q_EMIT provenanceItemCreated(item);
   }
 }
 
-void GuiActionProvenanceConverter::moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double newX, double newY)
+void GuiActionProvenanceConverter::moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double oldX, double oldY, double newX, double newY)
 {
+  positions_[id.id_] = { newX, newY };
   if (!provenanceManagerModifyingNetwork_)
   {
-    ProvenanceItemHandle item(boost::make_shared<ModuleMovedProvenanceItem>(id, newX, newY, editor_->saveNetwork()));
+    ProvenanceItemHandle item(boost::make_shared<ModuleMovedProvenanceItem>(id, oldX, oldY, newX, newY));
     Q_EMIT provenanceItemCreated(item);
   }
 }
@@ -336,4 +360,27 @@ void GuiActionProvenanceConverter::moduleMoved(const SCIRun::Dataflow::Networks:
 void GuiActionProvenanceConverter::networkBeingModifiedByProvenanceManager(bool inProgress)
 {
   provenanceManagerModifyingNetwork_ = inProgress;
+  if (!inProgress)
+    resetModuleCache();
+}
+
+void GuiActionProvenanceConverter::resetModuleCache()
+{
+  positions_ = editor_->dumpModulePositions([](ModuleHandle) { return true; })->modulePositions;
+  for (auto module = modules_.begin(); module != modules_.end();)
+  {
+    if (positions_.count(module->first) == 0)
+      module = modules_.erase(module);
+    else
+      ++module;
+  }
+}
+
+// Merges rather than replaces: a module in the middle of being deleted no longer
+// reports a position, but its last one is still needed for the undo fragment.
+void GuiActionProvenanceConverter::refreshModulePositions()
+{
+  auto current = editor_->dumpModulePositions([](ModuleHandle) { return true; });
+  for (const auto& pos : current->modulePositions)
+    positions_[pos.first] = pos.second;
 }
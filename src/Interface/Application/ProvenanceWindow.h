@@ -66,6 +66,7 @@ Q_SIGNALS:
   void undoStateChanged(bool enabled);
   void redoStateChanged(bool enabled);
   void networkModified();
+  void historyCleared();
 private:
   SCIRun::Dataflow::Engine::ProvenanceManagerHandle provenanceManager_;
   int lastUndoRow_, maxItems_{10};
@@ -86,13 +87,19 @@ public Q_SLOTS:
   void moduleRemoved(const SCIRun::Dataflow::Networks::ModuleId& id);
   void connectionAdded(const SCIRun::Dataflow::Networks::ConnectionDescription&);
   void connectionRemoved(const SCIRun::Dataflow::Networks::ConnectionId& id);
-  void moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double newX, double newY);
+  void moduleMoved(const SCIRun::Dataflow::Networks::ModuleId& id, double oldX, double oldY, double newX, double newY);
   void networkBeingModifiedByProvenanceManager(bool inProgress);
+  void resetModuleCache();
 Q_SIGNALS:
   void provenanceItemCreated(SCIRun::Dataflow::Engine::ProvenanceItemHandle item);
 private:
+  void refreshModulePositions();
   NetworkEditor* editor_;
   bool provenanceManagerModifyingNetwork_;
+  // a removed module is gone from the network and scene by the time moduleRemoved arrives,
+  // so its handle and last position are kept here to build the undo fragment.
+  std::map<std::string, SCIRun::Dataflow::Networks::ModuleHandle> modules_;
+  SCIRun::Dataflow::Networks::ModulePositions::Data positions_;
 };
 
 }
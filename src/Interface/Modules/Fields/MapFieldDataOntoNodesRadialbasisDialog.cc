@@ -28,6 +28,7 @@
 
 #include <Interface/Modules/Fields/MapFieldDataOntoNodesRadialbasisDialog.h>
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodes.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RadialBasisInterpolation.h>
 #include <Dataflow/Network/ModuleStateInterface.h>  ///TODO: extract into intermediate
 #include <Core/Logging/Log.h>
 #include <Core/Math/MiscMath.h>
@@ -47,4 +48,6 @@ MapFieldDataOntoNodesRadialbasisDialog::MapFieldDataOntoNodesRadialbasisDialog(c
   addComboBoxManager(interpolationComboBox_, Parameters::InterpolationModel);
   addDoubleSpinBoxManager(outsideValueDoubleSpinBox_, Parameters::OutsideValue);
   addDoubleLineEditManager(maximumDistanceLineEdit_, Parameters::MaxDistance);
+  addDoubleLineEditManager(supportRadiusLineEdit_, Parameters::SupportRadius);
+  addCheckBoxManager(nearestNodeCheckBox_, Parameters::DistanceToNearestNode);
 }
@@ -29,6 +29,7 @@
 #include <Interface/Modules/Inverse/SolveInverseProblemWithTSVDDialog.h>
 #include <Modules/Legacy/Inverse/SolveInverseProblemWithTSVD.h>
 #include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
 
 using namespace SCIRun::Gui;
 using namespace SCIRun::Dataflow::Networks;
@@ -61,6 +62,15 @@ SolveInverseProblemWithTSVDDialog::SolveInverseProblemWithTSVDDialog(const std::
 
   addComboBoxManager(lambdaMethodComboBox_, Parameters::RegularizationMethod, lambdaMethod_);
 
+  GuiStringTranslationMap svdMethod_;
+  svdMethod_.insert(StringPair("Full", "full"));
+  svdMethod_.insert(StringPair("Randomized", "randomized"));
+
+  addComboBoxManager(svdMethodComboBox_, SCIRun::Core::Algorithms::Math::Parameters::SVDMethod, svdMethod_);
+  addSpinBoxManager(truncationRankSpinBox_, SCIRun::Core::Algorithms::Math::Parameters::TruncationRank);
+  addSpinBoxManager(oversamplingSpinBox_, SCIRun::Core::Algorithms::Math::Parameters::Oversampling);
+  addSpinBoxManager(powerIterationsSpinBox_, SCIRun::Core::Algorithms::Math::Parameters::PowerIterations);
+
   connect(lambdaSlider_, SIGNAL(valueChanged(int)), this, SLOT(setSpinBoxValue(int)));
   connect(lambdaSliderDoubleSpinBox_, SIGNAL(valueChanged(double)), this, SLOT(setSliderValue(double)));
   connect(lambdaMinDoubleSpinBox_, SIGNAL(valueChanged(double)), this, SLOT(setSliderMin(double)));
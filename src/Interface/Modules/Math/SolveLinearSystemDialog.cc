@@ -28,6 +28,7 @@
 
 #include <Interface/Modules/Math/SolveLinearSystemDialog.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
 #include <Core/Logging/Log.h>
 #include <Dataflow/Network/ModuleStateInterface.h>  //TODO: extract into intermediate
 
@@ -50,9 +51,11 @@ namespace SCIRun {
       SolveLinearSystemDialogImpl()
       {
         solverNameLookup_.insert(StringPair("Conjugate Gradient (SCI)", "cg"));
+        solverNameLookup_.insert(StringPair("Pipelined Conjugate Gradient (SCI)", "pipecg"));
         solverNameLookup_.insert(StringPair("BiConjugate Gradient (SCI)", "bicg"));
         solverNameLookup_.insert(StringPair("Jacobi (SCI)", "jacobi"));
         solverNameLookup_.insert(StringPair("MINRES (SCI)", "minres"));
+        solverNameLookup_.insert(StringPair("Sparse Direct LDLT (Eigen)", "ldlt"));
       }
       GuiStringTranslationMap solverNameLookup_;
     };
@@ -103,5 +106,6 @@ SolveLinearSystemDialog::SolveLinearSystemDialog(const std::string& name, Module
 #endif
 
   addComboBoxManager(preconditionerComboBox_, Variables::Preconditioner);
+  addComboBoxManager(precisionComboBox_, Core::Algorithms::Math::Parameters::SolverPrecision);
   addComboBoxManager(methodComboBox_, Variables::Method, impl_->solverNameLookup_);
 }
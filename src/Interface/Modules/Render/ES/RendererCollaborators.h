@@ -46,28 +46,6 @@ namespace SCIRun
       explicit FatalRendererError(const std::string& message) : std::runtime_error(message) {}
     };
 
-    class SCISHARE DepthIndex
-    {
-    public:
-      size_t mIndex;
-      double mDepth;
-
-      DepthIndex() :
-        mIndex(0),
-        mDepth(0.0)
-      {}
-
-      DepthIndex(size_t index, double depth) :
-        mIndex(index),
-        mDepth(depth)
-      {}
-
-      bool operator<(const DepthIndex& di) const
-      {
-        return this->mDepth < di.mDepth;
-      }
-    };
-
     class SCISHARE SRObject
     {
     public:
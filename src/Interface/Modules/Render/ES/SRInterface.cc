@@ -832,9 +832,6 @@ glm::vec2 ScreenParams::positionFromClick(int x, int y) const
 
           DEBUG_LOG_LINE_INFO
           RENDERER_LOG("Add vertex buffer objects.");
-          std::vector<char*> vbo_buffer;
-          std::vector<size_t> stride_vbo;
-
           int nameIndex = 0;
           for (auto it = obj->vbos().cbegin(); it != obj->vbos().cend(); ++it, ++nameIndex)
           {
@@ -852,21 +849,13 @@ glm::vec2 ScreenParams::positionFromClick(int x, int y) const
               vboMan->addInMemoryVBO(vbo.data->getBuffer(), vbo.data->getBufferSize(), attributeData, vbo.name);
             }
 
-            vbo_buffer.push_back(reinterpret_cast<char*>(vbo.data->getBuffer()));
-            size_t stride = 0;
-            for (auto a : vbo.attributes)
-              stride += a.sizeInBytes;
-            stride_vbo.push_back(stride);
-
             bbox.extend(vbo.boundingBox);
           }
 
           DEBUG_LOG_LINE_INFO
           RENDERER_LOG("Add index buffer objects.");
-          nameIndex = 0;
-          for (auto it = obj->ibos().cbegin(); it != obj->ibos().cend(); ++it, ++nameIndex)
+          for (const auto& ibo : obj->ibos())
           {
-            const auto& ibo = *it;
             GLenum primType = GL_UNSIGNED_SHORT;
             switch (ibo.indexSize)
             {
@@ -908,96 +897,9 @@ glm::vec2 ScreenParams::positionFromClick(int x, int y) const
                 break;
             }
 
-            if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
-            {
-              RENDERER_LOG("Create sorted lists of Buffers for transparency in each direction of the axis.");
-              uint32_t* ibo_buffer = reinterpret_cast<uint32_t*>(ibo.data->getBuffer());
-              size_t num_triangles = ibo.data->getBufferSize() / (sizeof(uint32_t) * 3);
-              Vector dir(0.0, 0.0, 0.0);
-
-              std::vector<DepthIndex> rel_depth(num_triangles);
-              for (int i = 0; i <= 6; ++i)
-              {
-                std::string name = ibo.name;
-                if (i == 0)
-                {
-                  int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
-                  iboMan->addInMemoryIBO(ibo.data->getBuffer(),
-                    ibo.data->getBufferSize(), primitive, primType,
-                    numPrimitives, ibo.name);
-                }
-                if (i == 1)
-                {
-                  dir = Vector(1.0, 0.0, 0.0);
-                  name += "X";
-                }
-                if (i == 2)
-                {
-                  dir = Vector(0.0, 1.0, 0.0);
-                  name += "Y";
-                }
-                if (i == 3)
-                {
-                  dir = Vector(0.0, 0.0, 1.0);
-                  name += "Z";
-                }
-                if (i == 4)
-                {
-                  dir = Vector(-1.0, 0.0, 0.0);
-                  name += "NegX";
-                }
-                if (i == 5)
-                {
-                  dir = Vector(0.0, -1.0, 0.0);
-                  name += "NegY";
-                }
-                if (i == 6)
-                {
-                  dir = Vector(0.0, 0.0, -1.0);
-                  name += "NegZ";
-                }
-                if (i > 0)
-                {
-                  for (size_t j = 0; j < num_triangles; j++)
-                  {
-                    float* vertex1 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3]));
-                    Point node1(vertex1[0], vertex1[1], vertex1[2]);
-
-                    float* vertex2 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3 + 1]));
-                    Point node2(vertex2[0], vertex2[1], vertex2[2]);
-
-                    float* vertex3 = reinterpret_cast<float*>(vbo_buffer[nameIndex] + stride_vbo[nameIndex] * (ibo_buffer[j * 3 + 2]));
-                    Point node3(vertex3[0], vertex3[1], vertex3[2]);
-
-                    rel_depth[j].mDepth = Dot(dir, node1) + Dot(dir, node2) + Dot(dir, node3);
-                    rel_depth[j].mIndex = j;
-                  }
-
-                  std::sort(rel_depth.begin(), rel_depth.end());
-
-                  int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
-
-                  std::vector<char> sorted_buffer(ibo.data->getBufferSize());
-                  char* ibuffer = reinterpret_cast<char*>(ibo.data->getBuffer());
-                  char* sbuffer = !sorted_buffer.empty() ? reinterpret_cast<char*>(&sorted_buffer[0]) : nullptr;
-
-                  if (sbuffer && num_triangles > 0)
-                  {
-                    size_t tri_size = ibo.data->getBufferSize() / num_triangles;
-                    for (size_t j = 0; j < num_triangles; j++)
-                    {
-                      memcpy(sbuffer + j * tri_size, ibuffer + rel_depth[j].mIndex * tri_size, tri_size);
-                    }
-                    iboMan->addInMemoryIBO(sbuffer, ibo.data->getBufferSize(), primitive, primType, numPrimitives, name);
-                  }
-                }
-              }
-            }
-            else
-            {
-              int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
-              iboMan->addInMemoryIBO(ibo.data->getBuffer(), ibo.data->getBufferSize(), primitive, primType, numPrimitives, ibo.name);
-            }
+            // Transparent triangles are depth-sorted per view by RenderTransBasicSys.
+            int numPrimitives = ibo.data->getBufferSize() / ibo.indexSize;
+            iboMan->addInMemoryIBO(ibo.data->getBuffer(), ibo.data->getBufferSize(), primitive, primType, numPrimitives, ibo.name);
           }
 
           RENDERER_LOG("Add default identity transform to the object globally (instead of per-pass)");
@@ -1025,31 +927,7 @@ glm::vec2 ScreenParams::positionFromClick(int x, int y) const
               if (pass.renderType == RenderType::RENDER_VBO_IBO)
               {
                 addVBOToEntity(entityID, pass.vboName);
-                if (mRenderSortType == RenderState::TransparencySortType::LISTS_SORT)
-                {
-                  for (int i = 0; i <= 6; ++i)
-                  {
-                    std::string name = pass.iboName;
-                    if (i == 1)
-                      name += "X";
-                    if (i == 2)
-                      name += "Y";
-                    if (i == 3)
-                      name += "Z";
-                    if (i == 4)
-                      name += "NegX";
-                    if (i == 5)
-                      name += "NegY";
-                    if (i == 6)
-                      name += "NegZ";
-
-                    addIBOToEntity(entityID, name);
-                  }
-                }
-                else
-                {
-                  addIBOToEntity(entityID, pass.iboName);
-                }
+                addIBOToEntity(entityID, pass.iboName);
                 RENDERER_LOG("add texture");
                 addTextToEntity(entityID, pass.text);
                 addTextureToEntity(entityID, pass.texture);
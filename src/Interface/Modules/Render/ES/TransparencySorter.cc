@@ -0,0 +1,268 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Interface/Modules/Render/ES/TransparencySorter.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace SCIRun::Render;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+
+namespace
+{
+  const int RadixBits = 8;
+  const int RadixBuckets = 1 << RadixBits;
+
+  // Below this many triangles threading costs more than it saves.
+  const size_t ParallelSortThreshold = 1 << 14;
+
+  struct SortKey
+  {
+    uint32_t key;
+    uint32_t triangle;
+  };
+
+  void radixSort(std::vector<SortKey>& keys, int numProcs)
+  {
+    const size_t n = keys.size();
+    std::vector<SortKey> scratch(n);
+    std::vector<std::array<size_t, RadixBuckets>> counts(numProcs);
+    auto chunkBegin = [&](int proc) { return proc * n / numProcs; };
+
+    for (int shift = 0; shift < 32; shift += RadixBits)
+    {
+      Parallel::RunTasks([&](int proc)
+      {
+        auto& count = counts[proc];
+        count.fill(0);
+        for (size_t i = chunkBegin(proc); i < chunkBegin(proc + 1); ++i)
+          ++count[(keys[i].key >> shift) & (RadixBuckets - 1)];
+      }, numProcs);
+
+      // Every key has the same digit: this pass would not move anything.
+      bool trivial = false;
+      for (int b = 0; b < RadixBuckets && !trivial; ++b)
+      {
+        size_t total = 0;
+        for (int proc = 0; proc < numProcs; ++proc)
+          total += counts[proc][b];
+        trivial = total == n;
+      }
+      if (trivial)
+        continue;
+
+      // Exclusive prefix over (bucket, chunk) keeps the scatter stable.
+      size_t offset = 0;
+      for (int b = 0; b < RadixBuckets; ++b)
+      {
+        for (int proc = 0; proc < numProcs; ++proc)
+        {
+          const auto c = counts[proc][b];
+          counts[proc][b] = offset;
+          offset += c;
+        }
+      }
+
+      Parallel::RunTasks([&](int proc)
+      {
+        auto& next = counts[proc];
+        for (size_t i = chunkBegin(proc); i < chunkBegin(proc + 1); ++i)
+          scratch[next[(keys[i].key >> shift) & (RadixBuckets - 1)]++] = keys[i];
+      }, numProcs);
+      keys.swap(scratch);
+    }
+  }
+}
+
+void SCIRun::Render::sortTrianglesByDepth(const char* vbo, size_t vboStride,
+  const uint32_t* ibo, size_t numTriangles, const Vector& dir, uint32_t* sorted)
+{
+  if (numTriangles == 0)
+    return;
+
+  const int numProcs = numTriangles < ParallelSortThreshold ? 1
+    : static_cast<int>(std::max(1u, Parallel::NumCores()));
+  auto chunkBegin = [&](int proc) { return proc * numTriangles / numProcs; };
+
+  const float dx = static_cast<float>(dir.x());
+  const float dy = static_cast<float>(dir.y());
+  const float dz = static_cast<float>(dir.z());
+
+  std::vector<float> depth(numTriangles);
+  std::vector<float> lowest(numProcs, std::numeric_limits<float>::max());
+  std::vector<float> highest(numProcs, -std::numeric_limits<float>::max());
+  Parallel::RunTasks([&](int proc)
+  {
+    for (size_t t = chunkBegin(proc); t < chunkBegin(proc + 1); ++t)
+    {
+      float d = 0;
+      for (int v = 0; v < 3; ++v)
+      {
+        const auto* p = reinterpret_cast<const float*>(vbo + vboStride * ibo[3 * t + v]);
+        d += dx * p[0] + dy * p[1] + dz * p[2];
+      }
+      depth[t] = d;
+      lowest[proc] = std::min(lowest[proc], d);
+      highest[proc] = std::max(highest[proc], d);
+    }
+  }, numProcs);
+
+  const double low = *std::min_element(lowest.begin(), lowest.end());
+  const double high = *std::max_element(highest.begin(), highest.end());
+  const double scale = high > low ? std::numeric_limits<uint32_t>::max() / (high - low) : 0;
+
+  std::vector<SortKey> keys(numTriangles);
+  Parallel::RunTasks([&](int proc)
+  {
+    for (size_t t = chunkBegin(proc); t < chunkBegin(proc + 1); ++t)
+    {
+      keys[t].key = static_cast<uint32_t>(std::min((depth[t] - low) * scale,
+        static_cast<double>(std::numeric_limits<uint32_t>::max())));
+      keys[t].triangle = static_cast<uint32_t>(t);
+    }
+  }, numProcs);
+
+  radixSort(keys, numProcs);
+
+  Parallel::RunTasks([&](int proc)
+  {
+    for (size_t t = chunkBegin(proc); t < chunkBegin(proc + 1); ++t)
+    {
+      const auto* from = ibo + 3 * static_cast<size_t>(keys[t].triangle);
+      std::copy(from, from + 3, sorted + 3 * t);
+    }
+  }, numProcs);
+}
+
+ViewDependentTriangleSorter::ViewDependentTriangleSorter(std::shared_ptr<spire::VarBuffer> vbo, size_t vboStride,
+  std::shared_ptr<spire::VarBuffer> ibo) : vbo_(vbo), ibo_(ibo), stride_(vboStride)
+{
+}
+
+ViewDependentTriangleSorter::~ViewDependentTriangleSorter()
+{
+  if (pending_.valid())
+    pending_.wait();
+}
+
+size_t ViewDependentTriangleSorter::bufferSize() const
+{
+  return ibo_->getBufferSize();
+}
+
+bool ViewDependentTriangleSorter::collect()
+{
+  if (!pending_.valid() || pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    return false;
+  sorted_ = pending_.get();
+  hasOrdering_ = true;
+  return true;
+}
+
+bool ViewDependentTriangleSorter::update(const Vector& dir, double maxAngle, bool async)
+{
+  const bool collected = collect();
+
+  const auto length = dir.length();
+  if (length == 0)
+    return collected;
+  const auto unit = dir / length;
+
+  if (hasRequest_ && Dot(unit, requested_) >= std::cos(maxAngle))
+    return collected;
+  // Let the sort in flight finish; the next frame asks again if we are still off.
+  if (pending_.valid())
+    return collected;
+
+  requested_ = unit;
+  hasRequest_ = true;
+
+  auto vbo = vbo_;
+  auto ibo = ibo_;
+  const auto stride = stride_;
+  auto sort = [vbo, ibo, stride, unit]()
+  {
+    const auto numTriangles = ibo->getBufferSize() / (sizeof(uint32_t) * 3);
+    std::vector<uint32_t> sorted(3 * numTriangles);
+    sortTrianglesByDepth(vbo->getBuffer(), stride, reinterpret_cast<const uint32_t*>(ibo->getBuffer()),
+      numTriangles, unit, sorted.data());
+    return sorted;
+  };
+
+  if (async)
+  {
+    pending_ = std::async(std::launch::async, sort);
+    return collected;
+  }
+  sorted_ = sort();
+  hasOrdering_ = true;
+  return true;
+}
+
+SortedObjectCache::Entry& SortedObjectCache::find(const std::string& name, const spire::VarBuffer* source,
+  const ReleaseBuffer& release)
+{
+  auto entry = std::find_if(entries_.begin(), entries_.end(), [&name](const Entry& e) { return e.name == name; });
+  if (entry == entries_.end())
+  {
+    entries_.emplace_back();
+    entry = entries_.end() - 1;
+    entry->name = name;
+    entry->source = source;
+  }
+  else if (entry->source != source)
+  {
+    // Same name, new geometry: drop the ordering of the old buffer.
+    if (entry->sortedID != 0)
+      release(entry->sortedID);
+    *entry = Entry();
+    entry->name = name;
+    entry->source = source;
+  }
+  entry->drawn = true;
+  return *entry;
+}
+
+void SortedObjectCache::endFrame(const ReleaseBuffer& release)
+{
+  auto removed = std::partition(entries_.begin(), entries_.end(), [](const Entry& e) { return e.drawn; });
+  for (auto entry = removed; entry != entries_.end(); ++entry)
+  {
+    if (entry->sortedID != 0)
+      release(entry->sortedID);
+  }
+  entries_.erase(removed, entries_.end());
+  for (auto& entry : entries_)
+    entry.drawn = false;
+}
@@ -0,0 +1,120 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef INTERFACE_MODULES_RENDER_ES_TRANSPARENCYSORTER_H
+#define INTERFACE_MODULES_RENDER_ES_TRANSPARENCYSORTER_H
+
+#include <Core/GeometryPrimitives/Vector.h>
+#include <var-buffer/VarBuffer.hpp>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Interface/Modules/Render/share.h>
+
+namespace SCIRun {
+namespace Render {
+
+/// Orders the triangles of an index buffer back to front along dir: the triangle
+/// with the smallest Dot(dir, centroid) comes first. Depths are quantized to 32 bits
+/// and sorted with a parallel LSD radix sort, then the index triples are gathered
+/// into sorted, which must hold 3 * numTriangles indices.
+/// Vertex positions are the first three floats of each vboStride-sized vertex.
+SCISHARE void sortTrianglesByDepth(const char* vbo, size_t vboStride,
+  const uint32_t* ibo, size_t numTriangles,
+  const Core::Geometry::Vector& dir, uint32_t* sorted);
+
+/// Keeps one depth-sorted copy of a transparent triangle list and re-sorts it
+/// when the view direction has turned by more than a tolerance. Sorting can run on
+/// a worker thread so the render loop never waits on a large surface; until the new
+/// ordering is ready the previous one keeps being drawn.
+class SCISHARE ViewDependentTriangleSorter
+{
+public:
+  ViewDependentTriangleSorter(std::shared_ptr<spire::VarBuffer> vbo, size_t vboStride,
+    std::shared_ptr<spire::VarBuffer> ibo);
+  ~ViewDependentTriangleSorter();
+
+  /// Starts a sort for dir if it differs from the last requested direction by more
+  /// than maxAngle radians. Returns true when a new ordering is available in sorted().
+  bool update(const Core::Geometry::Vector& dir, double maxAngle, bool async);
+
+  bool hasOrdering() const { return hasOrdering_; }
+  const std::vector<uint32_t>& sorted() const { return sorted_; }
+  size_t bufferSize() const;
+
+private:
+  bool collect();
+
+  std::shared_ptr<spire::VarBuffer> vbo_, ibo_;
+  size_t stride_;
+  std::vector<uint32_t> sorted_;
+  std::future<std::vector<uint32_t>> pending_;
+  Core::Geometry::Vector requested_;
+  bool hasRequest_ {false};
+  bool hasOrdering_ {false};
+};
+
+/// The sorters of the transparent objects a renderer draws, by IBO name, with the GL
+/// buffer that holds each sorted copy. Objects that were not looked up during a frame
+/// are dropped at its end, so removing an object from the scene releases its geometry
+/// and its buffer.
+class SCISHARE SortedObjectCache
+{
+public:
+  using ReleaseBuffer = std::function<void(unsigned int)>;
+
+  struct Entry
+  {
+    std::string name;
+    unsigned int sortedID {0};
+    std::shared_ptr<ViewDependentTriangleSorter> sorter;
+    const spire::VarBuffer* source {nullptr};
+    bool drawn {false};
+  };
+
+  /// The entry for name, marked as drawn this frame. An entry whose source changed is
+  /// reset, releasing its buffer; new and reset entries have no sorter yet.
+  Entry& find(const std::string& name, const spire::VarBuffer* source, const ReleaseBuffer& release);
+
+  /// Drops the entries that were not drawn since the last call.
+  void endFrame(const ReleaseBuffer& release);
+
+  size_t size() const { return entries_.size(); }
+
+private:
+  std::vector<Entry> entries_;
+};
+
+} // namespace Render
+} // namespace SCIRun
+
+#endif
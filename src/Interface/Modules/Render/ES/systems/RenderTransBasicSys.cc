@@ -62,6 +62,7 @@
 #include "../comp/StaticClippingPlanes.h"
 #include "../comp/LightingUniforms.h"
 #include "../comp/ClippingPlaneUniforms.h"
+#include "../TransparencySorter.h"
 
 namespace es = spire;
 namespace shaders = spire;
@@ -118,46 +119,21 @@ public:
   }
 
 private:
-  class SortedObject
+  // Re-sort thresholds for the view direction. UPDATE_SORT keeps its historical
+  // chord length of 1.23 between unit directions (about 76 degrees); LISTS_SORT
+  // follows the camera closely but sorts in the background.
+  static constexpr double UpdateSortAngle = 1.3255;
+  static constexpr double ListsSortAngle = 0.1745;
+
+  static std::shared_ptr<ViewDependentTriangleSorter> makeSorter(const SpireSubPass& pass)
   {
-  public:
-    std::string mName;
-    GLuint mSortedID;
-    Core::Geometry::Vector prevDir = Core::Geometry::Vector(0.0);
-
-    SortedObject() :
-      mSortedID(0)
-    {}
-
-    SortedObject(const std::string& name, GLuint ID, Core::Geometry::Vector& dir) :
-      mName(name),
-      mSortedID(ID),
-      prevDir(dir)
-    {}
-  };
-
-  std::vector<SortedObject> sortedObjects;
-
-  class DepthIndex {
-  public:
-    size_t mIndex;
-    double mDepth;
-
-    DepthIndex() :
-      mIndex(0),
-      mDepth(0.0)
-    {}
-
-    DepthIndex(size_t index, double depth) :
-      mIndex(index),
-      mDepth(depth)
-    {}
-
-    bool operator<(const DepthIndex& di) const
-    {
-      return this->mDepth < di.mDepth;
-    }
-  };
+    size_t stride_vbo = 0;
+    for (auto a : pass.vbo.attributes)
+      stride_vbo += a.sizeInBytes;
+    return std::make_shared<ViewDependentTriangleSorter>(pass.vbo.data, stride_vbo, pass.ibo.data);
+  }
+
+  SortedObjectCache sortedObjects;
 
   GLuint addIBO(void* iboData, size_t iboDataSize)
   {
@@ -175,57 +151,43 @@ private:
     GL(glDeleteBuffers(1, &glid));
   }
 
-  GLuint sortObjects(const Core::Geometry::Vector& dir,
-    const spire::ComponentGroup<ren::IBO>& ibo,
-    const spire::ComponentGroup<SpireSubPass>& pass,
-    const spire::ComponentGroup<ren::StaticIBOMan>&)
+  // Returns the buffer holding the depth-sorted triangles of the pass, or the
+  // unsorted one while the first ordering is still being computed.
+  GLuint sortedIBO(const Core::Geometry::Vector& dir, const SpireSubPass& pass,
+    GLuint unsorted, double maxAngle, bool async)
   {
-    char* vbo_buffer = reinterpret_cast<char*>(pass.front().vbo.data->getBuffer());
-    uint32_t* ibo_buffer = reinterpret_cast<uint32_t*>(pass.front().ibo.data->getBuffer());
-    size_t num_triangles = pass.front().ibo.data->getBufferSize() / (sizeof(uint32_t) * 3);
-
-    size_t stride_vbo = 0;
-    for (auto a : pass.front().vbo.attributes)
-      stride_vbo += a.sizeInBytes;
-
-    std::vector<DepthIndex> rel_depth(num_triangles);
-
-
-    for (size_t j = 0; j < num_triangles; j++)
+    if (pass.ibo.indexSize != sizeof(uint32_t))
+      return unsorted;
+
+    auto& object = sortedObjects.find(pass.ibo.name, pass.ibo.data.get(),
+      [this](GLuint glid) { removeIBO(glid); });
+    if (!object.sorter)
+      object.sorter = makeSorter(pass);
+    if (object.sorter->update(dir, maxAngle, async))
     {
-      float* vertex1 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3]));
-      Core::Geometry::Point node1(vertex1[0], vertex1[1], vertex1[2]);
-
-      float* vertex2 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3 + 1]));
-      Core::Geometry::Point node2(vertex2[0], vertex2[1], vertex2[2]);
-
-      float* vertex3 = reinterpret_cast<float*>(vbo_buffer + stride_vbo * (ibo_buffer[j * 3 + 2]));
-      Core::Geometry::Point node3(vertex3[0], vertex3[1], vertex3[2]);
-
-      rel_depth[j].mDepth = Core::Geometry::Dot(dir, node1) + Core::Geometry::Dot(dir, node2) + Core::Geometry::Dot(dir, node3);
-      rel_depth[j].mIndex = j;
-    }
-
-    std::sort(rel_depth.begin(), rel_depth.end());
-
-    std::vector<char> sorted_buffer(pass.front().ibo.data->getBufferSize());
-    char* ibuffer = reinterpret_cast<char*>(pass.front().ibo.data->getBuffer());
-    char* sbuffer = !sorted_buffer.empty() ? reinterpret_cast<char*>(&sorted_buffer[0]) : nullptr;
-    GLuint result = ibo.front().glid;
-    if (sbuffer && num_triangles > 0)
-    {
-      size_t tri_size = pass.front().ibo.data->getBufferSize() / num_triangles;
-
-      for (size_t j = 0; j < num_triangles; j++)
+      auto& sorted = object.sorter->sorted();
+      const auto size = sorted.size() * sizeof(uint32_t);
+      if (object.sortedID == 0)
       {
-        memcpy(sbuffer + j * tri_size, ibuffer + rel_depth[j].mIndex * tri_size, tri_size);
+        object.sortedID = addIBO(const_cast<uint32_t*>(sorted.data()), size);
+      }
+      else
+      {
+        GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object.sortedID));
+        GL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), sorted.data()));
       }
-
-      std::string transIBOName = pass.front().ibo.name + "trans";
-      result = addIBO(sbuffer, pass.front().ibo.data->getBufferSize());
     }
+    return object.sorter->hasOrdering() && object.sortedID != 0 ? object.sortedID : unsorted;
+  }
 
-    return result;
+  void postWalkComponents(spire::ESCoreBase&) override
+  {
+    // Nothing was drawn, so nothing was looked up; keep the orderings for the next frame.
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+      return;
+
+    // Objects that left the scene release their geometry and sorted buffer here.
+    sortedObjects.endFrame([this](GLuint glid) { removeIBO(glid); });
   }
 
   void groupExecute(
@@ -286,89 +248,14 @@ private:
       switch (pass.front().renderState.mSortType)
       {
         case RenderState::TransparencySortType::CONTINUOUS_SORT:
-        {
-          iboID = sortObjects(dir, ibo, pass, iboMan);
+          iboID = sortedIBO(dir, pass.front(), iboID, 0.0, false);
           break;
-        }
         case RenderState::TransparencySortType::UPDATE_SORT:
-        {
-          unsigned int index = 0;
-          bool indexed = false;
-          for (int i = 0; i < sortedObjects.size(); ++i)
-          {
-            if (sortedObjects[i].mName == pass.front().ibo.name)
-            {
-              indexed = true;
-              index = i;
-            }
-          }
-          if (!indexed)
-          {
-            index = sortedObjects.size();
-            sortedObjects.push_back(SortedObject(pass.front().ibo.name, 0, dir));
-          }
-
-          Core::Geometry::Vector diff = sortedObjects[index].prevDir - dir;
-          double distance = sqrtf(Dot(diff, diff));
-          if (distance >= 1.23 || sortedObjects[index].mSortedID == 0)
-          {
-            if (sortedObjects[index].mSortedID != 0)
-            {
-              removeIBO(sortedObjects[index].mSortedID);
-            }
-            sortedObjects[index].prevDir = dir;
-            sortedObjects[index].mSortedID = sortObjects(dir, ibo, pass, iboMan);
-          }
-          iboID = sortedObjects[index].mSortedID;
+          iboID = sortedIBO(dir, pass.front(), iboID, UpdateSortAngle, false);
           break;
-        }
         case RenderState::TransparencySortType::LISTS_SORT:
-        {
-          GLuint iboXID = ibo.front().glid;
-          GLuint iboYID = ibo.front().glid;
-          GLuint iboZID = ibo.front().glid;
-          GLuint iboNegXID = ibo.front().glid;
-          GLuint iboNegYID = ibo.front().glid;
-          GLuint iboNegZID = ibo.front().glid;
-
-          int index = 0;
-          for (auto it = ibo.begin(); it != ibo.end(); ++it, ++index)
-          {
-            if (index == 1)
-              iboXID = it->glid;
-            if (index == 2)
-              iboYID = it->glid;
-            if (index == 3)
-              iboZID = it->glid;
-            if (index == 4)
-              iboNegXID = it->glid;
-            if (index == 5)
-              iboNegYID = it->glid;
-            if (index == 6)
-              iboNegZID = it->glid;
-          }
-
-          Core::Geometry::Vector absDir(fabs(camera.front().data.view[0][2]),
-                                        fabs(camera.front().data.view[1][2]),
-                                        fabs(camera.front().data.view[2][2]));
-
-          double xORy = absDir.x() > absDir.y() ? absDir.x() : absDir.y();
-          double orZ = absDir.z() > xORy ? absDir.z() : xORy;
-
-          if (orZ == absDir.x())
-          {
-            iboID = dir.x() < orZ ? iboNegXID : iboXID;
-          }
-          if (orZ == absDir.y())
-          {
-            iboID = dir.y() < orZ ? iboNegYID : iboYID;
-          }
-          if (orZ == absDir.z())
-          {
-            iboID = dir.z() < orZ ? iboNegZID : iboZID;
-          }
+          iboID = sortedIBO(dir, pass.front(), iboID, ListsSortAngle, true);
           break;
-        }
       }
     }
 
@@ -594,15 +481,6 @@ private:
       }
     }
 
-
-    if (!drawLines)
-    {
-      if (pass.front().renderState.mSortType == RenderState::TransparencySortType::CONTINUOUS_SORT)
-      {
-        removeIBO(iboID);
-      }
-    }
-
     if (depthMask)
     {
       GL(glDepthMask(GL_TRUE));
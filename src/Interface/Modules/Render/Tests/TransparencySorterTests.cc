@@ -0,0 +1,193 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <gtest/gtest.h>
+#include <Interface/Modules/Render/ES/TransparencySorter.h>
+#include <random>
+#include <thread>
+
+using namespace SCIRun;
+using namespace Render;
+using namespace Core::Geometry;
+
+namespace
+{
+  // Vertices carry a position and a normal, like the VBOs built by ShowField.
+  const size_t Stride = 6 * sizeof(float);
+
+  double depth(const std::vector<float>& vertices, const uint32_t* triangle, const Vector& dir)
+  {
+    double d = 0;
+    for (int v = 0; v < 3; ++v)
+    {
+      const float* p = &vertices[6 * triangle[v]];
+      d += dir.x() * p[0] + dir.y() * p[1] + dir.z() * p[2];
+    }
+    return d;
+  }
+
+  void randomGeometry(size_t numVertices, size_t numTriangles, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+  {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> coord(-10, 10);
+    vertices.resize(6 * numVertices);
+    for (auto& x : vertices)
+      x = coord(gen);
+    indices.resize(3 * numTriangles);
+    for (auto& i : indices)
+      i = gen() % numVertices;
+  }
+
+  void expectBackToFront(const std::vector<float>& vertices, const std::vector<uint32_t>& sorted, const Vector& dir)
+  {
+    for (size_t t = 1; t < sorted.size() / 3; ++t)
+      ASSERT_LE(depth(vertices, &sorted[3 * (t - 1)], dir), depth(vertices, &sorted[3 * t], dir) + 1e-3);
+  }
+
+  std::shared_ptr<spire::VarBuffer> toBuffer(const void* data, size_t size)
+  {
+    auto buffer = std::make_shared<spire::VarBuffer>(size);
+    buffer->writeBytes(reinterpret_cast<const char*>(data), size);
+    return buffer;
+  }
+}
+
+TEST(TransparencySorterTests, SortsLargeListsByDepth)
+{
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  randomGeometry(5000, 100000, vertices, indices);
+
+  const Vector dir(0.3, -0.5, 0.8);
+  std::vector<uint32_t> sorted(indices.size());
+  sortTrianglesByDepth(reinterpret_cast<const char*>(vertices.data()), Stride, indices.data(), indices.size() / 3, dir, sorted.data());
+
+  expectBackToFront(vertices, sorted, dir);
+
+  // Same triangles, only reordered.
+  auto before = indices, after = sorted;
+  std::sort(before.begin(), before.end());
+  std::sort(after.begin(), after.end());
+  EXPECT_EQ(before, after);
+}
+
+TEST(TransparencySorterTests, ResortsOnlyWhenViewTurns)
+{
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  randomGeometry(100, 500, vertices, indices);
+
+  ViewDependentTriangleSorter sorter(toBuffer(vertices.data(), vertices.size() * sizeof(float)), Stride,
+    toBuffer(indices.data(), indices.size() * sizeof(uint32_t)));
+  EXPECT_FALSE(sorter.hasOrdering());
+
+  const double maxAngle = 0.1;
+  EXPECT_TRUE(sorter.update(Vector(0, 0, 1), maxAngle, false));
+  expectBackToFront(vertices, sorter.sorted(), Vector(0, 0, 1));
+
+  EXPECT_FALSE(sorter.update(Vector(0.05, 0, 1), maxAngle, false));
+  EXPECT_TRUE(sorter.update(Vector(1, 0, 0), maxAngle, false));
+  expectBackToFront(vertices, sorter.sorted(), Vector(1, 0, 0));
+}
+
+TEST(TransparencySorterTests, AsynchronousSortIsPickedUpLater)
+{
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  randomGeometry(1000, 20000, vertices, indices);
+
+  ViewDependentTriangleSorter sorter(toBuffer(vertices.data(), vertices.size() * sizeof(float)), Stride,
+    toBuffer(indices.data(), indices.size() * sizeof(uint32_t)));
+
+  const Vector dir(0, 1, 0);
+  bool ready = sorter.update(dir, 0.1, true);
+  for (int frame = 0; frame < 1000 && !ready; ++frame)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ready = sorter.update(dir, 0.1, true);
+  }
+  ASSERT_TRUE(ready);
+  ASSERT_TRUE(sorter.hasOrdering());
+  expectBackToFront(vertices, sorter.sorted(), dir);
+}
+
+TEST(TransparencySorterTests, CacheReleasesObjectsLeftOutOfAFrame)
+{
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  randomGeometry(100, 500, vertices, indices);
+  auto vbo = toBuffer(vertices.data(), vertices.size() * sizeof(float));
+  auto ibo = toBuffer(indices.data(), indices.size() * sizeof(uint32_t));
+
+  SortedObjectCache cache;
+  std::vector<unsigned int> released;
+  auto release = [&released](unsigned int id) { released.push_back(id); };
+
+  auto& kept = cache.find("kept", ibo.get(), release);
+  kept.sorter = std::make_shared<ViewDependentTriangleSorter>(vbo, Stride, ibo);
+  kept.sortedID = 1;
+  auto& removed = cache.find("removed", ibo.get(), release);
+  removed.sorter = std::make_shared<ViewDependentTriangleSorter>(vbo, Stride, ibo);
+  removed.sortedID = 2;
+  std::weak_ptr<ViewDependentTriangleSorter> removedSorter = removed.sorter;
+  cache.endFrame(release);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(released.empty());
+
+  // "removed" left the scene
+  EXPECT_TRUE(cache.find("kept", ibo.get(), release).sorter);
+  cache.endFrame(release);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(removedSorter.expired());
+  EXPECT_EQ(std::vector<unsigned int>{ 2 }, released);
+}
+
+TEST(TransparencySorterTests, CacheResetsObjectsWithNewGeometry)
+{
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  randomGeometry(100, 500, vertices, indices);
+  auto vbo = toBuffer(vertices.data(), vertices.size() * sizeof(float));
+  auto ibo = toBuffer(indices.data(), indices.size() * sizeof(uint32_t));
+  auto newIbo = toBuffer(indices.data(), indices.size() * sizeof(uint32_t));
+
+  SortedObjectCache cache;
+  std::vector<unsigned int> released;
+  auto release = [&released](unsigned int id) { released.push_back(id); };
+
+  auto& object = cache.find("object", ibo.get(), release);
+  object.sorter = std::make_shared<ViewDependentTriangleSorter>(vbo, Stride, ibo);
+  object.sortedID = 3;
+
+  auto& updated = cache.find("object", newIbo.get(), release);
+  EXPECT_FALSE(updated.sorter);
+  EXPECT_EQ(0u, updated.sortedID);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(std::vector<unsigned int>{ 3 }, released);
+}
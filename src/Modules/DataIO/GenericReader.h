@@ -41,6 +41,7 @@
 #include <Core/Datatypes/String.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Thread/Mutex.h>
+#include <Core/Thread/IOThreadPool.h>
 #include <Core/Utils/Legacy/Environment.h>
 #include <Dataflow/Network/Module.h>
 
@@ -76,6 +77,28 @@ protected:
 
   static Core::Thread::Mutex fileCheckMutex_;
   static bool file_exists(const std::string& filename);
+
+private:
+  /// Native SCIRun files are decoded on the shared I/O pool once the network schedules this module
+  /// or the filename changes, so execute() usually finds the data already in memory.
+  void prefetch();
+
+  /// Result of reading a native file: opened is false if no stream could be opened,
+  /// an empty handle after opening means the data could not be parsed.
+  struct NativeRead
+  {
+    HType handle;
+    bool opened = false;
+  };
+
+  boost::optional<std::shared_future<NativeRead>> takePrefetched(const std::string& filename, time_t modified);
+  std::string filenameFromState() const;
+  static NativeRead readNativeFile(const std::string& filename, Core::Logging::LoggerHandle logger);
+
+  Core::Thread::Mutex prefetchMutex_;
+  std::string prefetchedFilename_;
+  time_t prefetchedModification_;
+  std::shared_future<NativeRead> prefetched_;
 };
 
 
@@ -86,10 +109,17 @@ GenericReader<HType, PortTag>::GenericReader(const std::string &name,
     //gui_filename_(get_ctx()->subVar("filename"), ""),
     //gui_from_env_(get_ctx()->subVar("from-env"),""),
     objectPortName_(SCIRun::Dataflow::Networks::PortId(0, objectPortName)),
-    old_filemodification_(0)
+    old_filemodification_(0),
+    prefetchMutex_("GenericReaderPrefetch"),
+    prefetchedModification_(0)
 {
   INITIALIZE_PORT(Filename);
   INITIALIZE_PORT(FileLoaded);
+  executionState().connectExecutionStateChanged([this](int state)
+  {
+    if (state == static_cast<int>(Dataflow::Networks::ModuleExecutionState::Value::Waiting))
+      prefetch();
+  });
 }
 
 template <class HType, class PortTag>
@@ -100,6 +130,7 @@ void GenericReader<HType, PortTag>::setStateDefaults()
   state->setValue(SCIRun::Core::Algorithms::Variables::FileTypeName, defaultFileTypeName());
   state->setValue(SCIRun::Core::Algorithms::Variables::GuiFileTypeName, std::string());
   state->setValue(SCIRun::Core::Algorithms::Variables::ScriptEnvironmentVariable, std::string());
+  state->connectSpecificStateChanged(SCIRun::Core::Algorithms::Variables::Filename, [this]() { prefetch(); });
 }
 
 template <class HType, class PortTag>
@@ -114,6 +145,73 @@ bool
   return boost::filesystem::exists(filename);
 }
 
+template <class HType, class PortTag>
+std::string GenericReader<HType, PortTag>::filenameFromState() const
+{
+  auto state = cstate();
+  auto environmentVariable = state->getValue(Core::Algorithms::Variables::ScriptEnvironmentVariable).toString();
+  if (!environmentVariable.empty() && sci_getenv(environmentVariable))
+    return sci_getenv(environmentVariable);
+  return state->getValue(SCIRun::Core::Algorithms::Variables::Filename).toFilename().string();
+}
+
+template <class HType, class PortTag>
+typename GenericReader<HType, PortTag>::NativeRead
+GenericReader<HType, PortTag>::readNativeFile(const std::string& filename, Core::Logging::LoggerHandle logger)
+{
+  NativeRead read;
+  auto stream = auto_istream(filename, logger);
+  if (stream)
+  {
+    read.opened = true;
+    Pio(*stream, read.handle);
+    if (stream->error())
+      read.handle.reset();
+  }
+  return read;
+}
+
+template <class HType, class PortTag>
+void GenericReader<HType, PortTag>::prefetch()
+{
+  // A connected filename port decides the file only at execute time.
+  auto filenamePort = getInputPort(Filename);
+  if (filenamePort && filenamePort->nconnections() > 0)
+    return;
+
+  auto filename = filenameFromState();
+  if (filename.empty() || !file_exists(filename) || useCustomImporter(filename))
+    return;
+
+  boost::system::error_code ec;
+  auto modified = boost::filesystem::last_write_time(filename, ec);
+  if (ec)
+    return;
+
+  Core::Thread::Guard g(prefetchMutex_.get());
+  if ((filename == filename_ && modified == old_filemodification_) ||
+    (prefetched_.valid() && filename == prefetchedFilename_ && modified == prefetchedModification_))
+    return;
+
+  // The task holds only copies, so it may safely outlive this module.
+  auto logger = getLogger();
+  prefetchedFilename_ = filename;
+  prefetchedModification_ = modified;
+  prefetched_ = Core::Thread::IOThreadPool::Instance().submit<NativeRead>([filename, logger]() { return readNativeFile(filename, logger); });
+}
+
+template <class HType, class PortTag>
+boost::optional<std::shared_future<typename GenericReader<HType, PortTag>::NativeRead>>
+GenericReader<HType, PortTag>::takePrefetched(const std::string& filename, time_t modified)
+{
+  Core::Thread::Guard g(prefetchMutex_.get());
+  if (!prefetched_.valid() || filename != prefetchedFilename_ || modified != prefetchedModification_)
+    return boost::none;
+  auto result = prefetched_;
+  prefetched_ = std::shared_future<NativeRead>();
+  return result;
+}
+
 template <class HType, class PortTag>
 void
 GenericReader<HType, PortTag>::execute()
@@ -142,7 +240,11 @@ GenericReader<HType, PortTag>::execute()
       state->setValue(SCIRun::Core::Algorithms::Variables::Filename, (*fileOption)->value());
     }
   }
-  filename_ = state->getValue(SCIRun::Core::Algorithms::Variables::Filename).toFilename().string();
+  {
+    // prefetch() compares against these from the signal thread.
+    Core::Thread::Guard g(prefetchMutex_.get());
+    filename_ = state->getValue(SCIRun::Core::Algorithms::Variables::Filename).toFilename().string();
+  }
 
 
   // Read the status of this file so we can compare modification timestamps
@@ -177,7 +279,10 @@ GenericReader<HType, PortTag>::execute()
 #endif
       )
   {
-    old_filemodification_ = new_filemodification;
+    {
+      Core::Thread::Guard g(prefetchMutex_.get());
+      old_filemodification_ = new_filemodification;
+    }
 
     HType handle;
 
@@ -192,16 +297,28 @@ GenericReader<HType, PortTag>::execute()
     }
     else
     {
-      auto stream = auto_istream(filename_, getLogger());
-      if (!stream)
+      boost::optional<NativeRead> read;
+      auto prefetched = takePrefetched(filename_, new_filemodification);
+      if (prefetched)
       {
-        MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading file '" + filename_ + "'.");
+        try
+        {
+          read = prefetched->get();
+        }
+        catch (std::exception& e)
+        {
+          warning(std::string("Background read failed, reading again: ") + e.what());
+        }
       }
+      if (!read)
+        read = readNativeFile(filename_, getLogger());
 
-      // Read the file
-      Pio(*stream, handle);
-
-      if (!handle || stream->error())
+      if (!read->opened)
+      {
+        MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading file '" + filename_ + "'.");
+      }
+      handle = read->handle;
+      if (!handle)
       {
         MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading data from file '" + filename_ + "'.");
       }
@@ -0,0 +1,105 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#include <Modules/DataIO/StreamMatrixFromDisk.h>
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Matrix.h>
+#include <Core/Datatypes/String.h>
+
+using namespace SCIRun::Modules::DataIO;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+using namespace SCIRun::Dataflow::Networks;
+
+MODULE_INFO_DEF(StreamMatrixFromDisk, DataIO, SCIRun)
+
+StreamMatrixFromDisk::StreamMatrixFromDisk() : Module(staticInfo_)
+{
+  INITIALIZE_PORT(Filename);
+  INITIALIZE_PORT(Indices);
+  INITIALIZE_PORT(DataVector);
+  INITIALIZE_PORT(Index);
+  INITIALIZE_PORT(ScaledIndex);
+  INITIALIZE_PORT(FileLoaded);
+}
+
+void StreamMatrixFromDisk::setStateDefaults()
+{
+  setStateStringFromAlgo(Variables::Filename);
+  setStateBoolFromAlgo(Parameters::StreamSliceIsColumn);
+  setStateIntFromAlgo(Parameters::StreamWindowStart);
+  setStateIntFromAlgo(Parameters::StreamWindowSize);
+  setStateIntFromAlgo(Parameters::StreamWindowIncrement);
+  setStateIntFromAlgo(Parameters::StreamMaxIndex);
+  setStateBoolFromAlgo(Parameters::StreamPrefetch);
+  setStateStringFromAlgoOption(Parameters::StreamStorageOrder);
+  setStateIntFromAlgo(Parameters::RawMatrixRows);
+  setStateIntFromAlgo(Parameters::RawMatrixColumns);
+  setStateStringFromAlgoOption(Parameters::RawMatrixDataType);
+}
+
+void StreamMatrixFromDisk::execute()
+{
+  auto state = get_state();
+  auto fileOption = getOptionalInput(Filename);
+  if (fileOption && *fileOption)
+    state->setValue(Variables::Filename, (*fileOption)->value());
+  auto indices = getOptionalInput(Indices);
+
+  setAlgoStringFromState(Variables::Filename);
+  setAlgoBoolFromState(Parameters::StreamSliceIsColumn);
+  setAlgoIntFromState(Parameters::StreamWindowStart);
+  setAlgoIntFromState(Parameters::StreamWindowSize);
+  setAlgoIntFromState(Parameters::StreamWindowIncrement);
+  setAlgoBoolFromState(Parameters::StreamPrefetch);
+  setAlgoOptionFromState(Parameters::StreamStorageOrder);
+  setAlgoIntFromState(Parameters::RawMatrixRows);
+  setAlgoIntFromState(Parameters::RawMatrixColumns);
+  setAlgoOptionFromState(Parameters::RawMatrixDataType);
+
+  auto output = algo().run(withInputData((Indices, optionalAlgoInput(indices))));
+  sendOutputFromAlgorithm(DataVector, output);
+  sendOutputFromAlgorithm(Index, output);
+  sendOutputFromAlgorithm(ScaledIndex, output);
+  sendOutput(FileLoaded, boost::make_shared<String>(state->getValue(Variables::Filename).toString()));
+
+  const auto maxIndex = output.additionalAlgoOutput()->toInt();
+  state->setValue(Parameters::StreamMaxIndex, maxIndex);
+
+  // Step through the file one window per execution, wrapping at the end. The
+  // stream has already started reading the next window in the background.
+  if (!(indices && *indices))
+  {
+    const auto next = StreamMatrixAlgo::nextWindowStart(state->getValue(Parameters::StreamWindowStart).toInt(),
+      state->getValue(Parameters::StreamWindowIncrement).toInt(), maxIndex);
+    state->setValue(Parameters::StreamWindowStart, static_cast<int>(next));
+  }
+}
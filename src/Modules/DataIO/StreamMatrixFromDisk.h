@@ -0,0 +1,63 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+
+#ifndef MODULES_DATAIO_STREAMMATRIXFROMDISK_H
+#define MODULES_DATAIO_STREAMMATRIXFROMDISK_H
+
+#include <Dataflow/Network/Module.h>
+#include <Modules/DataIO/share.h>
+
+namespace SCIRun {
+namespace Modules {
+namespace DataIO {
+
+  /// Sends windows of rows or columns of a matrix file that is too large to load,
+  /// stepping the window forward by StreamWindowIncrement on every execution.
+  class SCISHARE StreamMatrixFromDisk : public Dataflow::Networks::Module,
+    public Has2InputPorts<StringPortTag, MatrixPortTag>,
+    public Has4OutputPorts<MatrixPortTag, MatrixPortTag, MatrixPortTag, StringPortTag>
+  {
+  public:
+    StreamMatrixFromDisk();
+    void execute() override;
+    void setStateDefaults() override;
+
+    INPUT_PORT(0, Filename, String);
+    INPUT_PORT(1, Indices, Matrix);
+    OUTPUT_PORT(0, DataVector, Matrix);
+    OUTPUT_PORT(1, Index, Matrix);
+    OUTPUT_PORT(2, ScaledIndex, Matrix);
+    OUTPUT_PORT(3, FileLoaded, String);
+
+    MODULE_TRAITS_AND_INFO(ModuleFlags::ModuleHasAlgorithm)
+  };
+
+}}}
+
+#endif
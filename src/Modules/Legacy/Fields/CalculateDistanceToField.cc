@@ -58,6 +58,8 @@ void CalculateDistanceToField::setStateDefaults()
   setStateDoubleFromAlgo(Parameters::TruncateDistance);
   setStateStringFromAlgoOption(Parameters::BasisType);
   setStateStringFromAlgoOption(Parameters::OutputFieldDatatype);
+  setStateStringFromAlgoOption(Parameters::DistanceMethod);
+  setStateDoubleFromAlgo(Parameters::NarrowBandWidth);
 }
 
 void
@@ -74,6 +76,8 @@ CalculateDistanceToField::execute()
     setAlgoDoubleFromState(Parameters::TruncateDistance);
     setAlgoOptionFromState(Parameters::BasisType);
     setAlgoOptionFromState(Parameters::OutputFieldDatatype);
+    setAlgoOptionFromState(Parameters::DistanceMethod);
+    setAlgoDoubleFromState(Parameters::NarrowBandWidth);
 
     auto inputs = make_input((InputField, input)(ObjectField, object));
 
@@ -38,7 +38,7 @@ using namespace SCIRun::Dataflow::Networks;
 using namespace SCIRun::Modules::Fields;
 
 CalculateSignedDistanceToField::CalculateSignedDistanceToField()
-  : Module(ModuleLookupInfo("CalculateSignedDistanceToField", "ChangeFieldData", "SCIRun"), false)
+  : Module(ModuleLookupInfo("CalculateSignedDistanceToField", "ChangeFieldData", "SCIRun"))
 {
   INITIALIZE_PORT(InputField);
   INITIALIZE_PORT(ObjectField);
@@ -46,6 +46,12 @@ CalculateSignedDistanceToField::CalculateSignedDistanceToField()
   INITIALIZE_PORT(ValueField);
 }
 
+void CalculateSignedDistanceToField::setStateDefaults()
+{
+  setStateStringFromAlgoOption(Parameters::DistanceMethod);
+  setStateDoubleFromAlgo(Parameters::NarrowBandWidth);
+}
+
 void CalculateSignedDistanceToField::execute()
 {
   FieldHandle input = getRequiredInput(InputField);
@@ -55,6 +61,9 @@ void CalculateSignedDistanceToField::execute()
 
   if (needToExecute())
   {
+    setAlgoOptionFromState(Parameters::DistanceMethod);
+    setAlgoDoubleFromState(Parameters::NarrowBandWidth);
+
     auto inputs = make_input((InputField, input)(ObjectField, object));
 
     algo().set(CalculateSignedDistanceFieldAlgo::OutputValueField, value_connected);
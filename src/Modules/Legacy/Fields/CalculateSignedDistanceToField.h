@@ -50,13 +50,13 @@ namespace SCIRun {
         CalculateSignedDistanceToField();
 
         void execute() override;
-        void setStateDefaults() override {}
+        void setStateDefaults() override;
 
         INPUT_PORT(0, InputField, Field);
         INPUT_PORT(1, ObjectField, Field);
         OUTPUT_PORT(0, SignedDistanceField, Field);
         OUTPUT_PORT(1, ValueField, Field);
-        MODULE_TRAITS_AND_INFO(ModuleFlags::ModuleHasAlgorithm)
+        MODULE_TRAITS_AND_INFO(ModuleFlags::ModuleHasUIAndAlgorithm)
       };
 
     }
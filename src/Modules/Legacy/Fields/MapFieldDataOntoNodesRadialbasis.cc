@@ -33,15 +33,8 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 
-#include <Core/Datatypes/Matrix.h>
-#include <Core/Datatypes/DenseMatrix.h>
-#include <Core/Datatypes/DenseColumnMatrix.h>
-#include <Core/Datatypes/SparseRowMatrix.h>
-#include <Core/GeometryPrimitives/Vector.h>
-#include <Core/Math/MiscMath.h>
-#include <Core/Logging/Log.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/RadialBasisInterpolation.h>
 #include <vector>
-#include <sstream>
 
 using namespace SCIRun::Modules::Fields;
 using namespace SCIRun::Core::Algorithms;
@@ -52,21 +45,17 @@ using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::Core::Logging;
 using namespace SCIRun;
 
-/// @todo: code cleanup needed
-// documentation needed
-// move calculation to algorithm class
-
 /// @class MapFieldDataOntoNodesRadialbasis
 /// @brief Maps data centered on the nodes to another set of nodes using a radial basis.
 
 class MapFieldDataOntoNodesRadialbasisImpl
 {
 public:
-  explicit MapFieldDataOntoNodesRadialbasisImpl(ModuleStateHandle state) : state_(state) {}
-	bool radial_basis_func(FieldHandle& output, FieldHandle source, FieldHandle destination);
-  bool interp_on_mesh(VMesh* points, VMesh* Cors, const DenseMatrix& coefs, FieldHandle output);
+  MapFieldDataOntoNodesRadialbasisImpl(ModuleStateHandle state, const LegacyLoggerInterface* pr) : state_(state), pr_(pr) {}
+  bool radial_basis_func(FieldHandle& output, FieldHandle source, FieldHandle destination);
 private:
   ModuleStateHandle state_;
+  const LegacyLoggerInterface* pr_;
 };
 
 MODULE_INFO_DEF(MapFieldDataOntoNodesRadialbasis, ChangeFieldData, SCIRun)
@@ -85,6 +74,8 @@ void MapFieldDataOntoNodesRadialbasis::setStateDefaults()
   state->setValue(Parameters::MaxDistance, std::numeric_limits<double>::max());
   state->setValue(Parameters::InterpolationModel, std::string("thin-plate-spline"));
   state->setValue(Parameters::Quantity, std::string("value"));
+  state->setValue(Parameters::SupportRadius, 0.0);
+  state->setValue(Parameters::DistanceToNearestNode, false);
 }
 
 void MapFieldDataOntoNodesRadialbasis::execute()
@@ -95,7 +86,7 @@ void MapFieldDataOntoNodesRadialbasis::execute()
   if (needToExecute())
   {
     FieldHandle output;
-    MapFieldDataOntoNodesRadialbasisImpl impl(get_state());
+    MapFieldDataOntoNodesRadialbasisImpl impl(get_state(), this);
     impl.radial_basis_func(output, source, destination);
     sendOutput(Output, output);
   }
@@ -105,143 +96,56 @@ bool MapFieldDataOntoNodesRadialbasisImpl::radial_basis_func(FieldHandle& output
 {
   auto cors = source->vmesh();
   auto points = destination->vmesh();
+  auto ifield = source->vfield();
 
   FieldInformation fi(destination);
   FieldInformation fis(source);
-
-  VMesh::Node::size_type num_cors, num_pts;
-  VMesh::Node::iterator iti,itj;
-
-  cors->size(num_cors);
-  points->size(num_pts);
-
-  DenseMatrix sigma(num_cors, num_cors);
-
   fi.set_data_type(fis.get_data_type());
   output = CreateField(fi, destination->mesh());
 
-  //create the radial basis function
-  for(int i=0;i<num_cors;++i)
-  {
-    for(int j=0;j<num_cors;++j)
-    {
-      iti=i;
-      itj=j;
-
-      Point Pc, Pp;
-      cors->get_point(Pc,*(itj));
-      cors->get_point(Pp,*(iti));
-
-      auto xcomp = Pc.x() - Pp.x();
-      auto ycomp = Pc.y() - Pp.y();
-      auto zcomp = Pc.z() - Pp.z();
-
-      auto mag = sqrt(pow(xcomp,2.0)+pow(ycomp,2.0)+pow(zcomp,2.0));
-      if (mag == 0)
-      {
-        sigma(i,j) = sigma(j,i) = 0;
-      }
-      else
-      {
-        sigma(i,j) = sigma(j,i) = pow(mag,2.0)*log(mag);
-      }
-    }
-  }
-
-  //create the right side of the equation
-  DenseMatrix rsideMat(num_cors, 1);
-
-  auto ifield = source->vfield();
-  //TODO: NOT how to iterate through nodes
-  for(int i = 0; i < num_cors; ++i)
-  {
-    VMesh::Node::iterator it = i;
-    double elec_val = 0.0;
-    ifield->get_value(elec_val, *(it));
-    rsideMat(i, 0) = elec_val;
-  }
-
-  //run SVD
-  Eigen::JacobiSVD<DenseMatrix::EigenBase> svd_mat(sigma, Eigen::ComputeFullU | Eigen::ComputeFullV);
-
-  DenseMatrix Um = svd_mat.matrixU();
-  DenseMatrix Sm = svd_mat.singularValues();
-  DenseMatrix Vm = svd_mat.matrixV();
-
-  auto coefMat = Vm * (Um.transpose() * rsideMat).cwiseQuotient(Sm);
-
-  //done with solve, make the new field
-  return interp_on_mesh(points, cors, coefMat, output);
-}
-
-bool MapFieldDataOntoNodesRadialbasisImpl::interp_on_mesh(VMesh* points, VMesh* cors, const DenseMatrix& coefs, FieldHandle output)
-{
-  VMesh::Node::size_type num_cors, num_pts;
-  VMesh::Node::iterator it,itp,iti,itj;
-
   auto ofield = output->vfield();
-
   if (ofield->is_nodata())
     return false;
 
+  VMesh::Node::size_type num_cors, num_pts;
   cors->size(num_cors);
   points->size(num_pts);
 
-  double sumer=0.0;
-  double sigma=0.0;
-  bool max_dist = false;
+  std::vector<Point> centers(num_cors);
+  std::vector<double> values(num_cors, 0.0);
+  for (VMesh::Node::index_type i = 0; i < num_cors; ++i)
+  {
+    cors->get_point(centers[i], i);
+    ifield->get_value(values[i], i);
+  }
+
+  std::vector<Point> targets(num_pts);
+  for (VMesh::Node::index_type i = 0; i < num_pts; ++i)
+    points->get_point(targets[i], i);
 
-  double guiMD = state_->getValue(Parameters::MaxDistance).toDouble();
-  double guiOV = state_->getValue(Parameters::OutsideValue).toDouble();
+  const auto model = state_->getValue(Parameters::InterpolationModel).toString();
+  const auto kernel = model == "wendland-c2" ? RadialBasisInterpolant::Kernel::WendlandC2
+    : RadialBasisInterpolant::Kernel::ThinPlateSpline;
 
-  for (int i = 0; i < num_pts; ++i)
+  RadialBasisInterpolant rbf(centers, values, kernel, state_->getValue(Parameters::SupportRadius).toDouble());
+  if (rbf.usesPartitionOfUnity())
   {
-    sumer = 0;
-    max_dist = false;
-    for (int j = 0; j<num_cors; ++j)
-    {
-      iti = i;
-      itj = j;
-
-      Point Pp, Pc;
-      cors->get_point(Pc,*(itj));
-      points->get_point(Pp,*(iti));
-
-      auto xcomp = Pc.x()-Pp.x();
-      auto ycomp = Pc.y()-Pp.y();
-      auto zcomp = Pc.z()-Pp.z();
-
-      auto mag = sqrt(pow(xcomp,2.0)+pow(ycomp,2.0)+pow(zcomp,2.0));
-
-      if (mag > guiMD)
-      {
-        j = num_cors - 1;
-        max_dist = true;
-      }
-
-      if (mag == 0)
-      {
-        sigma = 0;
-      }
-      else
-      {
-        #if 0 //else: //   std::cerr<<"Not yet implemented"<<std::endl;
-        if(gui_value_.get() == "thin-plate-spline")
-        #endif
-        {
-          sigma = pow(mag,2.0)*log(mag);
-        }
-      }
-      sumer += coefs(j, 0) * sigma;
-    }
-    itp = i;
-
-    if (max_dist)
-    {
-      sumer = guiOV;
-    }
-    ofield->set_value(sumer, *(itp));
+    pr_->remark("More than " + std::to_string(RadialBasisInterpolant::GlobalSolveLimit) +
+      " source nodes: blending local thin-plate splines with a partition of unity.");
   }
+  else if (kernel == RadialBasisInterpolant::Kernel::WendlandC2)
+  {
+    pr_->remark("Wendland support radius: " + std::to_string(rbf.supportRadius()));
+  }
+
+  const auto result = rbf.evaluate(targets,
+    state_->getValue(Parameters::MaxDistance).toDouble(),
+    state_->getValue(Parameters::OutsideValue).toDouble(),
+    state_->getValue(Parameters::DistanceToNearestNode).toBool()
+      ? RadialBasisInterpolant::DistanceRule::NearestCenter : RadialBasisInterpolant::DistanceRule::AnyCenter);
+
+  for (VMesh::Node::index_type i = 0; i < num_pts; ++i)
+    ofield->set_value(result[i], i);
 
   return true;
 }
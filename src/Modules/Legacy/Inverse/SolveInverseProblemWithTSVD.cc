@@ -37,6 +37,7 @@
 #include <Modules/Legacy/Inverse/LCurvePlot.h>
 #include <Core/Algorithms/Legacy/Inverse/SolveInverseProblemWithTSVD_impl.h>
 #include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 
@@ -82,6 +83,10 @@ void SolveInverseProblemWithTSVD::setStateDefaults()
   setStateStringFromAlgoOption(Parameters::RegularizationMethod);
   setStateDoubleFromAlgo(Parameters::LambdaFromDirectEntry);
   setStateDoubleFromAlgo(Parameters::LambdaSliderValue);
+  setStateStringFromAlgoOption(Math::Parameters::SVDMethod);
+  setStateIntFromAlgo(Math::Parameters::TruncationRank);
+  setStateIntFromAlgo(Math::Parameters::Oversampling);
+  setStateIntFromAlgo(Math::Parameters::PowerIterations);
 }
 
 void SolveInverseProblemWithTSVD::execute()
@@ -140,6 +145,10 @@ void SolveInverseProblemWithTSVD::execute()
 		setAlgoDoubleFromState(Parameters::LambdaMax);
 		setAlgoIntFromState(Parameters::LambdaNum);
 		setAlgoDoubleFromState(Parameters::LambdaSliderValue);
+		setAlgoOptionFromState(Math::Parameters::SVDMethod);
+		setAlgoIntFromState(Math::Parameters::TruncationRank);
+		setAlgoIntFromState(Math::Parameters::Oversampling);
+		setAlgoIntFromState(Math::Parameters::PowerIterations);
 
 		// run
 		auto output = algo().run(
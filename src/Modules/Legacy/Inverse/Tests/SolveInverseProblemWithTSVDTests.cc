@@ -0,0 +1,113 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2020 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Testing/ModuleTestBase/ModuleTestBase.h>
+#include <Modules/Legacy/Inverse/SolveInverseProblemWithTSVD.h>
+#include <Core/Algorithms/Legacy/Inverse/TikhonovAlgoAbstractBase.h>
+#include <Core/Algorithms/Math/RandomizedSVD.h>
+#include <Core/Datatypes/DenseMatrix.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Testing;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Inverse;
+using namespace SCIRun::Dataflow::Networks;
+
+class SolveInverseProblemWithTSVDModuleTest : public ModuleTest
+{
+protected:
+  UseRealAlgorithmFactory f;
+
+  /// Solves diag(6,5,...,1) x = 1 keeping all six singular values.
+  ModuleHandle makeDiagonalProblem()
+  {
+    auto tsvd = makeModule("SolveInverseProblemWithTSVD");
+    DenseMatrix forward(DenseMatrix::Zero(6, 6));
+    for (int i = 0; i < 6; ++i)
+      forward(i, i) = 6 - i;
+    stubPortNWithThisData(tsvd, 0, boost::make_shared<DenseMatrix>(forward));
+    stubPortNWithThisData(tsvd, 1, boost::make_shared<DenseMatrix>(DenseMatrix::Identity(6, 6)));
+    stubPortNWithThisData(tsvd, 2, boost::make_shared<DenseMatrix>(DenseMatrix::Ones(6, 1)));
+    stubPortNWithThisData(tsvd, 3, boost::make_shared<DenseMatrix>(DenseMatrix::Identity(6, 6)));
+    connectDummyOutputConnection(tsvd, 0);
+
+    auto state = tsvd->get_state();
+    state->setValue(Parameters::RegularizationMethod, std::string("single"));
+    state->setValue(Parameters::LambdaFromDirectEntry, 6.0);
+    return tsvd;
+  }
+
+  DenseMatrixHandle solution(ModuleHandle tsvd)
+  {
+    return boost::dynamic_pointer_cast<DenseMatrix>(getDataOnThisOutputPort(tsvd, 0));
+  }
+};
+
+TEST_F(SolveInverseProblemWithTSVDModuleTest, ExposesDecompositionSettingsInState)
+{
+  auto tsvd = makeModule("SolveInverseProblemWithTSVD");
+  auto state = tsvd->get_state();
+
+  EXPECT_EQ("full", state->getValue(Math::Parameters::SVDMethod).toString());
+  EXPECT_EQ(10, state->getValue(Math::Parameters::TruncationRank).toInt());
+  EXPECT_EQ(10, state->getValue(Math::Parameters::Oversampling).toInt());
+  EXPECT_EQ(2, state->getValue(Math::Parameters::PowerIterations).toInt());
+}
+
+TEST_F(SolveInverseProblemWithTSVDModuleTest, FullDecompositionKeepsEverySingularValue)
+{
+  auto tsvd = makeDiagonalProblem();
+
+  ASSERT_NO_THROW(tsvd->execute());
+
+  auto x = solution(tsvd);
+  ASSERT_TRUE(x != nullptr);
+  for (int i = 0; i < 6; ++i)
+    EXPECT_NEAR(1.0 / (6 - i), (*x)(i, 0), 1e-10);
+}
+
+TEST_F(SolveInverseProblemWithTSVDModuleTest, RandomizedDecompositionIsTruncatedAtStateRank)
+{
+  auto tsvd = makeDiagonalProblem();
+  auto state = tsvd->get_state();
+  state->setValue(Math::Parameters::SVDMethod, std::string("randomized"));
+  state->setValue(Math::Parameters::TruncationRank, 2);
+  state->setValue(Math::Parameters::Oversampling, 4);
+  state->setValue(Math::Parameters::PowerIterations, 1);
+
+  ASSERT_NO_THROW(tsvd->execute());
+
+  // Only the two largest singular values survive the randomized decomposition.
+  auto x = solution(tsvd);
+  ASSERT_TRUE(x != nullptr);
+  EXPECT_NEAR(1.0 / 6, (*x)(0, 0), 1e-8);
+  EXPECT_NEAR(1.0 / 5, (*x)(1, 0), 1e-8);
+  for (int i = 2; i < 6; ++i)
+    EXPECT_NEAR(0.0, (*x)(i, 0), 1e-8);
+}
@@ -47,12 +47,27 @@ ComputeSVD::ComputeSVD() : Module(ModuleLookupInfo("ComputeSVD", "Math", "SCIRun
 	INITIALIZE_PORT(RightSingularMatrix);
 }
 
+void ComputeSVD::setStateDefaults()
+{
+	setStateStringFromAlgoOption(Parameters::SVDMethod);
+	setStateIntFromAlgo(Parameters::TruncationRank);
+	setStateIntFromAlgo(Parameters::Oversampling);
+	setStateIntFromAlgo(Parameters::PowerIterations);
+	setStateIntFromAlgo(Parameters::ColumnBlockSize);
+}
+
 void ComputeSVD::execute()
 {
 	auto input_matrix = getRequiredInput(InputMatrix);
 
 	if(needToExecute())
 	{
+		setAlgoOptionFromState(Parameters::SVDMethod);
+		setAlgoIntFromState(Parameters::TruncationRank);
+		setAlgoIntFromState(Parameters::Oversampling);
+		setAlgoIntFromState(Parameters::PowerIterations);
+		setAlgoIntFromState(Parameters::ColumnBlockSize);
+
 		auto output = algo().run(withInputData((InputMatrix,input_matrix)));
 
 		sendOutputFromAlgorithm(LeftSingularMatrix, output);
@@ -46,12 +46,27 @@ ComputePCA::ComputePCA() : Module(ModuleLookupInfo("ComputePCA", "Math", "SCIRun
     INITIALIZE_PORT(RightPrincipalMatrix);
 }
 
+void ComputePCA::setStateDefaults()
+{
+    setStateStringFromAlgoOption(Parameters::SVDMethod);
+    setStateIntFromAlgo(Parameters::TruncationRank);
+    setStateIntFromAlgo(Parameters::Oversampling);
+    setStateIntFromAlgo(Parameters::PowerIterations);
+    setStateIntFromAlgo(Parameters::ColumnBlockSize);
+}
+
 void ComputePCA::execute()
 {
     auto input_matrix = getRequiredInput(InputMatrix);
 
     if(needToExecute())
     {
+        setAlgoOptionFromState(Parameters::SVDMethod);
+        setAlgoIntFromState(Parameters::TruncationRank);
+        setAlgoIntFromState(Parameters::Oversampling);
+        setAlgoIntFromState(Parameters::PowerIterations);
+        setAlgoIntFromState(Parameters::ColumnBlockSize);
+
         auto output = algo().run(withInputData((InputMatrix,input_matrix)));
 
         sendOutputFromAlgorithm(LeftPrincipalMatrix, output);
@@ -32,6 +32,7 @@
 #include <Modules/Math/SolveLinearSystem.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Math/LinearSystem/SolveLinearSystemAlgo.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
 #include <Core/Datatypes/MatrixTypeConversions.h>
@@ -57,6 +58,7 @@ void SolveLinearSystem::setStateDefaults()
   setStateIntFromAlgo(Variables::MaxIterations);
   setStateStringFromAlgoOption(Variables::Method);
   setStateStringFromAlgoOption(Variables::Preconditioner);
+  setStateStringFromAlgoOption(Core::Algorithms::Math::Parameters::SolverPrecision);
 }
 
 void SolveLinearSystem::execute()
@@ -66,15 +68,24 @@ void SolveLinearSystem::execute()
 
   if (needToExecute())
   {
+    auto method = get_state()->getValue(Variables::Method).toString();
+    // the direct solver reuses its factorization for every column of the right-hand side
+    const bool direct = method == "ldlt";
+
     /// @todo: why aren't these checks in the algo class?
-    if (rhs->ncols() != 1)
+    if (rhs->ncols() != 1 && !direct)
       THROW_ALGORITHM_INPUT_ERROR("Right-hand side matrix must contain only one column.");
     if (!matrixIs::sparse(A))
       THROW_ALGORITHM_INPUT_ERROR("Left-hand side matrix to solve must be sparse.");
 
-    auto rhsCol = castMatrix::toColumn(rhs);
-    if (!rhsCol)
-      rhsCol = convertMatrix::toColumn(rhs);
+    MatrixHandle rhsInput = rhs;
+    if (!direct)
+    {
+      auto rhsCol = castMatrix::toColumn(rhs);
+      if (!rhsCol)
+        rhsCol = convertMatrix::toColumn(rhs);
+      rhsInput = rhsCol;
+    }
 
     auto tolerance = get_state()->getValue(Variables::TargetError).toDouble();
     auto maxIterations = get_state()->getValue(Variables::MaxIterations).toInt();
@@ -85,22 +96,27 @@ void SolveLinearSystem::execute()
     if (maxIterations > 0)
       algo().set(Variables::MaxIterations, maxIterations);
 
-    auto method = get_state()->getValue(Variables::Method).toString();
     auto precond = get_state()->getValue(Variables::Preconditioner).toString();
     if (!method.empty())
       algo().setOption(Variables::Method, method);
     if (!precond.empty())
       algo().setOption(Variables::Preconditioner, precond);
+    setAlgoOptionFromState(Core::Algorithms::Math::Parameters::SolverPrecision);
+    const bool mixed = !direct && get_state()->getValue(Core::Algorithms::Math::Parameters::SolverPrecision).toString() == "mixed";
 
     std::ostringstream ostr;
-    ostr << "Running algorithm Parallel " << method << " Solver with tolerance " << tolerance << " and maximum iterations " << maxIterations;
+    if (direct)
+      ostr << "Running algorithm sparse direct " << method << " Solver";
+    else
+      ostr << "Running algorithm Parallel " << (mixed ? "mixed precision " : "") << method << " Solver with tolerance " << tolerance << " and maximum iterations " << maxIterations;
     remark(ostr.str());
 
     {
       ScopedTimeRemarker perf(this, "Linear solver");
-      remark("Using preconditioner: " + precond);
+      if (!direct)
+        remark("Using preconditioner: " + precond);
 
-      auto output = algo().run(withInputData((LHS, A)(RHS, rhsCol)));
+      auto output = algo().run(withInputData((LHS, A)(RHS, rhsInput)));
 
       sendOutputFromAlgorithm(Solution, output);
     }
@@ -29,6 +29,7 @@
 #include <Testing/ModuleTestBase/ModuleTestBase.h>
 #include <Modules/Math/SolveLinearSystem.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
 
@@ -84,3 +85,36 @@ TEST_F(SolveLinearSystemModuleTest, CanSolveSimple)
 
   sls->execute();
 }
+
+TEST_F(SolveLinearSystemModuleTest, CanSolveSeveralRightHandSidesWithLdlt)
+{
+  UseRealAlgorithmFactory f;
+
+  auto sls = makeModule("SolveLinearSystem");
+  SparseRowMatrixHandle lhs(new SparseRowMatrix(3,3));
+  lhs->insert(0,0) = lhs->insert(1,1) = lhs->insert(2,2) = 2;
+  lhs->makeCompressed();
+  MatrixHandle rhs(new DenseMatrix(DenseMatrix::Identity(3,2)));
+
+  stubPortNWithThisData(sls, 0, lhs);
+  stubPortNWithThisData(sls, 1, rhs);
+  sls->get_state()->setValue(Variables::Method, std::string("ldlt"));
+
+  EXPECT_NO_THROW(sls->execute());
+}
+
+TEST_F(SolveLinearSystemModuleTest, ThrowsForSeveralRightHandSidesWithIterativeMethod)
+{
+  UseRealAlgorithmFactory f;
+
+  auto sls = makeModule("SolveLinearSystem");
+  SparseRowMatrixHandle lhs(new SparseRowMatrix(3,3));
+  lhs->insert(0,0) = lhs->insert(1,1) = lhs->insert(2,2) = 2;
+  lhs->makeCompressed();
+  MatrixHandle rhs(new DenseMatrix(DenseMatrix::Identity(3,2)));
+
+  stubPortNWithThisData(sls, 0, lhs);
+  stubPortNWithThisData(sls, 1, rhs);
+
+  EXPECT_THROW(sls->execute(), AlgorithmInputException);
+}
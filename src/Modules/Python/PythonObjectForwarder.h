@@ -112,6 +112,15 @@ namespace SCIRun
                   module_.sendOutput(matrixPort, boost::make_shared<Datatypes::DenseMatrix>(mat));
                 }
               }
+              else if (var.name().name() == Core::Python::pyDenseMatrixLabel())
+              {
+                auto dense = boost::dynamic_pointer_cast<Core::Datatypes::DenseMatrix>(var.getDatatype());
+                if (dense)
+                {
+                  output = dense;
+                  module_.sendOutput(matrixPort, dense);
+                }
+              }
               else if (var.name().name() == Core::Python::pySparseRowMatrixLabel())
               {
                 auto sparse = boost::dynamic_pointer_cast<Core::Datatypes::SparseRowMatrix>(var.getDatatype());
@@ -485,6 +485,34 @@ namespace
     coordinateMap = StandardColorMapFactory::create("Grayscale", 256, 0, false,
       realColorMap->getColorMapRescaleScale(), realColorMap->getColorMapRescaleShift());
   }
+
+  // Maps every field value to its texture coordinate in one batch, indexed like the field values.
+  std::vector<double> mapValuesToIndices(VField* fld, const ColorMap& coordinateMap)
+  {
+    std::vector<double> indices;
+    if (fld->is_scalar())
+    {
+      std::vector<double> values;
+      fld->get_values(values);
+      indices.resize(values.size());
+      coordinateMap.valuesToIndices(values.data(), values.size(), indices.data());
+    }
+    else if (fld->is_vector())
+    {
+      std::vector<Vector> values;
+      fld->get_values(values);
+      indices.resize(values.size());
+      coordinateMap.valuesToIndices(values.data(), values.size(), indices.data());
+    }
+    else if (fld->is_tensor())
+    {
+      std::vector<Tensor> values;
+      fld->get_values(values);
+      indices.resize(values.size());
+      coordinateMap.valuesToIndices(values.data(), values.size(), indices.data());
+    }
+    return indices;
+  }
 }
 
 
@@ -529,11 +557,6 @@ void GeometryBuilder::renderFacesLinear(
   bool isCellData = (fld->basis_order() == 0 && mesh->dimensionality() == 3);
   bool isFaceData = (fld->basis_order() == 0 && mesh->dimensionality() == 2);
   bool isNodeData = (fld->basis_order() == 1);
-  bool isScalar = fld->is_scalar();
-  bool isVector = fld->is_vector();
-  bool isTensor = fld->is_tensor();
-  int colorMapCase = (isCellData * 0 + isFaceData * 1 + isNodeData * 2) * 3;
-  colorMapCase += isScalar * 0 + isVector * 1 + isTensor * 2;
 
   ColorScheme colorScheme = ColorScheme::COLOR_UNIFORM;
 
@@ -541,10 +564,12 @@ void GeometryBuilder::renderFacesLinear(
   ColorMapHandle textureMap, coordinateMap;
   spiltColorMapToTextureAndCoordinates(colorMap, textureMap, coordinateMap);
 
+  std::vector<double> valueIndices;
   if (useColorMap)
   {
     numAttributes += 2;
     colorScheme = ColorScheme::COLOR_MAP;
+    valueIndices = mapValuesToIndices(fld, *coordinateMap);
   }
 
   int writeCase = getWriteCase(useQuads, useNormals, useColorMap);
@@ -552,9 +577,6 @@ void GeometryBuilder::renderFacesLinear(
   std::vector<Point> points(numNodesPerFace);
   std::vector<Vector> normals(numNodesPerFace);
   std::vector<glm::vec2> textureCoords(numNodesPerFace);
-  std::vector<double> svals(numNodesPerFace);
-  std::vector<Vector> vvals(numNodesPerFace);
-  std::vector<Tensor> tvals(numNodesPerFace);
 
   size_t passNumber = 0;
   size_t facesLeft = mesh->num_faces();
@@ -648,92 +670,25 @@ void GeometryBuilder::renderFacesLinear(
           VMesh::Elem::array_type cells;
           mesh->get_elems(cells, *fiter);
 
-          if (isScalar)
-          {
-            fld->get_value(svals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(svals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToIndex(svals[0]);
-              textureCoords[i].y = coordinateMap->valueToIndex(svals[1]);
-            }
-          }
-          else if (isVector)
-          {
-            fld->get_value(vvals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(vvals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToIndex(vvals[0]);
-              textureCoords[i].y = coordinateMap->valueToIndex(vvals[1]);
-            }
-          }
-          else if (isTensor)
+          double front = valueIndices[cells[0]];
+          double back = (cells.size() > 1) ? valueIndices[cells[1]] : front;
+          for (size_t i = 0; i < numNodesPerFace; ++i)
           {
-            fld->get_value(tvals[0], cells[0]);
-            if (cells.size() > 1) fld->get_value(tvals[1], cells[1]);
-            else svals[1] = svals[0];
-
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              textureCoords[i].x = coordinateMap->valueToIndex(tvals[0]);
-              textureCoords[i].y = coordinateMap->valueToIndex(tvals[1]);
-            }
+            textureCoords[i].x = front;
+            textureCoords[i].y = back;
           }
         }
         // Element data (faces)
         else if (isFaceData)
         {
-          if (isScalar)
-          {
-            fld->get_value(svals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToIndex(svals[0]);
-          }
-          else if (isVector)
-          {
-            fld->get_value(vvals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToIndex(vvals[0]);
-          }
-          else if (isTensor)
-          {
-            fld->get_value(tvals[0], *fiter);
-            textureCoords[0].x = coordinateMap->valueToIndex(tvals[0]);
-          }
-
           for (size_t i = 0; i < numNodesPerFace; ++i)
-            textureCoords[i].y = textureCoords[i].x = textureCoords[0].x;
+            textureCoords[i].y = textureCoords[i].x = valueIndices[*fiter];
         }
         // Data at nodes
         else if (isNodeData)
         {
-          if (isScalar)
-          {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(svals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToIndex(svals[i]);
-            }
-          }
-          else if (isVector)
-          {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(vvals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToIndex(vvals[i]);
-            }
-          }
-          else if (isTensor)
-          {
-            for (size_t i = 0; i < numNodesPerFace; ++i)
-            {
-              fld->get_value(tvals[i], nodes[i]);
-              textureCoords[i].x = textureCoords[i].y = coordinateMap->valueToIndex(tvals[i]);
-            }
-          }
+          for (size_t i = 0; i < numNodesPerFace; ++i)
+            textureCoords[i].x = textureCoords[i].y = valueIndices[nodes[i]];
         }
       }
 
@@ -785,14 +740,15 @@ void GeometryBuilder::renderFacesLinear(
       attribs.push_back(SpireVBO::AttributeData("aTexCoords", 2 * sizeof(float)));
 
       const static int colorMapResolution = 256;
+      std::vector<double> textureValues(colorMapResolution);
       for(int i = 0; i < colorMapResolution; ++i)
-      {
-        ColorRGB color = textureMap->valueToColor(static_cast<float>(i)/colorMapResolution * 2.0 - 1.0);
-        texture.bitmap.push_back(color.r()*255.99f);
-        texture.bitmap.push_back(color.g()*255.99f);
-        texture.bitmap.push_back(color.b()*255.99f);
-        texture.bitmap.push_back(color.a()*255.99f);
-      }
+        textureValues[i] = static_cast<float>(i)/colorMapResolution * 2.0 - 1.0;
+
+      std::vector<uint32_t> texels(colorMapResolution);
+      textureMap->valuesToRGBA8(textureValues.data(), colorMapResolution, texels.data());
+      for (uint32_t texel : texels)
+        for (int channel = 0; channel < 4; ++channel)
+          texture.bitmap.push_back(static_cast<uint8_t>(texel >> (8 * channel)));
       texture.name = "ColorMap";
       texture.height = 1;
       texture.width = colorMapResolution;
@@ -833,10 +789,6 @@ void GeometryBuilder::renderNodes(
   VField* fld = field->vfield();
   VMesh*  mesh = field->vmesh();
 
-  double sval;
-  Vector vval;
-  Tensor tval;
-
   ColorScheme colorScheme;
   ColorRGB node_color;
 
@@ -850,6 +802,10 @@ void GeometryBuilder::renderNodes(
   else
     colorScheme = ColorScheme::COLOR_IN_SITU;
 
+  std::vector<double> valueIndices;
+  if (colorScheme != ColorScheme::COLOR_UNIFORM)
+    valueIndices = mapValuesToIndices(fld, *coordinateMap);
+
   mesh->synchronize(Mesh::NODES_E);
 
   VMesh::Node::iterator eiter, eiter_end;
@@ -878,25 +834,8 @@ void GeometryBuilder::renderNodes(
     Point p;
     mesh->get_point(p, *eiter);
     //coloring options
-    if (colorScheme != ColorScheme::COLOR_UNIFORM)
-    {
-      ColorMapHandle map = colorMap.get();
-      if (fld->is_scalar())
-      {
-        fld->get_value(sval, *eiter);
-        node_color = ColorRGB(coordinateMap->valueToIndex(sval));
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vval, *eiter);
-        node_color = ColorRGB(coordinateMap->valueToIndex(vval));
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tval, *eiter);
-        node_color = ColorRGB(coordinateMap->valueToIndex(tval));
-      }
-    }
+    if (!valueIndices.empty())
+      node_color = ColorRGB(valueIndices[*eiter]);
     //accumulate VBO or IBO data
     if (state.get(RenderState::ActionFlags::USE_SPHERE))
     {
@@ -926,10 +865,6 @@ void GeometryBuilder::renderEdges(
   VField* fld = field->vfield();
   VMesh*  mesh = field->vmesh();
 
-  double sval0, sval1;
-  Vector vval0, vval1;
-  Tensor tval0, tval1;
-
   ColorScheme colorScheme;
   ColorRGB edge_colors[2];
 
@@ -945,6 +880,10 @@ void GeometryBuilder::renderEdges(
   else
     colorScheme = ColorScheme::COLOR_IN_SITU;
 
+  std::vector<double> valueIndices;
+  if (colorScheme != ColorScheme::COLOR_UNIFORM)
+    valueIndices = mapValuesToIndices(fld, *coordinateMap);
+
   mesh->synchronize(Mesh::EDGES_E);
 
   VMesh::Edge::iterator eiter, eiter_end;
@@ -976,56 +915,16 @@ void GeometryBuilder::renderEdges(
     mesh->get_point(p0, nodes[0]);
     mesh->get_point(p1, nodes[1]);
     //coloring options
-    if (colorScheme != ColorScheme::COLOR_UNIFORM)
+    if (!valueIndices.empty())
     {
-      ColorMapHandle map = colorMap.get();
-      if (fld->is_scalar())
-      {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(sval0, nodes[0]);
-          fld->get_value(sval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(sval0, *eiter);
-
-          sval1 = sval0;
-        }
-        edge_colors[0] = ColorRGB(coordinateMap->valueToIndex(sval0));
-        edge_colors[1] = ColorRGB(coordinateMap->valueToIndex(sval1));
-      }
-      else if (fld->is_vector())
+      if (fld->basis_order() == 1)
       {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(vval0, nodes[0]);
-          fld->get_value(vval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(vval0, *eiter);
-          vval1 = vval0;
-        }
-
-        edge_colors[0] = ColorRGB(coordinateMap->valueToIndex(vval0));
-        edge_colors[1] = ColorRGB(coordinateMap->valueToIndex(vval1));
+        edge_colors[0] = ColorRGB(valueIndices[nodes[0]]);
+        edge_colors[1] = ColorRGB(valueIndices[nodes[1]]);
       }
-      else if (fld->is_tensor())
+      else //if (mesh->dimensionality() == 1)
       {
-        if (fld->basis_order() == 1)
-        {
-          fld->get_value(tval0, nodes[0]);
-          fld->get_value(tval1, nodes[1]);
-        }
-        else //if (mesh->dimensionality() == 1)
-        {
-          fld->get_value(tval0, *eiter);
-          tval1 = tval0;
-        }
-
-        edge_colors[0] = ColorRGB(coordinateMap->valueToIndex(tval0));
-        edge_colors[1] = ColorRGB(coordinateMap->valueToIndex(tval1));
+        edge_colors[0] = edge_colors[1] = ColorRGB(valueIndices[*eiter]);
       }
     }
     //accumulate VBO or IBO data
@@ -260,66 +260,57 @@ namespace SCIRun{
         current_index = index;
       }
 
-      // Returns the color map value based on the Input Port
-      ColorRGB ShowFieldGlyphsPortHandler::getColorMapVal(int index)
+      namespace
       {
-        getFieldData(index);
+        template <class T>
+        void mapValuesToColors(const ColorMap& map, const VField* vfld, std::vector<ColorRGB>& colors)
+        {
+          std::vector<T> values;
+          vfld->get_values(values);
+          colors.resize(values.size());
+          map.valuesToColors(values.data(), values.size(), colors.data());
+        }
+      }
 
-        ColorRGB colorMapVal;
-        switch(colorInput)
+      void ShowFieldGlyphsPortHandler::mapFieldColors(VField* vfld, FieldDataType dataType, const char* portName)
+      {
+        switch(dataType)
         {
-          case RenderState::GlyphInputPort::PRIMARY_PORT:
-            switch(pf_data_type)
-            {
-              case FieldDataType::Scalar:
-                colorMapVal = colorMap.get()->valueToColor(pinputScalar.get());
-                break;
-              case FieldDataType::Vector:
-                colorMapVal = colorMap.get()->valueToColor(pinputVector.get());
-                break;
-              case FieldDataType::Tensor:
-                colorMapVal = colorMap.get()->valueToColor(pinputTensor.get());
-                break;
-              default:
-                throw std::invalid_argument("Primary color map did not find scalar, vector, or tensor data.");
-            }
+          case FieldDataType::Scalar:
+            mapValuesToColors<double>(*colorMap.get(), vfld, colorMapColors);
             break;
-          case RenderState::GlyphInputPort::SECONDARY_PORT:
-            switch(sf_data_type)
-            {
-              case FieldDataType::Scalar:
-                colorMapVal = colorMap.get()->valueToColor(sinputScalar.get());
-                break;
-              case FieldDataType::Vector:
-                colorMapVal = colorMap.get()->valueToColor(sinputVector.get());
-                break;
-              case FieldDataType::Tensor:
-                colorMapVal = colorMap.get()->valueToColor(sinputTensor.get());
-                break;
-              default:
-                throw std::invalid_argument("Secondary color map did not find scalar, vector, or tensor data.");
-            }
+          case FieldDataType::Vector:
+            mapValuesToColors<Vector>(*colorMap.get(), vfld, colorMapColors);
             break;
-          case RenderState::GlyphInputPort::TERTIARY_PORT:
-            switch(tf_data_type)
-            {
-              case FieldDataType::Scalar:
-                colorMapVal = colorMap.get()->valueToColor(tinputScalar.get());
-                break;
-              case FieldDataType::Vector:
-                colorMapVal = colorMap.get()->valueToColor(tinputVector.get());
-                break;
-              case FieldDataType::Tensor:
-                colorMapVal = colorMap.get()->valueToColor(tinputTensor.get());
-                break;
-              default:
-                throw std::invalid_argument("Tertiary color map did not find scalar, vector, or tensor data.");
-            }
+          case FieldDataType::Tensor:
+            mapValuesToColors<Tensor>(*colorMap.get(), vfld, colorMapColors);
             break;
           default:
-            throw std::invalid_argument("Color map selection was not given a primary, secondary, or tertiary port.");
+            throw std::invalid_argument(std::string(portName) + " color map did not find scalar, vector, or tensor data.");
+        }
+      }
+
+      // Returns the color map value based on the Input Port
+      ColorRGB ShowFieldGlyphsPortHandler::getColorMapVal(int index)
+      {
+        if (colorMapColors.empty())
+        {
+          switch(colorInput)
+          {
+            case RenderState::GlyphInputPort::PRIMARY_PORT:
+              mapFieldColors(p_vfld, pf_data_type, "Primary");
+              break;
+            case RenderState::GlyphInputPort::SECONDARY_PORT:
+              mapFieldColors(s_vfld, sf_data_type, "Secondary");
+              break;
+            case RenderState::GlyphInputPort::TERTIARY_PORT:
+              mapFieldColors(t_vfld, tf_data_type, "Tertiary");
+              break;
+            default:
+              throw std::invalid_argument("Color map selection was not given a primary, secondary, or tertiary port.");
+          }
         }
-        return colorMapVal;
+        return colorMapColors[index];
       }
 
       // Verifies that data is valid. Run this after initialization
@@ -75,8 +75,11 @@ namespace SCIRun{
         bool colorMapGiven;
         bool secondaryFieldGiven, tertiaryFieldGiven;
         FieldDataType pf_data_type{FieldDataType::UNKNOWN }, sf_data_type{ FieldDataType::UNKNOWN }, tf_data_type{FieldDataType::UNKNOWN };
+        // Colors of every value of the color map port's field, mapped in one batch on first use.
+        std::vector<Core::Datatypes::ColorRGB> colorMapColors;
 
         void getFieldData(int index);
+        void mapFieldColors(VField* vfld, FieldDataType dataType, const char* portName);
 
         // Returns a color value to use for color maps
         Core::Datatypes::ColorRGB getColorMapVal(int index);
@@ -289,6 +289,49 @@ FieldHandle CubeTriSurfLinearBasis(data_info_type type)
   return field;
 }
 
+FieldHandle CubeGrid(int n, FieldInformation fi)
+{
+  FieldHandle field = CreateField(fi);
+  VMesh* mesh = field->vmesh();
+  for (int k = 0; k <= n; ++k)
+    for (int j = 0; j <= n; ++j)
+      for (int i = 0; i <= n; ++i)
+        mesh->add_point(Point(i, j, k));
+
+  static const int tets[6][4] = { {0,1,3,7}, {0,3,2,7}, {0,2,6,7}, {0,6,4,7}, {0,4,5,7}, {0,5,1,7} };
+  static const int hexOrder[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  const bool hex = mesh->is_hexvolmesh();
+  VMesh::Node::array_type nodes;
+  for (int k = 0; k < n; ++k)
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i)
+      {
+        // corner c sits at (i,j,k) + (c & 1, (c >> 1) & 1, (c >> 2) & 1)
+        VMesh::index_type corner[8];
+        for (int c = 0; c < 8; ++c)
+          corner[c] = (i + (c & 1)) + (n + 1)*((j + ((c >> 1) & 1)) + (n + 1)*(k + ((c >> 2) & 1)));
+        if (hex)
+        {
+          nodes.resize(8);
+          for (int c = 0; c < 8; ++c)
+            nodes[c] = corner[hexOrder[c]];
+          mesh->add_elem(nodes);
+        }
+        else
+        {
+          nodes.resize(4);
+          for (const auto& tet : tets)
+          {
+            for (int c = 0; c < 4; ++c)
+              nodes[c] = corner[tet[c]];
+            mesh->add_elem(nodes);
+          }
+        }
+      }
+  field->vfield()->resize_values();
+  return field;
+}
+
 }}
 
 FieldHandle SCIRun::TestUtils::CreateEmptyLatVol()
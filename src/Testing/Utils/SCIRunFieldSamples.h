@@ -90,6 +90,11 @@ SCISHARE FieldHandle CubeTriSurfLinearBasis(data_info_type type);
 SCISHARE FieldHandle TetrahedronTriSurfConstantBasis(data_info_type type);
 SCISHARE FieldHandle TetrahedronTriSurfLinearBasis(data_info_type type);
 
+/// Grid of n x n x n unit cubes with node (i,j,k) at Point(i,j,k) and index i + (n+1)*(j + (n+1)*k).
+/// A HexVolMesh keeps one hex per cube, any other volume mesh gets six tets per cube around
+/// the cube diagonal. The values are resized but left unset.
+SCISHARE FieldHandle CubeGrid(int n, FieldInformation fi);
+
 SCISHARE FieldHandle CreateEmptyLatVol();
 SCISHARE FieldHandle CreateEmptyLatVol(size_type sizex, size_type sizey, size_type sizez,
   data_info_type type = data_info_type::DOUBLE_E,